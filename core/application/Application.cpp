@@ -40,6 +40,7 @@
 #include "file_server/event_handler/LogInput.h"
 #include "go_pipeline/LogtailPlugin.h"
 #include "logger/Logger.h"
+#include "metadata/K8sMetadata.h"
 #include "monitor/Monitor.h"
 #include "pipeline/PipelineManager.h"
 #include "pipeline/plugin/PluginRegistry.h"
@@ -351,6 +352,8 @@ void Application::Exit() {
 
     PluginRegistry::GetInstance()->UnloadPlugins();
 
+    K8sMetadata::GetInstance().Stop();
+
 #ifdef __ENTERPRISE__
     EnterpriseConfigProvider::GetInstance()->Stop();
     LegacyConfigProvider::GetInstance()->Stop();
@@ -0,0 +1,266 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/CompiledTimeFormat.h"
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+const uint64_t kHighNibbles = 0xF0F0F0F0F0F0F0F0ULL;
+const uint64_t kZeros = 0x3030303030303030ULL;
+const uint64_t kSixes = 0x0606060606060606ULL;
+
+// mktime of the beginning of the last hour parsed by the thread. Logs are mostly in order, so that mktime, which
+// looks up the local timezone and daylight saving time, is called about once an hour of log time.
+struct HourCache {
+    int64_t mKey = -1;
+    time_t mTime = 0;
+};
+
+thread_local HourCache sHourCache;
+
+uint64_t LoadBytes(const char* bytes, size_t size) {
+    uint64_t res = 0;
+    memcpy(&res, bytes, size);
+    return res;
+}
+
+int ReadDigits(const char* buf, int offset, int width) {
+    int res = 0;
+    for (int i = 0; i < width; ++i) {
+        res = res * 10 + (buf[offset + i] - '0');
+    }
+    return res;
+}
+
+bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+} // namespace
+
+CompiledTimeFormat::CompiledTimeFormat(const string& format, int32_t specifiedYear)
+    : mFormat(format), mSpecifiedYear(specifiedYear) {
+    mCompiled = Compile(format);
+}
+
+bool CompiledTimeFormat::Compile(const string& format) {
+    string expanded;
+    for (size_t i = 0; i < format.size(); ++i) {
+        if (format[i] != '%' || i + 1 == format.size()) {
+            expanded += format[i];
+        } else if (format[i + 1] == 'F') {
+            expanded += "%Y-%m-%d";
+            ++i;
+        } else if (format[i + 1] == 'T') {
+            expanded += "%H:%M:%S";
+            ++i;
+        } else {
+            expanded.append(format, i, 2);
+            ++i;
+        }
+    }
+
+    fill(begin(mFieldOffsets), end(mFieldOffsets), -1);
+    // the template, with '0' for digits, and whether each byte is a digit
+    string literals;
+    string digits;
+    auto addField = [&](Field field, int width) {
+        if (mFieldOffsets[field] >= 0) {
+            return false;
+        }
+        mFieldOffsets[field] = literals.size();
+        literals.append(width, '0');
+        digits.append(width, 1);
+        return true;
+    };
+    for (size_t i = 0; i < expanded.size(); ++i) {
+        char c = expanded[i];
+        bool literal = c != '%';
+        if (!literal) {
+            if (++i == expanded.size()) {
+                return false;
+            }
+            c = expanded[i];
+            literal = c == '%';
+        }
+        if (literal) {
+            // whitespace is taken as one literal byte, while more or other whitespace is left to Strptime
+            if (mHasNanosecond) {
+                mSuffix += c;
+            } else {
+                literals += c;
+                digits += '\0';
+            }
+            continue;
+        }
+        if (mHasNanosecond) {
+            return false;
+        }
+        bool added = false;
+        switch (c) {
+            case 'Y':
+                added = addField(YEAR, 4);
+                break;
+            case 'y':
+                added = addField(SHORT_YEAR, 2);
+                break;
+            case 'm':
+                added = addField(MONTH, 2);
+                break;
+            case 'd':
+            case 'e':
+                added = addField(DAY, 2);
+                break;
+            case 'H':
+            case 'k':
+                added = addField(HOUR, 2);
+                break;
+            case 'M':
+                added = addField(MINUTE, 2);
+                break;
+            case 'S':
+                added = addField(SECOND, 2);
+                break;
+            case 'f':
+                // of no fixed width, so only literals are allowed after it
+                mHasNanosecond = true;
+                added = true;
+                break;
+            default:
+                break;
+        }
+        if (!added) {
+            return false;
+        }
+    }
+    if ((mFieldOffsets[YEAR] >= 0) == (mFieldOffsets[SHORT_YEAR] >= 0) || mFieldOffsets[MONTH] < 0
+        || mFieldOffsets[DAY] < 0 || mFieldOffsets[HOUR] < 0 || mFieldOffsets[MINUTE] < 0) {
+        return false;
+    }
+
+    mSize = literals.size();
+    for (size_t offset = 0;; offset += 8) {
+        Chunk chunk;
+        // the last chunk overlaps the previous one, so that no byte after the template is read
+        chunk.mOffset = mSize < 8 ? 0 : min(offset, mSize - 8);
+        char digitMask[8] = {};
+        char literalMask[8] = {};
+        char literalBytes[8] = {};
+        for (size_t i = 0; i < 8 && chunk.mOffset + i < mSize; ++i) {
+            size_t pos = chunk.mOffset + i;
+            if (digits[pos]) {
+                digitMask[i] = '\xFF';
+            } else {
+                literalMask[i] = '\xFF';
+                literalBytes[i] = literals[pos];
+            }
+        }
+        chunk.mDigitMask = LoadBytes(digitMask, 8);
+        chunk.mLiteralMask = LoadBytes(literalMask, 8);
+        chunk.mLiterals = LoadBytes(literalBytes, 8);
+        mChunks.push_back(chunk);
+        if (chunk.mOffset + 8 >= mSize) {
+            break;
+        }
+    }
+    return true;
+}
+
+bool CompiledTimeFormat::MatchTemplate(const char* buf) const {
+    for (const auto& chunk : mChunks) {
+        uint64_t bytes = mSize < 8 ? LoadBytes(buf, mSize) : LoadBytes(buf + chunk.mOffset, 8);
+        // bytes of digits are kept and the others are set to '0', and then for each byte, the high nibble of both the
+        // byte and the byte plus 6 must be 3, i.e., the byte must be in ['0', '9']
+        uint64_t digits = (bytes & chunk.mDigitMask) | (kZeros & ~chunk.mDigitMask);
+        uint64_t mismatch = ((digits & kHighNibbles) ^ kZeros) | (((digits + kSixes) & kHighNibbles) ^ kZeros)
+            | ((bytes ^ chunk.mLiterals) & chunk.mLiteralMask);
+        if (mismatch != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const char* CompiledTimeFormat::Parse(const char* buf, size_t size, LogtailTime* ts, int& nanosecondLength) const {
+    if (!mCompiled || size < mSize || !MatchTemplate(buf)) {
+        return Strptime(buf, mFormat.c_str(), ts, nanosecondLength, mSpecifiedYear);
+    }
+    int year = 0;
+    if (mFieldOffsets[YEAR] >= 0) {
+        year = ReadDigits(buf, mFieldOffsets[YEAR], 4);
+    } else {
+        year = ReadDigits(buf, mFieldOffsets[SHORT_YEAR], 2);
+        year += year <= 68 ? 2000 : 1900;
+    }
+    int month = ReadDigits(buf, mFieldOffsets[MONTH], 2);
+    int day = ReadDigits(buf, mFieldOffsets[DAY], 2);
+    int hour = ReadDigits(buf, mFieldOffsets[HOUR], 2);
+    int minute = ReadDigits(buf, mFieldOffsets[MINUTE], 2);
+    int second = mFieldOffsets[SECOND] >= 0 ? ReadDigits(buf, mFieldOffsets[SECOND], 2) : 0;
+    // same ranges as Strptime
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 61) {
+        return Strptime(buf, mFormat.c_str(), ts, nanosecondLength, mSpecifiedYear);
+    }
+
+    const char* end = buf + mSize;
+    long nanosecond = 0;
+    int digitCnt = 0;
+    if (mHasNanosecond) {
+        const char* limit = buf + size;
+        while (end < limit && digitCnt <= 9 && IsDigit(*end)) {
+            nanosecond = nanosecond * 10 + (*end++ - '0');
+            ++digitCnt;
+        }
+        if (digitCnt == 0 || digitCnt > 9 || static_cast<size_t>(limit - end) < mSuffix.size()
+            || memcmp(end, mSuffix.data(), mSuffix.size()) != 0) {
+            return Strptime(buf, mFormat.c_str(), ts, nanosecondLength, mSpecifiedYear);
+        }
+        for (int i = digitCnt; i < 9; ++i) {
+            nanosecond *= 10;
+        }
+        end += mSuffix.size();
+    }
+
+    int64_t key = ((static_cast<int64_t>(year) * 13 + month) * 32 + day) * 24 + hour;
+    HourCache& cache = sHourCache;
+    if (cache.mKey != key) {
+        struct tm tm = {};
+        tm.tm_year = year - 1900;
+        tm.tm_mon = month - 1;
+        tm.tm_mday = day;
+        tm.tm_hour = hour;
+        time_t hourTime = mktime(&tm);
+        if (hourTime == -1) {
+            return Strptime(buf, mFormat.c_str(), ts, nanosecondLength, mSpecifiedYear);
+        }
+        cache.mKey = key;
+        cache.mTime = hourTime;
+    }
+    ts->tv_sec = cache.mTime + minute * 60 + second;
+    ts->tv_nsec = nanosecond;
+    if (mHasNanosecond) {
+        nanosecondLength = digitCnt;
+    }
+    return end;
+}
+
+} // namespace logtail
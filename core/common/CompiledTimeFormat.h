@@ -0,0 +1,70 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/TimeUtil.h"
+
+namespace logtail {
+
+// CompiledTimeFormat parses log time of a fixed width format, such as %Y-%m-%d %H:%M:%S.%f, by reading digits at
+// fixed offsets instead of interpreting the format for each log. The format is compiled into a template of literals
+// and digits checked 8 bytes at a time, and a list of fields to extract. Formats with names, such as %b, or with
+// conversions of no fixed width, such as %s, are not compiled, and any input not fitting the template, e.g., a month
+// of one digit, is passed to Strptime, so that the result is always the same as that of Strptime.
+class CompiledTimeFormat {
+public:
+    CompiledTimeFormat() = default;
+    explicit CompiledTimeFormat(const std::string& format, int32_t specifiedYear = -1);
+
+    // works like Strptime(buf, format, ts, nanosecondLength, specifiedYear), and reads no more than size bytes in the
+    // fast path
+    const char* Parse(const char* buf, size_t size, LogtailTime* ts, int& nanosecondLength) const;
+
+    bool IsCompiled() const { return mCompiled; }
+
+private:
+    enum Field { YEAR, SHORT_YEAR, MONTH, DAY, HOUR, MINUTE, SECOND, FIELD_COUNT };
+
+    // 8 bytes of the template starting at mOffset
+    struct Chunk {
+        size_t mOffset = 0;
+        uint64_t mDigitMask = 0;
+        uint64_t mLiteralMask = 0;
+        uint64_t mLiterals = 0;
+    };
+
+    bool Compile(const std::string& format);
+    bool MatchTemplate(const char* buf) const;
+
+    std::string mFormat;
+    int32_t mSpecifiedYear = -1;
+    bool mCompiled = false;
+    // size of the template, i.e., the part before %f
+    size_t mSize = 0;
+    std::vector<Chunk> mChunks;
+    int mFieldOffsets[FIELD_COUNT] = {};
+    bool mHasNanosecond = false;
+    // literals after %f
+    std::string mSuffix;
+};
+
+} // namespace logtail
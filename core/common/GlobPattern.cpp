@@ -0,0 +1,99 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/GlobPattern.h"
+
+#include <cstring>
+#include <string_view>
+#if defined(__linux__)
+#include <fnmatch.h>
+#endif
+
+#include "common/StringTools.h"
+
+using namespace std;
+
+namespace logtail {
+
+GlobPattern::GlobPattern(const string& pattern, int flags) : mPattern(pattern), mFlags(flags) {
+#if defined(__linux__)
+    // only flags 0 and FNM_PATHNAME are handled, FNM_PERIOD etc. fall back to fnmatch
+    if ((flags & ~FNM_PATHNAME) != 0) {
+        return;
+    }
+    mSlashExcluded = (flags & FNM_PATHNAME) != 0;
+
+    size_t firstStar = pattern.find('*');
+    size_t lastStar = pattern.rfind('*');
+    if (pattern.find_first_of("?[\\") != string::npos) {
+        return;
+    }
+    if (firstStar == string::npos) {
+        mLiteral = pattern;
+        mType = Type::LITERAL;
+        return;
+    }
+    // leading and trailing stars only, e.g. *, **, *.log, app*, *error*
+    size_t begin = pattern.find_first_not_of('*');
+    if (begin == string::npos) {
+        mType = Type::ANY;
+        return;
+    }
+    size_t end = pattern.find_last_not_of('*') + 1;
+    if (pattern.find('*', begin) < end) {
+        return;
+    }
+    mLiteral = pattern.substr(begin, end - begin);
+    // with FNM_PATHNAME, '*' can not match '/', which is easy to check only when the literal has no '/'
+    if (mSlashExcluded && mLiteral.find('/') != string::npos) {
+        return;
+    }
+    if (begin == 0) {
+        mType = Type::PREFIX;
+    } else if (lastStar < begin) {
+        mType = Type::SUFFIX;
+    } else {
+        mType = Type::CONTAINS;
+    }
+#endif
+}
+
+bool GlobPattern::Match(const string& s) const {
+    const char* str = s.data();
+    size_t len = s.size();
+    switch (mType) {
+        case Type::ANY:
+            return !mSlashExcluded || memchr(str, '/', len) == nullptr;
+        case Type::LITERAL:
+            return len == mLiteral.size() && memcmp(str, mLiteral.data(), len) == 0;
+        case Type::PREFIX:
+            return len >= mLiteral.size() && memcmp(str, mLiteral.data(), mLiteral.size()) == 0
+                && (!mSlashExcluded || memchr(str + mLiteral.size(), '/', len - mLiteral.size()) == nullptr);
+        case Type::SUFFIX:
+            return len >= mLiteral.size()
+                && memcmp(str + len - mLiteral.size(), mLiteral.data(), mLiteral.size()) == 0
+                && (!mSlashExcluded || memchr(str, '/', len - mLiteral.size()) == nullptr);
+        case Type::CONTAINS:
+            if (mSlashExcluded && memchr(str, '/', len) != nullptr) {
+                return false;
+            }
+            return len >= mLiteral.size()
+                && string_view(str, len).find(string_view(mLiteral.data(), mLiteral.size())) != string_view::npos;
+        default:
+            break;
+    }
+    return fnmatch(mPattern.c_str(), s.c_str(), mFlags) == 0;
+}
+
+} // namespace logtail
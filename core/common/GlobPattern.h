@@ -0,0 +1,49 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+
+namespace logtail {
+
+// GlobPattern is a fnmatch pattern parsed once, so that common patterns such as
+// *.log, access.log* or app.log can be matched by plain string comparison instead
+// of calling fnmatch every time. Other patterns fall back to fnmatch.
+// The result of Match is always the same as fnmatch(pattern, str, flags) == 0.
+class GlobPattern {
+public:
+    enum class Type { ANY, LITERAL, PREFIX, SUFFIX, CONTAINS, FNMATCH };
+
+    GlobPattern() = default;
+    GlobPattern(const std::string& pattern, int flags);
+
+    bool Match(const std::string& str) const;
+
+    const std::string& GetPattern() const { return mPattern; }
+    Type GetType() const { return mType; }
+
+private:
+    std::string mPattern;
+    // literal part of the pattern for ANY, LITERAL, PREFIX, SUFFIX and CONTAINS
+    std::string mLiteral;
+    int mFlags = 0;
+    Type mType = Type::FNMATCH;
+    // true if '*' in pattern can not match '/', i.e. FNM_PATHNAME is set
+    bool mSlashExcluded = false;
+};
+
+} // namespace logtail
@@ -0,0 +1,211 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/IoUring.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <linux/stat.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+// IORING_SETUP_CLAMP comes with headers of linux 5.6, which adds IORING_OP_STATX
+#if defined(IORING_SETUP_CLAMP) && defined(STATX_BASIC_STATS)
+#define LOGTAIL_IO_URING_STATX
+#endif
+#endif
+
+using namespace std;
+
+namespace logtail {
+
+#ifdef LOGTAIL_IO_URING_STATX
+
+namespace {
+
+template <typename T>
+T* RingField(void* ring, uint32_t offset) {
+    return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+} // namespace
+
+IoUring::~IoUring() {
+    Destroy();
+}
+
+bool IoUring::Init(uint32_t entries) {
+    Destroy();
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CLAMP;
+    int fd = syscall(__NR_io_uring_setup, entries, &params);
+    if (fd < 0) {
+        return false;
+    }
+    mRingFd = fd;
+    mSqEntries = params.sq_entries;
+    mSqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    mCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        mSqRingSize = mCqRingSize = max(mSqRingSize, mCqRingSize);
+    }
+    mSqRing = mmap(nullptr, mSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (mSqRing == MAP_FAILED) {
+        mSqRing = nullptr;
+        Destroy();
+        return false;
+    }
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        mCqRing = mSqRing;
+    } else {
+        mCqRing
+            = mmap(nullptr, mCqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (mCqRing == MAP_FAILED) {
+            mCqRing = nullptr;
+            Destroy();
+            return false;
+        }
+    }
+    mSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    mSqes = mmap(nullptr, mSqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (mSqes == MAP_FAILED) {
+        mSqes = nullptr;
+        Destroy();
+        return false;
+    }
+    mSqTail = RingField<uint32_t>(mSqRing, params.sq_off.tail);
+    mSqMask = *RingField<uint32_t>(mSqRing, params.sq_off.ring_mask);
+    mSqArray = RingField<uint32_t>(mSqRing, params.sq_off.array);
+    mCqHead = RingField<uint32_t>(mCqRing, params.cq_off.head);
+    mCqTail = RingField<uint32_t>(mCqRing, params.cq_off.tail);
+    mCqMask = *RingField<uint32_t>(mCqRing, params.cq_off.ring_mask);
+    mCqes = RingField<io_uring_cqe>(mCqRing, params.cq_off.cqes);
+    mStatxBuffer.resize(mSqEntries * sizeof(struct statx));
+
+    // older kernels set up the ring but reject statx
+    vector<FileStatResult> results;
+    if (!Statx({"/"}, results) || results[0].mErrno != 0) {
+        Destroy();
+        return false;
+    }
+    return true;
+}
+
+void IoUring::Destroy() {
+    if (mSqes != nullptr) {
+        munmap(mSqes, mSqesSize);
+        mSqes = nullptr;
+    }
+    if (mCqRing != nullptr && mCqRing != mSqRing) {
+        munmap(mCqRing, mCqRingSize);
+    }
+    mCqRing = nullptr;
+    if (mSqRing != nullptr) {
+        munmap(mSqRing, mSqRingSize);
+        mSqRing = nullptr;
+    }
+    if (mRingFd >= 0) {
+        close(mRingFd);
+        mRingFd = -1;
+    }
+}
+
+bool IoUring::Statx(const vector<string>& paths, vector<FileStatResult>& results) {
+    results.assign(paths.size(), FileStatResult());
+    if (mRingFd < 0) {
+        return false;
+    }
+    io_uring_cqe* cqes = static_cast<io_uring_cqe*>(mCqes);
+    io_uring_sqe* sqes = static_cast<io_uring_sqe*>(mSqes);
+    struct statx* buffers = reinterpret_cast<struct statx*>(mStatxBuffer.data());
+
+    // submit at most sq entries at a time and wait for all of them, so the completion ring never overflows
+    for (size_t begin = 0; begin < paths.size(); begin += mSqEntries) {
+        uint32_t cnt = static_cast<uint32_t>(min<size_t>(paths.size() - begin, mSqEntries));
+        uint32_t tail = *mSqTail;
+        for (uint32_t i = 0; i < cnt; ++i, ++tail) {
+            uint32_t idx = tail & mSqMask;
+            io_uring_sqe* sqe = &sqes[idx];
+            memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = IORING_OP_STATX;
+            sqe->fd = AT_FDCWD;
+            sqe->addr = reinterpret_cast<uintptr_t>(paths[begin + i].c_str());
+            sqe->len = STATX_BASIC_STATS;
+            sqe->off = reinterpret_cast<uintptr_t>(&buffers[i]);
+            sqe->user_data = i;
+            mSqArray[idx] = idx;
+        }
+        __atomic_store_n(mSqTail, tail, __ATOMIC_RELEASE);
+
+        uint32_t toSubmit = cnt;
+        uint32_t done = 0;
+        while (done < cnt) {
+            int ret = syscall(__NR_io_uring_enter, mRingFd, toSubmit, cnt - done, IORING_ENTER_GETEVENTS, nullptr, 0);
+            ++mSyscallCount;
+            if (ret < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            toSubmit -= min<uint32_t>(toSubmit, ret);
+            uint32_t head = *mCqHead;
+            uint32_t ready = __atomic_load_n(mCqTail, __ATOMIC_ACQUIRE);
+            for (; head != ready; ++head, ++done) {
+                const io_uring_cqe& cqe = cqes[head & mCqMask];
+                FileStatResult& result = results[begin + cqe.user_data];
+                if (cqe.res < 0) {
+                    result.mErrno = -cqe.res;
+                    continue;
+                }
+                const struct statx& buf = buffers[cqe.user_data];
+                result.mDev = makedev(buf.stx_dev_major, buf.stx_dev_minor);
+                result.mInode = buf.stx_ino;
+                result.mSize = buf.stx_size;
+                result.mModifySec = buf.stx_mtime.tv_sec;
+                result.mModifyNsec = buf.stx_mtime.tv_nsec;
+            }
+            __atomic_store_n(mCqHead, head, __ATOMIC_RELEASE);
+        }
+    }
+    return true;
+}
+
+#else
+
+IoUring::~IoUring() {
+}
+
+bool IoUring::Init(uint32_t entries) {
+    return false;
+}
+
+void IoUring::Destroy() {
+}
+
+bool IoUring::Statx(const vector<string>& paths, vector<FileStatResult>& results) {
+    results.assign(paths.size(), FileStatResult());
+    return false;
+}
+
+#endif
+
+} // namespace logtail
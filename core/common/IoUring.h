@@ -0,0 +1,78 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace logtail {
+
+struct FileStatResult {
+    // 0 if succeeded, or errno of the failure
+    int mErrno = 0;
+    uint64_t mDev = 0;
+    uint64_t mInode = 0;
+    uint64_t mSize = 0;
+    int64_t mModifySec = 0;
+    int64_t mModifyNsec = 0;
+};
+
+// IoUring submits file operations of many files through io_uring, so that a batch takes one syscall instead of one
+// for each file. It talks to the kernel by raw syscalls and needs linux 5.6+. Init fails if io_uring is not
+// available, and callers should fall back to plain syscalls then. It is not thread safe.
+class IoUring {
+public:
+    IoUring() = default;
+    ~IoUring();
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    bool Init(uint32_t entries);
+    void Destroy();
+    bool IsInit() const { return mRingFd >= 0; }
+
+    // Stats paths like stat(2), and results[i] is for paths[i]. Returns false if the ring fails.
+    bool Statx(const std::vector<std::string>& paths, std::vector<FileStatResult>& results);
+
+    // number of io_uring_enter calls made
+    uint64_t GetSyscallCount() const { return mSyscallCount; }
+
+private:
+    int mRingFd = -1;
+    uint32_t mSqEntries = 0;
+    void* mSqRing = nullptr;
+    size_t mSqRingSize = 0;
+    void* mCqRing = nullptr;
+    size_t mCqRingSize = 0;
+    void* mSqes = nullptr;
+    size_t mSqesSize = 0;
+    // fields in the mapped rings
+    uint32_t* mSqTail = nullptr;
+    uint32_t mSqMask = 0;
+    uint32_t* mSqArray = nullptr;
+    uint32_t* mCqHead = nullptr;
+    uint32_t* mCqTail = nullptr;
+    uint32_t mCqMask = 0;
+    void* mCqes = nullptr;
+    // buffers for the kernel to write statx results into
+    std::vector<char> mStatxBuffer;
+    uint64_t mSyscallCount = 0;
+};
+
+} // namespace logtail
@@ -0,0 +1,393 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/RegexPrefilter.h"
+
+#include <cctype>
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+using ByteSet = array<bool, 256>;
+
+void AddRange(ByteSet& set, unsigned char from, unsigned char to) {
+    for (int c = from; c <= to; ++c) {
+        set[c] = true;
+    }
+}
+
+void AddNonAscii(ByteSet& set) {
+    AddRange(set, 0x80, 0xff);
+}
+
+void Complement(ByteSet& set) {
+    for (auto& b : set) {
+        b = !b;
+    }
+}
+
+// returns the byte matched by a literal escape such as \. or \t, or -1 if c does not make one. \< \> \` and \' are
+// assertions in perl syntax of boost.
+int EscapedLiteral(char c) {
+    switch (c) {
+        case 't':
+            return '\t';
+        case 'n':
+            return '\n';
+        case 'r':
+            return '\r';
+        case 'f':
+            return '\f';
+        case 'a':
+            return '\a';
+        case 'e':
+            return 0x1b;
+        case '<':
+        case '>':
+        case '`':
+        case '\'':
+            return -1;
+        default:
+            break;
+    }
+    if (!isalnum(static_cast<unsigned char>(c)) && c != '\0') {
+        return static_cast<unsigned char>(c);
+    }
+    return -1;
+}
+
+// adds bytes matched by a class escape such as \d, returns false if c does not make one. Non-ascii bytes are always
+// added to word and whitespace classes, since they depend on locale.
+bool AddClassEscape(char c, ByteSet& set) {
+    ByteSet tmp{};
+    switch (c) {
+        case 'd':
+        case 'D':
+            AddRange(tmp, '0', '9');
+            break;
+        case 'w':
+        case 'W':
+            AddRange(tmp, '0', '9');
+            AddRange(tmp, 'a', 'z');
+            AddRange(tmp, 'A', 'Z');
+            tmp['_'] = true;
+            break;
+        case 's':
+        case 'S':
+            for (char s : string(" \t\n\r\f\v")) {
+                tmp[static_cast<unsigned char>(s)] = true;
+            }
+            break;
+        case 'v':
+        case 'V':
+            // vertical whitespace
+            for (char s : string("\n\v\f\r")) {
+                tmp[static_cast<unsigned char>(s)] = true;
+            }
+            break;
+        case 'h':
+        case 'H':
+            // horizontal whitespace
+            tmp[' '] = true;
+            tmp['\t'] = true;
+            break;
+        default:
+            return false;
+    }
+    if (isupper(static_cast<unsigned char>(c))) {
+        Complement(tmp);
+    } else if (c != 'd') {
+        AddNonAscii(tmp);
+    }
+    for (size_t i = 0; i < set.size(); ++i) {
+        set[i] = set[i] || tmp[i];
+    }
+    return true;
+}
+
+// parses the bracket expression at pos, which points to '['
+bool ParseClass(const string& p, size_t& pos, ByteSet& set) {
+    ByteSet tmp{};
+    ++pos;
+    bool negated = pos < p.size() && p[pos] == '^';
+    if (negated) {
+        ++pos;
+    }
+    // whether the bracket holds a class escape depending on locale, whose non-ascii bytes must survive the negation
+    bool localeDependent = false;
+    bool first = true;
+    while (pos < p.size() && (p[pos] != ']' || first)) {
+        first = false;
+        int from = -1;
+        if (p[pos] == '[') {
+            // posix classes such as [:alpha:] are not supported
+            if (pos + 1 < p.size() && (p[pos + 1] == ':' || p[pos + 1] == '=' || p[pos + 1] == '.')) {
+                return false;
+            }
+            from = '[';
+            ++pos;
+        } else if (p[pos] == '\\') {
+            if (pos + 1 >= p.size()) {
+                return false;
+            }
+            // \v is the vertical tab within brackets, while \V is still a class
+            if (p[pos + 1] != 'v' && AddClassEscape(p[pos + 1], tmp)) {
+                localeDependent = localeDependent || tolower(static_cast<unsigned char>(p[pos + 1])) != 'd';
+                pos += 2;
+                continue;
+            }
+            from = p[pos + 1] == 'v' ? '\v' : EscapedLiteral(p[pos + 1]);
+            if (from < 0) {
+                return false;
+            }
+            pos += 2;
+        } else {
+            from = static_cast<unsigned char>(p[pos]);
+            ++pos;
+        }
+        if (pos + 1 < p.size() && p[pos] == '-' && p[pos + 1] != ']') {
+            int to = static_cast<unsigned char>(p[pos + 1]);
+            pos += 2;
+            if (to == '\\' || to == '[' || to < from) {
+                return false;
+            }
+            AddRange(tmp, from, to);
+        } else {
+            tmp[from] = true;
+        }
+    }
+    if (pos >= p.size()) {
+        return false;
+    }
+    ++pos;
+    if (negated) {
+        Complement(tmp);
+        if (localeDependent) {
+            AddNonAscii(tmp);
+        }
+    }
+    for (size_t i = 0; i < set.size(); ++i) {
+        set[i] = set[i] || tmp[i];
+    }
+    return true;
+}
+
+// moves pos over the quantifier after an atom if any, returns false if the atom may occur zero times
+bool SkipQuantifier(const string& p, size_t& pos) {
+    if (pos >= p.size()) {
+        return true;
+    }
+    switch (p[pos]) {
+        case '?':
+        case '*':
+            return false;
+        case '+':
+            ++pos;
+            break;
+        case '{': {
+            size_t end = p.find('}', pos);
+            if (end == string::npos || !isdigit(static_cast<unsigned char>(p[pos + 1]))) {
+                return false;
+            }
+            // the min count is not 0
+            size_t i = pos + 1;
+            while (p[i] == '0') {
+                ++i;
+            }
+            if (!isdigit(static_cast<unsigned char>(p[i]))) {
+                return false;
+            }
+            pos = end + 1;
+            break;
+        }
+        default:
+            return true;
+    }
+    // lazy or possessive
+    if (pos < p.size() && (p[pos] == '?' || p[pos] == '+')) {
+        ++pos;
+    }
+    return true;
+}
+
+bool ParseBranches(const string& p, size_t& pos, ByteSet& set, char endChar);
+
+// parses the atom at pos and adds the bytes it may begin with to set, returns false if the atom is not supported
+bool ParseAtom(const string& p, size_t& pos, ByteSet& set) {
+    if (pos >= p.size()) {
+        return false;
+    }
+    char c = p[pos];
+    switch (c) {
+        case '(':
+            if (pos + 1 < p.size() && p[pos + 1] == '?') {
+                // only non-capturing groups are supported, flags and assertions may change what the group begins with
+                if (pos + 2 >= p.size() || p[pos + 2] != ':') {
+                    return false;
+                }
+                pos += 3;
+            } else {
+                ++pos;
+            }
+            return ParseBranches(p, pos, set, ')');
+        case '[':
+            return ParseClass(p, pos, set);
+        case '\\': {
+            if (pos + 1 >= p.size()) {
+                return false;
+            }
+            if (AddClassEscape(p[pos + 1], set)) {
+                pos += 2;
+                return true;
+            }
+            int literal = EscapedLiteral(p[pos + 1]);
+            if (literal < 0) {
+                return false;
+            }
+            set[literal] = true;
+            pos += 2;
+            return true;
+        }
+        case '.':
+        case '^':
+        case '$':
+        case '|':
+        case ')':
+        case '*':
+        case '+':
+        case '?':
+        case '{':
+            return false;
+        default:
+            set[static_cast<unsigned char>(c)] = true;
+            ++pos;
+            return true;
+    }
+}
+
+// moves pos to the '|' or endChar ending the current branch, returns false if not found
+bool SkipBranch(const string& p, size_t& pos, char endChar) {
+    int depth = 0;
+    while (pos < p.size()) {
+        char c = p[pos];
+        if (c == '\\') {
+            pos += 2;
+        } else if (c == '[') {
+            ++pos;
+            if (pos < p.size() && p[pos] == '^') {
+                ++pos;
+            }
+            if (pos < p.size() && p[pos] == ']') {
+                ++pos;
+            }
+            while (pos < p.size() && p[pos] != ']') {
+                if (p[pos] == '\\') {
+                    ++pos;
+                } else if (p[pos] == '[' && pos + 1 < p.size() && p[pos + 1] == ':') {
+                    size_t end = p.find(":]", pos + 2);
+                    if (end == string::npos) {
+                        return false;
+                    }
+                    pos = end + 1;
+                }
+                ++pos;
+            }
+            ++pos;
+        } else if (c == '(') {
+            ++depth;
+            ++pos;
+        } else if (c == ')' && depth > 0) {
+            --depth;
+            ++pos;
+        } else if (depth == 0 && (c == '|' || c == endChar)) {
+            return true;
+        } else {
+            ++pos;
+        }
+    }
+    return endChar == '\0';
+}
+
+// parses alternatives until endChar, adding bytes each of them may begin with to set
+bool ParseBranches(const string& p, size_t& pos, ByteSet& set, char endChar) {
+    while (true) {
+        if (pos < p.size() && p[pos] == '^') {
+            ++pos;
+        }
+        if (!ParseAtom(p, pos, set) || !SkipQuantifier(p, pos) || !SkipBranch(p, pos, endChar)) {
+            return false;
+        }
+        if (pos >= p.size()) {
+            return true;
+        }
+        ++pos;
+        if (p[pos - 1] != '|') {
+            return true;
+        }
+    }
+}
+
+// returns the literal every match begins with, given that the top level of p has no alternatives
+string GetLiteralPrefix(const string& p) {
+    string prefix;
+    size_t pos = p.empty() || p[0] != '^' ? 0 : 1;
+    while (pos < p.size()) {
+        int literal = -1;
+        size_t next = pos + 1;
+        if (p[pos] == '\\') {
+            if (pos + 1 >= p.size()) {
+                break;
+            }
+            literal = EscapedLiteral(p[pos + 1]);
+            next = pos + 2;
+        } else if (string(".^$|()[]{}*+?").find(p[pos]) == string::npos) {
+            literal = static_cast<unsigned char>(p[pos]);
+        }
+        if (literal < 0 || (next < p.size() && (p[next] == '?' || p[next] == '*' || p[next] == '{'))) {
+            break;
+        }
+        prefix += static_cast<char>(literal);
+        if (next < p.size() && p[next] == '+') {
+            break;
+        }
+        pos = next;
+    }
+    return prefix;
+}
+
+} // namespace
+
+RegexPrefilter::RegexPrefilter(const string& pattern) {
+    size_t pos = 0;
+    ByteSet set{};
+    if (pattern.empty() || !ParseBranches(pattern, pos, set, '\0')) {
+        return;
+    }
+    mFirstBytes = set;
+    for (bool b : mFirstBytes) {
+        mValid = mValid || !b;
+    }
+    if (!mValid) {
+        return;
+    }
+    pos = 0;
+    if (SkipBranch(pattern, pos, '\0') && pos >= pattern.size()) {
+        mPrefix = GetLiteralPrefix(pattern);
+    }
+}
+
+} // namespace logtail
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstring>
+#include <string>
+
+namespace logtail {
+
+// RegexPrefilter holds what a perl-style regex requires at the beginning of any string it matches from the first
+// character (i.e., with boost::match_continuous), namely the set of possible first bytes and the literal prefix, e.g.,
+// [0-9] for \d{4}-\d{2}-\d{2}.* and "Exception" for Exception.*, so that most strings can be rejected without calling
+// the regex engine. Patterns not understood, such as those starting with a lookahead or an optional atom, make no
+// requirement, and every string passes.
+class RegexPrefilter {
+public:
+    RegexPrefilter() = default;
+    explicit RegexPrefilter(const std::string& pattern);
+
+    // false means the regex can not match str from its beginning, while true means it may
+    bool MayMatch(const char* data, size_t size) const {
+        if (!mValid) {
+            return true;
+        }
+        if (size == 0 || !mFirstBytes[static_cast<unsigned char>(data[0])]) {
+            return false;
+        }
+        return size >= mPrefix.size() && memcmp(data, mPrefix.data(), mPrefix.size()) == 0;
+    }
+
+    bool IsValid() const { return mValid; }
+    const std::string& GetPrefix() const { return mPrefix; }
+
+private:
+    std::array<bool, 256> mFirstBytes{};
+    std::string mPrefix;
+    bool mValid = false;
+};
+
+} // namespace logtail
@@ -16,7 +16,9 @@
 
 #include <chrono>
 
+#include "common/memory/BufferPool.h"
 #include "monitor/metric_constants/MetricConstants.h"
+#include "monitor/metric_models/ScopedCpuTimer.h"
 
 using namespace std;
 
@@ -30,10 +32,16 @@ void Compressor::SetMetricRecordRef(MetricLabels&& labels, DynamicMetricLabels&&
     mOutItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_OUT_ITEMS_TOTAL);
     mOutItemSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_OUT_SIZE_BYTES);
     mTotalProcessMs = mMetricsRecordRef.CreateTimeCounter(METRIC_COMPONENT_TOTAL_PROCESS_TIME_MS);
+    mTotalCpuTimeMs = mMetricsRecordRef.CreateShardedTimeCounter(METRIC_COMPONENT_TOTAL_CPU_TIME_MS);
     mDiscardedItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_DISCARDED_ITEMS_TOTAL);
     mDiscardedItemSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_DISCARDED_SIZE_BYTES);
 }
 
+void Compressor::PrepareOutput(string& output, size_t size) {
+    BufferPool::GetInstance()->Reserve(output, size);
+    output.resize(size);
+}
+
 bool Compressor::DoCompress(const string& input, string& output, string& errorMsg) {
     if (mMetricsRecordRef != nullptr) {
         mInItemsTotal->Add(1);
@@ -41,7 +49,16 @@ bool Compressor::DoCompress(const string& input, string& output, string& errorMs
     }
 
     auto before = chrono::system_clock::now();
-    auto res = Compress(input, output, errorMsg);
+    bool res = false;
+    {
+        ScopedCpuTimer<ShardedTimeCounterPtr> cpuTimer(mTotalCpuTimeMs);
+        res = Compress(input, output, errorMsg);
+        if (res) {
+            // output is reserved for the compress bound, which is much larger than the compressed data usually, and
+            // is held by the sender queue item until sent
+            BufferPool::GetInstance()->Shrink(output);
+        }
+    }
 
     if (mMetricsRecordRef != nullptr) {
         mTotalProcessMs->Add(chrono::system_clock::now() - before);
@@ -39,6 +39,10 @@ public:
     void SetMetricRecordRef(MetricLabels&& labels, DynamicMetricLabels&& dynamicLabels = {});
 
 protected:
+    // output is resized to size, with buffer taken from pool if its capacity is not enough. The buffer is shrunk by
+    // DoCompress after compression.
+    static void PrepareOutput(std::string& output, size_t size);
+
     mutable MetricsRecordRef mMetricsRecordRef;
     CounterPtr mInItemsTotal;
     CounterPtr mInItemSizeBytes;
@@ -47,6 +51,7 @@ protected:
     CounterPtr mDiscardedItemsTotal;
     CounterPtr mDiscardedItemSizeBytes;
     TimeCounterPtr mTotalProcessMs;
+    ShardedTimeCounterPtr mTotalCpuTimeMs;
 
 private:
     virtual bool Compress(const std::string& input, std::string& output, std::string& errorMsg) = 0;
@@ -28,7 +28,7 @@ bool LZ4Compressor::Compress(const string& input, string& output, string& errorM
         errorMsg = "input size is incorrect";
         return false;
     }
-    output.resize(static_cast<size_t>(encodingSize));
+    PrepareOutput(output, static_cast<size_t>(encodingSize));
     try {
         encodingSize = static_cast<size_t>(
             LZ4_compress_default(input.c_str(), const_cast<char*>(output.c_str()), input.size(), encodingSize));
@@ -22,7 +22,7 @@ namespace logtail {
 
 bool ZstdCompressor::Compress(const string& input, string& output, string& errorMsg) {
     size_t encodingSize = ZSTD_compressBound(input.size());
-    output.resize(encodingSize);
+    PrepareOutput(output, encodingSize);
     try {
         encodingSize = ZSTD_compress(
             const_cast<char*>(output.c_str()), encodingSize, input.c_str(), input.size(), mCompressionLevel);
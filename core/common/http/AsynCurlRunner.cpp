@@ -26,6 +26,11 @@ using namespace std;
 namespace logtail {
 
 bool AsynCurlRunner::Init() {
+    lock_guard<mutex> lock(mMux);
+    if (mUserCnt > 0) {
+        ++mUserCnt;
+        return true;
+    }
     mClient = curl_multi_init();
     mIsFlush = false;
     if (mClient == nullptr) {
@@ -33,10 +38,15 @@ bool AsynCurlRunner::Init() {
         return false;
     }
     mThreadRes = async(launch::async, &AsynCurlRunner::Run, this);
+    ++mUserCnt;
     return true;
 }
 
 void AsynCurlRunner::Stop() {
+    lock_guard<mutex> lock(mMux);
+    if (mUserCnt == 0 || --mUserCnt > 0) {
+        return;
+    }
     mIsFlush = true;
     future_status s = mThreadRes.wait_for(chrono::seconds(1));
     if (s == future_status::ready) {
@@ -83,7 +93,7 @@ bool AsynCurlRunner::AddRequestToClient(unique_ptr<AsynHttpRequest>&& request) {
                                    request->mUrl,
                                    request->mQueryString,
                                    request->mHeader,
-                                   request->mBody,
+                                   request->GetBody(),
                                    request->mResponse,
                                    headers,
                                    request->mTimeout,
@@ -39,6 +39,7 @@ public:
         return &instance;
     }
 
+    // the runner is shared by several modules, and is only stopped when all who have inited it call Stop()
     bool Init();
     void Stop();
     bool AddRequest(std::unique_ptr<AsynHttpRequest>&& request);
@@ -57,6 +58,8 @@ private:
 
     std::future<void> mThreadRes;
     std::atomic_bool mIsFlush = false;
+    std::mutex mMux;
+    uint32_t mUserCnt = 0;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class HttpRequestTimerEventUnittest;
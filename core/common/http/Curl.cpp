@@ -153,7 +153,7 @@ bool SendHttpRequest(std::unique_ptr<HttpRequest>&& request, HttpResponse& respo
                                    request->mUrl,
                                    request->mQueryString,
                                    request->mHeader,
-                                   request->mBody,
+                                   request->GetBody(),
                                    response,
                                    headers,
                                    request->mTimeout,
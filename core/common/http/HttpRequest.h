@@ -19,6 +19,7 @@
 #include <chrono>
 #include <cstdint>
 #include <map>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -47,6 +48,9 @@ struct HttpRequest {
 
     std::map<std::string, std::string> mHeader;
     std::string mBody;
+    // if not null, the referenced string is sent instead of mBody to avoid copying large body, and it must outlive the
+    // request
+    const std::string* mBodyRef = nullptr;
     std::string mHost;
     int32_t mPort;
     uint32_t mTimeout = static_cast<uint32_t>(INT32_FLAG(default_http_request_timeout_secs));
@@ -82,6 +86,8 @@ struct HttpRequest {
           mFollowRedirects(followRedirects),
           mTls(std::move(tls)) {}
     virtual ~HttpRequest() = default;
+
+    const std::string& GetBody() const { return mBodyRef ? *mBodyRef : mBody; }
 };
 
 struct AsynHttpRequest : public HttpRequest {
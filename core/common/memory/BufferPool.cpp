@@ -0,0 +1,136 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/memory/BufferPool.h"
+
+#include "common/Flags.h"
+#include "monitor/metric_constants/MetricConstants.h"
+
+DEFINE_FLAG_INT64(buffer_pool_max_size_bytes, "max bytes of idle buffers cached in buffer pool", 64 * 1024 * 1024);
+
+using namespace std;
+
+namespace logtail {
+
+BufferPool::BufferPool() {
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
+        mMetricsRecordRef,
+        MetricCategory::METRIC_CATEGORY_COMPONENT,
+        {{METRIC_LABEL_KEY_COMPONENT_NAME, METRIC_LABEL_VALUE_COMPONENT_NAME_BUFFER_POOL}});
+    mPooledBuffersTotal = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BUFFER_POOL_POOLED_BUFFERS_TOTAL);
+    mPooledSizeBytesGauge = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BUFFER_POOL_POOLED_SIZE_BYTES);
+    mReusedBuffersTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_BUFFER_POOL_REUSED_BUFFERS_TOTAL);
+    mAllocatedBuffersTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_BUFFER_POOL_ALLOCATED_BUFFERS_TOTAL);
+    mDiscardedBuffersTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_BUFFER_POOL_DISCARDED_BUFFERS_TOTAL);
+}
+
+string BufferPool::Acquire(size_t size) {
+    size_t idx = 0;
+    while (idx < sClassCnt && GetClassSize(idx) < size) {
+        ++idx;
+    }
+    string res;
+    if (idx == sClassCnt) {
+        // too large to be pooled
+        mAllocatedBuffersTotal->Add(1);
+        res.reserve(size);
+        return res;
+    }
+    // an empty string has some inline capacity, so whether a buffer is pooled can not be told by its capacity
+    bool reused = false;
+    {
+        SizeClass& sizeClass = mClasses[idx];
+        lock_guard<mutex> lock(sizeClass.mMux);
+        if (!sizeClass.mBuffers.empty()) {
+            res.swap(sizeClass.mBuffers.back());
+            sizeClass.mBuffers.pop_back();
+            reused = true;
+        }
+    }
+    if (reused) {
+        mPooledSizeBytes -= res.capacity();
+        mPooledBuffersTotal->Sub(1);
+        mPooledSizeBytesGauge->Set(mPooledSizeBytes.load());
+        mReusedBuffersTotal->Add(1);
+        return res;
+    }
+    mAllocatedBuffersTotal->Add(1);
+    res.reserve(GetClassSize(idx));
+    return res;
+}
+
+void BufferPool::Release(string&& buf) {
+    size_t capacity = buf.capacity();
+    // buffers too large to be pooled are allocated directly by Acquire, and are freed here
+    if (capacity < sMinClassSize || capacity >= GetClassSize(sClassCnt - 1) * 2) {
+        return;
+    }
+    if (mPooledSizeBytes.load() + capacity > static_cast<size_t>(INT64_FLAG(buffer_pool_max_size_bytes))) {
+        mDiscardedBuffersTotal->Add(1);
+        return;
+    }
+    // find the largest class whose size is no more than the buffer capacity
+    size_t idx = 0;
+    while (idx + 1 < sClassCnt && GetClassSize(idx + 1) <= capacity) {
+        ++idx;
+    }
+    buf.clear();
+    {
+        SizeClass& sizeClass = mClasses[idx];
+        lock_guard<mutex> lock(sizeClass.mMux);
+        sizeClass.mBuffers.emplace_back(std::move(buf));
+    }
+    mPooledSizeBytes += capacity;
+    mPooledBuffersTotal->Add(1);
+    mPooledSizeBytesGauge->Set(mPooledSizeBytes.load());
+}
+
+void BufferPool::Reserve(string& buf, size_t size) {
+    if (buf.capacity() >= size) {
+        return;
+    }
+    Release(std::move(buf));
+    buf = Acquire(size);
+}
+
+void BufferPool::Shrink(string& buf) {
+    if (buf.size() > GetClassSize(sClassCnt - 1)) {
+        return;
+    }
+    size_t idx = 0;
+    while (GetClassSize(idx) < buf.size()) {
+        ++idx;
+    }
+    if (buf.capacity() < GetClassSize(idx) * 2) {
+        return;
+    }
+    string res = Acquire(buf.size());
+    res.assign(buf);
+    Release(std::move(buf));
+    buf.swap(res);
+}
+
+#ifdef APSARA_UNIT_TEST_MAIN
+void BufferPool::Clear() {
+    for (auto& sizeClass : mClasses) {
+        lock_guard<mutex> lock(sizeClass.mMux);
+        sizeClass.mBuffers.clear();
+    }
+    mPooledSizeBytes = 0;
+    mPooledBuffersTotal->Set(0);
+    mPooledSizeBytesGauge->Set(0);
+}
+#endif
+
+} // namespace logtail
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "monitor/MetricManager.h"
+
+namespace logtail {
+
+// BufferPool caches large string buffers used on the sending path, i.e., serialized data, compressed data and the data
+// held by sender queue items. Buffers are grouped by size classes (power of 2 times 4KB), so that a buffer released by
+// one thread can be reused by another one without going through malloc again.
+class BufferPool {
+public:
+    static constexpr size_t sMinClassSize = 4 * 1024;
+    static constexpr size_t sClassCnt = 13; // up to 16MB
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    static BufferPool* GetInstance() {
+        // never destructed, since buffers may still be released by other static objects on exit
+        static BufferPool* ptr = new BufferPool();
+        return ptr;
+    }
+
+    // the returned buffer is empty with capacity no less than size
+    std::string Acquire(size_t size);
+    // buffer content is discarded, it is cached only when its capacity fits some size class and the pool is not full
+    void Release(std::string&& buf);
+    // make sure buf has capacity no less than size by exchanging it with a pooled one if necessary, content is
+    // discarded in such case
+    void Reserve(std::string& buf, size_t size);
+    // move content of buf to a buffer of the smallest size class fitting it, if the capacity of buf is at least twice
+    // of that class, so that buffers reserved for the worst case hold no more than twice of their content
+    void Shrink(std::string& buf);
+
+    size_t GetPooledSizeBytes() const { return mPooledSizeBytes.load(); }
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    void Clear();
+#endif
+
+private:
+    struct SizeClass {
+        std::mutex mMux;
+        std::vector<std::string> mBuffers;
+    };
+
+    BufferPool();
+    ~BufferPool() = default;
+
+    static size_t GetClassSize(size_t idx) { return sMinClassSize << idx; }
+
+    std::array<SizeClass, sClassCnt> mClasses;
+    std::atomic_size_t mPooledSizeBytes = 0;
+
+    mutable MetricsRecordRef mMetricsRecordRef;
+    IntGaugePtr mPooledBuffersTotal;
+    IntGaugePtr mPooledSizeBytesGauge;
+    CounterPtr mReusedBuffersTotal;
+    CounterPtr mAllocatedBuffersTotal;
+    CounterPtr mDiscardedBuffersTotal;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class BufferPoolUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -0,0 +1,114 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/memory/ChunkPool.h"
+
+#include "common/Flags.h"
+#include "monitor/MetricManager.h"
+#include "monitor/metric_constants/MetricConstants.h"
+
+DEFINE_FLAG_INT64(chunk_pool_max_size_bytes, "max bytes of idle chunks cached in chunk pool", 64 * 1024 * 1024);
+
+using namespace std;
+
+namespace logtail {
+
+ChunkPool::ChunkPool() {
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
+        mMetricsRecordRef,
+        MetricCategory::METRIC_CATEGORY_COMPONENT,
+        {{METRIC_LABEL_KEY_COMPONENT_NAME, METRIC_LABEL_VALUE_COMPONENT_NAME_CHUNK_POOL}});
+    mPooledChunksTotal = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_CHUNK_POOL_POOLED_CHUNKS_TOTAL);
+    mPooledSizeBytesGauge = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_CHUNK_POOL_POOLED_SIZE_BYTES);
+    mReusedChunksTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_CHUNK_POOL_REUSED_CHUNKS_TOTAL);
+    mAllocatedChunksTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_CHUNK_POOL_ALLOCATED_CHUNKS_TOTAL);
+    mDiscardedChunksTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_CHUNK_POOL_DISCARDED_CHUNKS_TOTAL);
+}
+
+size_t ChunkPool::GetClassIndex(size_t size) {
+    size_t idx = 0;
+    while (idx < sClassCnt && GetClassSize(idx) + sChunkSlack < size) {
+        ++idx;
+    }
+    return idx;
+}
+
+uint8_t* ChunkPool::Acquire(size_t size) {
+    size_t idx = GetClassIndex(size);
+    if (idx == sClassCnt) {
+        // too large to be pooled
+        mAllocatedChunksTotal->Add(1);
+        return new uint8_t[size];
+    }
+    uint8_t* chunk = nullptr;
+    {
+        SizeClass& sizeClass = mClasses[idx];
+        lock_guard<mutex> lock(sizeClass.mMux);
+        if (!sizeClass.mChunks.empty()) {
+            chunk = sizeClass.mChunks.back();
+            sizeClass.mChunks.pop_back();
+        }
+    }
+    if (chunk != nullptr) {
+        mPooledSizeBytes -= GetClassSize(idx);
+        mPooledChunksTotal->Sub(1);
+        mPooledSizeBytesGauge->Set(mPooledSizeBytes.load());
+        mReusedChunksTotal->Add(1);
+        return chunk;
+    }
+    mAllocatedChunksTotal->Add(1);
+    return new uint8_t[GetClassSize(idx) + sChunkSlack];
+}
+
+void ChunkPool::Release(uint8_t* chunk, size_t size) {
+    if (chunk == nullptr) {
+        return;
+    }
+    size_t idx = GetClassIndex(size);
+    if (idx == sClassCnt) {
+        delete[] chunk;
+        return;
+    }
+    size_t classSize = GetClassSize(idx);
+    if (mPooledSizeBytes.load() + classSize > static_cast<size_t>(INT64_FLAG(chunk_pool_max_size_bytes))) {
+        mDiscardedChunksTotal->Add(1);
+        delete[] chunk;
+        return;
+    }
+    {
+        SizeClass& sizeClass = mClasses[idx];
+        lock_guard<mutex> lock(sizeClass.mMux);
+        sizeClass.mChunks.push_back(chunk);
+    }
+    mPooledSizeBytes += classSize;
+    mPooledChunksTotal->Add(1);
+    mPooledSizeBytesGauge->Set(mPooledSizeBytes.load());
+}
+
+#ifdef APSARA_UNIT_TEST_MAIN
+void ChunkPool::Clear() {
+    for (auto& sizeClass : mClasses) {
+        lock_guard<mutex> lock(sizeClass.mMux);
+        for (auto chunk : sizeClass.mChunks) {
+            delete[] chunk;
+        }
+        sizeClass.mChunks.clear();
+    }
+    mPooledSizeBytes = 0;
+    mPooledChunksTotal->Set(0);
+    mPooledSizeBytesGauge->Set(0);
+}
+#endif
+
+} // namespace logtail
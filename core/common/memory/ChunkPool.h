@@ -0,0 +1,90 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "monitor/metric_models/MetricRecord.h"
+
+namespace logtail {
+
+// ChunkPool caches memory chunks of BufferAllocator, which hold the content of event groups, e.g., logs read from
+// files. Chunks are grouped by size classes (power of 2 times 4KB) like BufferPool, and go back to the pool when the
+// source buffer owning them is destructed, which usually happens on another thread when the last event group
+// referencing it is released.
+class ChunkPool {
+public:
+    static constexpr size_t sMinClassSize = 4 * 1024;
+    static constexpr size_t sClassCnt = 13; // up to 16MB
+    // each chunk has a few more bytes than its class size, so that a request slightly larger than the class size,
+    // e.g., a 512KB read buffer plus the terminating '\0', still fits the class
+    static constexpr size_t sChunkSlack = 64;
+
+    ChunkPool(const ChunkPool&) = delete;
+    ChunkPool& operator=(const ChunkPool&) = delete;
+
+    static ChunkPool* GetInstance() {
+        // never destructed, since chunks may still be released by other static objects on exit
+        static ChunkPool* ptr = new ChunkPool();
+        return ptr;
+    }
+
+    // the returned chunk has no less than size bytes
+    uint8_t* Acquire(size_t size);
+    // size must be the same as the one passed to Acquire
+    void Release(uint8_t* chunk, size_t size);
+
+    size_t GetPooledSizeBytes() const { return mPooledSizeBytes.load(); }
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    void Clear();
+#endif
+
+private:
+    struct SizeClass {
+        std::mutex mMux;
+        std::vector<uint8_t*> mChunks;
+    };
+
+    ChunkPool();
+    ~ChunkPool() = default;
+
+    static size_t GetClassSize(size_t idx) { return sMinClassSize << idx; }
+    // returns sClassCnt if size is too large to be pooled
+    static size_t GetClassIndex(size_t size);
+
+    std::array<SizeClass, sClassCnt> mClasses;
+    std::atomic_size_t mPooledSizeBytes = 0;
+
+    mutable MetricsRecordRef mMetricsRecordRef;
+    IntGaugePtr mPooledChunksTotal;
+    IntGaugePtr mPooledSizeBytesGauge;
+    CounterPtr mReusedChunksTotal;
+    CounterPtr mAllocatedChunksTotal;
+    CounterPtr mDiscardedChunksTotal;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ChunkPoolUnittest;
+    friend class SourceBufferUnittest;
+#endif
+};
+
+} // namespace logtail
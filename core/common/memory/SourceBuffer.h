@@ -18,7 +18,10 @@
 
 #include <list>
 #include <memory>
+#include <utility>
+#include <vector>
 
+#include "common/memory/ChunkPool.h"
 #include "models/StringView.h"
 
 namespace logtail {
@@ -39,6 +42,8 @@ private:
 };
 
 // only movable
+// chunks are acquired from and returned to ChunkPool, so that memory of a destructed allocator, e.g., the one behind
+// an event group read from file, is reused by the next one instead of going back to the heap
 class BufferAllocator {
 private:
     static const uint32_t kAlignSize = sizeof(void*);
@@ -47,8 +52,8 @@ private:
 public:
     explicit BufferAllocator(uint32_t firstChunkSize = 4096, uint32_t chunkSizeLimit = 1024 * 128)
         : mFirstChunkSize(firstChunkSize), mChunkSizeLimit(chunkSizeLimit), mChunkSize(firstChunkSize) {
-        mAllocPtr = new uint8_t[mChunkSize];
-        mAllocatedChunks.push_back(mAllocPtr);
+        mAllocPtr = ChunkPool::GetInstance()->Acquire(mChunkSize);
+        mAllocatedChunks.emplace_back(mAllocPtr, mChunkSize);
         mFreeBytesInChunk = mChunkSize;
         mAllocated = mChunkSize;
     }
@@ -61,16 +66,16 @@ public:
 
     ~BufferAllocator() {
         for (size_t i = 0; i < mAllocatedChunks.size(); i++) {
-            delete[] mAllocatedChunks[i];
+            ChunkPool::GetInstance()->Release(mAllocatedChunks[i].first, mAllocatedChunks[i].second);
         }
     }
 
     void Reset(void) {
         for (size_t i = 1; i < mAllocatedChunks.size(); i++) {
-            delete[] mAllocatedChunks[i];
+            ChunkPool::GetInstance()->Release(mAllocatedChunks[i].first, mAllocatedChunks[i].second);
         }
         mAllocatedChunks.resize(1);
-        mAllocPtr = mAllocatedChunks[0];
+        mAllocPtr = mAllocatedChunks[0].first;
         mChunkSize = mFirstChunkSize;
         mFreeBytesInChunk = mChunkSize;
         mAllocated = mChunkSize;
@@ -106,8 +111,8 @@ private:
              * will not be so large. Thus, it is wise to allocate it directly
              * from heap in order to avoid polluting chunk size.
              */
-            mem = new uint8_t[bytes];
-            mAllocatedChunks.push_back(mem);
+            mem = ChunkPool::GetInstance()->Acquire(bytes);
+            mAllocatedChunks.emplace_back(mem, bytes);
             mAllocated += bytes;
         } else {
             /*
@@ -116,8 +121,8 @@ private:
             if (mChunkSize < mChunkSizeLimit) {
                 mChunkSize *= 2;
             }
-            mem = new uint8_t[mChunkSize];
-            mAllocatedChunks.push_back(mem);
+            mem = ChunkPool::GetInstance()->Acquire(mChunkSize);
+            mAllocatedChunks.emplace_back(mem, mChunkSize);
             mAllocPtr = mem + bytes;
             mFreeBytesInChunk = mChunkSize - bytes;
             mAllocated += mChunkSize;
@@ -131,8 +136,8 @@ private:
     const uint32_t mFirstChunkSize = 4096;
     const uint32_t mChunkSizeLimit = 1024 * 128;
 
-    // The allocated memory chunks
-    std::vector<uint8_t*> mAllocatedChunks;
+    // The allocated memory chunks and their sizes
+    std::vector<std::pair<uint8_t*, uint32_t>> mAllocatedChunks;
     // Statistics data
     uint64_t mAllocated = 0;
     uint64_t mUsed = 0;
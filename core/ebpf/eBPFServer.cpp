@@ -33,6 +33,10 @@
 DEFINE_FLAG_INT64(kernel_min_version_for_ebpf,
                   "the minimum kernel version that supported eBPF normal running, 4.19.0.0 -> 4019000000",
                   4019000000);
+DEFINE_FLAG_INT32(ebpf_spill_ring_capacity,
+                  "max number of event groups buffered per ebpf plugin type when the process queue is full",
+                  64);
+DEFINE_FLAG_INT32(ebpf_spill_ring_drain_interval_ms, "interval to replay event groups buffered in spill rings", 1000);
 
 namespace logtail {
 namespace ebpf {
@@ -41,6 +45,35 @@ static const uint16_t KERNEL_VERSION_310 = 3010; // for centos7
 static const std::string KERNEL_NAME_CENTOS = "CentOS";
 static const uint16_t KERNEL_CENTOS_MIN_VERSION = 7006;
 
+class SpillRingDrainEvent : public TimerEvent {
+public:
+    SpillRingDrainEvent(const std::weak_ptr<Timer>& timer, const std::vector<std::weak_ptr<SpillRing>>& rings)
+        : TimerEvent(std::chrono::steady_clock::now()
+                     + std::chrono::milliseconds(INT32_FLAG(ebpf_spill_ring_drain_interval_ms))),
+          mTimer(timer),
+          mRings(rings) {}
+
+    bool IsValid() const override { return !mTimer.expired(); }
+
+    bool Execute() override {
+        for (const auto& item : mRings) {
+            auto ring = item.lock();
+            if (ring) {
+                ring->Drain();
+            }
+        }
+        auto timer = mTimer.lock();
+        if (timer) {
+            timer->PushEvent(std::make_unique<SpillRingDrainEvent>(mTimer, mRings));
+        }
+        return true;
+    }
+
+private:
+    std::weak_ptr<Timer> mTimer;
+    std::vector<std::weak_ptr<SpillRing>> mRings;
+};
+
 bool EnvManager::IsSupportedEnv(nami::PluginType type) {
     if (!mInited) {
         LOG_ERROR(sLogger, ("env manager not inited ...", ""));
@@ -178,6 +211,37 @@ void eBPFServer::Init() {
     mNetworkSecureCB = std::make_unique<SecurityHandler>(nullptr, -1, 0);
     mProcessSecureCB = std::make_unique<SecurityHandler>(nullptr, -1, 0);
     mFileSecureCB = std::make_unique<SecurityHandler>(nullptr, -1, 0);
+    for (AbstractHandler* handler : std::initializer_list<AbstractHandler*>{mEventCB.get(),
+                                                                            mMeterCB.get(),
+                                                                            mSpanCB.get(),
+                                                                            mNetworkSecureCB.get(),
+                                                                            mProcessSecureCB.get(),
+                                                                            mFileSecureCB.get()}) {
+        handler->SetEventPool(&mEventPool);
+    }
+
+    // handlers of the same plugin type push to the same queue, so they share one ring to keep the order
+    const std::array<std::pair<nami::PluginType, const std::string*>, 4> ringTypes
+        = {{{nami::PluginType::NETWORK_OBSERVE, &METRIC_LABEL_VALUE_PLUGIN_TYPE_NETWORK_OBSERVER},
+            {nami::PluginType::PROCESS_SECURITY, &METRIC_LABEL_VALUE_PLUGIN_TYPE_PROCESS_SECURITY},
+            {nami::PluginType::NETWORK_SECURITY, &METRIC_LABEL_VALUE_PLUGIN_TYPE_NETWORK_SECURITY},
+            {nami::PluginType::FILE_SECURITY, &METRIC_LABEL_VALUE_PLUGIN_TYPE_FILE_SECURITY}}};
+    std::vector<std::weak_ptr<SpillRing>> rings;
+    for (const auto& item : ringTypes) {
+        auto& ring = mSpillRings[int(item.first)];
+        ring = std::make_shared<SpillRing>(*item.second, INT32_FLAG(ebpf_spill_ring_capacity));
+        rings.emplace_back(ring);
+    }
+    mMeterCB->SetSpillRing(mSpillRings[int(nami::PluginType::NETWORK_OBSERVE)]);
+    mSpanCB->SetSpillRing(mSpillRings[int(nami::PluginType::NETWORK_OBSERVE)]);
+    mEventCB->SetSpillRing(mSpillRings[int(nami::PluginType::NETWORK_OBSERVE)]);
+    mProcessSecureCB->SetSpillRing(mSpillRings[int(nami::PluginType::PROCESS_SECURITY)]);
+    mNetworkSecureCB->SetSpillRing(mSpillRings[int(nami::PluginType::NETWORK_SECURITY)]);
+    mFileSecureCB->SetSpillRing(mSpillRings[int(nami::PluginType::FILE_SECURITY)]);
+
+    mTimer = std::make_shared<Timer>();
+    mTimer->Init();
+    mTimer->PushEvent(std::make_unique<SpillRingDrainEvent>(mTimer, rings));
 }
 
 void eBPFServer::Stop() {
@@ -204,6 +268,10 @@ void eBPFServer::Stop() {
         mProcessSecureCB->UpdateContext(nullptr, -1, -1);
     if (mFileSecureCB)
         mFileSecureCB->UpdateContext(nullptr, -1, -1);
+
+    if (mTimer) {
+        mTimer->Stop();
+    }
 }
 
 bool eBPFServer::StartPluginInternal(const std::string& pipeline_name,
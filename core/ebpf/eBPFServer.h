@@ -27,7 +27,10 @@
 #include "ebpf/handler/AbstractHandler.h"
 #include "ebpf/handler/ObserveHandler.h"
 #include "ebpf/handler/SecurityHandler.h"
+#include "ebpf/handler/SpillRing.h"
+#include "common/timer/Timer.h"
 #include "ebpf/include/export.h"
+#include "models/EventPool.h"
 #include "monitor/metric_models/MetricTypes.h"
 #include "pipeline/PipelineContext.h"
 #include "runner/InputRunner.h"
@@ -107,6 +110,11 @@ private:
     std::unique_ptr<SecurityHandler> mNetworkSecureCB;
     std::unique_ptr<SecurityHandler> mProcessSecureCB;
     std::unique_ptr<SecurityHandler> mFileSecureCB;
+    // shared by all handlers, events are given back by processor threads when destroyed
+    EventPool mEventPool;
+    // one ring per plugin type, drained periodically by the timer
+    std::array<std::shared_ptr<SpillRing>, (int)nami::PluginType::MAX> mSpillRings = {};
+    std::shared_ptr<Timer> mTimer;
 
     mutable std::mutex mMtx;
     std::array<std::string, (int)nami::PluginType::MAX> mLoadedPipeline = {};
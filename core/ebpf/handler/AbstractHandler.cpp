@@ -0,0 +1,36 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ebpf/handler/AbstractHandler.h"
+
+#include "pipeline/limiter/MemoryBudget.h"
+#include "pipeline/queue/ProcessQueueItem.h"
+#include "pipeline/queue/ProcessQueueManager.h"
+
+namespace logtail {
+namespace ebpf {
+
+bool AbstractHandler::PushQueue(std::unique_ptr<ProcessQueueItem>&& item) {
+    if (mSpillRing) {
+        return mSpillRing->Push(mQueueKey, std::move(item));
+    }
+    int res = ProcessQueueManager::GetInstance()->PushQueue(mQueueKey, std::move(item));
+    if (res == 3) {
+        MemoryBudget::GetInstance()->AddDiscardedGroups(1);
+    }
+    return res == 0;
+}
+
+} // namespace ebpf
+} // namespace logtail
@@ -14,13 +14,20 @@
 
 #pragma once
 
+#include <memory>
 #include <mutex>
 
+#include "ebpf/handler/SpillRing.h"
+#include "ebpf/handler/TagSet.h"
 #include "monitor/MetricManager.h"
 #include "monitor/metric_models/MetricTypes.h"
 #include "pipeline/PipelineContext.h"
 
 namespace logtail {
+
+class EventPool;
+struct ProcessQueueItem;
+
 namespace ebpf {
 
 class AbstractHandler {
@@ -33,12 +40,26 @@ public:
         mQueueKey = key;
         mPluginIdx = index;
     }
+    // events are acquired from the pool if set, which must outlive all events handled
+    void SetEventPool(logtail::EventPool* pool) { mEventPool = pool; }
+    // groups rejected by a full process queue are buffered in the ring if set, which may be shared among handlers of
+    // the same plugin type
+    void SetSpillRing(const std::shared_ptr<SpillRing>& ring) { mSpillRing = ring; }
 
 protected:
+    // return false if the item is discarded
+    bool PushQueue(std::unique_ptr<logtail::ProcessQueueItem>&& item);
+    // return false if the current batch should be skipped to relieve a full spill ring
+    bool Sample() { return mSpillRing == nullptr || mSpillRing->Sample(); }
+
     const logtail::PipelineContext* mCtx = nullptr;
     logtail::QueueKey mQueueKey = 0;
     uint64_t mProcessTotalCnt = 0;
     uint32_t mPluginIdx = 0;
+    logtail::EventPool* mEventPool = nullptr;
+    // reused across calls to keep its storage
+    SharedTagSet mTagSet;
+    std::shared_ptr<SpillRing> mSpillRing;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class eBPFServerUnittest;
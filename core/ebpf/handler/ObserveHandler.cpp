@@ -21,33 +21,38 @@
 #include "common/RuntimeUtil.h"
 #include "ebpf/SourceManager.h"
 #include "logger/Logger.h"
+#include "models/EventPool.h"
 #include "models/PipelineEvent.h"
 #include "models/PipelineEventGroup.h"
 #include "models/SpanEvent.h"
 #include "pipeline/PipelineContext.h"
 #include "pipeline/queue/ProcessQueueItem.h"
-#include "pipeline/queue/ProcessQueueManager.h"
 
 namespace logtail {
 namespace ebpf {
 
+static const std::string kStatusCodeKey = "status_code";
+static const std::string kServiceRequestsTotal = "service_requests_total";
+
+// all metric events derived from the same measure reference the same tag set
 #define ADD_STATUS_METRICS(METRIC_NAME, FIELD_NAME, VALUE) \
     { \
-        if (!inner->FIELD_NAME) { \
-            return; \
-        } \
-        auto* event = group.AddMetricEvent(); \
-        for (const auto& tag : measure->tags_) { \
-            event->SetTag(tag.first, tag.second); \
+        if (inner->FIELD_NAME) { \
+            auto* event = group.AddMetricEvent(pool != nullptr, pool); \
+            tags.ApplyAsTags(*event); \
+            event->SetTagNoCopy(StringView(kStatusCodeKey), StringView(VALUE)); \
+            event->SetNameNoCopy(StringView(METRIC_NAME)); \
+            event->SetTimestamp(ts); \
+            event->SetValue(UntypedSingleValue{(double)inner->FIELD_NAME}); \
         } \
-        event->SetTag(std::string("status_code"), std::string(VALUE)); \
-        event->SetName(METRIC_NAME); \
-        event->SetTimestamp(ts); \
-        event->SetValue(UntypedSingleValue{(double)inner->FIELD_NAME}); \
     }
 
 #define GENERATE_METRICS(FUNC_NAME, MEASURE_TYPE, INNER_TYPE, METRIC_NAME, FIELD_NAME) \
-    void FUNC_NAME(PipelineEventGroup& group, const std::unique_ptr<Measure>& measure, uint64_t ts) { \
+    void FUNC_NAME(PipelineEventGroup& group, \
+                   const std::unique_ptr<Measure>& measure, \
+                   const SharedTagSet& tags, \
+                   uint64_t ts, \
+                   EventPool* pool) { \
         if (measure->type_ != (MEASURE_TYPE)) { \
             return; \
         } \
@@ -55,11 +60,9 @@ namespace ebpf {
         if (!inner->FIELD_NAME) { \
             return; \
         } \
-        auto* event = group.AddMetricEvent(); \
-        for (const auto& tag : measure->tags_) { \
-            event->SetTag(tag.first, tag.second); \
-        } \
-        event->SetName(METRIC_NAME); \
+        auto* event = group.AddMetricEvent(pool != nullptr, pool); \
+        tags.ApplyAsTags(*event); \
+        event->SetNameNoCopy(StringView(METRIC_NAME)); \
         event->SetTimestamp(ts); \
         event->SetValue(UntypedSingleValue{(double)inner->FIELD_NAME}); \
     }
@@ -71,15 +74,15 @@ void OtelMeterHandler::handle(const std::vector<std::unique_ptr<ApplicationBatch
     }
     for (const auto& appBatchMeasures : measures) {
         PipelineEventGroup eventGroup(std::make_shared<SourceBuffer>());
+        eventGroup.ReserveEvents(appBatchMeasures->measures_.size());
         for (const auto& measure : appBatchMeasures->measures_) {
             auto type = measure->type_;
             if (type == MeasureType::MEASURE_TYPE_APP) {
                 auto* inner = static_cast<AppSingleMeasure*>(measure->inner_measure_.get());
-                auto* event = eventGroup.AddMetricEvent();
-                for (const auto& tag : measure->tags_) {
-                    event->SetTag(tag.first, tag.second);
-                }
-                event->SetName("service_requests_total");
+                auto* event = eventGroup.AddMetricEvent(mEventPool != nullptr, mEventPool);
+                mTagSet.Reset(*eventGroup.GetSourceBuffer(), measure->tags_);
+                mTagSet.ApplyAsTags(*event);
+                event->SetNameNoCopy(StringView(kServiceRequestsTotal));
                 event->SetTimestamp(timestamp);
                 event->SetValue(UntypedSingleValue{(double)inner->request_total_});
             }
@@ -89,7 +92,7 @@ void OtelMeterHandler::handle(const std::vector<std::unique_ptr<ApplicationBatch
         continue;
 #endif
         std::unique_ptr<ProcessQueueItem> item = std::make_unique<ProcessQueueItem>(std::move(eventGroup), mPluginIdx);
-        if (ProcessQueueManager::GetInstance()->PushQueue(mQueueKey, std::move(item))) {
+        if (!PushQueue(std::move(item))) {
             LOG_WARNING(sLogger,
                         ("configName", mCtx->GetConfigName())("pluginIdx",
                                                               mPluginIdx)("[Otel Metrics] push queue failed!", ""));
@@ -102,13 +105,16 @@ void OtelSpanHandler::handle(const std::vector<std::unique_ptr<ApplicationBatchS
         return;
     }
     for (const auto& span : spans) {
+        if (!Sample()) {
+            continue;
+        }
         std::shared_ptr<SourceBuffer> sourceBuffer = std::make_shared<SourceBuffer>();
         PipelineEventGroup eventGroup(sourceBuffer);
+        eventGroup.ReserveEvents(span->single_spans_.size());
         for (const auto& x : span->single_spans_) {
-            auto* spanEvent = eventGroup.AddSpanEvent();
-            for (const auto& tag : x->tags_) {
-                spanEvent->SetTag(tag.first, tag.second);
-            }
+            auto* spanEvent = eventGroup.AddSpanEvent(mEventPool != nullptr, mEventPool);
+            mTagSet.Reset(*sourceBuffer, x->tags_);
+            mTagSet.ApplyAsTags(*spanEvent);
             spanEvent->SetName(x->span_name_);
             spanEvent->SetKind(static_cast<SpanEvent::Kind>(x->span_kind_));
             spanEvent->SetStartTimeNs(x->start_timestamp_);
@@ -121,7 +127,7 @@ void OtelSpanHandler::handle(const std::vector<std::unique_ptr<ApplicationBatchS
         continue;
 #endif
         std::unique_ptr<ProcessQueueItem> item = std::make_unique<ProcessQueueItem>(std::move(eventGroup), mPluginIdx);
-        if (ProcessQueueManager::GetInstance()->PushQueue(mQueueKey, std::move(item))) {
+        if (!PushQueue(std::move(item))) {
             LOG_WARNING(
                 sLogger,
                 ("configName", mCtx->GetConfigName())("pluginIdx", mPluginIdx)("[Span] push queue failed!", ""));
@@ -134,22 +140,22 @@ void EventHandler::handle(const std::vector<std::unique_ptr<ApplicationBatchEven
         return;
     }
     for (const auto& appEvents : events) {
-        if (!appEvents || appEvents->events_.empty()) {
+        if (!appEvents || appEvents->events_.empty() || !Sample()) {
             continue;
         }
         std::shared_ptr<SourceBuffer> sourceBuffer = std::make_shared<SourceBuffer>();
         PipelineEventGroup eventGroup(sourceBuffer);
+        eventGroup.ReserveEvents(appEvents->events_.size());
         for (const auto& event : appEvents->events_) {
             if (!event || event->GetAllTags().empty()) {
                 continue;
             }
-            auto* logEvent = eventGroup.AddLogEvent();
-            for (const auto& tag : event->GetAllTags()) {
-                logEvent->SetContent(tag.first, tag.second);
-                auto seconds
-                    = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::nanoseconds(event->GetTimestamp()));
-                logEvent->SetTimestamp(seconds.count(), event->GetTimestamp() - seconds.count() * 1e9);
-            }
+            auto* logEvent = eventGroup.AddLogEvent(mEventPool != nullptr, mEventPool);
+            mTagSet.Reset(*sourceBuffer, event->GetAllTags());
+            mTagSet.ApplyAsContents(*logEvent);
+            auto seconds
+                = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::nanoseconds(event->GetTimestamp()));
+            logEvent->SetTimestamp(seconds.count(), event->GetTimestamp() - seconds.count() * 1e9);
             mProcessTotalCnt++;
         }
         for (const auto& tag : appEvents->tags_) {
@@ -159,7 +165,7 @@ void EventHandler::handle(const std::vector<std::unique_ptr<ApplicationBatchEven
         continue;
 #endif
         std::unique_ptr<ProcessQueueItem> item = std::make_unique<ProcessQueueItem>(std::move(eventGroup), mPluginIdx);
-        if (ProcessQueueManager::GetInstance()->PushQueue(mQueueKey, std::move(item))) {
+        if (!PushQueue(std::move(item))) {
             LOG_WARNING(
                 sLogger,
                 ("configName", mCtx->GetConfigName())("pluginIdx", mPluginIdx)("[Event] push queue failed!", ""));
@@ -178,9 +184,9 @@ const static std::string rpc_request_err_count = "arms_rpc_requests_error_count"
 const static std::string rpc_request_rt = "arms_rpc_requests_seconds";
 const static std::string rpc_request_status_count = "arms_rpc_requests_by_status_count";
 static const std::string status_2xx_key = "2xx";
-static const std::string status_3xx_key = "2xx";
-static const std::string status_4xx_key = "2xx";
-static const std::string status_5xx_key = "2xx";
+static const std::string status_3xx_key = "3xx";
+static const std::string status_4xx_key = "4xx";
+static const std::string status_5xx_key = "5xx";
 
 // FOR APP METRICS
 GENERATE_METRICS(GenerateRequestsTotalMetrics,
@@ -198,7 +204,11 @@ GENERATE_METRICS(GenerateRequestsDurationSumMetrics,
                  rpc_request_status_count,
                  duration_ms_sum_)
 
-void GenerateRequestsStatusMetrics(PipelineEventGroup& group, const std::unique_ptr<Measure>& measure, uint64_t ts) {
+void GenerateRequestsStatusMetrics(PipelineEventGroup& group,
+                                   const std::unique_ptr<Measure>& measure,
+                                   const SharedTagSet& tags,
+                                   uint64_t ts,
+                                   EventPool* pool) {
     if (measure->type_ != MeasureType::MEASURE_TYPE_APP) {
         return;
     }
@@ -256,14 +266,17 @@ void ArmsSpanHandler::handle(const std::vector<std::unique_ptr<ApplicationBatchS
         return;
     }
     for (const auto& span : spans) {
+        if (!Sample()) {
+            continue;
+        }
         std::shared_ptr<SourceBuffer> sourceBuffer = std::make_shared<SourceBuffer>();
         PipelineEventGroup eventGroup(sourceBuffer);
         eventGroup.SetTag(app_id_key, span->app_id_);
+        eventGroup.ReserveEvents(span->single_spans_.size());
         for (const auto& x : span->single_spans_) {
-            auto* spanEvent = eventGroup.AddSpanEvent();
-            for (const auto& tag : x->tags_) {
-                spanEvent->SetTag(tag.first, tag.second);
-            }
+            auto* spanEvent = eventGroup.AddSpanEvent(mEventPool != nullptr, mEventPool);
+            mTagSet.Reset(*sourceBuffer, x->tags_);
+            mTagSet.ApplyAsTags(*spanEvent);
             spanEvent->SetName(x->span_name_);
             spanEvent->SetKind(static_cast<SpanEvent::Kind>(x->span_kind_));
             spanEvent->SetStartTimeNs(x->start_timestamp_);
@@ -276,7 +289,7 @@ void ArmsSpanHandler::handle(const std::vector<std::unique_ptr<ApplicationBatchS
         continue;
 #endif
         std::unique_ptr<ProcessQueueItem> item = std::make_unique<ProcessQueueItem>(std::move(eventGroup), mPluginIdx);
-        if (ProcessQueueManager::GetInstance()->PushQueue(mQueueKey, std::move(item))) {
+        if (!PushQueue(std::move(item))) {
             LOG_WARNING(
                 sLogger,
                 ("configName", mCtx->GetConfigName())("pluginIdx", mPluginIdx)("[Span] push queue failed!", ""));
@@ -291,28 +304,32 @@ void ArmsMeterHandler::handle(const std::vector<std::unique_ptr<ApplicationBatch
     }
     for (const auto& appBatchMeasures : measures) {
         std::shared_ptr<SourceBuffer> sourceBuffer = std::make_shared<SourceBuffer>();
-        ;
         PipelineEventGroup eventGroup(sourceBuffer);
+        // each app measure derives up to 8 metric events, and each net measure up to 7
+        eventGroup.ReserveEvents(appBatchMeasures->measures_.size() * 8);
 
         // source_ip
         eventGroup.SetTag(std::string(app_id_key), appBatchMeasures->app_id_);
         eventGroup.SetTag(std::string(ip_key), appBatchMeasures->ip_);
         for (const auto& measure : appBatchMeasures->measures_) {
             auto type = measure->type_;
+            if (type == MeasureType::MEASURE_TYPE_APP || type == MeasureType::MEASURE_TYPE_NET) {
+                mTagSet.Reset(*sourceBuffer, measure->tags_);
+            }
             if (type == MeasureType::MEASURE_TYPE_APP) {
-                GenerateRequestsTotalMetrics(eventGroup, measure, timestamp);
-                GenerateRequestsSlowMetrics(eventGroup, measure, timestamp);
-                GenerateRequestsErrorMetrics(eventGroup, measure, timestamp);
-                GenerateRequestsDurationSumMetrics(eventGroup, measure, timestamp);
-                GenerateRequestsStatusMetrics(eventGroup, measure, timestamp);
+                GenerateRequestsTotalMetrics(eventGroup, measure, mTagSet, timestamp, mEventPool);
+                GenerateRequestsSlowMetrics(eventGroup, measure, mTagSet, timestamp, mEventPool);
+                GenerateRequestsErrorMetrics(eventGroup, measure, mTagSet, timestamp, mEventPool);
+                GenerateRequestsDurationSumMetrics(eventGroup, measure, mTagSet, timestamp, mEventPool);
+                GenerateRequestsStatusMetrics(eventGroup, measure, mTagSet, timestamp, mEventPool);
             } else if (type == MeasureType::MEASURE_TYPE_NET) {
-                GenerateTcpDropTotalMetrics(eventGroup, measure, timestamp);
-                GenerateTcpRetransTotalMetrics(eventGroup, measure, timestamp);
-                GenerateTcpConnectionTotalMetrics(eventGroup, measure, timestamp);
-                GenerateTcpRecvPktsTotalMetrics(eventGroup, measure, timestamp);
-                GenerateTcpRecvBytesTotalMetrics(eventGroup, measure, timestamp);
-                GenerateTcpSendPktsTotalMetrics(eventGroup, measure, timestamp);
-                GenerateTcpSendBytesTotalMetrics(eventGroup, measure, timestamp);
+                GenerateTcpDropTotalMetrics(eventGroup, measure, mTagSet, timestamp, mEventPool);
+                GenerateTcpRetransTotalMetrics(eventGroup, measure, mTagSet, timestamp, mEventPool);
+                GenerateTcpConnectionTotalMetrics(eventGroup, measure, mTagSet, timestamp, mEventPool);
+                GenerateTcpRecvPktsTotalMetrics(eventGroup, measure, mTagSet, timestamp, mEventPool);
+                GenerateTcpRecvBytesTotalMetrics(eventGroup, measure, mTagSet, timestamp, mEventPool);
+                GenerateTcpSendPktsTotalMetrics(eventGroup, measure, mTagSet, timestamp, mEventPool);
+                GenerateTcpSendBytesTotalMetrics(eventGroup, measure, mTagSet, timestamp, mEventPool);
             }
             mProcessTotalCnt++;
         }
@@ -321,7 +338,7 @@ void ArmsMeterHandler::handle(const std::vector<std::unique_ptr<ApplicationBatch
         continue;
 #endif
         std::unique_ptr<ProcessQueueItem> item = std::make_unique<ProcessQueueItem>(std::move(eventGroup), mPluginIdx);
-        if (ProcessQueueManager::GetInstance()->PushQueue(mQueueKey, std::move(item))) {
+        if (!PushQueue(std::move(item))) {
             LOG_WARNING(
                 sLogger,
                 ("configName", mCtx->GetConfigName())("pluginIdx", mPluginIdx)("[Metrics] push queue failed!", ""));
@@ -18,12 +18,12 @@
 #include "common/RuntimeUtil.h"
 #include "ebpf/SourceManager.h"
 #include "logger/Logger.h"
+#include "models/EventPool.h"
 #include "models/PipelineEvent.h"
 #include "models/PipelineEventGroup.h"
 #include "models/SpanEvent.h"
 #include "pipeline/PipelineContext.h"
 #include "pipeline/queue/ProcessQueueItem.h"
-#include "pipeline/queue/ProcessQueueManager.h"
 
 namespace logtail {
 namespace ebpf {
@@ -35,13 +35,14 @@ SecurityHandler::SecurityHandler(const logtail::PipelineContext* ctx, logtail::Q
 }
 
 void SecurityHandler::handle(std::vector<std::unique_ptr<AbstractSecurityEvent>>& events) {
+    // security events are never sampled out
     if (events.empty()) {
         return;
     }
 
     std::shared_ptr<SourceBuffer> source_buffer = std::make_shared<SourceBuffer>();
-    ;
     PipelineEventGroup event_group(source_buffer);
+    event_group.ReserveEvents(events.size());
     // aggregate to pipeline event group
     // set host ips
     // TODO 后续这两个 key 需要移到 group 的 metadata 里，在 processortagnative 中转成tag
@@ -50,10 +51,9 @@ void SecurityHandler::handle(std::vector<std::unique_ptr<AbstractSecurityEvent>>
     event_group.SetTag(host_ip_key, mHostIp);
     event_group.SetTag(host_name_key, mHostName);
     for (const auto& x : events) {
-        auto* event = event_group.AddLogEvent();
-        for (const auto& tag : x->GetAllTags()) {
-            event->SetContent(tag.first, tag.second);
-        }
+        auto* event = event_group.AddLogEvent(mEventPool != nullptr, mEventPool);
+        mTagSet.Reset(*source_buffer, x->GetAllTags());
+        mTagSet.ApplyAsContents(*event);
         auto seconds = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::nanoseconds(x->GetTimestamp()));
         event->SetTimestamp(seconds.count(), x->GetTimestamp());
     }
@@ -64,7 +64,7 @@ void SecurityHandler::handle(std::vector<std::unique_ptr<AbstractSecurityEvent>>
     std::unique_ptr<ProcessQueueItem> item
         = std::unique_ptr<ProcessQueueItem>(new ProcessQueueItem(std::move(event_group), mPluginIdx));
 
-    if (ProcessQueueManager::GetInstance()->PushQueue(mQueueKey, std::move(item))) {
+    if (!PushQueue(std::move(item))) {
         LOG_WARNING(
             sLogger,
             ("configName", mCtx->GetConfigName())("pluginIdx", mPluginIdx)("Push queue failed!", events.size()));
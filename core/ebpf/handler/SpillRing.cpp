@@ -0,0 +1,153 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ebpf/handler/SpillRing.h"
+
+#include <algorithm>
+
+#include "pipeline/queue/ProcessQueueItem.h"
+#include "pipeline/queue/ProcessQueueManager.h"
+
+using namespace std;
+
+namespace logtail {
+namespace ebpf {
+
+static const uint32_t kMaxSampleInterval = 64;
+
+SpillRing::SpillRing(const string& pluginType, size_t capacity) : mCapacity(capacity) {
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
+        mMetricsRecordRef,
+        MetricCategory::METRIC_CATEGORY_RUNNER,
+        {{METRIC_LABEL_KEY_RUNNER_NAME, METRIC_LABEL_VALUE_RUNNER_NAME_EBPF_SERVER},
+         {METRIC_LABEL_KEY_PLUGIN_TYPE, pluginType}});
+    mSpilledGroupsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_EBPF_SPILLED_GROUPS_TOTAL);
+    mReplayedGroupsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_EBPF_REPLAYED_GROUPS_TOTAL);
+    mDiscardedGroupsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_EBPF_DISCARDED_GROUPS_TOTAL);
+    mSampledOutGroupsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_EBPF_SAMPLED_OUT_GROUPS_TOTAL);
+    mBufferedGroups = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_EBPF_SPILL_RING_GROUPS);
+    mSampleIntervalGauge = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_EBPF_SAMPLE_INTERVAL);
+    mSampleIntervalGauge->Set(1);
+}
+
+SpillRing::~SpillRing() = default;
+
+bool SpillRing::Push(QueueKey key, unique_ptr<ProcessQueueItem>&& item) {
+    lock_guard<mutex> lock(mMux);
+    if (key == -1) {
+        // plugin is suspended or stopped, buffered items are kept in case it is resumed with the same queue
+        mDiscardedGroupsTotal->Add(1);
+        return false;
+    }
+    if (key != mKey) {
+        // buffered items belong to a queue no longer fed by this plugin type
+        DiscardLocked();
+        mKey = key;
+    }
+    // buffered items go first to keep the order
+    if (DrainLocked()) {
+        int res = ProcessQueueManager::GetInstance()->PushQueue(key, std::move(item));
+        if (res == 0) {
+            ResetSampleIntervalLocked();
+            return true;
+        }
+        if (res == 2) {
+            mDiscardedGroupsTotal->Add(1);
+            return false;
+        }
+    }
+    if (mItems.size() >= mCapacity) {
+        mDiscardedGroupsTotal->Add(1);
+        uint32_t interval = min(mSampleInterval.load(memory_order_relaxed) * 2, kMaxSampleInterval);
+        mSampleInterval.store(interval, memory_order_relaxed);
+        mSampleIntervalGauge->Set(interval);
+        return false;
+    }
+    mItems.emplace_back(std::move(item));
+    mSpilledGroupsTotal->Add(1);
+    mBufferedGroups->Set(mItems.size());
+    return true;
+}
+
+void SpillRing::Drain() {
+    lock_guard<mutex> lock(mMux);
+    DrainLocked();
+}
+
+bool SpillRing::Sample() {
+    uint32_t interval = mSampleInterval.load(memory_order_relaxed);
+    if (interval <= 1) {
+        return true;
+    }
+    {
+        // the queue may have recovered since the last drain round, in which case no batch should be skipped
+        lock_guard<mutex> lock(mMux);
+        if (DrainLocked()) {
+            ResetSampleIntervalLocked();
+            return true;
+        }
+    }
+    if (mSampleCnt.fetch_add(1, memory_order_relaxed) % interval == 0) {
+        return true;
+    }
+    mSampledOutGroupsTotal->Add(1);
+    return false;
+}
+
+size_t SpillRing::Size() const {
+    lock_guard<mutex> lock(mMux);
+    return mItems.size();
+}
+
+bool SpillRing::DrainLocked() {
+    if (mItems.empty()) {
+        return true;
+    }
+    size_t replayed = 0;
+    while (!mItems.empty()) {
+        // the item is left untouched if the queue is full or the memory budget is used up
+        int res = ProcessQueueManager::GetInstance()->PushQueue(mKey, std::move(mItems.front()));
+        if (res == 1 || res == 3) {
+            break;
+        }
+        if (res == 2) {
+            DiscardLocked();
+            break;
+        }
+        mItems.pop_front();
+        ++replayed;
+    }
+    if (replayed > 0) {
+        ResetSampleIntervalLocked();
+    }
+    mReplayedGroupsTotal->Add(replayed);
+    mBufferedGroups->Set(mItems.size());
+    return mItems.empty();
+}
+
+void SpillRing::ResetSampleIntervalLocked() {
+    if (mSampleInterval.load(memory_order_relaxed) > 1) {
+        mSampleInterval.store(1, memory_order_relaxed);
+        mSampleIntervalGauge->Set(1);
+    }
+}
+
+void SpillRing::DiscardLocked() {
+    mDiscardedGroupsTotal->Add(mItems.size());
+    mItems.clear();
+    mBufferedGroups->Set(0);
+}
+
+} // namespace ebpf
+} // namespace logtail
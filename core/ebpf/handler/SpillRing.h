@@ -0,0 +1,84 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "monitor/MetricManager.h"
+#include "monitor/metric_models/MetricTypes.h"
+#include "pipeline/queue/QueueKey.h"
+
+namespace logtail {
+
+struct ProcessQueueItem;
+
+namespace ebpf {
+
+// Holds event groups of one ebpf plugin type that cannot be pushed to the process queue because it is full, and
+// replays them in order once the queue has room again. When the ring itself is full, new groups are discarded and the
+// sample interval is doubled, so that handlers build fewer groups while the queue keeps rejecting them. The interval
+// is reset to 1 as soon as the queue accepts a group again.
+class SpillRing {
+public:
+    SpillRing(const std::string& pluginType, size_t capacity);
+    ~SpillRing();
+    SpillRing(const SpillRing&) = delete;
+    SpillRing& operator=(const SpillRing&) = delete;
+
+    // return false if the item is discarded
+    bool Push(QueueKey key, std::unique_ptr<ProcessQueueItem>&& item);
+    // replay buffered items, called periodically
+    void Drain();
+    // return false if the current batch should be skipped by the handler, only possible while the queue rejects groups
+    bool Sample();
+
+    size_t Size() const;
+    uint32_t GetSampleInterval() const { return mSampleInterval.load(std::memory_order_relaxed); }
+
+private:
+    // return true if all buffered items have been replayed
+    bool DrainLocked();
+    void DiscardLocked();
+    void ResetSampleIntervalLocked();
+
+    mutable std::mutex mMux;
+    QueueKey mKey = -1;
+    std::deque<std::unique_ptr<ProcessQueueItem>> mItems;
+    size_t mCapacity = 0;
+
+    std::atomic_uint32_t mSampleInterval{1};
+    std::atomic_uint64_t mSampleCnt{0};
+
+    MetricsRecordRef mMetricsRecordRef;
+    CounterPtr mSpilledGroupsTotal;
+    CounterPtr mReplayedGroupsTotal;
+    CounterPtr mDiscardedGroupsTotal;
+    CounterPtr mSampledOutGroupsTotal;
+    IntGaugePtr mBufferedGroups;
+    IntGaugePtr mSampleIntervalGauge;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class SpillRingUnittest;
+#endif
+};
+
+} // namespace ebpf
+} // namespace logtail
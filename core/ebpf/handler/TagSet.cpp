@@ -0,0 +1,44 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ebpf/handler/TagSet.h"
+
+#include <mutex>
+#include <unordered_set>
+
+using namespace std;
+
+namespace logtail {
+namespace ebpf {
+
+static const size_t kMaxInternedTagKeys = 1024;
+
+StringView InternTagKey(const string& key) {
+    // never freed, since events referencing the keys may be alive until the process exits
+    static auto* sKeys = new unordered_set<string>();
+    static mutex sMux;
+
+    lock_guard<mutex> lock(sMux);
+    auto it = sKeys->find(key);
+    if (it == sKeys->end()) {
+        if (sKeys->size() >= kMaxInternedTagKeys) {
+            return StringView();
+        }
+        it = sKeys->insert(key).first;
+    }
+    return StringView(it->data(), it->size());
+}
+
+} // namespace ebpf
+} // namespace logtail
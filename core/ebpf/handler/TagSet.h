@@ -0,0 +1,74 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/memory/SourceBuffer.h"
+#include "models/StringView.h"
+
+namespace logtail {
+namespace ebpf {
+
+// Tag keys reported by eBPF come from a small fixed vocabulary, so they are interned into process-wide storage once
+// and referenced by all events afterwards. An empty view is returned when the pool is full, in which case the key
+// should be copied as usual.
+StringView InternTagKey(const std::string& key);
+
+// Tags of a measure, span or event, copied into the source buffer of the event group once and referenced by all
+// events derived from it. The set is meant to be reused across calls so that its storage is kept.
+class SharedTagSet {
+public:
+    template <class Tags>
+    void Reset(SourceBuffer& sourceBuffer, const Tags& tags) {
+        mTags.clear();
+        for (const auto& tag : tags) {
+            StringView key = InternTagKey(tag.first);
+            if (key.empty()) {
+                auto sb = sourceBuffer.CopyString(tag.first);
+                key = StringView(sb.data, sb.size);
+            }
+            auto sb = sourceBuffer.CopyString(tag.second);
+            mTags.emplace_back(key, StringView(sb.data, sb.size));
+        }
+    }
+
+    template <class Event>
+    void ApplyAsTags(Event& e) const {
+        for (const auto& tag : mTags) {
+            e.SetTagNoCopy(tag.first, tag.second);
+        }
+    }
+
+    template <class Event>
+    void ApplyAsContents(Event& e) const {
+        for (const auto& tag : mTags) {
+            e.SetContentNoCopy(tag.first, tag.second);
+        }
+    }
+
+    bool Empty() const { return mTags.empty(); }
+    size_t Size() const { return mTags.size(); }
+
+private:
+    std::vector<std::pair<StringView, StringView>> mTags;
+};
+
+} // namespace ebpf
+} // namespace logtail
@@ -97,6 +97,9 @@ DEFINE_FLAG_INT32(multi_config_alarm_interval, "second", 600);
 DEFINE_FLAG_STRING(ilogtail_docker_path_version, "ilogtail docker path config file", "0.1.0");
 DEFINE_FLAG_INT32(max_docker_config_update_times, "max times docker config update in 3 minutes", 10);
 DEFINE_FLAG_INT32(docker_config_update_interval, "interval between docker config updates, seconds", 3);
+DEFINE_FLAG_BOOL(enable_config_matcher_index,
+                 "only match paths against configs whose base path is a prefix of the path, found by a path trie",
+                 true);
 
 namespace logtail {
 
@@ -609,16 +612,17 @@ FileDiscoveryConfig ConfigManager::FindBestMatch(const string& path, const strin
             }
         }
     }
-    const auto& nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    auto itr = nameConfigMap.begin();
+    vector<FileDiscoveryConfig> candidates;
+    GetCandidateConfigs(path, candidates);
+    auto itr = candidates.begin();
     FileDiscoveryConfig prevMatch(nullptr, nullptr);
     size_t prevLen = 0;
     size_t curLen = 0;
     uint32_t nameRepeat = 0;
     string logNameList;
     vector<FileDiscoveryConfig> multiConfigs;
-    for (; itr != nameConfigMap.end(); ++itr) {
-        const FileDiscoveryOptions* config = itr->second.first;
+    for (; itr != candidates.end(); ++itr) {
+        const FileDiscoveryOptions* config = itr->first;
         // // exclude __FUSE_CONFIG__
         // if (itr->first == STRING_FLAG(fuse_customized_config_name)) {
         //     continue;
@@ -630,21 +634,21 @@ FileDiscoveryConfig ConfigManager::FindBestMatch(const string& path, const strin
             if (!name.empty() && !config->mAllowingIncludedByMultiConfigs) {
                 nameRepeat++;
                 logNameList.append("logstore:");
-                logNameList.append(itr->second.second->GetLogstoreName());
+                logNameList.append(itr->second->GetLogstoreName());
                 logNameList.append(",config:");
-                logNameList.append(itr->second.second->GetConfigName());
+                logNameList.append(itr->second->GetConfigName());
                 logNameList.append(" ");
-                multiConfigs.push_back(itr->second);
+                multiConfigs.push_back(*itr);
             }
 
             // note: best config is the one which length is longest and create time is nearest
             curLen = config->GetBasePath().size();
             if (prevLen < curLen) {
-                prevMatch = itr->second;
+                prevMatch = *itr;
                 prevLen = curLen;
             } else if (prevLen == curLen && prevMatch.first) {
-                if (prevMatch.second->GetCreateTime() > itr->second.second->GetCreateTime()) {
-                    prevMatch = itr->second;
+                if (prevMatch.second->GetCreateTime() > itr->second->GetCreateTime()) {
+                    prevMatch = *itr;
                     prevLen = curLen;
                 }
             }
@@ -698,10 +702,11 @@ int32_t ConfigManager::FindAllMatch(vector<FileDiscoveryConfig>& allConfig,
         }
     }
     bool alarmFlag = false;
-    auto nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    auto itr = nameConfigMap.begin();
-    for (; itr != nameConfigMap.end(); ++itr) {
-        const FileDiscoveryOptions* config = itr->second.first;
+    vector<FileDiscoveryConfig> candidates;
+    GetCandidateConfigs(path, candidates);
+    auto itr = candidates.begin();
+    for (; itr != candidates.end(); ++itr) {
+        const FileDiscoveryOptions* config = itr->first;
         // // exclude __FUSE_CONFIG__
         // if (itr->first == STRING_FLAG(fuse_customized_config_name)) {
         //     continue;
@@ -709,7 +714,7 @@ int32_t ConfigManager::FindAllMatch(vector<FileDiscoveryConfig>& allConfig,
 
         bool match = config->IsMatch(path, name);
         if (match) {
-            allConfig.push_back(itr->second);
+            allConfig.push_back(*itr);
         }
     }
 
@@ -746,16 +751,17 @@ int32_t ConfigManager::FindMatchWithForceFlag(std::vector<FileDiscoveryConfig>&
             }
         }
     }
-    auto nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    auto itr = nameConfigMap.begin();
+    vector<FileDiscoveryConfig> candidates;
+    GetCandidateConfigs(path, candidates);
+    auto itr = candidates.begin();
     FileDiscoveryConfig prevMatch = make_pair(nullptr, nullptr);
     size_t prevLen = 0;
     size_t curLen = 0;
     uint32_t nameRepeat = 0;
     string logNameList;
     vector<FileDiscoveryConfig> multiConfigs;
-    for (; itr != nameConfigMap.end(); ++itr) {
-        FileDiscoveryConfig config = itr->second;
+    for (; itr != candidates.end(); ++itr) {
+        FileDiscoveryConfig config = *itr;
         // // exclude __FUSE_CONFIG__
         // if (itr->first == STRING_FLAG(fuse_customized_config_name)) {
         //     continue;
@@ -867,10 +873,11 @@ void ConfigManager::DeleteHandlers() {
 // 1. No wildcard path: the base path of Config is the prefix of @path and within depth.
 // 2. Wildcard path: @path matches and within depth.
 void ConfigManager::GetRelatedConfigs(const std::string& path, std::vector<FileDiscoveryConfig>& configs) {
-    const auto& nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
-    for (auto iter = nameConfigMap.begin(); iter != nameConfigMap.end(); ++iter) {
-        if (iter->second.first->IsMatch(path, "")) {
-            configs.push_back(iter->second);
+    vector<FileDiscoveryConfig> candidates;
+    GetCandidateConfigs(path, candidates);
+    for (auto iter = candidates.begin(); iter != candidates.end(); ++iter) {
+        if (iter->first->IsMatch(path, "")) {
+            configs.push_back(*iter);
         }
     }
 }
@@ -919,6 +926,10 @@ bool ConfigManager::DoUpdateContainerPaths() {
         }
         delete tmpPathCmdVec[i];
     }
+    if (!tmpPathCmdVec.empty()) {
+        // real base dirs of containers are indexed
+        ResetMatcherIndex();
+    }
     return true;
 }
 
@@ -1110,12 +1121,46 @@ void ConfigManager::LoadDockerConfig() {
 }
 
 void ConfigManager::ClearFilePipelineMatchCache() {
+    ResetMatcherIndex();
     ScopedSpinLock lock(mCacheFileConfigMapLock);
     mCacheFileConfigMap.clear();
     ScopedSpinLock allLock(mCacheFileAllConfigMapLock);
     mCacheFileAllConfigMap.clear();
 }
 
+void ConfigManager::GetCandidateConfigs(const string& path, vector<FileDiscoveryConfig>& configs) {
+    const auto& nameConfigMap = FileServer::GetInstance()->GetAllFileDiscoveryConfigs();
+    if (!BOOL_FLAG(enable_config_matcher_index)) {
+        configs.reserve(nameConfigMap.size());
+        for (const auto& item : nameConfigMap) {
+            configs.push_back(item.second);
+        }
+        return;
+    }
+    shared_ptr<FileDiscoveryMatcherIndex> index;
+    uint64_t version = 0;
+    {
+        ScopedSpinLock lock(mMatcherIndexLock);
+        index = mMatcherIndex;
+        version = mMatcherIndexVersion;
+    }
+    if (!index) {
+        index = make_shared<FileDiscoveryMatcherIndex>(nameConfigMap);
+        ScopedSpinLock lock(mMatcherIndexLock);
+        // do not keep the index if it has been reset while building
+        if (version == mMatcherIndexVersion) {
+            mMatcherIndex = index;
+        }
+    }
+    index->FindCandidates(path, configs);
+}
+
+void ConfigManager::ResetMatcherIndex() {
+    ScopedSpinLock lock(mMatcherIndexLock);
+    mMatcherIndex.reset();
+    ++mMatcherIndexVersion;
+}
+
 #ifdef APSARA_UNIT_TEST_MAIN
 void ConfigManager::CleanEnviroments() {
     for (std::unordered_map<std::string, EventHandler*>::iterator iter = mDirEventHandlerMap.begin();
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -25,6 +26,7 @@
 #include "common/Lock.h"
 #include "container_manager/ConfigContainerInfoUpdateCmd.h"
 #include "file_server/event/Event.h"
+#include "file_server/FileDiscoveryMatcherIndex.h"
 #include "file_server/FileDiscoveryOptions.h"
 
 namespace logtail {
@@ -156,6 +158,11 @@ protected:
     SpinLock mCacheFileAllConfigMapLock;
     std::unordered_map<std::string, std::pair<std::vector<FileDiscoveryConfig>, int32_t>> mCacheFileAllConfigMap;
 
+    // built lazily when configs are matched, and reset whenever configs or container paths change
+    SpinLock mMatcherIndexLock;
+    std::shared_ptr<FileDiscoveryMatcherIndex> mMatcherIndex;
+    uint64_t mMatcherIndexVersion = 0;
+
     PTMutex mContainerInfoCmdLock;
     std::vector<ConfigContainerInfoUpdateCmd*> mContainerInfoCmdVec;
 
@@ -419,6 +426,7 @@ public:
     // void RemoveAllConfigs();
 
     void ClearFilePipelineMatchCache();
+    void ResetMatcherIndex();
 
     void ClearConfigMatchCache();
 
@@ -560,6 +568,9 @@ private:
     //  */
     // void LoadSingleUserConfig(const std::string& name, const Json::Value& value, bool localFlag = false);
     // bool CheckRegFormat(const std::string& regStr);
+    // configs which may match @path, all configs are returned if matcher index is disabled
+    void GetCandidateConfigs(const std::string& path, std::vector<FileDiscoveryConfig>& configs);
+
     void SendAllMatchAlarm(const std::string& path,
                            const std::string& name,
                            std::vector<FileDiscoveryConfig>& allConfig,
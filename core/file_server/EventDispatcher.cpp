@@ -224,17 +224,24 @@ bool EventDispatcher::RegisterEventHandler(const string& path,
     }
 
     wd = -1;
-    if (mInotifyWatchNum >= INT32_FLAG(default_max_inotify_watch_num)) {
+    auto onInotifyWatchLimit = [&]() {
         LOG_INFO(sLogger,
                  ("failed to add inotify watcher for dir", path)("max allowd inotify watchers",
                                                                  INT32_FLAG(default_max_inotify_watch_num)));
         AlarmManager::GetInstance()->SendAlarm(INOTIFY_DIR_NUM_LIMIT_ALARM,
                                                string("failed to register inotify watcher for dir") + path);
+    };
+    bool inotifyWatchFull = mInotifyWatchNum >= INT32_FLAG(default_max_inotify_watch_num);
+    if (inotifyWatchFull && !mEventListener->IsFanotifyEnabled()) {
+        onInotifyWatchLimit();
     } else {
         // need check mEventListener valid
         if (mEventListener->IsInit() && !AppConfig::GetInstance()->IsInInotifyBlackList(path)) {
-            wd = mEventListener->AddWatch(path.c_str());
-            if (!EventListener::IsValidID(wd)) {
+            // dirs watched by fanotify take no inotify watch, so they are still watched after the limit is reached
+            wd = mEventListener->AddWatch(path.c_str(), !inotifyWatchFull);
+            if (!EventListener::IsValidID(wd) && inotifyWatchFull) {
+                onInotifyWatchLimit();
+            } else if (!EventListener::IsValidID(wd)) {
                 string str = ErrnoToString(GetErrno());
                 LOG_WARNING(sLogger, ("failed to register dir", path)("reason", str));
 #if defined(__linux__)
@@ -268,7 +275,7 @@ bool EventDispatcher::RegisterEventHandler(const string& path,
                               ("can not register inotify monitor", path)("inode", inode)("wd", wd)(
                                   "reason", "there is already a dir in inotify watch list shard the same inode"));
                     wd = -1;
-                } else
+                } else if (!EventListener::IsFanotifyID(wd))
                     mInotifyWatchNum++;
             }
         }
@@ -828,7 +835,9 @@ void EventDispatcher::UnregisterEventHandler(const string& path) {
     mWdUpdateTimeMap.erase(wd);
     if (EventListener::IsValidID(wd) && mEventListener->IsInit()) {
         mEventListener->RemoveWatch(wd);
-        mInotifyWatchNum--;
+        if (!EventListener::IsFanotifyID(wd)) {
+            mInotifyWatchNum--;
+        }
     }
     mWatchNum--;
     LOG_INFO(sLogger, ("remove the watcher for dir", path)("wd", wd));
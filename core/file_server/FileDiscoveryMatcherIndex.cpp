@@ -0,0 +1,112 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "file_server/FileDiscoveryMatcherIndex.h"
+
+#include <algorithm>
+
+#include "common/FileSystemUtil.h"
+
+using namespace std;
+
+namespace logtail {
+
+FileDiscoveryMatcherIndex::FileDiscoveryMatcherIndex(const unordered_map<string, FileDiscoveryConfig>& configs) {
+    mNodes.emplace_back("");
+    mConfigs.reserve(configs.size());
+    for (const auto& item : configs) {
+        const FileDiscoveryOptions* opts = item.second.first;
+        if (opts == nullptr) {
+            continue;
+        }
+        uint32_t idx = static_cast<uint32_t>(mConfigs.size());
+        mConfigs.push_back(item.second);
+        if (opts->IsContainerDiscoveryEnabled()) {
+            // both wildcard and normal container configs only match paths under real base dirs
+            const auto& containerInfos = opts->GetContainerInfo();
+            if (!containerInfos) {
+                Insert("", idx);
+                continue;
+            }
+            for (const auto& info : *containerInfos) {
+                Insert(info.mRealBaseDir, idx);
+            }
+        } else if (!opts->GetWildcardPaths().empty()) {
+#if defined(_MSC_VER)
+            // PathMatchSpec is case insensitive, so the constant prefix can not be compared byte by byte
+            Insert("", idx);
+#else
+            Insert(opts->GetWildcardPaths()[0], idx);
+#endif
+        } else {
+            Insert(opts->GetBasePath(), idx);
+        }
+    }
+}
+
+void FileDiscoveryMatcherIndex::Insert(const string& prefix, uint32_t idx) {
+    Node* node = &mNodes.front();
+    size_t begin = 0;
+    while (begin < prefix.size()) {
+        size_t end = prefix.find(PATH_SEPARATOR[0], begin);
+        if (end == string::npos) {
+            end = prefix.size();
+        }
+        if (end > begin) {
+            string_view name(prefix.data() + begin, end - begin);
+            auto it = node->mChildren.find(name);
+            if (it == node->mChildren.end()) {
+                Node* child = &mNodes.emplace_back(string(name));
+                it = node->mChildren.emplace(string_view(child->mName), child).first;
+            }
+            node = it->second;
+        }
+        begin = end + 1;
+    }
+    // a config may be inserted more than once with the same prefix, e.g., containers sharing the same real base dir
+    if (node->mConfigIdxs.empty() || node->mConfigIdxs.back() != idx) {
+        node->mConfigIdxs.push_back(idx);
+    }
+}
+
+void FileDiscoveryMatcherIndex::FindCandidates(const string& path, vector<FileDiscoveryConfig>& candidates) const {
+    vector<uint32_t> idxs;
+    const Node* node = &mNodes.front();
+    idxs.insert(idxs.end(), node->mConfigIdxs.begin(), node->mConfigIdxs.end());
+    size_t begin = 0;
+    while (begin < path.size()) {
+        size_t end = path.find(PATH_SEPARATOR[0], begin);
+        if (end == string::npos) {
+            end = path.size();
+        }
+        if (end > begin) {
+            auto it = node->mChildren.find(string_view(path.data() + begin, end - begin));
+            if (it == node->mChildren.end()) {
+                break;
+            }
+            node = it->second;
+            idxs.insert(idxs.end(), node->mConfigIdxs.begin(), node->mConfigIdxs.end());
+        }
+        begin = end + 1;
+    }
+    // a config with several containers may appear on more than one node
+    sort(idxs.begin(), idxs.end());
+    idxs.erase(unique(idxs.begin(), idxs.end()), idxs.end());
+    candidates.reserve(candidates.size() + idxs.size());
+    for (auto idx : idxs) {
+        candidates.push_back(mConfigs[idx]);
+    }
+}
+
+} // namespace logtail
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "file_server/FileDiscoveryOptions.h"
+
+namespace logtail {
+
+// FileDiscoveryMatcherIndex is a trie over path components built from the constant prefix of each config, i.e., base
+// path for normal configs, the part before the first wildcard for wildcard configs and real base dirs of containers
+// for container configs. Configs which may match a path are those on the way from the root to the deepest node the
+// path reaches, so finding them costs O(path length) instead of calling IsMatch on every config.
+// The candidates are a superset of the matched configs, IsMatch should still be called on each of them.
+class FileDiscoveryMatcherIndex {
+public:
+    explicit FileDiscoveryMatcherIndex(const std::unordered_map<std::string, FileDiscoveryConfig>& configs);
+    FileDiscoveryMatcherIndex(const FileDiscoveryMatcherIndex&) = delete;
+    FileDiscoveryMatcherIndex& operator=(const FileDiscoveryMatcherIndex&) = delete;
+
+    // candidates are appended in the same order as configs are iterated in the map given on construction
+    void FindCandidates(const std::string& path, std::vector<FileDiscoveryConfig>& candidates) const;
+
+    size_t GetConfigCount() const { return mConfigs.size(); }
+    size_t GetNodeCount() const { return mNodes.size(); }
+
+private:
+    struct Node {
+        explicit Node(const std::string& name) : mName(name) {}
+
+        std::string mName;
+        // key points to mName of the child
+        std::unordered_map<std::string_view, Node*> mChildren;
+        std::vector<uint32_t> mConfigIdxs;
+    };
+
+    void Insert(const std::string& prefix, uint32_t idx);
+
+    std::vector<FileDiscoveryConfig> mConfigs;
+    // deque is used so that nodes never move
+    std::deque<Node> mNodes;
+};
+
+} // namespace logtail
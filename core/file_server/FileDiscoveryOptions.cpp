@@ -171,6 +171,7 @@ bool FileDiscoveryOptions::Init(const Json::Value& config, const PipelineContext
     mBasePath = EncodingConverter::GetInstance()->FromUTF8ToACP(mBasePath);
     mFilePattern = EncodingConverter::GetInstance()->FromUTF8ToACP(mFilePattern);
 #endif
+    mFilePatternMatcher = GlobPattern(mFilePattern, 0);
     size_t len = mBasePath.size();
     if (len > 2 && mBasePath[len - 1] == '*' && mBasePath[len - 2] == '*'
         && mBasePath[len - 3] == filesystem::path::preferred_separator) {
@@ -234,8 +235,10 @@ bool FileDiscoveryOptions::Init(const Json::Value& config, const PipelineContext
             bool isMultipleLevelWildcard = mExcludeFilePaths[i].find("**") != string::npos;
             if (isMultipleLevelWildcard) {
                 mMLFilePathBlacklist.push_back(mExcludeFilePaths[i]);
+                mMLFilePathBlacklistMatchers.emplace_back(mExcludeFilePaths[i], 0);
             } else {
                 mFilePathBlacklist.push_back(mExcludeFilePaths[i]);
+                mFilePathBlacklistMatchers.emplace_back(mExcludeFilePaths[i], FNM_PATHNAME);
             }
         }
     }
@@ -264,6 +267,7 @@ bool FileDiscoveryOptions::Init(const Json::Value& config, const PipelineContext
                 continue;
             }
             mFileNameBlacklist.push_back(mExcludeFiles[i]);
+            mFileNameBlacklistMatchers.emplace_back(mExcludeFiles[i], 0);
         }
     }
 
@@ -293,12 +297,14 @@ bool FileDiscoveryOptions::Init(const Json::Value& config, const PipelineContext
             bool isMultipleLevelWildcard = mExcludeDirs[i].find("**") != string::npos;
             if (isMultipleLevelWildcard) {
                 mMLWildcardDirPathBlacklist.push_back(mExcludeDirs[i]);
+                mMLWildcardDirPathBlacklistMatchers.emplace_back(mExcludeDirs[i], 0);
                 continue;
             }
             bool isWildcardPath
                 = mExcludeDirs[i].find("*") != string::npos || mExcludeDirs[i].find("?") != string::npos;
             if (isWildcardPath) {
                 mWildcardDirPathBlacklist.push_back(mExcludeDirs[i]);
+                mWildcardDirPathBlacklistMatchers.emplace_back(mExcludeDirs[i], FNM_PATHNAME);
             } else {
                 mDirPathBlacklist.push_back(mExcludeDirs[i]);
             }
@@ -427,13 +433,13 @@ bool FileDiscoveryOptions::IsDirectoryInBlacklist(const string& dirPath) const {
             return true;
         }
     }
-    for (auto& dp : mWildcardDirPathBlacklist) {
-        if (0 == fnmatch(dp.c_str(), dirPath.c_str(), FNM_PATHNAME)) {
+    for (auto& dp : mWildcardDirPathBlacklistMatchers) {
+        if (dp.Match(dirPath)) {
             return true;
         }
     }
-    for (auto& dp : mMLWildcardDirPathBlacklist) {
-        if (0 == fnmatch(dp.c_str(), dirPath.c_str(), 0)) {
+    for (auto& dp : mMLWildcardDirPathBlacklistMatchers) {
+        if (dp.Match(dirPath)) {
             return true;
         }
     }
@@ -453,13 +459,13 @@ bool FileDiscoveryOptions::IsObjectInBlacklist(const string& path, const string&
     }
 
     auto const filePath = PathJoin(path, name);
-    for (auto& fp : mFilePathBlacklist) {
-        if (0 == fnmatch(fp.c_str(), filePath.c_str(), FNM_PATHNAME)) {
+    for (auto& fp : mFilePathBlacklistMatchers) {
+        if (fp.Match(filePath)) {
             return true;
         }
     }
-    for (auto& fp : mMLFilePathBlacklist) {
-        if (0 == fnmatch(fp.c_str(), filePath.c_str(), 0)) {
+    for (auto& fp : mMLFilePathBlacklistMatchers) {
+        if (fp.Match(filePath)) {
             return true;
         }
     }
@@ -472,8 +478,8 @@ bool FileDiscoveryOptions::IsFileNameInBlacklist(const string& fileName) const {
         return false;
     }
 
-    for (auto& pattern : mFileNameBlacklist) {
-        if (0 == fnmatch(pattern.c_str(), fileName.c_str(), 0)) {
+    for (auto& pattern : mFileNameBlacklistMatchers) {
+        if (pattern.Match(fileName)) {
             return true;
         }
     }
@@ -486,7 +492,7 @@ bool FileDiscoveryOptions::IsFileNameInBlacklist(const string& fileName) const {
 bool FileDiscoveryOptions::IsMatch(const string& path, const string& name) const {
     // Check if the file name is matched or blacklisted.
     if (!name.empty()) {
-        if (fnmatch(mFilePattern.c_str(), name.c_str(), 0) != 0)
+        if (!mFilePatternMatcher.Match(name))
             return false;
         if (IsFileNameInBlacklist(name)) {
             return false;
@@ -24,6 +24,7 @@
 #include <utility>
 #include <vector>
 
+#include "common/GlobPattern.h"
 #include "file_server/ContainerInfo.h"
 #include "pipeline/PipelineContext.h"
 
@@ -81,6 +82,7 @@ private:
 
     std::string mBasePath;
     std::string mFilePattern;
+    GlobPattern mFilePatternMatcher;
     std::vector<std::string> mConstWildcardPaths;
     std::vector<std::string> mWildcardPaths;
     uint16_t mWildcardDepth;
@@ -106,6 +108,12 @@ private:
     // File name only, */? is supported too, such as 100*.log. It is similar to
     // mFilePattern, but works in reversed way.
     std::vector<std::string> mFileNameBlacklist;
+    // Compiled patterns of the blacklists above, which are used for matching.
+    std::vector<GlobPattern> mWildcardDirPathBlacklistMatchers;
+    std::vector<GlobPattern> mMLWildcardDirPathBlacklistMatchers;
+    std::vector<GlobPattern> mFilePathBlacklistMatchers;
+    std::vector<GlobPattern> mMLFilePathBlacklistMatchers;
+    std::vector<GlobPattern> mFileNameBlacklistMatchers;
 
     bool mEnableContainerDiscovery = false;
     std::shared_ptr<std::vector<ContainerInfo>> mContainerInfos; // must not be null if container discovery is enabled
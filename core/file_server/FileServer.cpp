@@ -135,14 +135,20 @@ FileDiscoveryConfig FileServer::GetFileDiscoveryConfig(const string& name) const
 
 // 添加文件发现配置
 void FileServer::AddFileDiscoveryConfig(const string& name, FileDiscoveryOptions* opts, const PipelineContext* ctx) {
-    WriteLock lock(mReadWriteLock);
-    mPipelineNameFileDiscoveryConfigsMap[name] = make_pair(opts, ctx);
+    {
+        WriteLock lock(mReadWriteLock);
+        mPipelineNameFileDiscoveryConfigsMap[name] = make_pair(opts, ctx);
+    }
+    ConfigManager::GetInstance()->ResetMatcherIndex();
 }
 
 // 移除给定名称的文件发现配置
 void FileServer::RemoveFileDiscoveryConfig(const string& name) {
-    WriteLock lock(mReadWriteLock);
-    mPipelineNameFileDiscoveryConfigsMap.erase(name);
+    {
+        WriteLock lock(mReadWriteLock);
+        mPipelineNameFileDiscoveryConfigsMap.erase(name);
+    }
+    ConfigManager::GetInstance()->ResetMatcherIndex();
 }
 
 // 获取给定名称的文件读取器配置
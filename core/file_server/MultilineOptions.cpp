@@ -61,7 +61,7 @@ bool MultilineOptions::Init(const Json::Value& config, const PipelineContext& ct
                                  ctx.GetProjectName(),
                                  ctx.GetLogstoreName(),
                                  ctx.GetRegion());
-        } else if (!ParseRegex(pattern, mStartPatternRegPtr)) {
+        } else if (!ParseRegex(pattern, mStartPatternRegPtr, mStartPatternFilter)) {
             PARAM_WARNING_IGNORE(ctx.GetLogger(),
                                  ctx.GetAlarm(),
                                  "string param Multiline.StartPattern is not a valid regex",
@@ -85,7 +85,7 @@ bool MultilineOptions::Init(const Json::Value& config, const PipelineContext& ct
                                  ctx.GetProjectName(),
                                  ctx.GetLogstoreName(),
                                  ctx.GetRegion());
-        } else if (!ParseRegex(pattern, mContinuePatternRegPtr)) {
+        } else if (!ParseRegex(pattern, mContinuePatternRegPtr, mContinuePatternFilter)) {
             PARAM_WARNING_IGNORE(ctx.GetLogger(),
                                  ctx.GetAlarm(),
                                  "string param Multiline.ContinuePattern is not a valid regex",
@@ -109,7 +109,7 @@ bool MultilineOptions::Init(const Json::Value& config, const PipelineContext& ct
                                  ctx.GetProjectName(),
                                  ctx.GetLogstoreName(),
                                  ctx.GetRegion());
-        } else if (!ParseRegex(pattern, mEndPatternRegPtr)) {
+        } else if (!ParseRegex(pattern, mEndPatternRegPtr, mEndPatternFilter)) {
             PARAM_WARNING_IGNORE(ctx.GetLogger(),
                                  ctx.GetAlarm(),
                                  "string param Multiline.EndPattern is not a valid regex",
@@ -199,7 +199,7 @@ bool MultilineOptions::Init(const Json::Value& config, const PipelineContext& ct
     return true;
 }
 
-bool MultilineOptions::ParseRegex(const string& pattern, shared_ptr<boost::regex>& reg) {
+bool MultilineOptions::ParseRegex(const string& pattern, shared_ptr<boost::regex>& reg, RegexPrefilter& filter) {
     string regexPattern = pattern;
     if (!regexPattern.empty() && EndWith(regexPattern, "$")) {
         regexPattern = regexPattern.substr(0, regexPattern.size() - 1);
@@ -215,6 +215,7 @@ bool MultilineOptions::ParseRegex(const string& pattern, shared_ptr<boost::regex
     } catch (...) {
         return false;
     }
+    filter = RegexPrefilter(regexPattern);
     return true;
 }
 
@@ -22,6 +22,7 @@
 #include <utility>
 
 #include "boost/regex.hpp"
+#include "common/RegexPrefilter.h"
 #include "pipeline/PipelineContext.h"
 
 namespace logtail {
@@ -35,6 +36,10 @@ public:
     const std::shared_ptr<boost::regex>& GetStartPatternReg() const { return mStartPatternRegPtr; }
     const std::shared_ptr<boost::regex>& GetContinuePatternReg() const { return mContinuePatternRegPtr; }
     const std::shared_ptr<boost::regex>& GetEndPatternReg() const { return mEndPatternRegPtr; }
+    // lines rejected by the filters can not be matched by the corresponding regex
+    const RegexPrefilter& GetStartPatternFilter() const { return mStartPatternFilter; }
+    const RegexPrefilter& GetContinuePatternFilter() const { return mContinuePatternFilter; }
+    const RegexPrefilter& GetEndPatternFilter() const { return mEndPatternFilter; }
     bool IsMultiline() const { return mIsMultiline; }
 
     Mode mMode = Mode::CUSTOM;
@@ -45,12 +50,19 @@ public:
     bool mIgnoringUnmatchWarning = false;
 
 private:
-    bool ParseRegex(const std::string& pattern, std::shared_ptr<boost::regex>& reg);
+    bool ParseRegex(const std::string& pattern, std::shared_ptr<boost::regex>& reg, RegexPrefilter& filter);
 
     std::shared_ptr<boost::regex> mStartPatternRegPtr;
     std::shared_ptr<boost::regex> mContinuePatternRegPtr;
     std::shared_ptr<boost::regex> mEndPatternRegPtr;
+    RegexPrefilter mStartPatternFilter;
+    RegexPrefilter mContinuePatternFilter;
+    RegexPrefilter mEndPatternFilter;
     bool mIsMultiline = false;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class SplitMultilinePrefilterBenchmark;
+#endif
 };
 
 const std::string&
@@ -0,0 +1,81 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "file_server/event/Event.h"
+
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "common/Flags.h"
+
+DEFINE_FLAG_INT32(event_pool_max_size, "max number of memory blocks of deleted events kept for reuse", 4096);
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+struct EventBlockPool {
+    mutex mMux;
+    vector<void*> mBlocks;
+};
+
+EventBlockPool& GetEventBlockPool() {
+    // never destructed, since events may still be deleted by other static objects on exit
+    static EventBlockPool* ptr = new EventBlockPool();
+    return *ptr;
+}
+
+} // namespace
+
+void* Event::operator new(size_t size) {
+    if (size == sizeof(Event)) {
+        auto& pool = GetEventBlockPool();
+        lock_guard<mutex> lock(pool.mMux);
+        if (!pool.mBlocks.empty()) {
+            void* ptr = pool.mBlocks.back();
+            pool.mBlocks.pop_back();
+            return ptr;
+        }
+    }
+    return ::operator new(size);
+}
+
+void Event::operator delete(void* ptr, size_t size) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+    if (size == sizeof(Event)) {
+        auto& pool = GetEventBlockPool();
+        lock_guard<mutex> lock(pool.mMux);
+        if (pool.mBlocks.size() < static_cast<size_t>(INT32_FLAG(event_pool_max_size))) {
+            try {
+                pool.mBlocks.push_back(ptr);
+                return;
+            } catch (...) {
+            }
+        }
+    }
+    ::operator delete(ptr);
+}
+
+size_t Event::GetPooledBlockCount() {
+    auto& pool = GetEventBlockPool();
+    lock_guard<mutex> lock(pool.mMux);
+    return pool.mBlocks.size();
+}
+
+} // namespace logtail
@@ -16,6 +16,7 @@
 
 #pragma once
 #include <stdint.h>
+#include <cstddef>
 #include <string>
 #include "common/DevInode.h"
 
@@ -68,6 +69,12 @@ public:
           uint64_t inode)
         : mSource(source), mObject(object), mType(type), mWd(wd), mCookie(cookie), mDev(dev), mInode(inode) {}
 
+    // Events are created and deleted for every file change, so memory blocks of deleted events are kept in a free list
+    // and reused by new events instead of going through malloc again.
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size) noexcept;
+    static size_t GetPooledBlockCount();
+
     static bool CompareByFullPath(const Event* lhs, const Event* rhs) {
         std::string lhsPath(lhs->mSource);
         lhsPath.append("/").append(lhs->mObject);
@@ -13,37 +13,153 @@
 // limitations under the License.
 
 #include "EventListener_Linux.h"
+#include <fcntl.h>
+#include <sys/fanotify.h>
 #include <sys/inotify.h>
+#include <sys/stat.h>
+#include <sys/statfs.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
 #include "logger/Logger.h"
 #include "monitor/AlarmManager.h"
 #include "common/ErrorUtil.h"
 #include "common/Flags.h"
+#include "common/TimeUtil.h"
 #include "file_server/EventDispatcher.h"
+#include "file_server/FileServer.h"
 #include "file_server/event_handler/LogInput.h"
 
 DEFINE_FLAG_BOOL(fs_events_inotify_enable, "", true);
+DEFINE_FLAG_INT32(inotify_modify_event_coalesce_window,
+                  "ms, modify events of the same file are merged into one if they arrive within the window, events "
+                  "read at once are always merged unless the value is negative",
+                  0);
+DEFINE_FLAG_BOOL(fs_events_fanotify_enable,
+                 "watch dirs by marking whole filesystems with fanotify instead of adding an inotify watch for each "
+                 "dir, requires CAP_SYS_ADMIN and linux 5.9+, inotify is used if not available",
+                 false);
 
 namespace logtail {
 
+static const size_t kMaxIdleReadBufferSize = 1024 * 1024;
+static const size_t kFanotifyReadBufferSize = 64 * 1024;
+static const int kMaxFanotifyReadsPerRound = 16;
+
 const uint32_t EventListener::mWatchEventMask
     = IN_CREATE | IN_MODIFY | IN_MASK_ADD | IN_DELETE_SELF | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE;
 
+#ifdef FAN_REPORT_DFID_NAME
+static const uint64_t kFanotifyEventMask
+    = FAN_CREATE | FAN_MODIFY | FAN_DELETE_SELF | FAN_MOVED_FROM | FAN_MOVED_TO | FAN_DELETE | FAN_ONDIR;
+
+static void MakeHandleKey(const void* fsid, const struct file_handle* handle, std::string& key) {
+    key.assign(static_cast<const char*>(fsid), sizeof(__kernel_fsid_t))
+        .append(reinterpret_cast<const char*>(&handle->handle_type), sizeof(handle->handle_type))
+        .append(reinterpret_cast<const char*>(handle->f_handle), handle->handle_bytes);
+}
+#endif
+
 logtail::EventListener::~EventListener() {
     Destroy();
 }
 
 bool logtail::EventListener::Init() {
+    if (!mRawEventsTotal) {
+        mRawEventsTotal
+            = FileServer::GetInstance()->GetMetricsRecordRef().CreateCounter(METRIC_RUNNER_FILE_INOTIFY_EVENTS_TOTAL);
+        mCoalescedEventsTotal = FileServer::GetInstance()->GetMetricsRecordRef().CreateCounter(
+            METRIC_RUNNER_FILE_INOTIFY_COALESCED_EVENTS_TOTAL);
+        mFanotifyEventsTotal = FileServer::GetInstance()->GetMetricsRecordRef().CreateCounter(
+            METRIC_RUNNER_FILE_FANOTIFY_EVENTS_TOTAL);
+    }
     mInotifyFd = inotify_init();
+    if (BOOL_FLAG(fs_events_fanotify_enable)) {
+        InitFanotify();
+    }
     return mInotifyFd != -1;
 }
 
-int logtail::EventListener::AddWatch(const char* dir) {
+void EventListener::InitFanotify() {
+#ifdef FAN_REPORT_DFID_NAME
+    mFanotifyFd
+        = fanotify_init(FAN_CLASS_NOTIF | FAN_REPORT_DFID_NAME | FAN_NONBLOCK | FAN_CLOEXEC, O_RDONLY | O_LARGEFILE);
+    if (mFanotifyFd < 0) {
+        LOG_WARNING(sLogger, ("failed to init fanotify, use inotify instead", ErrnoToString(GetErrno())));
+        return;
+    }
+    mFanotifyReadBuffer.resize(kFanotifyReadBufferSize);
+    LOG_INFO(sLogger, ("fanotify is enabled", "dirs are watched by filesystem marks"));
+#else
+    LOG_WARNING(sLogger, ("fanotify is not supported by the build", "use inotify instead"));
+#endif
+}
+
+int logtail::EventListener::AddWatch(const char* dir, bool allowInotify) {
+    if (mFanotifyFd >= 0) {
+        int wd = AddFanotifyWatch(dir);
+        if (IsValidID(wd) || !allowInotify) {
+            return wd;
+        }
+    }
     return inotify_add_watch(mInotifyFd, dir, mWatchEventMask);
 }
 
+int EventListener::AddFanotifyWatch(const char* dir) {
+#ifdef FAN_REPORT_DFID_NAME
+    struct stat st;
+    if (stat(dir, &st) != 0 || mFanotifyUnmarkableDevs.find(st.st_dev) != mFanotifyUnmarkableDevs.end()) {
+        return -1;
+    }
+    if (mFanotifyMarkedDevs.find(st.st_dev) == mFanotifyMarkedDevs.end()) {
+        if (fanotify_mark(mFanotifyFd, FAN_MARK_ADD | FAN_MARK_FILESYSTEM, kFanotifyEventMask, AT_FDCWD, dir) != 0) {
+            LOG_WARNING(sLogger,
+                        ("failed to mark filesystem with fanotify, use inotify instead",
+                         ErrnoToString(GetErrno()))("dir", dir)("dev", st.st_dev));
+            mFanotifyUnmarkableDevs.insert(st.st_dev);
+            return -1;
+        }
+        LOG_INFO(sLogger, ("mark filesystem with fanotify", dir)("dev", st.st_dev));
+        mFanotifyMarkedDevs.insert(st.st_dev);
+    }
+
+    // events are reported with the handle of the parent dir, which is resolved to the watched dir in user space
+    struct statfs sfs;
+    if (statfs(dir, &sfs) != 0) {
+        return -1;
+    }
+    union {
+        struct file_handle handle;
+        char buf[sizeof(struct file_handle) + MAX_HANDLE_SZ];
+    } fh;
+    fh.handle.handle_bytes = MAX_HANDLE_SZ;
+    int mountId = 0;
+    if (name_to_handle_at(AT_FDCWD, dir, &fh.handle, &mountId, AT_SYMLINK_FOLLOW) != 0) {
+        return -1;
+    }
+    MakeHandleKey(&sfs.f_fsid, &fh.handle, mHandleKeyBuffer);
+    auto iter = mFanotifyHandleWdMap.find(mHandleKeyBuffer);
+    if (iter != mFanotifyHandleWdMap.end()) {
+        return iter->second;
+    }
+    int wd = mNextFanotifyWd++;
+    mFanotifyHandleWdMap.emplace(mHandleKeyBuffer, wd);
+    mFanotifyWdHandleMap.emplace(wd, mHandleKeyBuffer);
+    return wd;
+#else
+    return -1;
+#endif
+}
+
 bool logtail::EventListener::RemoveWatch(int wd) {
+    if (IsFanotifyID(wd)) {
+        auto iter = mFanotifyWdHandleMap.find(wd);
+        if (iter == mFanotifyWdHandleMap.end()) {
+            return false;
+        }
+        mFanotifyHandleWdMap.erase(iter->second);
+        mFanotifyWdHandleMap.erase(iter);
+        return true;
+    }
     return inotify_rm_watch(mInotifyFd, wd) != -1;
 }
 
@@ -52,30 +168,44 @@ int32_t logtail::EventListener::ReadEvents(std::vector<logtail::Event*>& eventVe
     if (mInotifyFd < 0) {
         return 0;
     }
+    ReadInotifyEvents(eventVec);
+    ReadFanotifyEvents(eventVec);
+    if (!mPendingModifyEvents.empty()
+        && GetCurrentTimeInMilliSeconds() - mPendingSinceMs >= INT32_FLAG(inotify_modify_event_coalesce_window)) {
+        FlushPendingEvents(eventVec);
+    }
+    return (int32_t)eventVec.size();
+}
+
+void EventListener::ReadInotifyEvents(std::vector<Event*>& eventVec) {
     int len = 0;
     ioctl(mInotifyFd, FIONREAD, &len);
-    if (len < 1)
-        return 0;
-    static char* s_lastHalfEventBuf = new char[65536];
-    static int32_t s_lastHalfEventSize = 0;
+    if (len < 1) {
+        return;
+    }
 
-    char* buffer = new char[len + s_lastHalfEventSize];
-    if (s_lastHalfEventSize > 0) {
-        memcpy(buffer, s_lastHalfEventBuf, s_lastHalfEventSize);
+    size_t bufSize = mHalfEventSize + len;
+    if (mReadBuffer.size() < bufSize) {
+        mReadBuffer.resize(bufSize);
+    } else if (mReadBuffer.size() > kMaxIdleReadBufferSize && bufSize < kMaxIdleReadBufferSize / 16) {
+        // give back memory taken by a burst of events
+        std::vector<char> buffer(kMaxIdleReadBufferSize / 16);
+        memcpy(buffer.data(), mReadBuffer.data(), mHalfEventSize);
+        mReadBuffer.swap(buffer);
     }
-    size_t readLen = read(mInotifyFd, buffer + s_lastHalfEventSize, len);
-    if (readLen == 0) {
+    char* buffer = mReadBuffer.data();
+    ssize_t readLen = read(mInotifyFd, buffer + mHalfEventSize, len);
+    if (readLen <= 0) {
         LOG_ERROR(sLogger, ("read inotify fd error", ErrnoToString(GetErrno()))("read len", len));
-        delete[] buffer;
-        return 0;
+        return;
     }
     // update len
-    len = readLen + s_lastHalfEventSize;
+    len = readLen + mHalfEventSize;
     // when read success, set lastHalfSize 0
-    s_lastHalfEventSize = 0;
+    mHalfEventSize = 0;
     if (BOOL_FLAG(fs_events_inotify_enable)) {
-        static EventDispatcher* dispatcher = EventDispatcher::GetInstance();
         int n = 0;
+        uint64_t rawCnt = 0;
         struct inotify_event* event;
         while (n < len) {
             // maybe invalid, must check if this packet is a whole packet
@@ -84,16 +214,17 @@ int32_t logtail::EventListener::ReadEvents(std::vector<logtail::Event*>& eventVe
             int tailSize = len - n;
             if ((size_t)tailSize < sizeof(struct inotify_event)
                 || (size_t)tailSize < event->len + sizeof(struct inotify_event)) {
-                s_lastHalfEventSize = tailSize;
+                mHalfEventSize = tailSize;
                 LOG_WARNING(sLogger,
                             ("read notify event abnormal, half packet is readed, proccess size", n)("read len", len));
-                memcpy(s_lastHalfEventBuf, buffer + n, tailSize);
+                memmove(buffer, buffer + n, tailSize);
                 break;
             }
-
+            ++rawCnt;
 
             // when interrupt (config update), must check event buf tail, if not a whole packet, next read will crash
             if (LogInput::GetInstance()->IsInterupt()) {
+                ClearPendingEvents();
                 n += sizeof(struct inotify_event) + event->len;
                 continue;
             }
@@ -109,16 +240,187 @@ int32_t logtail::EventListener::ReadEvents(std::vector<logtail::Event*>& eventVe
                 etype |= event->mask & IN_MOVED_FROM ? EVENT_MOVE_FROM : 0;
                 etype |= event->mask & IN_MOVED_TO ? EVENT_MOVE_TO : 0;
                 etype |= event->mask & IN_DELETE ? EVENT_DELETE : 0;
-                std::string path;
-                if (etype != 0 && dispatcher->IsRegistered(event->wd, path))
-                    eventVec.push_back(
-                        new Event(path, event->len > 0 ? event->name : "", etype, event->wd, event->cookie));
+                if (etype != 0) {
+                    AddEvent(event->wd, event->len > 0 ? event->name : "", etype, event->cookie, eventVec);
+                }
             }
             n += sizeof(struct inotify_event) + event->len;
         }
+        if (mRawEventsTotal) {
+            mRawEventsTotal->Add(rawCnt);
+        }
     }
-    delete[] buffer;
-    return (int32_t)eventVec.size();
+}
+
+void EventListener::ReadFanotifyEvents(std::vector<Event*>& eventVec) {
+#ifdef FAN_REPORT_DFID_NAME
+    if (mFanotifyFd < 0) {
+        return;
+    }
+    // the fd is nonblocking, and each read returns whole events only
+    for (int i = 0; i < kMaxFanotifyReadsPerRound; ++i) {
+        ssize_t len = read(mFanotifyFd, mFanotifyReadBuffer.data(), mFanotifyReadBuffer.size());
+        if (len <= 0) {
+            if (len < 0 && errno != EAGAIN) {
+                LOG_ERROR(sLogger, ("read fanotify fd error", ErrnoToString(GetErrno())));
+            }
+            return;
+        }
+        if (!BOOL_FLAG(fs_events_inotify_enable)) {
+            continue;
+        }
+        const size_t readLen = len;
+        uint64_t rawCnt = 0;
+        struct fanotify_event_metadata* event = (struct fanotify_event_metadata*)mFanotifyReadBuffer.data();
+        for (; FAN_EVENT_OK(event, len); event = FAN_EVENT_NEXT(event, len)) {
+            if (event->vers != FANOTIFY_METADATA_VERSION) {
+                LOG_ERROR(sLogger, ("fanotify metadata version mismatch", event->vers));
+                break;
+            }
+            ++rawCnt;
+            if (LogInput::GetInstance()->IsInterupt()) {
+                ClearPendingEvents();
+                continue;
+            }
+            if (event->mask & FAN_Q_OVERFLOW) {
+                LOG_INFO(sLogger, ("fanotify event queue overflow", "miss fanotify events"));
+                AlarmManager::GetInstance()->SendAlarm(INOTIFY_EVENT_OVERFLOW_ALARM, "fanotify event queue overflow");
+                continue;
+            }
+            ParseFanotifyEvent(reinterpret_cast<const char*>(event), eventVec);
+        }
+        if (mFanotifyEventsTotal) {
+            mFanotifyEventsTotal->Add(rawCnt);
+        }
+        if (readLen < mFanotifyReadBuffer.size() / 2) {
+            return;
+        }
+    }
+#endif
+}
+
+void EventListener::ParseFanotifyEvent(const char* event, std::vector<Event*>& eventVec) {
+#ifdef FAN_REPORT_DFID_NAME
+    auto metadata = reinterpret_cast<const struct fanotify_event_metadata*>(event);
+    const char* info = event + metadata->metadata_len;
+    const char* end = event + metadata->event_len;
+    while (info + sizeof(struct fanotify_event_info_header) <= end) {
+        auto header = reinterpret_cast<const struct fanotify_event_info_header*>(info);
+        if (header->len == 0 || info + header->len > end) {
+            return;
+        }
+        if (header->info_type != FAN_EVENT_INFO_TYPE_DFID_NAME && header->info_type != FAN_EVENT_INFO_TYPE_DFID) {
+            info += header->len;
+            continue;
+        }
+        auto fid = reinterpret_cast<const struct fanotify_event_info_fid*>(info);
+        auto handle = reinterpret_cast<const struct file_handle*>(fid->handle);
+        const char* name = "";
+        if (header->info_type == FAN_EVENT_INFO_TYPE_DFID_NAME) {
+            name = reinterpret_cast<const char*>(handle->f_handle) + handle->handle_bytes;
+            // events on the dir itself are reported with name "."
+            if (name[0] == '.' && name[1] == '\0') {
+                name = "";
+            }
+        }
+        MakeHandleKey(&fid->fsid, handle, mHandleKeyBuffer);
+        auto iter = mFanotifyHandleWdMap.find(mHandleKeyBuffer);
+        if (iter == mFanotifyHandleWdMap.end()) {
+            // not a registered dir
+            return;
+        }
+        int wd = iter->second;
+        uint64_t mask = metadata->mask;
+        EventType dirFlag = mask & FAN_ONDIR ? EVENT_ISDIR : 0;
+        // unlike inotify, events on the same name may be merged into one by kernel, so split them in the order they
+        // could happen. If the name was both removed and created, e.g., a file rotated by renaming and then created
+        // again, the removal comes first if the name exists now.
+        auto addRemovalEvents = [&]() {
+            if (mask & FAN_MOVED_FROM) {
+                AddEvent(wd, name, EVENT_MOVE_FROM | dirFlag, 0, eventVec);
+            }
+            if (mask & FAN_DELETE) {
+                AddEvent(wd, name, EVENT_DELETE | dirFlag, 0, eventVec);
+            }
+        };
+        bool removalFirst = false;
+        if ((mask & (FAN_MOVED_FROM | FAN_DELETE)) && (mask & (FAN_CREATE | FAN_MOVED_TO)) && name[0] != '\0') {
+            std::string path;
+            struct stat st;
+            removalFirst = EventDispatcher::GetInstance()->IsRegistered(wd, path)
+                && lstat((path + "/" + name).c_str(), &st) == 0;
+        }
+        if (removalFirst) {
+            addRemovalEvents();
+        }
+        if (mask & FAN_CREATE) {
+            AddEvent(wd, name, EVENT_CREATE | dirFlag, 0, eventVec);
+        }
+        if (mask & FAN_MOVED_TO) {
+            AddEvent(wd, name, EVENT_MOVE_TO | dirFlag, 0, eventVec);
+        }
+        if (mask & FAN_MODIFY) {
+            AddEvent(wd, name, EVENT_MODIFY | dirFlag, 0, eventVec);
+        }
+        if (!removalFirst) {
+            addRemovalEvents();
+        }
+        if ((mask & FAN_DELETE_SELF) && (mask & FAN_ONDIR) && name[0] == '\0') {
+            AddEvent(wd, name, EVENT_TIMEOUT, 0, eventVec);
+        }
+        return;
+    }
+#endif
+}
+
+void EventListener::AddEvent(
+    int wd, const char* name, EventType etype, uint32_t cookie, std::vector<Event*>& eventVec) {
+    if (etype == EVENT_MODIFY && INT32_FLAG(inotify_modify_event_coalesce_window) >= 0) {
+        AddModifyEvent(wd, name, eventVec);
+        return;
+    }
+    // keep the order of events, since other events may change what the modified file refers to
+    FlushPendingEvents(eventVec);
+    std::string path;
+    if (EventDispatcher::GetInstance()->IsRegistered(wd, path)) {
+        eventVec.push_back(new Event(path, name, etype, wd, cookie));
+    }
+}
+
+void EventListener::AddModifyEvent(int wd, const char* name, std::vector<Event*>& eventVec) {
+    mKeyBuffer.assign(reinterpret_cast<const char*>(&wd), sizeof(wd)).append(name);
+    if (mPendingModifyEventKeys.find(mKeyBuffer) != mPendingModifyEventKeys.end()) {
+        if (mCoalescedEventsTotal) {
+            mCoalescedEventsTotal->Add(1);
+        }
+        return;
+    }
+    std::string path;
+    if (!EventDispatcher::GetInstance()->IsRegistered(wd, path)) {
+        return;
+    }
+    if (mPendingModifyEvents.empty()) {
+        mPendingSinceMs = GetCurrentTimeInMilliSeconds();
+    }
+    mPendingModifyEvents.push_back(new Event(path, name, EVENT_MODIFY, wd, 0));
+    mPendingModifyEventKeys.insert(mKeyBuffer);
+}
+
+void EventListener::FlushPendingEvents(std::vector<Event*>& eventVec) {
+    if (mPendingModifyEvents.empty()) {
+        return;
+    }
+    eventVec.insert(eventVec.end(), mPendingModifyEvents.begin(), mPendingModifyEvents.end());
+    mPendingModifyEvents.clear();
+    mPendingModifyEventKeys.clear();
+}
+
+void EventListener::ClearPendingEvents() {
+    for (auto ev : mPendingModifyEvents) {
+        delete ev;
+    }
+    mPendingModifyEvents.clear();
+    mPendingModifyEventKeys.clear();
 }
 
 bool logtail::EventListener::IsInit() {
@@ -126,8 +428,20 @@ bool logtail::EventListener::IsInit() {
 }
 
 void logtail::EventListener::Destroy() {
-    if (mInotifyFd >= 0)
+    ClearPendingEvents();
+    if (mInotifyFd >= 0) {
         close(mInotifyFd);
+        mInotifyFd = -1;
+    }
+    mHalfEventSize = 0;
+    if (mFanotifyFd >= 0) {
+        close(mFanotifyFd);
+        mFanotifyFd = -1;
+    }
+    mFanotifyMarkedDevs.clear();
+    mFanotifyUnmarkableDevs.clear();
+    mFanotifyHandleWdMap.clear();
+    mFanotifyWdHandleMap.clear();
 }
 
 bool EventListener::IsValidID(int id) {
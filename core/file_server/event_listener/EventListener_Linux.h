@@ -18,8 +18,11 @@
 #define LOGTAIL_EVENTLISTENER_H
 
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include "file_server/event/Event.h"
+#include "monitor/MetricManager.h"
 
 namespace logtail {
 
@@ -40,14 +43,66 @@ public:
     static bool IsValidID(int id);
     static const uint32_t mWatchEventMask;
 
-    int AddWatch(const char* dir);
+    // If fanotify is enabled, dirs are watched by marking the filesystems they belong to, so that no kernel watch is
+    // needed for each dir. Dirs on filesystems which can not be marked are watched by inotify instead, unless
+    // allowInotify is false.
+    int AddWatch(const char* dir, bool allowInotify = true);
     bool RemoveWatch(int wd);
+    bool IsFanotifyEnabled() const { return mFanotifyFd >= 0; }
+    static bool IsFanotifyID(int id) { return id >= kFanotifyWdBase; }
 
     int32_t ReadEvents(std::vector<Event*>& eventVec);
 
+    uint64_t GetRawEventsTotal() const { return mRawEventsTotal ? mRawEventsTotal->GetTotalValue() : 0; }
+    uint64_t GetCoalescedEventsTotal() const {
+        return mCoalescedEventsTotal ? mCoalescedEventsTotal->GetTotalValue() : 0;
+    }
+
 private:
+    // ids of dirs watched by fanotify are allocated from here, which are never reached by inotify watch descriptors
+    static constexpr int kFanotifyWdBase = 1 << 30;
+
     EventListener() = default;
+
+    void InitFanotify();
+    int AddFanotifyWatch(const char* dir);
+    void ReadInotifyEvents(std::vector<Event*>& eventVec);
+    void ReadFanotifyEvents(std::vector<Event*>& eventVec);
+    void ParseFanotifyEvent(const char* event, std::vector<Event*>& eventVec);
+    void AddEvent(int wd, const char* name, EventType etype, uint32_t cookie, std::vector<Event*>& eventVec);
+    void AddModifyEvent(int wd, const char* name, std::vector<Event*>& eventVec);
+    void FlushPendingEvents(std::vector<Event*>& eventVec);
+    void ClearPendingEvents();
+
     int32_t mInotifyFd = -1;
+    // reused by each read, the first mHalfEventSize bytes are the incomplete event left by the last read
+    std::vector<char> mReadBuffer;
+    size_t mHalfEventSize = 0;
+
+    // modify events not dispatched yet, in the order they are received
+    std::vector<Event*> mPendingModifyEvents;
+    // wd and name of the pending modify events
+    std::unordered_set<std::string> mPendingModifyEventKeys;
+    std::string mKeyBuffer;
+    int64_t mPendingSinceMs = 0;
+
+    int32_t mFanotifyFd = -1;
+    std::vector<char> mFanotifyReadBuffer;
+    std::unordered_set<uint64_t> mFanotifyMarkedDevs;
+    std::unordered_set<uint64_t> mFanotifyUnmarkableDevs;
+    // key is fsid, handle type and handle of the dir
+    std::unordered_map<std::string, int> mFanotifyHandleWdMap;
+    std::unordered_map<int, std::string> mFanotifyWdHandleMap;
+    std::string mHandleKeyBuffer;
+    int mNextFanotifyWd = kFanotifyWdBase;
+
+    CounterPtr mRawEventsTotal;
+    CounterPtr mCoalescedEventsTotal;
+    CounterPtr mFanotifyEventsTotal;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class FanotifyEventListenerUnittest;
+#endif
 };
 
 } // namespace logtail
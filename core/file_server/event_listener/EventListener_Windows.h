@@ -37,8 +37,10 @@ public:
 
     static bool IsValidID(int id);
 
-    int AddWatch(const char* dir);
+    int AddWatch(const char* dir, bool allowInotify = true);
     bool RemoveWatch(int wd);
+    bool IsFanotifyEnabled() const { return false; }
+    static bool IsFanotifyID(int id) { return false; }
 
     int32_t ReadEvents(std::vector<Event*>& eventVec);
 
@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #include "file_server/polling/PollingCache.h"
+
+#include <algorithm>
+
 #include "common/Flags.h"
 
 DEFINE_FLAG_INT32(max_file_not_exist_times, "treate as deleted when file stat failed XX times, default", 10);
@@ -33,6 +36,10 @@ bool ModifyCheckCache::UpdateFileNotExist() {
     return false;
 }
 
+void ModifyCheckCache::UpdateCheckInterval(bool modified, int32_t minInterval, int32_t maxInterval) {
+    mCheckInterval = std::clamp(modified ? mCheckInterval / 2 : mCheckInterval * 2, minInterval, maxInterval);
+}
+
 void ModifyCheckCache::UpdateFileProperty(uint64_t dev, uint64_t inode, uint64_t fileSize, timespec modifyTime) {
     mDev = dev;
     mInode = inode;
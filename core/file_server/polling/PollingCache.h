@@ -17,10 +17,12 @@
 #pragma once
 #include <string>
 #include <map>
+#include <memory>
 #include <vector>
 #include <deque>
 #include <unordered_map>
 #include <ctime>
+#include "common/FileSystemUtil.h"
 #include "common/SplitedFilePath.h"
 
 namespace logtail {
@@ -64,6 +66,18 @@ private:
 typedef std::unordered_map<std::string, DirFileCache> DirCheckCacheMap;
 typedef std::unordered_map<std::string, DirFileCache> FileCheckCacheMap;
 
+// DirListingCache records entries of a directory listed in current polling round,
+// so that configs and containers sharing the directory need not to list it again.
+struct DirListingCache {
+    bool mOpened = false;
+    int mErrno = 0;
+    std::vector<fsutil::Entry> mEntries;
+};
+
+typedef std::unordered_map<std::string, std::shared_ptr<DirListingCache>> DirListingCacheMap;
+// Stat results of paths in current polling round, the first item indicates if stat succeeded.
+typedef std::unordered_map<std::string, std::pair<bool, fsutil::PathStat>> PathStatCacheMap;
+
 struct ModifyCheckCache {
     ModifyCheckCache() : mDev(0), mInode(0), mFileSize(0), mNotExistTimes(0) {
         mModifyTime.tv_sec = 0;
@@ -79,11 +93,18 @@ struct ModifyCheckCache {
     // return : true as deleted, false as normal.
     bool UpdateFileNotExist();
 
+    // Files found modified are checked twice as often next time, and files not modified half as often, within
+    // [minInterval, maxInterval] in milliseconds.
+    void UpdateCheckInterval(bool modified, int32_t minInterval, int32_t maxInterval);
+
     uint64_t mDev;
     uint64_t mInode;
     uint64_t mFileSize;
     timespec mModifyTime;
     int32_t mNotExistTimes;
+    // When and how often to stat the file, in milliseconds.
+    int64_t mNextCheckTime = 0;
+    int32_t mCheckInterval = 0;
 };
 
 typedef std::map<SplitedFilePath, ModifyCheckCache> ModifyCheckCacheMap;
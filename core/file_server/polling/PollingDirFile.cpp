@@ -59,6 +59,9 @@ DEFINE_FLAG_INT32(polling_max_stat_count, "max stat count in each round", 100000
 DEFINE_FLAG_INT32(polling_max_stat_count_per_dir, "max stat count per dir in each round", 100000);
 DEFINE_FLAG_INT32(polling_max_stat_count_per_config, "max stat count per config in each round", 100000);
 DEFINE_FLAG_INT32(polling_modify_repush_interval, "polling modify event repush interval, seconds", 10);
+DEFINE_FLAG_BOOL(polling_dir_shared_scan,
+                 "share directory listings and stat results among configs and containers in each polling round",
+                 true);
 DECLARE_FLAG_INT32(wildcard_max_sub_dir_count);
 
 using namespace std;
@@ -73,6 +76,12 @@ void PollingDirFile::Start() {
         = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(METRIC_RUNNER_FILE_POLLING_DIR_CACHE_SIZE);
     mPollingFileCacheSize
         = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE);
+    mPollingReaddirCount
+        = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(METRIC_RUNNER_FILE_POLLING_READDIR_COUNT);
+    mPollingStatCount
+        = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(METRIC_RUNNER_FILE_POLLING_STAT_COUNT);
+    mPollingSharedScanHitCount = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(
+        METRIC_RUNNER_FILE_POLLING_SHARED_SCAN_HIT_COUNT);
     mRuningFlag = true;
     mThreadPtr = CreateThread([this]() { Polling(); });
 }
@@ -145,6 +154,7 @@ void PollingDirFile::PollingIteration() {
     PTScopedLock thradLock(mPollingThreadLock);
     mStatCount = 0;
     mNewFileVec.clear();
+    ClearRoundCache();
     ++mCurrentRound;
 
     // Get a copy of config list from ConfigManager.
@@ -178,7 +188,7 @@ void PollingDirFile::PollingIteration() {
         const PipelineContext* ctx = itr->second;
         if (!config->IsContainerDiscoveryEnabled()) {
             fsutil::PathStat baseDirStat;
-            if (!fsutil::PathStat::stat(config->GetBasePath(), baseDirStat)) {
+            if (!StatPath(config->GetBasePath(), baseDirStat)) {
                 LOG_DEBUG(sLogger,
                           ("get base dir info error: ", config->GetBasePath())(ctx->GetProjectName(),
                                                                                ctx->GetLogstoreName()));
@@ -196,7 +206,7 @@ void PollingDirFile::PollingIteration() {
             for (size_t i = 0; i < config->GetContainerInfo()->size(); ++i) {
                 const string& basePath = (*config->GetContainerInfo())[i].mRealBaseDir;
                 fsutil::PathStat baseDirStat;
-                if (!fsutil::PathStat::stat(basePath, baseDirStat)) {
+                if (!StatPath(basePath, baseDirStat)) {
                     LOG_DEBUG(
                         sLogger,
                         ("get docker base dir info error: ", basePath)(ctx->GetProjectName(), ctx->GetLogstoreName()));
@@ -248,6 +258,17 @@ void PollingDirFile::PollingIteration() {
     // Add collected new files to PollingModify.
     PollingModify::GetInstance()->AddNewFile(mNewFileVec);
 
+    if (mPollingReaddirCount) {
+        mPollingReaddirCount->Set(mRoundReaddirCount);
+        mPollingStatCount->Set(mRoundStatCallCount);
+        mPollingSharedScanHitCount->Set(mRoundSharedScanHitCount);
+    }
+    LOG_DEBUG(sLogger,
+              ("dir file polling done, round", mCurrentRound)("readdir count", mRoundReaddirCount)(
+                  "stat count", mRoundStatCallCount)("shared scan hit count", mRoundSharedScanHitCount));
+    // Release the memory of listings as soon as possible, they are useless in next round.
+    ClearRoundCache();
+
     // Check cache, clear unavailable and overtime items.
     if (mCurrentRound % INT32_FLAG(check_not_exist_file_dir_round) == 0) {
         ClearUnavailableFileAndDir();
@@ -386,57 +407,14 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
     }
 
     // Iterate directories and files in dirPath.
-    fsutil::Dir dir(dirPath);
-    if (!dir.Open()) {
-        auto err = GetErrno();
-        if (fsutil::Dir::IsENOENT(err)) {
-            LOG_DEBUG(sLogger, ("Open dir error, ENOENT, dir", dirPath.c_str()));
-            return false;
-        } else {
-            AlarmManager::GetInstance()->SendAlarm(LOGDIR_PERMINSSION_ALARM,
-                                                   string("Failed to open dir : ") + dirPath
-                                                       + ";\terrno : " + ToString(err),
-                                                   pConfig.second->GetProjectName(),
-                                                   pConfig.second->GetLogstoreName());
-            LOG_ERROR(sLogger, ("Open dir error", dirPath.c_str())("error", ErrnoToString(err)));
-        }
-        return true;
+    auto listing = ListDir(dirPath, pConfig);
+    if (!listing->mOpened) {
+        return !fsutil::Dir::IsENOENT(listing->mErrno);
     }
-    int32_t nowStatCount = 0;
-    fsutil::Entry ent;
-    while ((ent = dir.ReadNext(false))) {
+    for (const auto& ent : listing->mEntries) {
         if (!mRuningFlag || mHoldOnFlag)
             break;
 
-        if (++mStatCount % INT32_FLAG(dirfile_stat_count) == 0) {
-            usleep(INT32_FLAG(dirfile_stat_sleep) * 1000);
-        }
-
-        if (mStatCount > INT32_FLAG(polling_max_stat_count)) {
-            LOG_WARNING(sLogger,
-                        ("total dir's polling stat count is exceeded", nowStatCount)(dirPath, mStatCount)(
-                            pConfig.second->GetProjectName(), pConfig.second->GetLogstoreName()));
-            AlarmManager::GetInstance()->SendAlarm(
-                STAT_LIMIT_ALARM,
-                string("total dir's polling stat count is exceeded, now count:") + ToString(nowStatCount)
-                    + " total count:" + ToString(mStatCount) + " path: " + dirPath + " project:"
-                    + pConfig.second->GetProjectName() + " logstore:" + pConfig.second->GetLogstoreName());
-            break;
-        }
-
-        if (++nowStatCount > INT32_FLAG(polling_max_stat_count_per_dir)) {
-            LOG_WARNING(sLogger,
-                        ("this dir's polling stat count is exceeded", nowStatCount)(dirPath, mStatCount)(
-                            pConfig.second->GetProjectName(), pConfig.second->GetLogstoreName()));
-            AlarmManager::GetInstance()->SendAlarm(
-                STAT_LIMIT_ALARM,
-                string("this dir's polling stat count is exceeded, now count:") + ToString(nowStatCount)
-                    + " total count:" + ToString(mStatCount) + " path: " + dirPath
-                    + " project:" + pConfig.second->GetProjectName() + " logstore:" + pConfig.second->GetLogstoreName(),
-                pConfig.second->GetRegion());
-            break;
-        }
-
         // If the type of item is raw directory or file, use MatchDirPattern or FindBestMatch
         // to check if there are configs that match it.
         auto entName = ent.Name();
@@ -469,7 +447,7 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
 
         // Mainly for symbolic (Linux), we need to use stat to dig out the real type.
         fsutil::PathStat buf;
-        if (!fsutil::PathStat::stat(item, buf)) {
+        if (!StatPath(item, buf)) {
             LOG_DEBUG(sLogger, ("get file info error", item.c_str())("errno", errno));
             continue;
         }
@@ -528,7 +506,7 @@ bool PollingDirFile::PollingWildcardConfigPath(const FileDiscoveryConfig& pConfi
         // permission to access it, just return true to stop polling.
         string item = PathJoin(dirPath, pConfig.first->GetConstWildcardPaths()[depth]);
         fsutil::PathStat baseDirStat;
-        if (!fsutil::PathStat::stat(item, baseDirStat)) {
+        if (!StatPath(item, baseDirStat)) {
             LOG_DEBUG(sLogger,
                       ("get wildcard dir info error: ", pConfig.first->GetBasePath())("stat path", item)(
                           pConfig.second->GetProjectName(),
@@ -551,25 +529,12 @@ bool PollingDirFile::PollingWildcardConfigPath(const FileDiscoveryConfig& pConfi
 
     // Current part is not constant (normal) path, so we have to iterate and match one by one.
     bool hasMatchFlag = false;
-    fsutil::Dir dir(dirPath);
-    if (!dir.Open()) {
-        auto err = GetErrno();
-        if (fsutil::Dir::IsENOENT(err)) {
-            LOG_DEBUG(sLogger, ("Open dir fail, ENOENT, dir", dirPath.c_str()));
-            return false;
-        } else {
-            AlarmManager::GetInstance()->SendAlarm(LOGDIR_PERMINSSION_ALARM,
-                                                   string("Failed to open dir : ") + dirPath
-                                                       + ";\terrno : " + ToString(err),
-                                                   pConfig.second->GetProjectName(),
-                                                   pConfig.second->GetLogstoreName());
-            LOG_WARNING(sLogger, ("Open dir fail", dirPath.c_str())("errno", err));
-        }
-        return true;
+    auto listing = ListDir(dirPath, pConfig);
+    if (!listing->mOpened) {
+        return !fsutil::Dir::IsENOENT(listing->mErrno);
     }
-    fsutil::Entry ent;
     int32_t dirCount = 0;
-    while ((ent = dir.ReadNext(false))) {
+    for (const auto& ent : listing->mEntries) {
         if (!mRuningFlag || mHoldOnFlag)
             break;
 
@@ -587,25 +552,10 @@ bool PollingDirFile::PollingWildcardConfigPath(const FileDiscoveryConfig& pConfi
             break;
         }
 
-        if (++mStatCount % INT32_FLAG(dirfile_stat_count) == 0)
-            usleep(INT32_FLAG(dirfile_stat_sleep) * 1000);
-
-        if (mStatCount > INT32_FLAG(polling_max_stat_count)) {
-            LOG_WARNING(sLogger,
-                        ("total dir's polling stat count is exceeded",
-                         "")(dirPath, mStatCount)(pConfig.second->GetProjectName(), pConfig.second->GetLogstoreName()));
-            AlarmManager::GetInstance()->SendAlarm(
-                STAT_LIMIT_ALARM,
-                string("total dir's polling stat count is exceeded, total count:" + ToString(mStatCount)
-                       + " path: " + dirPath + " project:" + pConfig.second->GetProjectName()
-                       + " logstore:" + pConfig.second->GetLogstoreName()));
-            break;
-        }
-
         auto entName = ent.Name();
         string item = PathJoin(dirPath, entName);
         fsutil::PathStat buf;
-        if (!fsutil::PathStat::stat(item, buf)) {
+        if (!StatPath(item, buf)) {
             LOG_WARNING(sLogger, ("get file info fail", item.c_str())("errno", GetErrno()));
             continue;
         }
@@ -642,6 +592,105 @@ bool PollingDirFile::PollingWildcardConfigPath(const FileDiscoveryConfig& pConfi
     return hasMatchFlag;
 }
 
+shared_ptr<DirListingCache> PollingDirFile::ListDir(const string& dirPath, const FileDiscoveryConfig& pConfig) {
+    if (BOOL_FLAG(polling_dir_shared_scan)) {
+        auto iter = mRoundDirListings.find(dirPath);
+        if (iter != mRoundDirListings.end()) {
+            ++mRoundSharedScanHitCount;
+            return iter->second;
+        }
+    }
+
+    auto listing = make_shared<DirListingCache>();
+    fsutil::Dir dir(dirPath);
+    if (!dir.Open()) {
+        listing->mErrno = GetErrno();
+        if (fsutil::Dir::IsENOENT(listing->mErrno)) {
+            LOG_DEBUG(sLogger, ("Open dir error, ENOENT, dir", dirPath.c_str()));
+        } else {
+            AlarmManager::GetInstance()->SendAlarm(LOGDIR_PERMINSSION_ALARM,
+                                                   string("Failed to open dir : ") + dirPath
+                                                       + ";\terrno : " + ToString(listing->mErrno),
+                                                   pConfig.second->GetProjectName(),
+                                                   pConfig.second->GetLogstoreName());
+            LOG_ERROR(sLogger, ("Open dir error", dirPath.c_str())("error", ErrnoToString(listing->mErrno)));
+        }
+    } else {
+        listing->mOpened = true;
+        ++mRoundReaddirCount;
+        int32_t nowStatCount = 0;
+        fsutil::Entry ent;
+        while ((ent = dir.ReadNext(false))) {
+            if (!mRuningFlag || mHoldOnFlag)
+                break;
+
+            if (++mStatCount % INT32_FLAG(dirfile_stat_count) == 0) {
+                usleep(INT32_FLAG(dirfile_stat_sleep) * 1000);
+            }
+
+            if (mStatCount > INT32_FLAG(polling_max_stat_count)) {
+                LOG_WARNING(sLogger,
+                            ("total dir's polling stat count is exceeded", nowStatCount)(dirPath, mStatCount)(
+                                pConfig.second->GetProjectName(), pConfig.second->GetLogstoreName()));
+                AlarmManager::GetInstance()->SendAlarm(
+                    STAT_LIMIT_ALARM,
+                    string("total dir's polling stat count is exceeded, now count:") + ToString(nowStatCount)
+                        + " total count:" + ToString(mStatCount) + " path: " + dirPath + " project:"
+                        + pConfig.second->GetProjectName() + " logstore:" + pConfig.second->GetLogstoreName());
+                break;
+            }
+
+            if (++nowStatCount > INT32_FLAG(polling_max_stat_count_per_dir)) {
+                LOG_WARNING(sLogger,
+                            ("this dir's polling stat count is exceeded", nowStatCount)(dirPath, mStatCount)(
+                                pConfig.second->GetProjectName(), pConfig.second->GetLogstoreName()));
+                AlarmManager::GetInstance()->SendAlarm(
+                    STAT_LIMIT_ALARM,
+                    string("this dir's polling stat count is exceeded, now count:") + ToString(nowStatCount)
+                        + " total count:" + ToString(mStatCount) + " path: " + dirPath + " project:"
+                        + pConfig.second->GetProjectName() + " logstore:" + pConfig.second->GetLogstoreName(),
+                    pConfig.second->GetRegion());
+                break;
+            }
+            listing->mEntries.emplace_back(std::move(ent));
+        }
+    }
+
+    // Listings interrupted by stop or hold on are incomplete, they should not be reused.
+    if (BOOL_FLAG(polling_dir_shared_scan) && mRuningFlag && !mHoldOnFlag) {
+        mRoundDirListings.emplace(dirPath, listing);
+    }
+    return listing;
+}
+
+bool PollingDirFile::StatPath(const string& path, fsutil::PathStat& statBuf) {
+    if (!BOOL_FLAG(polling_dir_shared_scan)) {
+        ++mRoundStatCallCount;
+        return fsutil::PathStat::stat(path, statBuf);
+    }
+    auto iter = mRoundPathStats.find(path);
+    if (iter != mRoundPathStats.end()) {
+        ++mRoundSharedScanHitCount;
+        if (iter->second.first) {
+            statBuf = iter->second.second;
+        }
+        return iter->second.first;
+    }
+    ++mRoundStatCallCount;
+    bool res = fsutil::PathStat::stat(path, statBuf);
+    mRoundPathStats.emplace(path, make_pair(res, statBuf));
+    return res;
+}
+
+void PollingDirFile::ClearRoundCache() {
+    // Swap to release memory, the maps might be large after a round.
+    DirListingCacheMap().swap(mRoundDirListings);
+    PathStatCacheMap().swap(mRoundPathStats);
+    mRoundReaddirCount = 0;
+    mRoundStatCallCount = 0;
+    mRoundSharedScanHitCount = 0;
+}
+
 void PollingDirFile::ClearTimeoutFileAndDir() {
     int32_t curTime = (int32_t)time(NULL);
     static int32_t s_lastClearTime = 0;
@@ -26,10 +26,6 @@
 
 namespace logtail {
 
-namespace fsutil {
-    class PathStat;
-}
-
 class PollingDirFile : public LogRunnable {
 public:
     static PollingDirFile* GetInstance() {
@@ -51,6 +47,7 @@ public:
         mStatCount = 0;
         mNewFileVec.clear();
         mCurrentRound = 0;
+        ClearRoundCache();
     }
 
 private:
@@ -102,6 +99,20 @@ private:
                                       bool needFindBestMatch,
                                       bool exceedPreservedDirDepth);
 
+    // ListDir returns entries of @dirPath. When flag polling_dir_shared_scan is enabled, each directory
+    // is read from filesystem at most once per round, and later calls from other configs or
+    // containers reuse the entries. If the directory can not be opened, mOpened of the result
+    // is false and mErrno is set.
+    std::shared_ptr<DirListingCache> ListDir(const std::string& dirPath, const FileDiscoveryConfig& config);
+
+    // StatPath wraps fsutil::PathStat::stat, the result is reused in current round when
+    // flag polling_dir_shared_scan is enabled.
+    bool StatPath(const std::string& path, fsutil::PathStat& statBuf);
+
+    // ClearRoundCache clears directory listings and stat results of current round, as well as
+    // the round statistics.
+    void ClearRoundCache();
+
     // ClearUnavailableFileAndDir checks cache, remove unavailable items.
     // By default, it will be called every 20 rounds (flag check_not_exist_file_dir_round).
     void ClearUnavailableFileAndDir();
@@ -140,11 +151,23 @@ private:
     // The sequence number of current round, uint64_t is used to avoid overflow.
     uint64_t mCurrentRound;
 
+    // Directory listings and stat results shared by all configs in current round.
+    DirListingCacheMap mRoundDirListings;
+    PathStatCacheMap mRoundPathStats;
+    // Statistics of current round, exported after each round.
+    int32_t mRoundReaddirCount = 0;
+    int32_t mRoundStatCallCount = 0;
+    int32_t mRoundSharedScanHitCount = 0;
+
     IntGaugePtr mPollingDirCacheSize;
     IntGaugePtr mPollingFileCacheSize;
+    IntGaugePtr mPollingReaddirCount;
+    IntGaugePtr mPollingStatCount;
+    IntGaugePtr mPollingSharedScanHitCount;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class PollingUnittest;
+    friend class PollingDirFileUnittest;
 #endif
 };
 
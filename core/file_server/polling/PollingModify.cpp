@@ -20,6 +20,7 @@
 #endif
 #include <sys/stat.h>
 
+#include "common/ErrorUtil.h"
 #include "common/FileSystemUtil.h"
 #include "common/Flags.h"
 #include "common/StringTools.h"
@@ -33,6 +34,21 @@
 using namespace std;
 
 DEFINE_FLAG_INT32(modify_check_interval, "modify check interval ms", 1000);
+DEFINE_FLAG_INT32(modify_check_min_interval,
+                  "ms, files modified since last check are checked more often, down to this interval",
+                  250);
+DEFINE_FLAG_INT32(modify_check_max_interval,
+                  "ms, files not modified since last check are checked less often, up to this interval, which is also "
+                  "the worst latency to find a modification of an idle file. No more than modify_check_interval means "
+                  "no backoff",
+                  0);
+DEFINE_FLAG_INT32(modify_stat_max_count_per_round,
+                  "max files to stat in a round, files left are checked first in the next round",
+                  10000);
+DEFINE_FLAG_BOOL(polling_modify_io_uring_enable,
+                 "stat files of a batch with one io_uring syscall in modify polling, requires linux 5.6+, files are "
+                 "stated one by one if not available",
+                 false);
 DEFINE_FLAG_INT32(ignore_file_modify_timeout, "if file modify time is up to XXX seconds, ignore it", 180);
 DEFINE_FLAG_INT32(modify_stat_count, "sleep when dir file stat count up to", 100);
 DEFINE_FLAG_INT32(modify_stat_sleepMs, "sleep time when dir file stat up to 1000, ms", 10);
@@ -51,6 +67,8 @@ void PollingModify::Start() {
     ClearCache();
     mPollingModifySize
         = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(METRIC_RUNNER_FILE_POLLING_MODIFY_CACHE_SIZE);
+    mPollingModifyStatCount = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(
+        METRIC_RUNNER_FILE_POLLING_MODIFY_STAT_COUNT);
 
     mRuningFlag = true;
     mThreadPtr = CreateThread([this]() { Polling(); });
@@ -124,7 +142,7 @@ void PollingModify::MakeSpaceForNewFile() {
     }
     sort(sortedItemVec.begin(), sortedItemVec.end(), ModifySortItem::Compare);
     for (int i = 0; i < removeCount; ++i) {
-        mModifyCacheMap.erase(mModifyCacheMap.find(*(sortedItemVec[i].filePath)));
+        EraseFile(mModifyCacheMap.find(*(sortedItemVec[i].filePath)));
     }
 }
 
@@ -163,16 +181,77 @@ void PollingModify::LoadFileNameInQueues() {
         }
     }
     if (hasSpace) {
+        int64_t curTime = GetCurrentTimeInMilliSeconds();
         for (auto iter = newFileNameQueue.begin(); iter != newFileNameQueue.end(); ++iter) {
-            mModifyCacheMap[*iter];
+            auto res = mModifyCacheMap.emplace(*iter, ModifyCheckCache());
+            if (res.second) {
+                // new files are checked in this round
+                res.first->second.mCheckInterval = INT32_FLAG(modify_check_interval);
+                ScheduleCheck(&*res.first, curTime);
+            }
         }
     }
 
     for (auto iter = deletedFileNameQueue.begin(); iter != deletedFileNameQueue.end(); ++iter) {
-        mModifyCacheMap.erase(*iter);
+        auto item = mModifyCacheMap.find(*iter);
+        if (item != mModifyCacheMap.end()) {
+            EraseFile(item);
+        }
+    }
+}
+
+void PollingModify::StatFiles(size_t begin, size_t end) {
+    mStatPaths.clear();
+    for (size_t i = begin; i < end; ++i) {
+        mStatPaths.emplace_back(PathJoin(mDueFiles[i]->first.mFileDir, mDueFiles[i]->first.mFileName));
+    }
+
+    if (BOOL_FLAG(polling_modify_io_uring_enable) && !mIoUringUnavailable && !mIoUring.IsInit()) {
+        if (mIoUring.Init(max(INT32_FLAG(modify_stat_count), 1))) {
+            LOG_INFO(sLogger, ("polling modify stats files with io_uring", "enabled"));
+        } else {
+            LOG_WARNING(sLogger, ("io_uring is not available", "stat files one by one"));
+            mIoUringUnavailable = true;
+        }
+    } else if (!BOOL_FLAG(polling_modify_io_uring_enable) && mIoUring.IsInit()) {
+        mIoUring.Destroy();
+    }
+    if (mIoUring.IsInit()) {
+        if (mIoUring.Statx(mStatPaths, mStatResults)) {
+            return;
+        }
+        LOG_WARNING(sLogger, ("failed to stat files with io_uring", ErrnoToString(GetErrno()))("fall back to", "stat"));
+        mIoUring.Destroy();
+        mIoUringUnavailable = true;
+    }
+
+    mStatResults.assign(mStatPaths.size(), FileStatResult());
+    for (size_t i = 0; i < mStatPaths.size(); ++i) {
+        fsutil::PathStat logFileStat;
+        FileStatResult& result = mStatResults[i];
+        if (!fsutil::PathStat::stat(mStatPaths[i], logFileStat)) {
+            result.mErrno = errno;
+            continue;
+        }
+        auto devInode = logFileStat.GetDevInode();
+        result.mDev = devInode.dev;
+        result.mInode = devInode.inode;
+        result.mSize = logFileStat.GetFileSize();
+        logFileStat.GetLastWriteTime(result.mModifySec, result.mModifyNsec);
     }
 }
 
+void PollingModify::ScheduleCheck(ModifyCheckCacheMap::value_type* item, int64_t nextCheckTime) {
+    mCheckSchedule.erase(make_pair(item->second.mNextCheckTime, item));
+    item->second.mNextCheckTime = nextCheckTime;
+    mCheckSchedule.emplace(nextCheckTime, item);
+}
+
+void PollingModify::EraseFile(ModifyCheckCacheMap::iterator iter) {
+    mCheckSchedule.erase(make_pair(iter->second.mNextCheckTime, &*iter));
+    mModifyCacheMap.erase(iter);
+}
+
 bool PollingModify::UpdateFile(const SplitedFilePath& filePath,
                                ModifyCheckCache& modifyCache,
                                uint64_t dev,
@@ -247,58 +326,97 @@ void PollingModify::Polling() {
     while (mRuningFlag) {
         PollingIteration();
 
-        // Sleep for a while, by default, 1s.
-        for (int i = 0; i < 10 && mRuningFlag; ++i) {
-            usleep(INT32_FLAG(modify_check_interval) * 100);
+        // Sleep until the next file to check is due, by default, at most 1s.
+        int64_t sliceTime = max(INT32_FLAG(modify_check_interval) / 10, 1);
+        for (int64_t slept = 0; slept < mWaitTime && mRuningFlag; slept += sliceTime) {
+            usleep(min(sliceTime, mWaitTime - slept) * 1000);
         }
     }
     LOG_INFO(sLogger, ("PollingModify::Polling", "stop"));
 }
 
+// Files are checked in the order of their next check time rather than all in each round. Files modified recently are
+// checked more often. If modify_check_max_interval is set above modify_check_interval, idle files are checked with
+// exponential backoff, which saves stat calls on hosts with lots of idle files at the cost of their latency.
 void PollingModify::PollingIteration() {
     PTScopedLock threadLock(mPollingThreadLock);
     LoadFileNameInQueues();
 
-    vector<SplitedFilePath> deletedFileVec;
+    const int32_t checkInterval = INT32_FLAG(modify_check_interval);
+    const int32_t minInterval = min(INT32_FLAG(modify_check_min_interval), checkInterval);
+    const int32_t maxInterval = max(INT32_FLAG(modify_check_max_interval), checkInterval);
     vector<Event*> pollingEventVec;
     int32_t statCount = 0;
+    bool exceedStatLimit = false;
     mPollingModifySize->Set(mModifyCacheMap.size());
-    for (auto iter = mModifyCacheMap.begin(); iter != mModifyCacheMap.end(); ++iter) {
-        if (!mRuningFlag || mHoldOnFlag)
+    int64_t curTime = GetCurrentTimeInMilliSeconds();
+    mDueFiles.clear();
+    for (auto iter = mCheckSchedule.begin(); iter != mCheckSchedule.end() && iter->first <= curTime; ++iter) {
+        if (mDueFiles.size() >= (size_t)INT32_FLAG(modify_stat_max_count_per_round)) {
+            exceedStatLimit = true;
             break;
+        }
+        mDueFiles.push_back(iter->second);
+    }
 
-        const SplitedFilePath& filePath = iter->first;
-        ModifyCheckCache& modifyCache = iter->second;
-        fsutil::PathStat logFileStat;
-        if (!fsutil::PathStat::stat(PathJoin(filePath.mFileDir, filePath.mFileName), logFileStat)) {
-            if (errno == ENOENT) {
-                LOG_DEBUG(sLogger, ("file deleted", PathJoin(filePath.mFileDir, filePath.mFileName)));
-                if (UpdateDeletedFile(filePath, modifyCache, pollingEventVec)) {
-                    deletedFileVec.push_back(filePath);
+    // files are stated in batches of modify_stat_count, with a short sleep after each batch
+    const size_t batchSize = max(INT32_FLAG(modify_stat_count), 1);
+    for (size_t begin = 0; begin < mDueFiles.size(); begin += batchSize) {
+        if (!mRuningFlag || mHoldOnFlag)
+            break;
+        size_t end = min(begin + batchSize, mDueFiles.size());
+        StatFiles(begin, end);
+        for (size_t i = begin; i < end; ++i) {
+            ModifyCheckCacheMap::value_type* item = mDueFiles[i];
+            const SplitedFilePath& filePath = item->first;
+            ModifyCheckCache& modifyCache = item->second;
+            const FileStatResult& stat = mStatResults[i - begin];
+            if (stat.mErrno != 0) {
+                if (stat.mErrno == ENOENT) {
+                    LOG_DEBUG(sLogger, ("file deleted", mStatPaths[i - begin]));
+                    if (UpdateDeletedFile(filePath, modifyCache, pollingEventVec)) {
+                        EraseFile(mModifyCacheMap.find(filePath));
+                        continue;
+                    }
+                } else {
+                    LOG_DEBUG(sLogger, ("get file info error", mStatPaths[i - begin])("errno", stat.mErrno));
                 }
+                // keep the pace of checking missing files, so that deletion is found in time
+                modifyCache.mCheckInterval = checkInterval;
             } else {
-                LOG_DEBUG(sLogger, ("get file info error", PathJoin(filePath.mFileDir, filePath.mFileName)));
+                timespec mtim{stat.mModifySec, stat.mModifyNsec};
+                bool modified
+                    = UpdateFile(filePath, modifyCache, stat.mDev, stat.mInode, stat.mSize, mtim, pollingEventVec);
+                modifyCache.UpdateCheckInterval(modified, minInterval, maxInterval);
             }
-        } else {
-            int64_t sec, nsec;
-            logFileStat.GetLastWriteTime(sec, nsec);
-            timespec mtim{sec, nsec};
-            auto devInode = logFileStat.GetDevInode();
-            UpdateFile(
-                filePath, modifyCache, devInode.dev, devInode.inode, logFileStat.GetFileSize(), mtim, pollingEventVec);
+            ScheduleCheck(item, curTime + modifyCache.mCheckInterval);
         }
 
-        ++statCount;
-        if (statCount % INT32_FLAG(modify_stat_count) == 0) {
+        statCount += end - begin;
+        if (end - begin == batchSize) {
             usleep(1000 * INT32_FLAG(modify_stat_sleepMs));
         }
     }
+    mRoundStatCount = statCount;
+    mPollingModifyStatCount->Set(statCount);
+    if (exceedStatLimit) {
+        LOG_DEBUG(sLogger,
+                  ("modify polling stat count exceeds limit, check the rest next round",
+                   INT32_FLAG(modify_stat_max_count_per_round))("overdue files", mCheckSchedule.size()));
+    }
 
     if (pollingEventVec.size() > 0) {
         PollingEventQueue::GetInstance()->PushEvent(pollingEventVec);
     }
-    for (size_t i = 0; i < deletedFileVec.size(); ++i) {
-        mModifyCacheMap.erase(deletedFileVec[i]);
+
+    // overdue files are checked after the shortest interval
+    mWaitTime = checkInterval;
+    if (exceedStatLimit) {
+        mWaitTime = minInterval;
+    } else if (!mCheckSchedule.empty()) {
+        mWaitTime = min<int64_t>(max<int64_t>(mCheckSchedule.begin()->first - GetCurrentTimeInMilliSeconds(),
+                                              minInterval),
+                                 checkInterval);
     }
 }
 
@@ -17,9 +17,12 @@
 #pragma once
 #include <deque>
 #include <map>
+#include <set>
+#include <utility>
 #include <vector>
 
 #include "file_server/polling/PollingCache.h"
+#include "common/IoUring.h"
 #include "common/Lock.h"
 #include "common/LogRunnable.h"
 #include "common/Thread.h"
@@ -47,6 +50,7 @@ public:
     void ClearCache() {
         PTScopedLock lock(mFileLock);
         mModifyCacheMap.clear();
+        mCheckSchedule.clear();
         mNewFileNameQueue.clear();
         mDeletedFileNameQueue.clear();
     }
@@ -70,6 +74,13 @@ private:
     // LoadFileNameInQueues loads files from two queues.
     void LoadFileNameInQueues();
 
+    // StatFiles stats due files in [begin, end) into mStatResults, with io_uring if enabled.
+    void StatFiles(size_t begin, size_t end);
+    // ScheduleCheck sets when the file will be checked next time.
+    void ScheduleCheck(ModifyCheckCacheMap::value_type* item, int64_t nextCheckTime);
+    // EraseFile removes the file from modify cache and check schedule.
+    void EraseFile(ModifyCheckCacheMap::iterator iter);
+
     // UpdateFile updates corresponding cache of the file.
     // It compares the last state and current state of the file to decide if there is
     // a modification since last round.
@@ -101,11 +112,25 @@ private:
     std::deque<SplitedFilePath> mDeletedFileNameQueue;
 
     ModifyCheckCacheMap mModifyCacheMap;
+    // Files in modify cache ordered by next check time, the earliest first.
+    std::set<std::pair<int64_t, ModifyCheckCacheMap::value_type*>> mCheckSchedule;
+    // How long to sleep before next round, in milliseconds.
+    int64_t mWaitTime = 0;
+    int32_t mRoundStatCount = 0;
+    // buffers of current round
+    std::vector<ModifyCheckCacheMap::value_type*> mDueFiles;
+    std::vector<std::string> mStatPaths;
+    std::vector<FileStatResult> mStatResults;
+    IoUring mIoUring;
+    bool mIoUringUnavailable = false;
 
     IntGaugePtr mPollingModifySize;
+    IntGaugePtr mPollingModifyStatCount;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class PollingUnittest;
+    friend class PollingModifyUnittest;
+    friend class PollingModifyStatBenchmark;
     bool FindNewFile(const std::string& dir, const std::string& fileName);
 #endif
 };
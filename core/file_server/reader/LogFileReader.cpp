@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <boost/filesystem.hpp>
 #include <boost/regex.hpp>
+#include <functional>
 #include <limits>
 #include <numeric>
 #include <random>
@@ -48,6 +49,7 @@
 #include "logger/Logger.h"
 #include "monitor/AlarmManager.h"
 #include "monitor/metric_constants/MetricConstants.h"
+#include "monitor/metric_models/ScopedCpuTimer.h"
 #include "pipeline/queue/ExactlyOnceQueueManager.h"
 #include "pipeline/queue/ProcessQueueManager.h"
 #include "pipeline/queue/QueueKeyManager.h"
@@ -223,6 +225,7 @@ void LogFileReader::SetMetrics() {
     mOutSizeBytes = mMetricsRecordRef->GetCounter(METRIC_PLUGIN_OUT_SIZE_BYTES);
     mSourceSizeBytes = mMetricsRecordRef->GetIntGauge(METRIC_PLUGIN_SOURCE_SIZE_BYTES);
     mSourceReadOffsetBytes = mMetricsRecordRef->GetIntGauge(METRIC_PLUGIN_SOURCE_READ_OFFSET_BYTES);
+    mTotalCpuTimeMs = mMetricsRecordRef->GetTimeCounter(METRIC_PLUGIN_TOTAL_CPU_TIME_MS);
     mMetricInited = true;
 }
 
@@ -909,6 +912,7 @@ void LogFileReader::skipCheckpointRelayHole() {
 }
 
 bool LogFileReader::ReadLog(LogBuffer& logBuffer, const Event* event) {
+    ScopedCpuTimer<TimeCounterPtr> cpuTimer(mTotalCpuTimeMs);
     // when event is read timeout and the file cannot be opened, simply flush the cache.
     if (!mLogFileOp.IsOpen() && (event == nullptr || !event->IsReaderFlushTimeout())) {
         if (!ShouldForceReleaseDeletedFileFd()) {
@@ -2001,6 +2005,15 @@ LogFileReader::RemoveLastIncompleteLog(char* buffer, int32_t size, int32_t& roll
     if (!allowRollback || size == 0) {
         return size;
     }
+    // the first parser always handles raw text, which is where all the parsers find line boundaries
+    RawTextParser* rawParser = static_cast<RawTextParser*>(mLineParsers[0]);
+    rawParser->EnableBoundaryCache(StringView(buffer, size));
+    int32_t res = RemoveLastIncompleteLogWithCache(buffer, size, rollbackLineFeedCount);
+    rawParser->DisableBoundaryCache();
+    return res;
+}
+
+int32_t LogFileReader::RemoveLastIncompleteLogWithCache(char* buffer, int32_t size, int32_t& rollbackLineFeedCount) {
     int32_t endPs; // the position of \n or \0
     if (buffer[size - 1] == '\n') {
         endPs = size - 1;
@@ -2185,6 +2198,65 @@ StringBuffer* BaseLineParse::GetStringBuffer() {
     return &mStringBuffer;
 }
 
+// returns the position of the last '\n' in buffer[0, end), or -1 if not found. memrchr of glibc is vectorized and
+// picks the best implementation for the cpu at runtime, e.g., AVX2 or EVEX.
+static int32_t FindLastLineFeed(const char* buffer, int32_t end) {
+#if defined(__linux__)
+    const void* pos = memrchr(buffer, '\n', end);
+    return pos == nullptr ? -1 : static_cast<int32_t>(static_cast<const char*>(pos) - buffer);
+#else
+    for (int32_t i = end - 1; i >= 0; --i) {
+        if (buffer[i] == '\n') {
+            return i;
+        }
+    }
+    return -1;
+#endif
+}
+
+void RawTextParser::EnableBoundaryCache(StringView buffer) {
+    mCachedBuffer = buffer.data();
+    mCachedSize = buffer.size();
+    mScannedBegin = 0;
+    mScannedEnd = 0;
+    mLineFeeds.clear();
+}
+
+void RawTextParser::DisableBoundaryCache() {
+    mCachedBuffer = nullptr;
+    mCachedSize = 0;
+    mLineFeeds.clear();
+}
+
+int32_t RawTextParser::FindLineBegin(StringView buffer, int32_t end) {
+    if (buffer.data() != mCachedBuffer || buffer.size() != mCachedSize) {
+        return FindLastLineFeed(buffer.data(), end) + 1;
+    }
+    if (end > mScannedEnd) {
+        mLineFeeds.clear();
+        mScannedBegin = end;
+        mScannedEnd = end;
+    }
+    // the last one is the smallest, which is usually not less than end when lines are walked backwards
+    if (!mLineFeeds.empty() && mLineFeeds.back() < end) {
+        return *upper_bound(mLineFeeds.begin(), mLineFeeds.end(), end, greater<int32_t>()) + 1;
+    }
+    // no line feed in [mScannedBegin, end), continue scanning from where the last scan stopped
+    while (mScannedBegin > 0) {
+        int32_t pos = FindLastLineFeed(buffer.data(), mScannedBegin);
+        if (pos < 0) {
+            mScannedBegin = 0;
+            break;
+        }
+        mLineFeeds.push_back(pos);
+        mScannedBegin = pos;
+        if (pos < end) {
+            return pos + 1;
+        }
+    }
+    return 0;
+}
+
 LineInfo RawTextParser::GetLastLine(StringView buffer,
                                     int32_t end,
                                     size_t protocolFunctionIndex,
@@ -2197,17 +2269,9 @@ LineInfo RawTextParser::GetLastLine(StringView buffer,
         return {.data = StringView(), .lineBegin = 0, .lineEnd = 0, .rollbackLineFeedCount = 0, .fullLine = false};
     }
 
-    for (int32_t begin = end; begin > 0; --begin) {
-        if (begin == 0 || buffer[begin - 1] == '\n') {
-            return {.data = StringView(buffer.data() + begin, end - begin),
-                    .lineBegin = begin,
-                    .lineEnd = end,
-                    .rollbackLineFeedCount = 1,
-                    .fullLine = true};
-        }
-    }
-    return {.data = StringView(buffer.data(), end),
-            .lineBegin = 0,
+    int32_t begin = FindLineBegin(buffer, end);
+    return {.data = StringView(buffer.data() + begin, end - begin),
+            .lineBegin = begin,
             .lineEnd = end,
             .rollbackLineFeedCount = 1,
             .fullLine = true};
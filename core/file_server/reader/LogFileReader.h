@@ -109,6 +109,22 @@ public:
                          std::vector<BaseLineParse*>* lineParsers) override;
     LineInfo parse(StringView buffer, int32_t end, size_t protocolFunctionIndex);
     RawTextParser(size_t size) : BaseLineParse(size) {}
+
+    // caches line boundaries found in buffer until DisableBoundaryCache is called, so that repeated backward searches
+    // over the same buffer, e.g., during rollback, don't examine the same bytes again
+    void EnableBoundaryCache(StringView buffer);
+    void DisableBoundaryCache();
+
+private:
+    int32_t FindLineBegin(StringView buffer, int32_t end);
+
+    const char* mCachedBuffer = nullptr;
+    size_t mCachedSize = 0;
+    // bytes in [mScannedBegin, mScannedEnd) of the cached buffer have been examined, and positions of line feeds in
+    // the range are kept in descending order
+    int32_t mScannedBegin = 0;
+    int32_t mScannedEnd = 0;
+    std::vector<int32_t> mLineFeeds;
 };
 
 // Only get the currently written log file, it will choose the last modified file to read. There are several condition
@@ -542,6 +558,7 @@ protected:
     CounterPtr mOutSizeBytes;
     IntGaugePtr mSourceSizeBytes;
     IntGaugePtr mSourceReadOffsetBytes;
+    TimeCounterPtr mTotalCpuTimeMs;
 
 private:
     bool mHasReadContainerBom = false;
@@ -597,6 +614,8 @@ private:
     // @param fromCpt: if the read size is recoveried from checkpoint, set it to true.
     size_t getNextReadSize(int64_t fileEnd, bool& fromCpt);
 
+    // line boundaries found in buffer are cached by the raw text parser during the call
+    int32_t RemoveLastIncompleteLogWithCache(char* buffer, int32_t size, int32_t& rollbackLineFeedCount);
     LineInfo GetLastLine(StringView buffer, int32_t end, bool needSingleLine = false);
 
     // Update current checkpoint's read offset and length after success read.
@@ -690,6 +709,7 @@ private:
     friend class LastMatchedDockerJsonFileUnittest;
     friend class LastMatchedContainerdTextWithDockerJsonUnittest;
     friend class ForceReadUnittest;
+    friend class GetLastLineBenchmark;
 
 protected:
     void UpdateReaderManual();
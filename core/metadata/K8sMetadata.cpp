@@ -18,15 +18,39 @@
 #include <thread>
 
 #include "common/MachineInfoUtil.h"
+#include "common/http/AsynCurlRunner.h"
 #include "common/http/Curl.h"
 #include "common/http/HttpRequest.h"
 #include "common/http/HttpResponse.h"
 #include "logger/Logger.h"
+#include "metadata/K8sMetadataHttpRequest.h"
+#include "monitor/metric_constants/MetricConstants.h"
+
+DEFINE_FLAG_INT32(k8s_metadata_cache_ttl_sec, "ttl of k8s metadata cache entries", 600);
+DEFINE_FLAG_INT32(k8s_metadata_negative_cache_ttl_sec,
+                  "ttl of k8s metadata cache entries for keys not known by the operator",
+                  30);
 
 using namespace std;
 
 namespace logtail {
 
+K8sMetadata::K8sMetadata(size_t cacheSize) : containerCache(cacheSize), ipCache(cacheSize) {
+    mServiceHost = STRING_FLAG(loong_collector_operator_service);
+    mServicePort = INT32_FLAG(loong_collector_k8s_meta_service_port);
+
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
+        mMetricsRecordRef,
+        MetricCategory::METRIC_CATEGORY_COMPONENT,
+        {{METRIC_LABEL_KEY_COMPONENT_NAME, METRIC_LABEL_VALUE_COMPONENT_NAME_K8S_METADATA}});
+    mCacheHitTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_K8S_METADATA_CACHE_HIT_TOTAL);
+    mCacheMissTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_K8S_METADATA_CACHE_MISS_TOTAL);
+    mRefreshRequestsTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_K8S_METADATA_REFRESH_REQUESTS_TOTAL);
+    mRefreshFailedTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_K8S_METADATA_REFRESH_FAILED_TOTAL);
+    mTotalRefreshTimeMs = mMetricsRecordRef.CreateTimeCounter(METRIC_COMPONENT_K8S_METADATA_TOTAL_REFRESH_TIME_MS);
+    mPendingKeysCnt = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_K8S_METADATA_PENDING_KEYS);
+}
+
 size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
     ((std::string*)userp)->append((char*)contents, size * nmemb);
     return size * nmemb;
@@ -63,21 +87,6 @@ bool K8sMetadata::FromInfoJson(const Json::Value& json, k8sContainerInfo& info)
     return true;
 }
 
-bool ContainerInfoIsExpired(std::shared_ptr<k8sContainerInfo> info) {
-    if (info == nullptr) {
-        return false;
-    }
-    std::time_t now = std::time(0);
-    std::chrono::system_clock::time_point th1 = std::chrono::system_clock::from_time_t(info->timestamp);
-    std::chrono::system_clock::time_point th2 = std::chrono::system_clock::from_time_t(now);
-    std::chrono::duration<double> diff = th2 - th1;
-    double seconds_diff = diff.count();
-    if (seconds_diff > 600) { // 10 minutes in seconds
-        return true;
-    }
-    return false;
-}
-
 bool K8sMetadata::FromContainerJson(const Json::Value& json, std::shared_ptr<ContainerData> data) {
     if (!json.isObject()) {
         return false;
@@ -106,29 +115,11 @@ bool K8sMetadata::SendRequestToOperator(const std::string& urlHost,
         "GET", false, mServiceHost, mServicePort, path, "", map<std::string, std::string>(), output, 30, 3);
     bool success = SendHttpRequest(std::move(request), res);
     if (success) {
-        if (res.GetStatusCode() != 200) {
-            LOG_DEBUG(sLogger, ("fetch k8s meta from one operator fail, code is ", res.GetStatusCode()));
-            return false;
-        }
-        Json::CharReaderBuilder readerBuilder;
-        Json::CharReader* reader = readerBuilder.newCharReader();
         Json::Value root;
-        std::string errors;
-
-        auto& responseBody = *res.GetBody<std::string>();
-        if (reader->parse(responseBody.c_str(), responseBody.c_str() + responseBody.size(), &root, &errors)) {
-            if (infoType == containerInfoType::ContainerIdInfo) {
-                SetContainerCache(root);
-            } else {
-                SetIpCache(root);
-            }
-        } else {
-            LOG_DEBUG(sLogger, ("JSON parse error:", errors));
-            delete reader;
+        if (!ParseResponse(res, root)) {
             return false;
         }
-
-        delete reader;
+        SetCache(root, infoType);
         return true;
     } else {
         LOG_DEBUG(sLogger, ("fetch k8s meta from one operator fail", urlHost));
@@ -136,6 +127,23 @@ bool K8sMetadata::SendRequestToOperator(const std::string& urlHost,
     }
 }
 
+bool K8sMetadata::ParseResponse(HttpResponse& res, Json::Value& root) {
+    if (res.GetStatusCode() != 200) {
+        LOG_DEBUG(sLogger, ("fetch k8s meta from one operator fail, code is ", res.GetStatusCode()));
+        return false;
+    }
+    Json::CharReaderBuilder readerBuilder;
+    std::unique_ptr<Json::CharReader> reader(readerBuilder.newCharReader());
+    std::string errors;
+
+    auto& responseBody = *res.GetBody<std::string>();
+    if (!reader->parse(responseBody.c_str(), responseBody.c_str() + responseBody.size(), &root, &errors)) {
+        LOG_DEBUG(sLogger, ("JSON parse error:", errors));
+        return false;
+    }
+    return true;
+}
+
 bool K8sMetadata::GetByContainerIdsFromServer(std::vector<std::string> containerIds) {
     Json::Value jsonObj;
     for (auto& str : containerIds) {
@@ -161,29 +169,33 @@ void K8sMetadata::GetByLocalHostFromServer() {
 }
 
 void K8sMetadata::SetContainerCache(const Json::Value& root) {
+    SetCache(root, containerInfoType::ContainerIdInfo);
+}
+
+void K8sMetadata::SetIpCache(const Json::Value& root) {
+    SetCache(root, containerInfoType::IpInfo);
+}
+
+void K8sMetadata::SetCache(const Json::Value& root,
+                           containerInfoType infoType,
+                           const std::vector<std::string>* requestedKeys) {
+    auto& cache = infoType == containerInfoType::ContainerIdInfo ? containerCache : ipCache;
     std::shared_ptr<ContainerData> data = std::make_shared<ContainerData>();
-    if (data == nullptr) {
-        return;
-    }
     if (!FromContainerJson(root, data)) {
-        LOG_DEBUG(sLogger, ("from container json error:", "SetContainerCache"));
+        LOG_DEBUG(sLogger,
+                  ("from container json error:",
+                   infoType == containerInfoType::ContainerIdInfo ? "SetContainerCache" : "SetIpCache"));
     } else {
         for (const auto& pair : data->containers) {
-            containerCache.insert(pair.first, std::make_shared<k8sContainerInfo>(pair.second));
+            cache.Insert(pair.first, std::make_shared<k8sContainerInfo>(pair.second), INT32_FLAG(k8s_metadata_cache_ttl_sec));
         }
     }
-}
-
-void K8sMetadata::SetIpCache(const Json::Value& root) {
-    std::shared_ptr<ContainerData> data = std::make_shared<ContainerData>();
-    if (data == nullptr) {
+    if (requestedKeys == nullptr) {
         return;
     }
-    if (!FromContainerJson(root, data)) {
-        LOG_DEBUG(sLogger, ("from container json error:", "SetIpCache"));
-    } else {
-        for (const auto& pair : data->containers) {
-            ipCache.insert(pair.first, std::make_shared<k8sContainerInfo>(pair.second));
+    for (const auto& key : *requestedKeys) {
+        if (data->containers.find(key) == data->containers.end()) {
+            cache.Insert(key, nullptr, INT32_FLAG(k8s_metadata_negative_cache_ttl_sec));
         }
     }
 }
@@ -203,21 +215,128 @@ std::shared_ptr<k8sContainerInfo> K8sMetadata::GetInfoByContainerIdFromCache(con
     if (containerId.empty()) {
         return nullptr;
     }
-    return containerCache.get(containerId);
+    std::shared_ptr<k8sContainerInfo> info;
+    bool needRefresh = false;
+    containerCache.Get(containerId, info, needRefresh);
+    return info;
 }
 
 std::shared_ptr<k8sContainerInfo> K8sMetadata::GetInfoByIpFromCache(const std::string& ip) {
     if (ip.empty()) {
         return nullptr;
     }
-    std::shared_ptr<k8sContainerInfo> ip_info = ipCache.get(ip);
-    if (ip_info == nullptr) {
-        return nullptr;
+    std::shared_ptr<k8sContainerInfo> info;
+    bool needRefresh = false;
+    ipCache.Get(ip, info, needRefresh);
+    return info;
+}
+
+bool K8sMetadata::TryGetInfoByContainerIdFromCache(const std::string& containerId,
+                                                   std::shared_ptr<k8sContainerInfo>& info,
+                                                   bool& needRefresh) {
+    return TryGetInfoFromCache(containerCache, containerId, info, needRefresh);
+}
+
+bool K8sMetadata::TryGetInfoByIpFromCache(const std::string& ip,
+                                          std::shared_ptr<k8sContainerInfo>& info,
+                                          bool& needRefresh) {
+    return TryGetInfoFromCache(ipCache, ip, info, needRefresh);
+}
+
+bool K8sMetadata::TryGetInfoFromCache(K8sMetadataCache& cache,
+                                      const std::string& key,
+                                      std::shared_ptr<k8sContainerInfo>& info,
+                                      bool& needRefresh) {
+    needRefresh = false;
+    if (key.empty()) {
+        return false;
     }
-    if (ContainerInfoIsExpired(ip_info)) {
-        return nullptr;
+    if (cache.Get(key, info, needRefresh)) {
+        mCacheHitTotal->Add(1);
+        return true;
+    }
+    mCacheMissTotal->Add(1);
+    return false;
+}
+
+bool K8sMetadata::AsyncGetByContainerIdsFromServer(const std::vector<std::string>& containerIds) {
+    return SendAsyncRequestToOperator(containerIds, containerInfoType::ContainerIdInfo);
+}
+
+bool K8sMetadata::AsyncGetByIpsFromServer(const std::vector<std::string>& ips) {
+    return SendAsyncRequestToOperator(ips, containerInfoType::IpInfo);
+}
+
+bool K8sMetadata::SendAsyncRequestToOperator(const std::vector<std::string>& keys, containerInfoType infoType) {
+    // keys must not be marked pending unless the runner is there to finish the request
+    std::call_once(mAsynRunnerOnce, [this]() { mAsynRunnerStarted = AsynCurlRunner::GetInstance()->Init(); });
+    if (!mAsynRunnerStarted) {
+        mRefreshFailedTotal->Add(1);
+        return false;
+    }
+
+    std::vector<std::string> keysToFetch;
+    {
+        std::lock_guard<std::mutex> lock(mPendingMux);
+        auto& pending = mPendingKeys[static_cast<size_t>(infoType)];
+        for (const auto& key : keys) {
+            if (!key.empty() && pending.insert(key).second) {
+                keysToFetch.push_back(key);
+            }
+        }
+        mPendingKeysCnt->Set(mPendingKeys[0].size() + mPendingKeys[1].size());
+    }
+    if (keysToFetch.empty()) {
+        return true;
+    }
+
+    Json::Value jsonObj;
+    for (const auto& key : keysToFetch) {
+        jsonObj["keys"].append(key);
+    }
+    Json::StreamWriterBuilder writer;
+    std::string output = Json::writeString(writer, jsonObj);
+    std::string path = infoType == containerInfoType::IpInfo ? "/metadata/ip" : "/metadata/containerid";
+    auto request = std::make_unique<K8sMetadataHttpRequest>(
+        mServiceHost, mServicePort, path, output, std::move(keysToFetch), infoType, 30, 3);
+    mRefreshRequestsTotal->Add(1);
+    return AsynCurlRunner::GetInstance()->AddRequest(std::move(request));
+}
+
+void K8sMetadata::OnAsyncRequestDone(const std::vector<std::string>& keys,
+                                     containerInfoType infoType,
+                                     HttpResponse& response,
+                                     std::chrono::system_clock::time_point sendTime) {
+    mTotalRefreshTimeMs->Add(std::chrono::system_clock::now() - sendTime);
+    Json::Value root;
+    if (ParseResponse(response, root)) {
+        SetCache(root, infoType, &keys);
+    } else {
+        // keep the operator from being flooded with requests for the same keys while it is unavailable
+        mRefreshFailedTotal->Add(1);
+        auto& cache = infoType == containerInfoType::ContainerIdInfo ? containerCache : ipCache;
+        for (const auto& key : keys) {
+            std::shared_ptr<k8sContainerInfo> info;
+            bool needRefresh = false;
+            if (!cache.Get(key, info, needRefresh)) {
+                cache.Insert(key, nullptr, INT32_FLAG(k8s_metadata_negative_cache_ttl_sec));
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mPendingMux);
+    auto& pending = mPendingKeys[static_cast<size_t>(infoType)];
+    for (const auto& key : keys) {
+        pending.erase(key);
+    }
+    mPendingKeysCnt->Set(mPendingKeys[0].size() + mPendingKeys[1].size());
+}
+
+void K8sMetadata::Stop() {
+    if (mAsynRunnerStarted) {
+        AsynCurlRunner::GetInstance()->Stop();
+        mAsynRunnerStarted = false;
     }
-    return ip_info;
 }
 
 } // namespace logtail
@@ -12,12 +12,19 @@
 // See the License for the specific l
 #pragma once
 #include <iostream>
+#include <array>
+#include <chrono>
+#include <mutex>
 #include <string>
+#include <unordered_set>
+#include <vector>
 #include <curl/curl.h>
-#include "common/LRUCache.h"
 #include "app_config/AppConfig.h"
 #include <json/json.h>
 #include "common/Flags.h"
+#include "common/http/HttpResponse.h"
+#include "metadata/K8sMetadataCache.h"
+#include "monitor/MetricManager.h"
 
 DECLARE_FLAG_STRING(loong_collector_operator_service);
 DECLARE_FLAG_INT32(loong_collector_k8s_meta_service_port);
@@ -55,22 +62,37 @@ namespace logtail {
 
     class K8sMetadata {
         private:
-            lru11::Cache<std::string, std::shared_ptr<k8sContainerInfo>> containerCache;
-            lru11::Cache<std::string, std::shared_ptr<k8sContainerInfo>> ipCache;
+            K8sMetadataCache containerCache;
+            K8sMetadataCache ipCache;
             std::string mServiceHost;
             int32_t mServicePort;
-            K8sMetadata(size_t cacheSize)
-              : containerCache(cacheSize, 0), ipCache(cacheSize, 0){
-                mServiceHost = STRING_FLAG(loong_collector_operator_service);
-                mServicePort = INT32_FLAG(loong_collector_k8s_meta_service_port);
-              }
+
+            // keys being fetched in the background, indexed by containerInfoType
+            std::mutex mPendingMux;
+            std::array<std::unordered_set<std::string>, 2> mPendingKeys;
+            std::once_flag mAsynRunnerOnce;
+            bool mAsynRunnerStarted = false;
+
+            mutable MetricsRecordRef mMetricsRecordRef;
+            CounterPtr mCacheHitTotal;
+            CounterPtr mCacheMissTotal;
+            CounterPtr mRefreshRequestsTotal;
+            CounterPtr mRefreshFailedTotal;
+            TimeCounterPtr mTotalRefreshTimeMs;
+            IntGaugePtr mPendingKeysCnt;
+
+            K8sMetadata(size_t cacheSize);
             K8sMetadata(const K8sMetadata&) = delete;
             K8sMetadata& operator=(const K8sMetadata&) = delete;
 
             void SetIpCache(const Json::Value& root);
             void SetContainerCache(const Json::Value& root);
+            void SetCache(const Json::Value& root, containerInfoType infoType, const std::vector<std::string>* requestedKeys = nullptr);
             bool FromInfoJson(const Json::Value& json, k8sContainerInfo& info);
             bool FromContainerJson(const Json::Value& json, std::shared_ptr<ContainerData> data);
+            bool ParseResponse(HttpResponse& res, Json::Value& root);
+            bool SendAsyncRequestToOperator(const std::vector<std::string>& keys, containerInfoType infoType);
+            bool TryGetInfoFromCache(K8sMetadataCache& cache, const std::string& key, std::shared_ptr<k8sContainerInfo>& info, bool& needRefresh);
 
         public:
             static K8sMetadata& GetInstance() {
@@ -87,7 +109,22 @@ namespace logtail {
             // get info by ip from cache
             std::shared_ptr<k8sContainerInfo> GetInfoByIpFromCache(const std::string& ip);
             bool SendRequestToOperator(const std::string& urlHost, const std::string& output, containerInfoType infoType);
-    
+
+            // non-blocking counterparts of the methods above, used on processor threads. Keys already being fetched
+            // are skipped, and the cache is filled by the async curl runner when the response arrives. Keys missing
+            // from the response, or all keys if the request fails, are cached as negative entries for a while.
+            bool AsyncGetByContainerIdsFromServer(const std::vector<std::string>& containerIds);
+            bool AsyncGetByIpsFromServer(const std::vector<std::string>& ips);
+            // return false if the cache knows nothing about the key. Otherwise, info is null for a negative entry, and
+            // needRefresh is set if the entry should be prefetched before it expires.
+            bool TryGetInfoByContainerIdFromCache(const std::string& containerId, std::shared_ptr<k8sContainerInfo>& info, bool& needRefresh);
+            bool TryGetInfoByIpFromCache(const std::string& ip, std::shared_ptr<k8sContainerInfo>& info, bool& needRefresh);
+            void OnAsyncRequestDone(const std::vector<std::string>& keys,
+                                    containerInfoType infoType,
+                                    HttpResponse& response,
+                                    std::chrono::system_clock::time_point sendTime);
+            void Stop();
+
     #ifdef APSARA_UNIT_TEST_MAIN
         friend class k8sMetadataUnittest;
     #endif
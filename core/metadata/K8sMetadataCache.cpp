@@ -0,0 +1,100 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "metadata/K8sMetadataCache.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace logtail {
+
+// an entry is refreshed in advance once the last fifth of its ttl is reached
+static const double kRefreshAheadRatio = 0.8;
+// min interval between two background refreshes of the same entry
+static const time_t kRefreshRetryIntervalSec = 5;
+
+K8sMetadataCache::K8sMetadataCache(size_t maxSize, size_t shardCnt) {
+    shardCnt = max<size_t>(shardCnt, 1);
+    mShardMaxSize = max<size_t>((maxSize + shardCnt - 1) / shardCnt, 1);
+    mShards.reserve(shardCnt);
+    for (size_t i = 0; i < shardCnt; ++i) {
+        mShards.emplace_back(make_unique<Shard>());
+    }
+}
+
+bool K8sMetadataCache::Get(const string& key, shared_ptr<k8sContainerInfo>& info, bool& needRefresh) {
+    needRefresh = false;
+    auto& shard = GetShard(key);
+    time_t now = time(nullptr);
+    lock_guard<mutex> lock(shard.mMux);
+    auto it = shard.mIndex.find(key);
+    if (it == shard.mIndex.end()) {
+        return false;
+    }
+    auto& entry = *it->second;
+    if (now >= entry.mExpireTime) {
+        shard.mEntries.erase(it->second);
+        shard.mIndex.erase(it);
+        return false;
+    }
+    if (now >= entry.mRefreshTime) {
+        needRefresh = true;
+        entry.mRefreshTime = now + kRefreshRetryIntervalSec;
+    }
+    info = entry.mInfo;
+    shard.mEntries.splice(shard.mEntries.begin(), shard.mEntries, it->second);
+    return true;
+}
+
+void K8sMetadataCache::Insert(const string& key, const shared_ptr<k8sContainerInfo>& info, int64_t ttlSec) {
+    auto& shard = GetShard(key);
+    time_t now = time(nullptr);
+    lock_guard<mutex> lock(shard.mMux);
+    auto it = shard.mIndex.find(key);
+    if (it == shard.mIndex.end()) {
+        shard.mEntries.emplace_front();
+        shard.mEntries.front().mKey = key;
+        shard.mIndex[key] = shard.mEntries.begin();
+    } else {
+        shard.mEntries.splice(shard.mEntries.begin(), shard.mEntries, it->second);
+    }
+    auto& entry = shard.mEntries.front();
+    entry.mInfo = info;
+    entry.mExpireTime = now + ttlSec;
+    entry.mRefreshTime = now + static_cast<time_t>(ttlSec * kRefreshAheadRatio);
+    while (shard.mEntries.size() > mShardMaxSize) {
+        shard.mIndex.erase(shard.mEntries.back().mKey);
+        shard.mEntries.pop_back();
+    }
+}
+
+size_t K8sMetadataCache::Size() const {
+    size_t size = 0;
+    for (const auto& shard : mShards) {
+        lock_guard<mutex> lock(shard->mMux);
+        size += shard->mEntries.size();
+    }
+    return size;
+}
+
+void K8sMetadataCache::Clear() {
+    for (auto& shard : mShards) {
+        lock_guard<mutex> lock(shard->mMux);
+        shard->mEntries.clear();
+        shard->mIndex.clear();
+    }
+}
+
+} // namespace logtail
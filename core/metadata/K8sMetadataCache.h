@@ -0,0 +1,72 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <ctime>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace logtail {
+
+struct k8sContainerInfo;
+
+// LRU cache split into independently locked shards, so that lookups from processor threads and updates from the
+// async curl thread seldom contend. An entry with null info is a negative entry, i.e. the key is known to have no
+// metadata until the entry expires.
+class K8sMetadataCache {
+public:
+    explicit K8sMetadataCache(size_t maxSize, size_t shardCnt = 16);
+    K8sMetadataCache(const K8sMetadataCache&) = delete;
+    K8sMetadataCache& operator=(const K8sMetadataCache&) = delete;
+
+    // return false if the key is absent or expired. needRefresh is set when the entry is about to expire and should
+    // be fetched again in the background, and is set at most once every few seconds for the same entry.
+    bool Get(const std::string& key, std::shared_ptr<k8sContainerInfo>& info, bool& needRefresh);
+    void Insert(const std::string& key, const std::shared_ptr<k8sContainerInfo>& info, int64_t ttlSec);
+    size_t Size() const;
+    void Clear();
+
+private:
+    struct Entry {
+        std::string mKey;
+        std::shared_ptr<k8sContainerInfo> mInfo;
+        time_t mExpireTime = 0;
+        time_t mRefreshTime = 0;
+    };
+
+    struct Shard {
+        mutable std::mutex mMux;
+        std::list<Entry> mEntries;
+        std::unordered_map<std::string, std::list<Entry>::iterator> mIndex;
+    };
+
+    Shard& GetShard(const std::string& key) { return *mShards[std::hash<std::string>{}(key) % mShards.size()]; }
+
+    std::vector<std::unique_ptr<Shard>> mShards;
+    size_t mShardMaxSize = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class k8sMetadataUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -0,0 +1,44 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "metadata/K8sMetadataHttpRequest.h"
+
+#include <chrono>
+#include <map>
+#include <utility>
+
+using namespace std;
+
+namespace logtail {
+
+K8sMetadataHttpRequest::K8sMetadataHttpRequest(const string& host,
+                                               int32_t port,
+                                               const string& url,
+                                               const string& body,
+                                               vector<string>&& keys,
+                                               containerInfoType infoType,
+                                               uint32_t timeout,
+                                               uint32_t maxTryCnt)
+    : AsynHttpRequest(
+        "GET", false, host, port, url, "", map<string, string>(), body, HttpResponse(), timeout, maxTryCnt),
+      mKeys(std::move(keys)),
+      mInfoType(infoType) {
+    mEnqueTime = chrono::system_clock::now();
+}
+
+void K8sMetadataHttpRequest::OnSendDone(HttpResponse& response) {
+    K8sMetadata::GetInstance().OnAsyncRequestDone(mKeys, mInfoType, response, mEnqueTime);
+}
+
+} // namespace logtail
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/http/HttpRequest.h"
+#include "metadata/K8sMetadata.h"
+
+namespace logtail {
+
+class K8sMetadataHttpRequest : public AsynHttpRequest {
+public:
+    K8sMetadataHttpRequest(const std::string& host,
+                           int32_t port,
+                           const std::string& url,
+                           const std::string& body,
+                           std::vector<std::string>&& keys,
+                           containerInfoType infoType,
+                           uint32_t timeout,
+                           uint32_t maxTryCnt);
+    ~K8sMetadataHttpRequest() override = default;
+
+    void OnSendDone(HttpResponse& response) override;
+    [[nodiscard]] bool IsContextValid() const override { return true; }
+
+private:
+    std::vector<std::string> mKeys;
+    containerInfoType mInfoType;
+};
+
+} // namespace logtail
@@ -16,6 +16,7 @@
 
 #include "LabelingK8sMetadata.h"
 
+#include <algorithm>
 #include <vector>
 #include <string>
 #include "common/ParamExtractor.h"
@@ -37,23 +38,18 @@ void LabelingK8sMetadata::AddLabelToLogGroup(PipelineEventGroup& logGroup) {
     EventsContainer& events = logGroup.MutableEvents();
     std::vector<std::string> containerVec;
     std::vector<std::string> remoteIpVec;
-    std::vector<size_t>  cotainerNotTag;
     for (size_t rIdx = 0; rIdx < events.size(); ++rIdx) {
-        if (!ProcessEvent(events[rIdx], containerVec, remoteIpVec)) {
-            cotainerNotTag.push_back(rIdx);
-        }
+        ProcessEvent(events[rIdx], containerVec, remoteIpVec);
     }
+    // metadata is fetched in the background, so that the processor thread is never blocked by the operator. Events
+    // whose metadata is not cached yet are passed on without labels.
     auto& k8sMetadata = K8sMetadata::GetInstance();
-    if (containerVec.empty() || (!k8sMetadata.GetByContainerIdsFromServer(containerVec))) {
-        return;
-    }
-    if (remoteIpVec.empty() || (!k8sMetadata.GetByIpsFromServer(remoteIpVec))) {
-        return;
+    if (!containerVec.empty()) {
+        k8sMetadata.AsyncGetByContainerIdsFromServer(containerVec);
     }
-    for (size_t i = 0; i < cotainerNotTag.size(); ++i) {
-        ProcessEvent(events[i], containerVec, remoteIpVec);
+    if (!remoteIpVec.empty()) {
+        k8sMetadata.AsyncGetByIpsFromServer(remoteIpVec);
     }
-    return;
 }
 
 bool LabelingK8sMetadata::ProcessEvent(PipelineEventPtr& e, std::vector<std::string>& containerVec, std::vector<std::string>& remoteIpVec) {
@@ -79,11 +75,17 @@ bool LabelingK8sMetadata::AddLabels(Event& e, std::vector<std::string>& containe
     StringView containerIdView = e.HasTag(containerIdViewKey) ? e.GetTag(containerIdViewKey) : StringView{};
     if (!containerIdView.empty()) {
         std::string containerId(containerIdView);
-        std::shared_ptr<k8sContainerInfo> containerInfo = k8sMetadata.GetInfoByContainerIdFromCache(containerId);
-        if (containerInfo == nullptr) {
-            containerVec.push_back(containerId);
+        std::shared_ptr<k8sContainerInfo> containerInfo;
+        bool needRefresh = false;
+        // a negative entry is a hit with no info, and is not fetched again until it expires
+        bool hit = k8sMetadata.TryGetInfoByContainerIdFromCache(containerId, containerInfo, needRefresh);
+        if (!hit) {
             res = false;
-        } else {
+        }
+        if (!hit || needRefresh) {
+            AddKey(containerVec, containerId);
+        }
+        if (containerInfo != nullptr) {
             e.SetTag(workloadNameKey, containerInfo->workloadName);
             e.SetTag(workloadKindKey, containerInfo->workloadKind);
             e.SetTag(namespaceKey, containerInfo->k8sNamespace);
@@ -95,11 +97,16 @@ bool LabelingK8sMetadata::AddLabels(Event& e, std::vector<std::string>& containe
     StringView remoteIpView = e.HasTag(ipView) ? e.GetTag(ipView) : StringView{};
     if (!remoteIpView.empty()) {
         std::string remoteIp(remoteIpView);
-        std::shared_ptr<k8sContainerInfo> ipInfo = k8sMetadata.GetInfoByIpFromCache(remoteIp);
-        if (ipInfo == nullptr) {
-            remoteIpVec.push_back(remoteIp);
+        std::shared_ptr<k8sContainerInfo> ipInfo;
+        bool needRefresh = false;
+        bool hit = k8sMetadata.TryGetInfoByIpFromCache(remoteIp, ipInfo, needRefresh);
+        if (!hit) {
             res = false;
-        } else {
+        }
+        if (!hit || needRefresh) {
+            AddKey(remoteIpVec, remoteIp);
+        }
+        if (ipInfo != nullptr) {
             e.SetTag(peerWorkloadNameKey, ipInfo->workloadName);
             e.SetTag(peerWorkloadKindKey, ipInfo->workloadKind);
             e.SetTag(peerNamespaceKey, ipInfo->k8sNamespace);
@@ -108,6 +115,13 @@ bool LabelingK8sMetadata::AddLabels(Event& e, std::vector<std::string>& containe
     return res;
 }
 
+void LabelingK8sMetadata::AddKey(std::vector<std::string>& keys, const std::string& key) {
+    // events in the same group usually come from the same few containers
+    if (std::find(keys.begin(), keys.end(), key) == keys.end()) {
+        keys.push_back(key);
+    }
+}
+
 bool LabelingK8sMetadata::IsSupportedEvent(const PipelineEventPtr& e) const {
     return e.Is<MetricEvent>() || e.Is<SpanEvent>();
 }
@@ -29,6 +29,7 @@ namespace logtail {
 
     class LabelingK8sMetadata {
     public:
+        // label events with metadata in cache, and fetch metadata of the others in the background without blocking
         void AddLabelToLogGroup(PipelineEventGroup& logGroup);
         bool ProcessEvent(PipelineEventPtr& e,  std::vector<std::string>& container_vec,  std::vector<std::string>& remote_ip_vec);
         // 声明模板函数
@@ -36,6 +37,8 @@ namespace logtail {
         bool AddLabels(Event& e, std::vector<std::string>& containerVec, std::vector<std::string>& remoteIpVec);
     protected:
         bool IsSupportedEvent(const PipelineEventPtr& e) const;   
+    private:
+        static void AddKey(std::vector<std::string>& keys, const std::string& key);
     };
 
 } // namespace logtail
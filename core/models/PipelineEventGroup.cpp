@@ -16,6 +16,8 @@
 
 #include "models/PipelineEventGroup.h"
 
+#include <utility>
+
 #ifdef APSARA_UNIT_TEST_MAIN
 #include <sstream>
 #endif
@@ -39,7 +41,8 @@ void DestroyEvents(vector<PipelineEventPtr>&& events) {
     typename unordered_map<EventPool*, vector<T*>>::iterator cachedIt;
     bool firstEvent = true;
     for (auto& item : events) {
-        if (item && item.IsFromEventPool()) {
+        // shared events are only given back to pool by the last owner
+        if (item && item.IsFromEventPool() && item.TryUnshare()) {
             item->Reset();
             if (firstEvent || item.GetEventPool() != cachedPoolPtr) {
                 cachedPoolPtr = item.GetEventPool();
@@ -69,7 +72,7 @@ PipelineEventGroup::PipelineEventGroup(PipelineEventGroup&& rhs) noexcept
       mEvents(std::move(rhs.mEvents)),
       mSourceBuffer(std::move(rhs.mSourceBuffer)) {
     for (auto& item : mEvents) {
-        item->ResetPipelineEventGroup(this);
+        item.ResetPipelineEventGroup(this);
     }
 }
 
@@ -77,7 +80,7 @@ PipelineEventGroup::~PipelineEventGroup() {
     if (mEvents.empty() || !mEvents[0]) {
         return;
     }
-    switch (mEvents[0]->GetType()) {
+    switch (as_const(mEvents[0])->GetType()) {
         case PipelineEvent::Type::LOG:
             DestroyEvents<LogEvent>(std::move(mEvents));
             break;
@@ -102,7 +105,7 @@ PipelineEventGroup& PipelineEventGroup::operator=(PipelineEventGroup&& rhs) noex
         mEvents = std::move(rhs.mEvents);
         mSourceBuffer = std::move(rhs.mSourceBuffer);
         for (auto& item : mEvents) {
-            item->ResetPipelineEventGroup(this);
+            item.ResetPipelineEventGroup(this);
         }
     }
     return *this;
@@ -115,7 +118,20 @@ PipelineEventGroup PipelineEventGroup::Copy() const {
     res.mExactlyOnceCheckpoint = mExactlyOnceCheckpoint;
     for (auto& event : mEvents) {
         res.mEvents.emplace_back(event.Copy());
-        res.mEvents.back()->ResetPipelineEventGroup(&res);
+        res.mEvents.back().ResetPipelineEventGroup(&res);
+    }
+    return res;
+}
+
+PipelineEventGroup PipelineEventGroup::Share() {
+    PipelineEventGroup res(mSourceBuffer);
+    res.mMetadata = mMetadata;
+    res.mTags = mTags;
+    res.mExactlyOnceCheckpoint = mExactlyOnceCheckpoint;
+    res.mEvents.reserve(mEvents.size());
+    for (auto& event : mEvents) {
+        res.mEvents.emplace_back(event.Share());
+        res.mEvents.back().ResetPipelineEventGroup(&res);
     }
     return res;
 }
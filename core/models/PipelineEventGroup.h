@@ -78,6 +78,9 @@ public:
     PipelineEventGroup& operator=(PipelineEventGroup&&) noexcept;
 
     PipelineEventGroup Copy() const;
+    // events and source buffer are shared with the returned group and copied on write, while metadata and tags are
+    // copied so that they can be modified independently
+    PipelineEventGroup Share();
 
     std::unique_ptr<LogEvent> CreateLogEvent(bool fromPool = false, EventPool* pool = nullptr);
     std::unique_ptr<MetricEvent> CreateMetricEvent(bool fromPool = false, EventPool* pool = nullptr);
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <typeinfo>
 
@@ -28,7 +29,12 @@
 namespace logtail {
 class EventPool;
 
+class PipelineEventGroup;
+
 // only movable
+//
+// An event can be shared among several event groups (see PipelineEventGroup::Share), in which case it is read only for
+// all owners. Any mutable access to a shared event makes a private copy first, unless the caller is the last owner.
 class PipelineEventPtr {
 public:
     PipelineEventPtr() = default;
@@ -36,51 +42,139 @@ public:
         : mData(std::unique_ptr<PipelineEvent>(ptr)), mFromEventPool(fromPool), mEventPool(pool) {}
     PipelineEventPtr(std::unique_ptr<PipelineEvent>&& ptr, bool fromPool, EventPool* pool)
         : mData(std::move(ptr)), mFromEventPool(fromPool), mEventPool(pool) {}
+    PipelineEventPtr(PipelineEventPtr&& rhs) noexcept
+        : mData(std::move(rhs.mData)),
+          mSharedData(rhs.mSharedData),
+          mGroupPtr(rhs.mGroupPtr),
+          mFromEventPool(rhs.mFromEventPool),
+          mEventPool(rhs.mEventPool) {
+        rhs.mSharedData = nullptr;
+    }
+    PipelineEventPtr& operator=(PipelineEventPtr&& rhs) noexcept {
+        if (this != &rhs) {
+            ReleaseSharedData();
+            mData = std::move(rhs.mData);
+            mSharedData = rhs.mSharedData;
+            rhs.mSharedData = nullptr;
+            mGroupPtr = rhs.mGroupPtr;
+            mFromEventPool = rhs.mFromEventPool;
+            mEventPool = rhs.mEventPool;
+        }
+        return *this;
+    }
+    ~PipelineEventPtr() { ReleaseSharedData(); }
 
     template <typename T>
     bool Is() const {
         if (typeid(T) == typeid(LogEvent)) {
-            return mData->GetType() == PipelineEvent::Type::LOG;
+            return Data()->GetType() == PipelineEvent::Type::LOG;
         }
         if (typeid(T) == typeid(MetricEvent)) {
-            return mData->GetType() == PipelineEvent::Type::METRIC;
+            return Data()->GetType() == PipelineEvent::Type::METRIC;
         }
         if (typeid(T) == typeid(SpanEvent)) {
-            return mData->GetType() == PipelineEvent::Type::SPAN;
+            return Data()->GetType() == PipelineEvent::Type::SPAN;
         }
         if (typeid(T) == typeid(RawEvent)) {
-            return mData->GetType() == PipelineEvent::Type::RAW;
+            return Data()->GetType() == PipelineEvent::Type::RAW;
         }
         return false;
     }
     template <typename T>
     T& Cast() {
-        return *static_cast<T*>(mData.get());
+        return *static_cast<T*>(MutableData());
     }
     template <typename T>
     const T& Cast() const {
-        return *static_cast<const T*>(mData.get());
+        return *static_cast<const T*>(Data());
     }
     template <typename T>
     T* Get() {
-        return Is<T>() ? static_cast<T*>(mData.get()) : nullptr;
+        return Is<T>() ? static_cast<T*>(MutableData()) : nullptr;
     }
     template <typename T>
     const T* Get() const {
-        return Is<T>() ? static_cast<const T*>(mData.get()) : nullptr;
+        return Is<T>() ? static_cast<const T*>(Data()) : nullptr;
+    }
+    // for shared event, the share is dropped and nullptr is returned unless the caller is the last owner
+    PipelineEvent* Release() {
+        if (TryUnshare()) {
+            return mData.release();
+        }
+        ReleaseSharedData();
+        return nullptr;
     }
-    PipelineEvent* Release() { return mData.release(); }
 
-    operator bool() const { return static_cast<bool>(mData); }
-    PipelineEvent* operator->() { return mData.operator->(); }
-    const PipelineEvent* operator->() const { return mData.operator->(); }
+    operator bool() const { return mData || mSharedData; }
+    PipelineEvent* operator->() { return MutableData(); }
+    const PipelineEvent* operator->() const { return Data(); }
 
-    PipelineEventPtr Copy() const { return PipelineEventPtr(mData->Copy(), mFromEventPool, mEventPool); }
+    PipelineEventPtr Copy() const { return PipelineEventPtr(Data()->Copy(), mFromEventPool, mEventPool); }
     bool IsFromEventPool() const { return mFromEventPool; }
     EventPool* GetEventPool() const { return mEventPool; }
 
+    PipelineEventPtr Share() {
+        if (!mSharedData) {
+            mGroupPtr = mData->GetPipelineEventGroupPtr();
+            mSharedData = new SharedEvent(std::move(mData));
+        }
+        // a new owner can only be made by an existing one, so no ordering is needed
+        mSharedData->mOwnerCnt.fetch_add(1, std::memory_order_relaxed);
+        PipelineEventPtr res;
+        res.mSharedData = mSharedData;
+        res.mGroupPtr = mGroupPtr;
+        res.mFromEventPool = mFromEventPool;
+        res.mEventPool = mEventPool;
+        return res;
+    }
+    bool IsShared() const { return mSharedData != nullptr; }
+    // regain exclusive ownership without copy if this is the last owner of the shared event. The acquire load pairs
+    // with the release decrement of other owners, so that their reads of the event happen before it is modified here.
+    bool TryUnshare() {
+        if (mSharedData && mSharedData->mOwnerCnt.load(std::memory_order_acquire) == 1) {
+            mData = std::move(mSharedData->mData);
+            mData->ResetPipelineEventGroup(mGroupPtr);
+            delete mSharedData;
+            mSharedData = nullptr;
+        }
+        return !mSharedData;
+    }
+    void ResetPipelineEventGroup(PipelineEventGroup* ptr) {
+        if (mSharedData) {
+            // the shared event is read only, so the owner group is recorded here until it is copied on write
+            mGroupPtr = ptr;
+        } else if (mData) {
+            mData->ResetPipelineEventGroup(ptr);
+        }
+    }
+
 private:
+    struct SharedEvent {
+        explicit SharedEvent(std::unique_ptr<PipelineEvent>&& data) : mData(std::move(data)) {}
+
+        std::unique_ptr<PipelineEvent> mData;
+        std::atomic_size_t mOwnerCnt{1};
+    };
+
+    const PipelineEvent* Data() const { return mSharedData ? mSharedData->mData.get() : mData.get(); }
+    PipelineEvent* MutableData() {
+        if (!TryUnshare()) {
+            mData = mSharedData->mData->Copy();
+            mData->ResetPipelineEventGroup(mGroupPtr);
+            ReleaseSharedData();
+        }
+        return mData.get();
+    }
+    void ReleaseSharedData() {
+        if (mSharedData && mSharedData->mOwnerCnt.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete mSharedData;
+        }
+        mSharedData = nullptr;
+    }
+
     std::unique_ptr<PipelineEvent> mData;
+    SharedEvent* mSharedData = nullptr;
+    PipelineEventGroup* mGroupPtr = nullptr; // only valid for shared event
     bool mFromEventPool = false;
     EventPool* mEventPool = nullptr; // null means using processor runner threaded pool
 };
@@ -64,6 +64,7 @@ MetricsRecord* WriteMetrics::GetHead() {
 }
 
 void WriteMetrics::Clear() {
+    std::lock_guard<std::mutex> snapshotLock(mSnapshotMux);
     std::lock_guard<std::mutex> lock(mMutex);
     while (mHead) {
         MetricsRecord* toDeleted = mHead;
@@ -73,6 +74,7 @@ void WriteMetrics::Clear() {
 }
 
 MetricsRecord* WriteMetrics::DoSnapshot() {
+    std::lock_guard<std::mutex> snapshotLock(mSnapshotMux);
     // new read head
     MetricsRecord* snapshot = nullptr;
     MetricsRecord* toDeleteHead = nullptr;
@@ -153,6 +155,18 @@ MetricsRecord* WriteMetrics::DoSnapshot() {
     return snapshot;
 }
 
+void WriteMetrics::VisitRecords(const std::function<void(const MetricsRecord&)>& visitor) {
+    std::lock_guard<std::mutex> snapshotLock(mSnapshotMux);
+    // records are only unlinked when taking snapshot, and new ones are always inserted before the head
+    MetricsRecord* tmp = GetHead();
+    while (tmp) {
+        if (!tmp->IsDeleted()) {
+            visitor(*tmp);
+        }
+        tmp = tmp->GetNext();
+    }
+}
+
 ReadMetrics::~ReadMetrics() {
     Clear();
 }
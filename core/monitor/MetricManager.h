@@ -17,6 +17,7 @@
 #pragma once
 
 #include <atomic>
+#include <functional>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -35,6 +36,8 @@ private:
     WriteMetrics() = default;
     std::mutex mMutex;
     MetricsRecord* mHead = nullptr;
+    // held while taking snapshot, so that records are neither unlinked nor collected when visited
+    std::mutex mSnapshotMux;
 
     void Clear();
     MetricsRecord* GetHead();
@@ -56,6 +59,9 @@ public:
                                 DynamicMetricLabels&& dynamicLabels = {});
     void CommitMetricsRecordRef(MetricsRecordRef& ref);
     MetricsRecord* DoSnapshot();
+    // visit records not deleted without resetting them. the visitor should only copy values out, since no snapshot
+    // can be taken meanwhile.
+    void VisitRecords(const std::function<void(const MetricsRecord&)>& visitor);
 
 
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -37,6 +37,7 @@
 #include "go_pipeline/LogtailPlugin.h"
 #include "logger/Logger.h"
 #include "monitor/AlarmManager.h"
+#include "monitor/OpenMetricsServer.h"
 #include "monitor/SelfMonitorServer.h"
 #include "plugin/flusher/sls/FlusherSLS.h"
 #include "protobuf/sls/sls_logs.pb.h"
@@ -605,6 +606,7 @@ LoongCollectorMonitor::~LoongCollectorMonitor() {
 void LoongCollectorMonitor::Init() {
     LOG_INFO(sLogger, ("LoongCollector monitor", "started"));
     SelfMonitorServer::GetInstance()->Init();
+    OpenMetricsServer::GetInstance()->Init();
 
     // create metric record
     MetricLabels labels;
@@ -636,6 +638,7 @@ void LoongCollectorMonitor::Init() {
 }
 
 void LoongCollectorMonitor::Stop() {
+    OpenMetricsServer::GetInstance()->Stop();
     SelfMonitorServer::GetInstance()->Stop();
     LOG_INFO(sLogger, ("LoongCollector monitor", "stopped successfully"));
 }
@@ -0,0 +1,548 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "monitor/OpenMetricsServer.h"
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "common/Flags.h"
+#include "logger/Logger.h"
+#include "monitor/MetricManager.h"
+#include "monitor/metric_constants/MetricConstants.h"
+
+DEFINE_FLAG_INT32(self_monitor_openmetrics_port,
+                  "port of the local http endpoint serving self monitor metrics in openmetrics format, 0 means disabled",
+                  0);
+DEFINE_FLAG_STRING(self_monitor_openmetrics_address,
+                   "listen address of the local http endpoint serving self monitor metrics",
+                   "127.0.0.1");
+DEFINE_FLAG_INT32(self_monitor_openmetrics_min_render_interval_ms,
+                  "scrapes within the interval after the last rendering are served with the cached response",
+                  1000);
+
+using namespace std;
+
+namespace logtail {
+
+static const char* kMetricPrefix = "loongcollector_";
+static const char* kCounterType = "counter";
+static const char* kGaugeType = "gauge";
+static const char* kHistogramType = "histogram";
+static const char* kSummaryType = "summary";
+// le bounds of histograms in milliseconds
+static const uint64_t kHistogramBoundsMs[] = {1, 5, 10, 50, 100, 500, 1000, 5000, 10000};
+static const size_t kHistogramBoundCnt = sizeof(kHistogramBoundsMs) / sizeof(kHistogramBoundsMs[0]);
+static const pair<double, const char*> kQuantiles[] = {{0.5, "0.5"}, {0.9, "0.9"}, {0.99, "0.99"}};
+static const size_t kMaxRequestSize = 8192;
+static const int kPollTimeoutMs = 500;
+static const int kIOTimeoutMs = 1000;
+
+// ':' is only allowed in metric names, and label names must not start with a digit
+static void AppendName(string& res, const string& name, bool isLabel = false) {
+    if (isLabel && !name.empty() && name[0] >= '0' && name[0] <= '9') {
+        res += '_';
+    }
+    for (char c : name) {
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_'
+            || (c == ':' && !isLabel)) {
+            res += c;
+        } else {
+            res += '_';
+        }
+    }
+}
+
+static void AppendLabelValue(string& res, const string& value) {
+    for (char c : value) {
+        switch (c) {
+            case '\\':
+                res += "\\\\";
+                break;
+            case '"':
+                res += "\\\"";
+                break;
+            case '\n':
+                res += "\\n";
+                break;
+            default:
+                res += c;
+        }
+    }
+}
+
+static void AppendDouble(string& res, double val) {
+    char buf[32];
+    int len = snprintf(buf, sizeof(buf), "%.15g", val);
+    res.append(buf, len);
+}
+
+// labels end with ',' if not empty
+static void AppendSumAndCount(
+    string& samples, const string& familyName, const string& labels, double sum, uint64_t cnt) {
+    samples += familyName;
+    samples += "_sum{";
+    samples.append(labels.data(), labels.empty() ? 0 : labels.size() - 1);
+    samples += "} ";
+    AppendDouble(samples, sum);
+    samples += '\n';
+    samples += familyName;
+    samples += "_count{";
+    samples.append(labels.data(), labels.empty() ? 0 : labels.size() - 1);
+    samples += "} ";
+    samples += to_string(cnt);
+    samples += '\n';
+}
+
+OpenMetricsServer* OpenMetricsServer::GetInstance() {
+    static OpenMetricsServer* ptr = new OpenMetricsServer();
+    return ptr;
+}
+
+void OpenMetricsServer::Init() {
+#if defined(__linux__)
+    if (INT32_FLAG(self_monitor_openmetrics_port) <= 0) {
+        return;
+    }
+    lock_guard<mutex> lock(mThreadRunningMux);
+    if (mIsThreadRunning) {
+        return;
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(INT32_FLAG(self_monitor_openmetrics_port)));
+    if (inet_pton(AF_INET, STRING_FLAG(self_monitor_openmetrics_address).c_str(), &addr.sin_addr) != 1) {
+        LOG_WARNING(sLogger,
+                    ("failed to start openmetrics server", "invalid listen address")(
+                        "address", STRING_FLAG(self_monitor_openmetrics_address)));
+        return;
+    }
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        LOG_WARNING(sLogger, ("failed to start openmetrics server", "failed to create socket")("errno", errno));
+        return;
+    }
+    int opt = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(fd, 16) != 0) {
+        LOG_WARNING(sLogger,
+                    ("failed to start openmetrics server", "failed to listen")("errno", errno)(
+                        "port", INT32_FLAG(self_monitor_openmetrics_port)));
+        close(fd);
+        return;
+    }
+    mIsThreadRunning = true;
+    mThreadRes = async(launch::async, &OpenMetricsServer::Run, this, fd);
+    LOG_INFO(sLogger,
+             ("openmetrics server", "started")("address", STRING_FLAG(self_monitor_openmetrics_address))(
+                 "port", INT32_FLAG(self_monitor_openmetrics_port)));
+#endif
+}
+
+void OpenMetricsServer::Stop() {
+    {
+        lock_guard<mutex> lock(mThreadRunningMux);
+        if (!mIsThreadRunning) {
+            return;
+        }
+        mIsThreadRunning = false;
+    }
+    future_status s = mThreadRes.wait_for(chrono::milliseconds(kPollTimeoutMs * 2));
+    if (s == future_status::ready) {
+        LOG_INFO(sLogger, ("openmetrics server", "stopped successfully"));
+    } else {
+        LOG_WARNING(sLogger, ("openmetrics server", "forced to stopped"));
+    }
+}
+
+void OpenMetricsServer::Run(int listenFd) {
+#if defined(__linux__)
+    while (true) {
+        {
+            lock_guard<mutex> lock(mThreadRunningMux);
+            if (!mIsThreadRunning) {
+                break;
+            }
+        }
+        pollfd pfd{listenFd, POLLIN, 0};
+        if (poll(&pfd, 1, kPollTimeoutMs) <= 0) {
+            continue;
+        }
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+        HandleConnection(fd);
+        close(fd);
+    }
+    close(listenFd);
+#endif
+}
+
+void OpenMetricsServer::HandleConnection(int fd) {
+#if defined(__linux__)
+    // connections are served one by one, so that scrapes never render concurrently
+    char buf[kMaxRequestSize];
+    size_t size = 0;
+    while (size < sizeof(buf)) {
+        pollfd pfd{fd, POLLIN, 0};
+        if (poll(&pfd, 1, kIOTimeoutMs) <= 0) {
+            return;
+        }
+        ssize_t n = recv(fd, buf + size, sizeof(buf) - size, 0);
+        if (n <= 0) {
+            return;
+        }
+        size += n;
+        if (memmem(buf, size, "\r\n\r\n", 4) != nullptr) {
+            break;
+        }
+    }
+
+    auto matchPath = [&buf, size](const char* path) {
+        size_t len = strlen(path);
+        return size > len && memcmp(buf, path, len) == 0 && (buf[len] == ' ' || buf[len] == '?');
+    };
+    string body;
+    string header;
+    if (matchPath("GET /metrics")) {
+        body = GetResponseBody();
+        header = "HTTP/1.1 200 OK\r\nContent-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n";
+    } else if (matchPath("GET /debug/profile")) {
+        body = GetProfileBody();
+        header = "HTTP/1.1 200 OK\r\nContent-Type: text/plain; charset=utf-8\r\n";
+    } else {
+        body = "not found\n";
+        header = "HTTP/1.1 404 Not Found\r\nContent-Type: text/plain; charset=utf-8\r\n";
+    }
+    header += "Content-Length: " + to_string(body.size()) + "\r\nConnection: close\r\n\r\n";
+
+    for (const string* data : {&header, &body}) {
+        size_t sent = 0;
+        while (sent < data->size()) {
+            pollfd pfd{fd, POLLOUT, 0};
+            if (poll(&pfd, 1, kIOTimeoutMs) <= 0) {
+                return;
+            }
+            ssize_t n = send(fd, data->data() + sent, data->size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) {
+                return;
+            }
+            sent += n;
+        }
+    }
+#endif
+}
+
+string OpenMetricsServer::GetResponseBody() {
+    lock_guard<mutex> lock(mRenderMux);
+    auto now = chrono::steady_clock::now();
+    if (mBody.empty()
+        || now - mLastRenderTime >= chrono::milliseconds(INT32_FLAG(self_monitor_openmetrics_min_render_interval_ms))) {
+        CopyRecords();
+        Render();
+        mLastRenderTime = now;
+    }
+    return mBody;
+}
+
+string OpenMetricsServer::GetProfileBody() {
+    // pipeline name -> frame -> cpu time in ms
+    map<string, map<string, uint64_t>> pipelines;
+    WriteMetrics::GetInstance()->VisitRecords([&pipelines](const MetricsRecord& record) {
+        uint64_t cpuTimeMs = 0;
+        bool found = false;
+        for (const auto& item : record.GetTimeCounters()) {
+            if (item->GetName() == METRIC_PLUGIN_TOTAL_CPU_TIME_MS) {
+                cpuTimeMs += item->GetTotalValue();
+                found = true;
+            }
+        }
+        for (const auto& item : record.GetShardedTimeCounters()) {
+            if (item->GetName() == METRIC_PLUGIN_TOTAL_CPU_TIME_MS) {
+                cpuTimeMs += item->GetTotalValue();
+                found = true;
+            }
+        }
+        if (!found || !record.GetLabels()) {
+            return;
+        }
+        string pipeline, plugin, pluginID, component, flusherID;
+        for (const auto& label : *record.GetLabels()) {
+            if (label.first == METRIC_LABEL_KEY_PIPELINE_NAME) {
+                pipeline = label.second;
+            } else if (label.first == METRIC_LABEL_KEY_PLUGIN_TYPE) {
+                plugin = label.second;
+            } else if (label.first == METRIC_LABEL_KEY_PLUGIN_ID) {
+                pluginID = label.second;
+            } else if (label.first == METRIC_LABEL_KEY_COMPONENT_NAME) {
+                component = label.second;
+            } else if (label.first == METRIC_LABEL_KEY_FLUSHER_PLUGIN_ID) {
+                flusherID = label.second;
+            }
+        }
+        if (pipeline.empty()) {
+            return;
+        }
+        // records of input files are merged into the input plugin, and components are placed under their flusher
+        string frame;
+        if (!plugin.empty()) {
+            frame = plugin + "/" + pluginID;
+        } else if (!component.empty()) {
+            frame = flusherID.empty() ? component : "flusher/" + flusherID + ";" + component;
+        } else {
+            return;
+        }
+        pipelines[pipeline][frame] += cpuTimeMs;
+    });
+
+    vector<pair<uint64_t, const string*>> pipelineRank;
+    for (const auto& pipeline : pipelines) {
+        uint64_t total = 0;
+        for (const auto& frame : pipeline.second) {
+            total += frame.second;
+        }
+        pipelineRank.emplace_back(total, &pipeline.first);
+    }
+    sort(pipelineRank.begin(), pipelineRank.end(), [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+    string body;
+    vector<pair<uint64_t, const string*>> frameRank;
+    for (const auto& pipeline : pipelineRank) {
+        frameRank.clear();
+        for (const auto& frame : pipelines[*pipeline.second]) {
+            if (frame.second > 0) {
+                frameRank.emplace_back(frame.second, &frame.first);
+            }
+        }
+        sort(frameRank.begin(), frameRank.end(), [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+        for (const auto& frame : frameRank) {
+            body += *pipeline.second;
+            body += ';';
+            body += *frame.second;
+            body += ' ';
+            body += to_string(frame.first);
+            body += '\n';
+        }
+    }
+    return body;
+}
+
+void OpenMetricsServer::CopyRecords() {
+    // only values are copied here, since snapshots are blocked meanwhile
+    mRecordCnt = 0;
+    WriteMetrics::GetInstance()->VisitRecords([this](const MetricsRecord& record) {
+        if (mRecordCnt == mRecords.size()) {
+            mRecords.emplace_back();
+        }
+        CopyRecord(record, mRecords[mRecordCnt++]);
+    });
+}
+
+void OpenMetricsServer::CopyRecord(const MetricsRecord& record, RecordValues& values) {
+    values.mCategory = record.GetCategory();
+    values.mLabels.clear();
+    values.mCounters.clear();
+    values.mGauges.clear();
+    if (record.GetLabels()) {
+        values.mLabels.insert(values.mLabels.end(), record.GetLabels()->begin(), record.GetLabels()->end());
+    }
+    if (record.GetDynamicLabels()) {
+        for (const auto& item : *record.GetDynamicLabels()) {
+            values.mLabels.emplace_back(item.first, item.second());
+        }
+    }
+    for (const auto& item : record.GetCounters()) {
+        values.mCounters.emplace_back(item->GetName(), item->GetTotalValue());
+    }
+    for (const auto& item : record.GetTimeCounters()) {
+        values.mCounters.emplace_back(item->GetName(), item->GetTotalValue());
+    }
+    for (const auto& item : record.GetShardedCounters()) {
+        values.mCounters.emplace_back(item->GetName(), item->GetTotalValue());
+    }
+    for (const auto& item : record.GetShardedTimeCounters()) {
+        values.mCounters.emplace_back(item->GetName(), item->GetTotalValue());
+    }
+    for (const auto& item : record.GetIntGauges()) {
+        values.mGauges.emplace_back(item->GetName(), static_cast<double>(item->GetValue()));
+    }
+    for (const auto& item : record.GetDoubleGauges()) {
+        values.mGauges.emplace_back(item->GetName(), item->GetValue());
+    }
+    values.mHistograms.resize(record.GetHistograms().size());
+    for (size_t i = 0; i < record.GetHistograms().size(); ++i) {
+        const auto& histogram = record.GetHistograms()[i];
+        auto& counts = values.mHistograms[i].mCounts;
+        values.mHistograms[i].mName = histogram->GetName();
+        values.mHistograms[i].mSum = histogram->GetTotalSum();
+        counts.assign(kHistogramBoundCnt + 1, 0);
+        mBuckets.assign(Histogram::kBucketCnt, 0);
+        histogram->GetTotalBuckets(mBuckets);
+        auto& quantiles = values.mHistograms[i].mQuantiles;
+        quantiles.clear();
+        for (const auto& quantile : kQuantiles) {
+            quantiles.push_back(Histogram::GetQuantile(mBuckets, quantile.first));
+        }
+        // buckets are recorded in microseconds, and each one is counted in the first le bound covering it
+        size_t bound = 0;
+        for (size_t j = 0; j < mBuckets.size(); ++j) {
+            while (bound < kHistogramBoundCnt && Histogram::GetBucketUpperBound(j) > kHistogramBoundsMs[bound] * 1000) {
+                ++bound;
+            }
+            counts[bound] += mBuckets[j];
+        }
+        for (size_t j = 1; j < counts.size(); ++j) {
+            counts[j] += counts[j - 1];
+        }
+    }
+}
+
+OpenMetricsServer::Family* OpenMetricsServer::GetFamily(const string& name, const char* type) {
+    auto& family = mFamilies[name];
+    if (family.mType == nullptr || family.mSamples.empty()) {
+        family.mType = type;
+    } else if (family.mType != type) {
+        // samples of the same name but different types cannot be exposed in one family
+        return nullptr;
+    }
+    return &family;
+}
+
+void OpenMetricsServer::Render() {
+    // samples of the same family must be grouped together, so they are rendered per family first
+    for (auto& item : mFamilies) {
+        item.second.mSamples.clear();
+    }
+    string familyName;
+    string labels;
+    for (size_t i = 0; i < mRecordCnt; ++i) {
+        const auto& values = mRecords[i];
+        labels.clear();
+        for (const auto& label : values.mLabels) {
+            AppendName(labels, label.first, true);
+            labels += "=\"";
+            AppendLabelValue(labels, label.second);
+            labels += "\",";
+        }
+        string prefix = kMetricPrefix;
+        AppendName(prefix, values.mCategory);
+        prefix += '_';
+
+        for (const auto& counter : values.mCounters) {
+            familyName = prefix;
+            AppendName(familyName, counter.first);
+            if (familyName.size() > 6 && familyName.compare(familyName.size() - 6, 6, "_total") == 0) {
+                familyName.resize(familyName.size() - 6);
+            }
+            auto family = GetFamily(familyName, kCounterType);
+            if (family == nullptr) {
+                continue;
+            }
+            auto& samples = family->mSamples;
+            samples += familyName;
+            samples += "_total{";
+            samples.append(labels.data(), labels.empty() ? 0 : labels.size() - 1);
+            samples += "} ";
+            samples += to_string(counter.second);
+            samples += '\n';
+        }
+        for (const auto& gauge : values.mGauges) {
+            familyName = prefix;
+            AppendName(familyName, gauge.first);
+            auto family = GetFamily(familyName, kGaugeType);
+            if (family == nullptr) {
+                continue;
+            }
+            auto& samples = family->mSamples;
+            samples += familyName;
+            samples += '{';
+            samples.append(labels.data(), labels.empty() ? 0 : labels.size() - 1);
+            samples += "} ";
+            AppendDouble(samples, gauge.second);
+            samples += '\n';
+        }
+        for (const auto& histogram : values.mHistograms) {
+            familyName = prefix;
+            AppendName(familyName, histogram.mName);
+            auto family = GetFamily(familyName, kHistogramType);
+            if (family == nullptr) {
+                continue;
+            }
+            auto& samples = family->mSamples;
+            const auto& counts = histogram.mCounts;
+            for (size_t j = 0; j < counts.size(); ++j) {
+                samples += familyName;
+                samples += "_bucket{";
+                samples += labels;
+                samples += "le=\"";
+                if (j < kHistogramBoundCnt) {
+                    samples += to_string(kHistogramBoundsMs[j]);
+                    samples += ".0";
+                } else {
+                    samples += "+Inf";
+                }
+                samples += "\"} ";
+                samples += to_string(counts[j]);
+                samples += '\n';
+            }
+            AppendSumAndCount(samples, familyName, labels, histogram.mSum, counts.back());
+
+            familyName += "_summary";
+            family = GetFamily(familyName, kSummaryType);
+            if (family == nullptr) {
+                continue;
+            }
+            auto& summarySamples = family->mSamples;
+            for (size_t j = 0; j < histogram.mQuantiles.size(); ++j) {
+                summarySamples += familyName;
+                summarySamples += '{';
+                summarySamples += labels;
+                summarySamples += "quantile=\"";
+                summarySamples += kQuantiles[j].second;
+                summarySamples += "\"} ";
+                AppendDouble(summarySamples, histogram.mQuantiles[j]);
+                summarySamples += '\n';
+            }
+            AppendSumAndCount(summarySamples, familyName, labels, histogram.mSum, counts.back());
+        }
+    }
+
+    mBody.clear();
+    for (const auto& item : mFamilies) {
+        if (item.second.mSamples.empty()) {
+            continue;
+        }
+        mBody += "# TYPE ";
+        mBody += item.first;
+        mBody += ' ';
+        mBody += item.second.mType;
+        mBody += '\n';
+        mBody += item.second.mSamples;
+    }
+    mBody += "# EOF\n";
+}
+
+} // namespace logtail
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace logtail {
+
+class MetricsRecord;
+
+// Serves cumulative values of all self monitor metric records in OpenMetrics text format on a local http endpoint, so
+// that they can be scraped by Prometheus compatible collectors. Values are copied out while snapshots are blocked and
+// formatted afterwards, and the rendered response is reused for scrapes arriving within the min render interval.
+// Histograms are also exposed as summaries of their p50, p90 and p99, named with suffix _summary. A cpu profile summary
+// per pipeline is also served on the same endpoint.
+class OpenMetricsServer {
+public:
+    OpenMetricsServer(const OpenMetricsServer&) = delete;
+    OpenMetricsServer& operator=(const OpenMetricsServer&) = delete;
+    static OpenMetricsServer* GetInstance();
+
+    void Init();
+    void Stop();
+
+    // return the rendered metrics, which may be cached
+    std::string GetResponseBody();
+    // return cpu time of plugins and components since start in folded stack format, i.e., one
+    // "pipeline;plugin cpu_time_ms" line per plugin, ranked by cpu time, which can be fed to flame graph tools directly
+    std::string GetProfileBody();
+
+private:
+    struct HistogramValues {
+        std::string mName;
+        // cumulative counts of each le bound
+        std::vector<uint64_t> mCounts;
+        double mSum = 0;
+        std::vector<double> mQuantiles;
+    };
+
+    // values of one metric record
+    struct RecordValues {
+        std::string mCategory;
+        std::vector<std::pair<std::string, std::string>> mLabels;
+        std::vector<std::pair<std::string, uint64_t>> mCounters;
+        std::vector<std::pair<std::string, double>> mGauges;
+        std::vector<HistogramValues> mHistograms;
+    };
+
+    struct Family {
+        const char* mType = nullptr;
+        std::string mSamples;
+    };
+
+    OpenMetricsServer() = default;
+    ~OpenMetricsServer() = default;
+
+    void Run(int listenFd);
+    void HandleConnection(int fd);
+    void CopyRecords();
+    void CopyRecord(const MetricsRecord& record, RecordValues& values);
+    void Render();
+    Family* GetFamily(const std::string& name, const char* type);
+
+    std::future<void> mThreadRes;
+    std::mutex mThreadRunningMux;
+    bool mIsThreadRunning = false;
+
+    std::mutex mRenderMux;
+    std::chrono::steady_clock::time_point mLastRenderTime;
+    // buffers below are kept across renders to save allocations
+    std::vector<RecordValues> mRecords;
+    size_t mRecordCnt = 0;
+    std::vector<uint64_t> mBuckets;
+    std::map<std::string, Family> mFamilies;
+    std::string mBody;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class OpenMetricsServerUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -19,7 +19,9 @@
 #include "Monitor.h"
 #include "PipelineManager.h"
 #include "common/LogtailCommonFlags.h"
-#include "runner/ProcessorRunner.h"
+#include "pipeline/limiter/MemoryBudget.h"
+#include "pipeline/queue/ProcessQueueItem.h"
+#include "pipeline/queue/ProcessQueueManager.h"
 
 using namespace std;
 
@@ -106,8 +108,16 @@ void SelfMonitorServer::SendMetrics() {
         = PipelineManager::GetInstance()->FindConfigByName(mMetricPipelineCtx->GetConfigName());
     if (pipeline.get() != nullptr) {
         if (pipelineEventGroup.GetEvents().size() > 0) {
-            ProcessorRunner::GetInstance()->PushQueue(
-                pipeline->GetContext().GetProcessQueueKey(), 0, std::move(pipelineEventGroup));
+            // not retried, since metrics of the next round will be sent soon
+            QueueKey key = pipeline->GetContext().GetProcessQueueKey();
+            int res = ProcessQueueManager::GetInstance()->PushQueue(
+                key, make_unique<ProcessQueueItem>(std::move(pipelineEventGroup), 0));
+            if (res != 0) {
+                LOG_WARNING(sLogger, ("failed to push self monitor metrics to process queue, discard data", res));
+                if (res == 3) {
+                    MemoryBudget::GetInstance()->AddDiscardedGroups(1);
+                }
+            }
         }
     }
 }
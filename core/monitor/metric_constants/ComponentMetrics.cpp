@@ -36,7 +36,11 @@ const string METRIC_LABEL_KEY_GROUP_BATCH_ENABLED = "group_batch_enabled";
 
 // label values
 const string METRIC_LABEL_VALUE_COMPONENT_NAME_BATCHER = "batcher";
+const string METRIC_LABEL_VALUE_COMPONENT_NAME_BUFFER_POOL = "buffer_pool";
+const string METRIC_LABEL_VALUE_COMPONENT_NAME_CHUNK_POOL = "chunk_pool";
 const string METRIC_LABEL_VALUE_COMPONENT_NAME_COMPRESSOR = "compressor";
+const string METRIC_LABEL_VALUE_COMPONENT_NAME_K8S_METADATA = "k8s_metadata";
+const string METRIC_LABEL_VALUE_COMPONENT_NAME_MEMORY_BUDGET = "memory_budget";
 const string METRIC_LABEL_VALUE_COMPONENT_NAME_PROCESS_QUEUE = "process_queue";
 const string METRIC_LABEL_VALUE_COMPONENT_NAME_ROUTER = "router";
 const string METRIC_LABEL_VALUE_COMPONENT_NAME_SENDER_QUEUE = "sender_queue";
@@ -51,8 +55,11 @@ const string& METRIC_COMPONENT_OUT_ITEMS_TOTAL = METRIC_OUT_ITEMS_TOTAL;
 const string& METRIC_COMPONENT_OUT_SIZE_BYTES = METRIC_OUT_SIZE_BYTES;
 const string& METRIC_COMPONENT_TOTAL_DELAY_MS = METRIC_TOTAL_DELAY_MS;
 const string& METRIC_COMPONENT_TOTAL_PROCESS_TIME_MS = METRIC_TOTAL_PROCESS_TIME_MS;
+const string& METRIC_COMPONENT_TOTAL_CPU_TIME_MS = METRIC_TOTAL_CPU_TIME_MS;
 const string& METRIC_COMPONENT_DISCARDED_ITEMS_TOTAL = METRIC_DISCARDED_ITEMS_TOTAL;
 const string& METRIC_COMPONENT_DISCARDED_SIZE_BYTES = METRIC_DISCARDED_SIZE_BYTES;
+const string METRIC_COMPONENT_DELAY_MS = "delay_ms";
+const string METRIC_COMPONENT_PROCESS_TIME_MS = "process_time_ms";
 
 /**********************************************************
  *   batcher
@@ -62,6 +69,49 @@ const string METRIC_COMPONENT_BATCHER_BUFFERED_GROUPS_TOTAL = "buffered_groups_t
 const string METRIC_COMPONENT_BATCHER_BUFFERED_EVENTS_TOTAL = "buffered_events_total";
 const string METRIC_COMPONENT_BATCHER_BUFFERED_SIZE_BYTES = "buffered_size_bytes";
 const string METRIC_COMPONENT_BATCHER_TOTAL_ADD_TIME_MS = "total_add_time_ms";
+const string METRIC_COMPONENT_BATCHER_SHARD_HASH_KEYS_TOTAL = "shard_hash_keys_total";
+const string METRIC_COMPONENT_BATCHER_MAX_SHARD_HASH_KEY_BATCHES_TOTAL = "max_shard_hash_key_batches_total";
+const string METRIC_COMPONENT_BATCHER_TARGET_SIZE_BYTES = "target_size_bytes";
+const string METRIC_COMPONENT_BATCHER_TARGET_CNT = "target_cnt";
+
+/**********************************************************
+ *   buffer pool
+ **********************************************************/
+const string METRIC_COMPONENT_BUFFER_POOL_POOLED_BUFFERS_TOTAL = "pooled_buffers_total";
+const string METRIC_COMPONENT_BUFFER_POOL_POOLED_SIZE_BYTES = "pooled_size_bytes";
+const string METRIC_COMPONENT_BUFFER_POOL_REUSED_BUFFERS_TOTAL = "reused_buffers_total";
+const string METRIC_COMPONENT_BUFFER_POOL_ALLOCATED_BUFFERS_TOTAL = "allocated_buffers_total";
+const string METRIC_COMPONENT_BUFFER_POOL_DISCARDED_BUFFERS_TOTAL = "discarded_buffers_total";
+
+/**********************************************************
+ *   chunk pool
+ **********************************************************/
+const string METRIC_COMPONENT_CHUNK_POOL_POOLED_CHUNKS_TOTAL = "pooled_chunks_total";
+const string METRIC_COMPONENT_CHUNK_POOL_POOLED_SIZE_BYTES = "pooled_size_bytes";
+const string METRIC_COMPONENT_CHUNK_POOL_REUSED_CHUNKS_TOTAL = "reused_chunks_total";
+const string METRIC_COMPONENT_CHUNK_POOL_ALLOCATED_CHUNKS_TOTAL = "allocated_chunks_total";
+const string METRIC_COMPONENT_CHUNK_POOL_DISCARDED_CHUNKS_TOTAL = "discarded_chunks_total";
+
+/**********************************************************
+ *   k8s metadata
+ **********************************************************/
+const string METRIC_COMPONENT_K8S_METADATA_CACHE_HIT_TOTAL = "cache_hit_total";
+const string METRIC_COMPONENT_K8S_METADATA_CACHE_MISS_TOTAL = "cache_miss_total";
+const string METRIC_COMPONENT_K8S_METADATA_REFRESH_REQUESTS_TOTAL = "refresh_requests_total";
+const string METRIC_COMPONENT_K8S_METADATA_REFRESH_FAILED_TOTAL = "refresh_failed_total";
+const string METRIC_COMPONENT_K8S_METADATA_TOTAL_REFRESH_TIME_MS = "total_refresh_time_ms";
+const string METRIC_COMPONENT_K8S_METADATA_PENDING_KEYS = "pending_keys";
+
+/**********************************************************
+ *   memory budget
+ **********************************************************/
+const string METRIC_COMPONENT_MEMORY_BUDGET_PROCESS_QUEUE_SIZE_BYTES = "process_queue_size_bytes";
+const string METRIC_COMPONENT_MEMORY_BUDGET_BATCHER_SIZE_BYTES = "batcher_size_bytes";
+const string METRIC_COMPONENT_MEMORY_BUDGET_SENDER_QUEUE_SIZE_BYTES = "sender_queue_size_bytes";
+const string METRIC_COMPONENT_MEMORY_BUDGET_TOTAL_SIZE_BYTES = "total_size_bytes";
+const string METRIC_COMPONENT_MEMORY_BUDGET_LIMIT_SIZE_BYTES = "limit_size_bytes";
+const string METRIC_COMPONENT_MEMORY_BUDGET_REJECTED_PUSH_TIMES_TOTAL = "rejected_push_times_total";
+const string METRIC_COMPONENT_MEMORY_BUDGET_DISCARDED_GROUPS_TOTAL = "discarded_groups_total";
 
 /**********************************************************
  *   queue
@@ -81,4 +131,9 @@ const string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_PROJECT_LIMITER_TIMES_TOTA
 const string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_LOGSTORE_LIMITER_TIMES_TOTAL = "logstore_reject_times_total";
 const string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_RATE_LIMITER_TIMES_TOTAL = "rate_reject_times_total";
 
+/**********************************************************
+ *   router
+ **********************************************************/
+const string METRIC_COMPONENT_ROUTER_PARTITIONED_EVENTS_TOTAL = "partitioned_events_total";
+
 } // namespace logtail
@@ -57,6 +57,7 @@ extern const std::string METRIC_PIPELINE_PROCESSORS_IN_EVENTS_TOTAL;
 extern const std::string METRIC_PIPELINE_PROCESSORS_IN_EVENT_GROUPS_TOTAL;
 extern const std::string METRIC_PIPELINE_PROCESSORS_IN_SIZE_BYTES;
 extern const std::string METRIC_PIPELINE_PROCESSORS_TOTAL_PROCESS_TIME_MS;
+extern const std::string METRIC_PIPELINE_PROCESSORS_PROCESS_TIME_MS;
 extern const std::string METRIC_PIPELINE_FLUSHERS_IN_EVENTS_TOTAL;
 extern const std::string METRIC_PIPELINE_FLUSHERS_IN_EVENT_GROUPS_TOTAL;
 extern const std::string METRIC_PIPELINE_FLUSHERS_IN_SIZE_BYTES;
@@ -80,6 +81,7 @@ extern const std::string& METRIC_PLUGIN_OUT_EVENT_GROUPS_TOTAL;
 extern const std::string& METRIC_PLUGIN_OUT_SIZE_BYTES;
 extern const std::string& METRIC_PLUGIN_TOTAL_DELAY_MS;
 extern const std::string& METRIC_PLUGIN_TOTAL_PROCESS_TIME_MS;
+extern const std::string& METRIC_PLUGIN_TOTAL_CPU_TIME_MS;
 
 /**********************************************************
  *   input_file
@@ -180,6 +182,8 @@ extern const std::string METRIC_PLUGIN_HISTORY_FAILURE_TOTAL;
 extern const std::string METRIC_PLUGIN_MATCHED_EVENTS_TOTAL;
 extern const std::string METRIC_PLUGIN_MATCHED_LINES_TOTAL;
 extern const std::string METRIC_PLUGIN_UNMATCHED_LINES_TOTAL;
+extern const std::string METRIC_PLUGIN_PATTERN_CHECKS_TOTAL;
+extern const std::string METRIC_PLUGIN_PREFILTERED_PATTERN_CHECKS_TOTAL;
 
 /**********************************************************
  *   processor_merge_multiline_log_native
@@ -214,7 +218,11 @@ extern const std::string METRIC_LABEL_KEY_GROUP_BATCH_ENABLED;
 
 // label values
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_BATCHER;
+extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_BUFFER_POOL;
+extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_CHUNK_POOL;
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_COMPRESSOR;
+extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_K8S_METADATA;
+extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_MEMORY_BUDGET;
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_PROCESS_QUEUE;
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_ROUTER;
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_SENDER_QUEUE;
@@ -229,8 +237,11 @@ extern const std::string& METRIC_COMPONENT_OUT_ITEMS_TOTAL;
 extern const std::string& METRIC_COMPONENT_OUT_SIZE_BYTES;
 extern const std::string& METRIC_COMPONENT_TOTAL_DELAY_MS;
 extern const std::string& METRIC_COMPONENT_TOTAL_PROCESS_TIME_MS;
+extern const std::string& METRIC_COMPONENT_TOTAL_CPU_TIME_MS;
 extern const std::string& METRIC_COMPONENT_DISCARDED_ITEMS_TOTAL;
 extern const std::string& METRIC_COMPONENT_DISCARDED_SIZE_BYTES;
+extern const std::string METRIC_COMPONENT_DELAY_MS;
+extern const std::string METRIC_COMPONENT_PROCESS_TIME_MS;
 
 /**********************************************************
  *   batcher
@@ -240,6 +251,49 @@ extern const std::string METRIC_COMPONENT_BATCHER_BUFFERED_GROUPS_TOTAL;
 extern const std::string METRIC_COMPONENT_BATCHER_BUFFERED_EVENTS_TOTAL;
 extern const std::string METRIC_COMPONENT_BATCHER_BUFFERED_SIZE_BYTES;
 extern const std::string METRIC_COMPONENT_BATCHER_TOTAL_ADD_TIME_MS;
+extern const std::string METRIC_COMPONENT_BATCHER_SHARD_HASH_KEYS_TOTAL;
+extern const std::string METRIC_COMPONENT_BATCHER_MAX_SHARD_HASH_KEY_BATCHES_TOTAL;
+extern const std::string METRIC_COMPONENT_BATCHER_TARGET_SIZE_BYTES;
+extern const std::string METRIC_COMPONENT_BATCHER_TARGET_CNT;
+
+/**********************************************************
+ *   buffer pool
+ **********************************************************/
+extern const std::string METRIC_COMPONENT_BUFFER_POOL_POOLED_BUFFERS_TOTAL;
+extern const std::string METRIC_COMPONENT_BUFFER_POOL_POOLED_SIZE_BYTES;
+extern const std::string METRIC_COMPONENT_BUFFER_POOL_REUSED_BUFFERS_TOTAL;
+extern const std::string METRIC_COMPONENT_BUFFER_POOL_ALLOCATED_BUFFERS_TOTAL;
+extern const std::string METRIC_COMPONENT_BUFFER_POOL_DISCARDED_BUFFERS_TOTAL;
+
+/**********************************************************
+ *   chunk pool
+ **********************************************************/
+extern const std::string METRIC_COMPONENT_CHUNK_POOL_POOLED_CHUNKS_TOTAL;
+extern const std::string METRIC_COMPONENT_CHUNK_POOL_POOLED_SIZE_BYTES;
+extern const std::string METRIC_COMPONENT_CHUNK_POOL_REUSED_CHUNKS_TOTAL;
+extern const std::string METRIC_COMPONENT_CHUNK_POOL_ALLOCATED_CHUNKS_TOTAL;
+extern const std::string METRIC_COMPONENT_CHUNK_POOL_DISCARDED_CHUNKS_TOTAL;
+
+/**********************************************************
+ *   k8s metadata
+ **********************************************************/
+extern const std::string METRIC_COMPONENT_K8S_METADATA_CACHE_HIT_TOTAL;
+extern const std::string METRIC_COMPONENT_K8S_METADATA_CACHE_MISS_TOTAL;
+extern const std::string METRIC_COMPONENT_K8S_METADATA_REFRESH_REQUESTS_TOTAL;
+extern const std::string METRIC_COMPONENT_K8S_METADATA_REFRESH_FAILED_TOTAL;
+extern const std::string METRIC_COMPONENT_K8S_METADATA_TOTAL_REFRESH_TIME_MS;
+extern const std::string METRIC_COMPONENT_K8S_METADATA_PENDING_KEYS;
+
+/**********************************************************
+ *   memory budget
+ **********************************************************/
+extern const std::string METRIC_COMPONENT_MEMORY_BUDGET_PROCESS_QUEUE_SIZE_BYTES;
+extern const std::string METRIC_COMPONENT_MEMORY_BUDGET_BATCHER_SIZE_BYTES;
+extern const std::string METRIC_COMPONENT_MEMORY_BUDGET_SENDER_QUEUE_SIZE_BYTES;
+extern const std::string METRIC_COMPONENT_MEMORY_BUDGET_TOTAL_SIZE_BYTES;
+extern const std::string METRIC_COMPONENT_MEMORY_BUDGET_LIMIT_SIZE_BYTES;
+extern const std::string METRIC_COMPONENT_MEMORY_BUDGET_REJECTED_PUSH_TIMES_TOTAL;
+extern const std::string METRIC_COMPONENT_MEMORY_BUDGET_DISCARDED_GROUPS_TOTAL;
 
 /**********************************************************
  *   queue
@@ -259,6 +313,11 @@ extern const std::string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_PROJECT_LIMITE
 extern const std::string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_LOGSTORE_LIMITER_TIMES_TOTAL;
 extern const std::string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_RATE_LIMITER_TIMES_TOTAL;
 
+/**********************************************************
+ *   router
+ **********************************************************/
+extern const std::string METRIC_COMPONENT_ROUTER_PARTITIONED_EVENTS_TOTAL;
+
 //////////////////////////////////////////////////////////////////////////
 // runner
 //////////////////////////////////////////////////////////////////////////
@@ -294,6 +353,7 @@ extern const std::string METRIC_RUNNER_SINK_OUT_SUCCESSFUL_ITEMS_TOTAL;
 extern const std::string METRIC_RUNNER_SINK_OUT_FAILED_ITEMS_TOTAL;
 extern const std::string METRIC_RUNNER_SINK_SUCCESSFUL_ITEM_TOTAL_RESPONSE_TIME_MS;
 extern const std::string METRIC_RUNNER_SINK_FAILED_ITEM_TOTAL_RESPONSE_TIME_MS;
+extern const std::string METRIC_RUNNER_SINK_ITEM_RESPONSE_TIME_MS;
 extern const std::string METRIC_RUNNER_SINK_SENDING_ITEMS_TOTAL;
 extern const std::string METRIC_RUNNER_SINK_SEND_CONCURRENCY;
 
@@ -310,8 +370,15 @@ extern const std::string METRIC_RUNNER_FILE_WATCHED_DIRS_TOTAL;
 extern const std::string METRIC_RUNNER_FILE_ACTIVE_READERS_TOTAL;
 extern const std::string METRIC_RUNNER_FILE_ENABLE_FILE_INCLUDED_BY_MULTI_CONFIGS_FLAG;
 extern const std::string METRIC_RUNNER_FILE_POLLING_MODIFY_CACHE_SIZE;
+extern const std::string METRIC_RUNNER_FILE_POLLING_MODIFY_STAT_COUNT;
 extern const std::string METRIC_RUNNER_FILE_POLLING_DIR_CACHE_SIZE;
 extern const std::string METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE;
+extern const std::string METRIC_RUNNER_FILE_POLLING_READDIR_COUNT;
+extern const std::string METRIC_RUNNER_FILE_POLLING_STAT_COUNT;
+extern const std::string METRIC_RUNNER_FILE_POLLING_SHARED_SCAN_HIT_COUNT;
+extern const std::string METRIC_RUNNER_FILE_INOTIFY_EVENTS_TOTAL;
+extern const std::string METRIC_RUNNER_FILE_INOTIFY_COALESCED_EVENTS_TOTAL;
+extern const std::string METRIC_RUNNER_FILE_FANOTIFY_EVENTS_TOTAL;
 
 /**********************************************************
  *   ebpf server
@@ -319,5 +386,11 @@ extern const std::string METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE;
 extern const std::string METRIC_RUNNER_EBPF_START_PLUGIN_TOTAL;
 extern const std::string METRIC_RUNNER_EBPF_STOP_PLUGIN_TOTAL;
 extern const std::string METRIC_RUNNER_EBPF_SUSPEND_PLUGIN_TOTAL;
+extern const std::string METRIC_RUNNER_EBPF_SPILLED_GROUPS_TOTAL;
+extern const std::string METRIC_RUNNER_EBPF_REPLAYED_GROUPS_TOTAL;
+extern const std::string METRIC_RUNNER_EBPF_DISCARDED_GROUPS_TOTAL;
+extern const std::string METRIC_RUNNER_EBPF_SAMPLED_OUT_GROUPS_TOTAL;
+extern const std::string METRIC_RUNNER_EBPF_SPILL_RING_GROUPS;
+extern const std::string METRIC_RUNNER_EBPF_SAMPLE_INTERVAL;
 
 } // namespace logtail
@@ -32,6 +32,7 @@ const string& METRIC_PLUGIN_OUT_EVENT_GROUPS_TOTAL = METRIC_OUT_EVENT_GROUPS_TOT
 const string& METRIC_PLUGIN_OUT_SIZE_BYTES = METRIC_OUT_SIZE_BYTES;
 const string& METRIC_PLUGIN_TOTAL_DELAY_MS = METRIC_TOTAL_DELAY_MS;
 const string& METRIC_PLUGIN_TOTAL_PROCESS_TIME_MS = METRIC_TOTAL_PROCESS_TIME_MS;
+const string& METRIC_PLUGIN_TOTAL_CPU_TIME_MS = METRIC_TOTAL_CPU_TIME_MS;
 
 /**********************************************************
  *   input_file
@@ -119,6 +120,8 @@ const string METRIC_PLUGIN_HISTORY_FAILURE_TOTAL = "history_failure_total";
 const string METRIC_PLUGIN_MATCHED_EVENTS_TOTAL = "matched_events_total";
 const string METRIC_PLUGIN_MATCHED_LINES_TOTAL = "matched_lines_total";
 const string METRIC_PLUGIN_UNMATCHED_LINES_TOTAL = "unmatched_lines_total";
+const string METRIC_PLUGIN_PATTERN_CHECKS_TOTAL = "pattern_checks_total";
+const string METRIC_PLUGIN_PREFILTERED_PATTERN_CHECKS_TOTAL = "prefiltered_pattern_checks_total";
 
 /**********************************************************
  *   processor_merge_multiline_log_native
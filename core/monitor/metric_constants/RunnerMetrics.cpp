@@ -50,6 +50,7 @@ const string METRIC_RUNNER_SINK_OUT_SUCCESSFUL_ITEMS_TOTAL = "out_successful_ite
 const string METRIC_RUNNER_SINK_OUT_FAILED_ITEMS_TOTAL = "out_failed_items_total";
 const string METRIC_RUNNER_SINK_SUCCESSFUL_ITEM_TOTAL_RESPONSE_TIME_MS = "successful_response_time_ms";
 const string METRIC_RUNNER_SINK_FAILED_ITEM_TOTAL_RESPONSE_TIME_MS = "failed_response_time_ms";
+const string METRIC_RUNNER_SINK_ITEM_RESPONSE_TIME_MS = "response_time_ms";
 const string METRIC_RUNNER_SINK_SENDING_ITEMS_TOTAL = "sending_items_total";
 const string METRIC_RUNNER_SINK_SEND_CONCURRENCY = "send_concurrency";
 
@@ -66,8 +67,15 @@ const string METRIC_RUNNER_FILE_WATCHED_DIRS_TOTAL = "watched_dirs_total";
 const string METRIC_RUNNER_FILE_ACTIVE_READERS_TOTAL = "active_readers_total";
 const string METRIC_RUNNER_FILE_ENABLE_FILE_INCLUDED_BY_MULTI_CONFIGS_FLAG = "enable_multi_configs";
 const string METRIC_RUNNER_FILE_POLLING_MODIFY_CACHE_SIZE = "polling_modify_cache_size";
+const string METRIC_RUNNER_FILE_POLLING_MODIFY_STAT_COUNT = "polling_modify_stat_count";
 const string METRIC_RUNNER_FILE_POLLING_DIR_CACHE_SIZE = "polling_dir_cache_size";
 const string METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE = "polling_file_cache_size";
+const string METRIC_RUNNER_FILE_POLLING_READDIR_COUNT = "polling_readdir_count";
+const string METRIC_RUNNER_FILE_POLLING_STAT_COUNT = "polling_stat_count";
+const string METRIC_RUNNER_FILE_POLLING_SHARED_SCAN_HIT_COUNT = "polling_shared_scan_hit_count";
+const string METRIC_RUNNER_FILE_INOTIFY_EVENTS_TOTAL = "inotify_events_total";
+const string METRIC_RUNNER_FILE_INOTIFY_COALESCED_EVENTS_TOTAL = "inotify_coalesced_events_total";
+const string METRIC_RUNNER_FILE_FANOTIFY_EVENTS_TOTAL = "fanotify_events_total";
 
 /**********************************************************
  *   ebpf server
@@ -75,5 +83,11 @@ const string METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE = "polling_file_cache_si
 const string METRIC_RUNNER_EBPF_START_PLUGIN_TOTAL = "start_plugin_total";
 const string METRIC_RUNNER_EBPF_STOP_PLUGIN_TOTAL = "stop_plugin_total";
 const string METRIC_RUNNER_EBPF_SUSPEND_PLUGIN_TOTAL = "suspend_plugin_total";
+const string METRIC_RUNNER_EBPF_SPILLED_GROUPS_TOTAL = "spilled_groups_total";
+const string METRIC_RUNNER_EBPF_REPLAYED_GROUPS_TOTAL = "replayed_groups_total";
+const string METRIC_RUNNER_EBPF_DISCARDED_GROUPS_TOTAL = "discarded_groups_total";
+const string METRIC_RUNNER_EBPF_SAMPLED_OUT_GROUPS_TOTAL = "sampled_out_groups_total";
+const string METRIC_RUNNER_EBPF_SPILL_RING_GROUPS = "spill_ring_groups";
+const string METRIC_RUNNER_EBPF_SAMPLE_INTERVAL = "sample_interval";
 
 } // namespace logtail
\ No newline at end of file
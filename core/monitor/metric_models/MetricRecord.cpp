@@ -54,6 +54,24 @@ DoubleGaugePtr MetricsRecord::CreateDoubleGauge(const std::string& name) {
     return gaugePtr;
 }
 
+ShardedCounterPtr MetricsRecord::CreateShardedCounter(const std::string& name) {
+    ShardedCounterPtr counterPtr = std::make_shared<ShardedCounter>(name);
+    mShardedCounters.emplace_back(counterPtr);
+    return counterPtr;
+}
+
+ShardedTimeCounterPtr MetricsRecord::CreateShardedTimeCounter(const std::string& name) {
+    ShardedTimeCounterPtr counterPtr = std::make_shared<ShardedTimeCounter>(name);
+    mShardedTimeCounters.emplace_back(counterPtr);
+    return counterPtr;
+}
+
+HistogramPtr MetricsRecord::CreateHistogram(const std::string& name) {
+    HistogramPtr histogramPtr = std::make_shared<Histogram>(name);
+    mHistograms.emplace_back(histogramPtr);
+    return histogramPtr;
+}
+
 void MetricsRecord::MarkDeleted() {
     mDeleted = true;
 }
@@ -90,6 +108,18 @@ const std::vector<DoubleGaugePtr>& MetricsRecord::GetDoubleGauges() const {
     return mDoubleGauges;
 }
 
+const std::vector<ShardedCounterPtr>& MetricsRecord::GetShardedCounters() const {
+    return mShardedCounters;
+}
+
+const std::vector<ShardedTimeCounterPtr>& MetricsRecord::GetShardedTimeCounters() const {
+    return mShardedTimeCounters;
+}
+
+const std::vector<HistogramPtr>& MetricsRecord::GetHistograms() const {
+    return mHistograms;
+}
+
 MetricsRecord* MetricsRecord::Collect() {
     MetricsRecord* metrics = new MetricsRecord(mCategory, mLabels, mDynamicLabels);
     for (auto& item : mCounters) {
@@ -108,6 +138,18 @@ MetricsRecord* MetricsRecord::Collect() {
         DoubleGaugePtr newPtr(item->Collect());
         metrics->mDoubleGauges.emplace_back(newPtr);
     }
+    for (auto& item : mShardedCounters) {
+        CounterPtr newPtr(item->Collect());
+        metrics->mCounters.emplace_back(newPtr);
+    }
+    for (auto& item : mShardedTimeCounters) {
+        TimeCounterPtr newPtr(item->Collect());
+        metrics->mTimeCounters.emplace_back(newPtr);
+    }
+    for (auto& item : mHistograms) {
+        HistogramPtr newPtr(item->Collect());
+        metrics->mHistograms.emplace_back(newPtr);
+    }
     return metrics;
 }
 
@@ -157,6 +199,18 @@ DoubleGaugePtr MetricsRecordRef::CreateDoubleGauge(const std::string& name) {
     return mMetrics->CreateDoubleGauge(name);
 }
 
+ShardedCounterPtr MetricsRecordRef::CreateShardedCounter(const std::string& name) {
+    return mMetrics->CreateShardedCounter(name);
+}
+
+ShardedTimeCounterPtr MetricsRecordRef::CreateShardedTimeCounter(const std::string& name) {
+    return mMetrics->CreateShardedTimeCounter(name);
+}
+
+HistogramPtr MetricsRecordRef::CreateHistogram(const std::string& name) {
+    return mMetrics->CreateHistogram(name);
+}
+
 const MetricsRecord* MetricsRecordRef::operator->() const {
     return mMetrics;
 }
@@ -39,6 +39,10 @@ private:
     std::vector<TimeCounterPtr> mTimeCounters;
     std::vector<IntGaugePtr> mIntGauges;
     std::vector<DoubleGaugePtr> mDoubleGauges;
+    // sharded counters are collected into plain counters
+    std::vector<ShardedCounterPtr> mShardedCounters;
+    std::vector<ShardedTimeCounterPtr> mShardedTimeCounters;
+    std::vector<HistogramPtr> mHistograms;
 
     std::atomic_bool mDeleted;
     MetricsRecord* mNext = nullptr;
@@ -55,10 +59,16 @@ public:
     const std::vector<TimeCounterPtr>& GetTimeCounters() const;
     const std::vector<IntGaugePtr>& GetIntGauges() const;
     const std::vector<DoubleGaugePtr>& GetDoubleGauges() const;
+    const std::vector<ShardedCounterPtr>& GetShardedCounters() const;
+    const std::vector<ShardedTimeCounterPtr>& GetShardedTimeCounters() const;
+    const std::vector<HistogramPtr>& GetHistograms() const;
     CounterPtr CreateCounter(const std::string& name);
     TimeCounterPtr CreateTimeCounter(const std::string& name);
     IntGaugePtr CreateIntGauge(const std::string& name);
     DoubleGaugePtr CreateDoubleGauge(const std::string& name);
+    ShardedCounterPtr CreateShardedCounter(const std::string& name);
+    ShardedTimeCounterPtr CreateShardedTimeCounter(const std::string& name);
+    HistogramPtr CreateHistogram(const std::string& name);
     MetricsRecord* Collect();
     void SetNext(MetricsRecord* next);
     MetricsRecord* GetNext() const;
@@ -87,6 +97,10 @@ public:
     TimeCounterPtr CreateTimeCounter(const std::string& name);
     IntGaugePtr CreateIntGauge(const std::string& name);
     DoubleGaugePtr CreateDoubleGauge(const std::string& name);
+    // for counters updated by many threads concurrently
+    ShardedCounterPtr CreateShardedCounter(const std::string& name);
+    ShardedTimeCounterPtr CreateShardedTimeCounter(const std::string& name);
+    HistogramPtr CreateHistogram(const std::string& name);
     const MetricsRecord* operator->() const;
     // this is not thread-safe, and should be only used before WriteMetrics::CommitMetricsRecordRef
     void AddLabels(MetricLabels&& labels);
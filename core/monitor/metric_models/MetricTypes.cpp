@@ -0,0 +1,112 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MetricTypes.h"
+
+#include <cmath>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace logtail {
+
+static size_t HighestBit(uint64_t val) {
+#ifdef _MSC_VER
+    unsigned long index = 0;
+    _BitScanReverse64(&index, val);
+    return index;
+#else
+    return 63 - __builtin_clzll(val);
+#endif
+}
+
+void Histogram::GetBuckets(std::vector<uint64_t>& buckets) const {
+    buckets.resize(kBucketCnt);
+    for (size_t i = 0; i < kBucketCnt; ++i) {
+        buckets[i] += mBuckets[i].load(std::memory_order_relaxed);
+    }
+}
+
+void Histogram::GetTotalBuckets(std::vector<uint64_t>& buckets) const {
+    GetBuckets(buckets);
+    for (size_t i = 0; i < mCollectedBuckets.size(); ++i) {
+        buckets[i] += mCollectedBuckets[i];
+    }
+}
+
+uint64_t Histogram::GetCount() const {
+    uint64_t cnt = 0;
+    for (const auto& bucket : mBuckets) {
+        cnt += bucket.load(std::memory_order_relaxed);
+    }
+    return cnt;
+}
+
+Histogram* Histogram::Collect() {
+    auto res = new Histogram(mName);
+    mCollectedBuckets.resize(kBucketCnt);
+    for (size_t i = 0; i < kBucketCnt; ++i) {
+        uint64_t val = mBuckets[i].exchange(0, std::memory_order_relaxed);
+        res->mBuckets[i].store(val, std::memory_order_relaxed);
+        mCollectedBuckets[i] += val;
+    }
+    uint64_t sum = mSum.exchange(0, std::memory_order_relaxed);
+    res->mSum.store(sum, std::memory_order_relaxed);
+    mCollectedSum += sum;
+    return res;
+}
+
+size_t Histogram::GetBucketIndex(uint64_t val) {
+    if (val < kSubBucketCnt) {
+        return val;
+    }
+    size_t shift = HighestBit(val) - kSubBucketBits;
+    return (shift + 1) * kSubBucketCnt + ((val >> shift) & (kSubBucketCnt - 1));
+}
+
+uint64_t Histogram::GetBucketUpperBound(size_t index) {
+    if (index < kSubBucketCnt) {
+        return index;
+    }
+    size_t shift = index / kSubBucketCnt - 1;
+    uint64_t lower = static_cast<uint64_t>(kSubBucketCnt + index % kSubBucketCnt) << shift;
+    return lower + ((static_cast<uint64_t>(1) << shift) - 1);
+}
+
+double Histogram::GetQuantile(const std::vector<uint64_t>& buckets, double q) {
+    uint64_t cnt = 0;
+    for (auto bucket : buckets) {
+        cnt += bucket;
+    }
+    if (cnt == 0) {
+        return 0;
+    }
+    auto rank = static_cast<uint64_t>(std::ceil(q * cnt));
+    if (rank == 0) {
+        rank = 1;
+    }
+    uint64_t acc = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        acc += buckets[i];
+        if (acc >= rank) {
+            return GetBucketUpperBound(i) / 1000.0;
+        }
+    }
+    return GetBucketUpperBound(buckets.size() - 1) / 1000.0;
+}
+
+} // namespace logtail
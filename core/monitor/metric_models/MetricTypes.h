@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
@@ -39,13 +40,23 @@ class Counter {
 protected:
     std::string mName;
     std::atomic_uint64_t mVal;
+    // sum of all collected values, only accessed when no snapshot is being taken
+    uint64_t mCollectedVal = 0;
+
+    uint64_t Exchange() {
+        uint64_t val = mVal.exchange(0);
+        mCollectedVal += val;
+        return val;
+    }
 
 public:
     Counter(const std::string& name, uint64_t val = 0) : mName(name), mVal(val) {}
     uint64_t GetValue() const { return mVal.load(); }
+    // value since creation, not reset by Collect
+    uint64_t GetTotalValue() const { return mCollectedVal + mVal.load(); }
     const std::string& GetName() const { return mName; }
     void Add(uint64_t val) { mVal.fetch_add(val); }
-    Counter* Collect() { return new Counter(mName, mVal.exchange(0)); }
+    Counter* Collect() { return new Counter(mName, Exchange()); }
 };
 
 // input: nanosecond, output: milisecond
@@ -53,8 +64,128 @@ class TimeCounter : public Counter {
 public:
     TimeCounter(const std::string& name, uint64_t val = 0) : Counter(name, val) {}
     uint64_t GetValue() const { return mVal.load()/1000000; }
+    uint64_t GetTotalValue() const { return Counter::GetTotalValue() / 1000000; }
     void Add(std::chrono::nanoseconds val) { mVal.fetch_add(val.count()); }
-    TimeCounter* Collect() { return new TimeCounter(mName, mVal.exchange(0)); }
+    TimeCounter* Collect() { return new TimeCounter(mName, Exchange()); }
+    // sequence number of the next scope timed on this counter, see ScopedCpuTimer
+    uint32_t NextSampleSeq() {
+        uint32_t seq = mSampleSeq.load(std::memory_order_relaxed);
+        mSampleSeq.store(seq + 1, std::memory_order_relaxed);
+        return seq;
+    }
+
+private:
+    std::atomic_uint32_t mSampleSeq{0};
+};
+
+// Counter split into cache-line-padded shards, each thread adding to the shard it is assigned to, so that threads
+// updating the same counter do not contend on one cache line. Shards are summed up when collected.
+class ShardedCounter {
+public:
+    static constexpr size_t kShardCnt = 16;
+
+    ShardedCounter(const std::string& name) : mName(name) {}
+    uint64_t GetValue() const {
+        uint64_t val = 0;
+        for (const auto& shard : mShards) {
+            val += shard.mVal.load(std::memory_order_relaxed);
+        }
+        return val;
+    }
+    // value since creation, not reset by Collect
+    uint64_t GetTotalValue() const { return mCollectedVal + GetValue(); }
+    const std::string& GetName() const { return mName; }
+    void Add(uint64_t val) { mShards[GetShardIndex()].mVal.fetch_add(val, std::memory_order_relaxed); }
+    Counter* Collect() { return new Counter(mName, Exchange()); }
+    // sequence number of the next scope timed on this counter by the current thread's shard, see ScopedCpuTimer.
+    // Updates lost by threads sharing a shard only shift the sampled scopes.
+    uint32_t NextSampleSeq() {
+        auto& cnt = mShards[GetShardIndex()].mSampleSeq;
+        uint32_t seq = cnt.load(std::memory_order_relaxed);
+        cnt.store(seq + 1, std::memory_order_relaxed);
+        return seq;
+    }
+
+protected:
+    uint64_t Exchange() {
+        uint64_t val = 0;
+        for (auto& shard : mShards) {
+            val += shard.mVal.exchange(0, std::memory_order_relaxed);
+        }
+        mCollectedVal += val;
+        return val;
+    }
+
+    std::string mName;
+    // sum of all collected values, only accessed when no snapshot is being taken
+    uint64_t mCollectedVal = 0;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic_uint64_t mVal{0};
+        std::atomic_uint32_t mSampleSeq{0};
+    };
+
+    static size_t GetShardIndex() {
+        static std::atomic_size_t sNextIndex{0};
+        thread_local size_t index = sNextIndex.fetch_add(1, std::memory_order_relaxed) % kShardCnt;
+        return index;
+    }
+
+    std::array<Shard, kShardCnt> mShards;
+};
+
+// input: nanosecond, output: milisecond
+class ShardedTimeCounter : public ShardedCounter {
+public:
+    ShardedTimeCounter(const std::string& name) : ShardedCounter(name) {}
+    uint64_t GetValue() const { return ShardedCounter::GetValue() / 1000000; }
+    uint64_t GetTotalValue() const { return ShardedCounter::GetTotalValue() / 1000000; }
+    void Add(std::chrono::nanoseconds val) { ShardedCounter::Add(val.count()); }
+    TimeCounter* Collect() { return new TimeCounter(mName, Exchange()); }
+};
+
+// Log-linear latency histogram in the spirit of HDR histograms. Values below 8us have a bucket each, and every power of
+// two above is split into 8 linear sub-buckets, so quantiles are accurate within 12.5%. Recording is a single relaxed
+// atomic add, and quantiles are only computed from collected buckets.
+// input: nanosecond, output: milisecond
+class Histogram {
+public:
+    static constexpr size_t kSubBucketBits = 3;
+    static constexpr size_t kSubBucketCnt = 1 << kSubBucketBits;
+    static constexpr size_t kBucketCnt = (64 - kSubBucketBits + 1) * kSubBucketCnt;
+
+    Histogram(const std::string& name) : mName(name) {}
+
+    const std::string& GetName() const { return mName; }
+    void Observe(std::chrono::nanoseconds val) {
+        auto count = std::chrono::duration_cast<std::chrono::microseconds>(val).count();
+        uint64_t us = count < 0 ? 0 : static_cast<uint64_t>(count);
+        mBuckets[GetBucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+        mSum.fetch_add(us, std::memory_order_relaxed);
+    }
+    // add bucket counts to buckets, which is resized to kBucketCnt if necessary
+    void GetBuckets(std::vector<uint64_t>& buckets) const;
+    // same as GetBuckets, but counts since creation are returned, which are not reset by Collect
+    void GetTotalBuckets(std::vector<uint64_t>& buckets) const;
+    uint64_t GetCount() const;
+    // sum of values since creation in milisecond, not reset by Collect
+    double GetTotalSum() const { return (mCollectedSum + mSum.load(std::memory_order_relaxed)) / 1000.0; }
+    Histogram* Collect();
+
+    static size_t GetBucketIndex(uint64_t val);
+    static uint64_t GetBucketUpperBound(size_t index);
+    // return the upper bound of the bucket holding the q-quantile in milisecond, or 0 if no value is recorded
+    static double GetQuantile(const std::vector<uint64_t>& buckets, double q);
+
+private:
+    std::string mName;
+    std::array<std::atomic_uint64_t, kBucketCnt> mBuckets{};
+    // in microsecond
+    std::atomic_uint64_t mSum{0};
+    // sum of all collected buckets and values, only accessed when no snapshot is being taken
+    std::vector<uint64_t> mCollectedBuckets;
+    uint64_t mCollectedSum = 0;
 };
 
 template <typename T>
@@ -85,6 +216,9 @@ public:
 
 using CounterPtr = std::shared_ptr<Counter>;
 using TimeCounterPtr = std::shared_ptr<TimeCounter>;
+using ShardedCounterPtr = std::shared_ptr<ShardedCounter>;
+using ShardedTimeCounterPtr = std::shared_ptr<ShardedTimeCounter>;
+using HistogramPtr = std::shared_ptr<Histogram>;
 using IntGaugePtr = std::shared_ptr<IntGauge>;
 using DoubleGaugePtr = std::shared_ptr<Gauge<double>>;
 
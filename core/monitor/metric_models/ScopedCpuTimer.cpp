@@ -0,0 +1,55 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "monitor/metric_models/ScopedCpuTimer.h"
+
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+#include "common/Flags.h"
+
+DEFINE_FLAG_INT32(cpu_time_sample_interval,
+                  "thread cpu time of 1 in every n scopes of each plugin and component is measured, 0 means disabled",
+                  16);
+
+namespace logtail {
+
+uint32_t CpuTimeSampler::Sample(uint32_t seq) {
+#if defined(__linux__)
+    int32_t interval = INT32_FLAG(cpu_time_sample_interval);
+    if (interval <= 0) {
+        return 0;
+    }
+    return seq % interval == 0 ? interval : 0;
+#else
+    return 0;
+#endif
+}
+
+uint64_t CpuTimeSampler::GetThreadCpuTimeNs() {
+#if defined(__linux__)
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+#else
+    return 0;
+#endif
+}
+
+} // namespace logtail
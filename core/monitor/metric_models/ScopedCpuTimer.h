@@ -0,0 +1,63 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace logtail {
+
+class CpuTimeSampler {
+public:
+    // return the sample interval if the scope of sequence number seq should be measured, or 0 otherwise
+    static uint32_t Sample(uint32_t seq);
+    // cpu time consumed by the current thread, 0 if not supported on the platform
+    static uint64_t GetThreadCpuTimeNs();
+};
+
+// Adds thread cpu time spent in the scope to a time counter. Only 1 in every cpu_time_sample_interval scopes timed on
+// the counter is measured, and the measured value is scaled up by the interval. Scopes are counted by the counter
+// rather than by the thread, otherwise scopes run in a fixed cycle on a thread, e.g., processors of a pipeline, would
+// always have the same ones measured.
+// T: TimeCounterPtr, ShardedTimeCounterPtr
+template <typename T>
+class ScopedCpuTimer {
+public:
+    explicit ScopedCpuTimer(const T& counter) {
+        if (counter && (mInterval = CpuTimeSampler::Sample(counter->NextSampleSeq())) != 0) {
+            mCounter = &counter;
+            mStart = CpuTimeSampler::GetThreadCpuTimeNs();
+        }
+    }
+    ~ScopedCpuTimer() {
+        if (mCounter) {
+            uint64_t end = CpuTimeSampler::GetThreadCpuTimeNs();
+            if (end > mStart) {
+                (*mCounter)->Add(std::chrono::nanoseconds((end - mStart) * mInterval));
+            }
+        }
+    }
+    ScopedCpuTimer(const ScopedCpuTimer&) = delete;
+    ScopedCpuTimer& operator=(const ScopedCpuTimer&) = delete;
+
+private:
+    const T* mCounter = nullptr;
+    uint64_t mStart = 0;
+    uint32_t mInterval = 0;
+};
+
+} // namespace logtail
@@ -16,6 +16,8 @@
 
 #include "SelfMonitorMetricEvent.h"
 
+#include <algorithm>
+
 #include "common/HashUtil.h"
 #include "common/JsonUtil.h"
 #include "common/TimeUtil.h"
@@ -29,6 +31,9 @@ const string METRIC_GO_KEY_LABELS = "labels";
 const string METRIC_GO_KEY_COUNTERS = "counters";
 const string METRIC_GO_KEY_GAUGES = "gauges";
 
+static const vector<pair<string, double>> kHistogramQuantiles = {{"_p50", 0.5}, {"_p90", 0.9}, {"_p99", 0.99}};
+static const string kHistogramCountSuffix = "_count";
+
 SelfMonitorMetricEvent::SelfMonitorMetricEvent() {
 }
 
@@ -60,6 +65,10 @@ SelfMonitorMetricEvent::SelfMonitorMetricEvent(MetricsRecord* metricRecord) {
     for (auto& item : metricRecord->GetDoubleGauges()) {
         mGauges[item->GetName()] = item->GetValue();
     }
+    // histograms
+    for (auto& item : metricRecord->GetHistograms()) {
+        item->GetBuckets(mHistograms[item->GetName()]);
+    }
     CreateKey();
 }
 
@@ -149,6 +158,13 @@ void SelfMonitorMetricEvent::Merge(SelfMonitorMetricEvent& event) {
     for (auto gauge = event.mGauges.begin(); gauge != event.mGauges.end(); gauge++) {
         mGauges[gauge->first] = gauge->second;
     }
+    for (auto histogram = event.mHistograms.begin(); histogram != event.mHistograms.end(); histogram++) {
+        auto& buckets = mHistograms[histogram->first];
+        buckets.resize(max(buckets.size(), histogram->second.size()));
+        for (size_t i = 0; i < histogram->second.size(); ++i) {
+            buckets[i] += histogram->second[i];
+        }
+    }
     mUpdatedFlag = true;
 }
 
@@ -179,6 +195,21 @@ void SelfMonitorMetricEvent::ReadAsMetricEvent(MetricEvent* metricEventPtr) {
     for (auto gauge = mGauges.begin(); gauge != mGauges.end(); gauge++) {
         metricEventPtr->MutableValue<UntypedMultiDoubleValues>()->SetValue(gauge->first, gauge->second);
     }
+    for (auto histogram = mHistograms.begin(); histogram != mHistograms.end(); histogram++) {
+        uint64_t cnt = 0;
+        for (auto bucket : histogram->second) {
+            cnt += bucket;
+        }
+        metricEventPtr->MutableValue<UntypedMultiDoubleValues>()->SetValue(histogram->first + kHistogramCountSuffix,
+                                                                           cnt);
+        if (cnt > 0) {
+            for (const auto& quantile : kHistogramQuantiles) {
+                metricEventPtr->MutableValue<UntypedMultiDoubleValues>()->SetValue(
+                    histogram->first + quantile.first, Histogram::GetQuantile(histogram->second, quantile.second));
+            }
+        }
+        fill(histogram->second.begin(), histogram->second.end(), 0);
+    }
     // set flags
     mLastSendInterval = 0;
     mUpdatedFlag = false;
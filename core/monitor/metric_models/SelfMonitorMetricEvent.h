@@ -56,6 +56,8 @@ private:
     std::unordered_map<std::string, std::string> mLabels;
     std::unordered_map<std::string, uint64_t> mCounters;
     std::unordered_map<std::string, double> mGauges;
+    // histogram buckets, read as quantiles
+    std::unordered_map<std::string, std::vector<uint64_t>> mHistograms;
     int32_t mSendInterval;
     int32_t mLastSendInterval;
     bool mUpdatedFlag;
@@ -17,7 +17,9 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "models/PipelineEventGroup.h"
@@ -148,6 +150,9 @@ public:
         AddSourceBuffer(sourceBuffer);
     }
 
+    void SetShardHashKey(uint64_t key) { mBatch.mShardHashKey = key; }
+    const std::optional<uint64_t>& GetShardHashKey() const { return mBatch.mShardHashKey; }
+
     void AddSourceBuffer(const std::shared_ptr<SourceBuffer>& sourceBuffer) {
         if (mSourceBuffers.find(sourceBuffer.get()) == mSourceBuffers.end()) {
             mSourceBuffers.insert(sourceBuffer.get());
@@ -172,8 +177,8 @@ private:
     }
 
     void UpdateExactlyOnceLogPosition() {
-        uint32_t offset = mBatch.mEvents.front().Cast<LogEvent>().GetPosition().first;
-        auto lastEventPosition = mBatch.mEvents.back().Cast<LogEvent>().GetPosition();
+        uint32_t offset = std::as_const(mBatch.mEvents.front()).Cast<LogEvent>().GetPosition().first;
+        auto lastEventPosition = std::as_const(mBatch.mEvents.back()).Cast<LogEvent>().GetPosition();
         mBatch.mExactlyOnceCheckpoint->data.set_read_offset(offset);
         mBatch.mExactlyOnceCheckpoint->data.set_read_length(lastEventPosition.first + lastEventPosition.second
                                                             - offset);
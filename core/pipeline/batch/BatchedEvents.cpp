@@ -14,6 +14,8 @@
 
 #include "pipeline/batch/BatchedEvents.h"
 
+#include <utility>
+
 #include "models/EventPool.h"
 
 using namespace std;
@@ -28,7 +30,8 @@ void DestroyEvents(vector<PipelineEventPtr>&& events) {
     typename unordered_map<EventPool*, vector<T*>>::iterator cachedIt;
     bool firstEvent = true;
     for (auto& item : events) {
-        if (item && item.IsFromEventPool()) {
+        // shared events are only given back to pool by the last owner
+        if (item && item.IsFromEventPool() && item.TryUnshare()) {
             item->Reset();
             if (firstEvent || item.GetEventPool() != cachedPoolPtr) {
                 cachedPoolPtr = item.GetEventPool();
@@ -56,7 +59,7 @@ BatchedEvents::~BatchedEvents() {
     if (mEvents.empty() || !mEvents[0]) {
         return;
     }
-    switch (mEvents[0]->GetType()) {
+    switch (as_const(mEvents[0])->GetType()) {
         case PipelineEvent::Type::LOG:
             DestroyEvents<LogEvent>(std::move(mEvents));
             break;
@@ -97,6 +100,7 @@ void BatchedEvents::Clear() {
     mSizeBytes = 0;
     mExactlyOnceCheckpoint.reset();
     mPackIdPrefix = StringView();
+    mShardHashKey.reset();
 }
 
 } // namespace logtail
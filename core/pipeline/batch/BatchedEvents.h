@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <cstdint>
+#include <optional>
 #include <unordered_set>
 #include <vector>
 
@@ -32,6 +34,8 @@ struct BatchedEvents {
     // for flusher_sls only
     RangeCheckpointPtr mExactlyOnceCheckpoint;
     StringView mPackIdPrefix;
+    // for flusher_sls only, digest of ShardHashKeys values computed by batcher
+    std::optional<uint64_t> mShardHashKey;
 
     BatchedEvents() = default;
     ~BatchedEvents();
@@ -17,11 +17,18 @@
 #pragma once
 
 #include <json/json.h>
+#include <xxhash/xxhash.h>
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <limits>
 #include <map>
 #include <mutex>
 #include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "common/Flags.h"
@@ -29,11 +36,13 @@
 #include "models/PipelineEventGroup.h"
 #include "monitor/MetricManager.h"
 #include "monitor/metric_constants/MetricConstants.h"
+#include "monitor/metric_models/ScopedCpuTimer.h"
 #include "pipeline/PipelineContext.h"
 #include "pipeline/batch/BatchItem.h"
 #include "pipeline/batch/BatchStatus.h"
 #include "pipeline/batch/FlushStrategy.h"
 #include "pipeline/batch/TimeoutFlushManager.h"
+#include "pipeline/limiter/MemoryBudget.h"
 
 namespace logtail {
 
@@ -43,7 +52,8 @@ public:
     bool Init(const Json::Value& config,
               Flusher* flusher,
               const DefaultFlushStrategyOptions& strategy,
-              bool enableGroupBatch = false) {
+              bool enableGroupBatch = false,
+              const std::vector<std::string>& shardHashKeys = {}) {
         std::string errorMsg;
         PipelineContext& ctx = flusher->GetContext();
 
@@ -98,7 +108,24 @@ public:
         mEventFlushStrategy.SetMinSizeBytes(minSizeBytes);
         mEventFlushStrategy.SetMinCnt(minCnt);
 
+        bool enableAdaptiveBatch = false;
+        if (!GetOptionalBoolParam(config, "EnableAdaptiveBatch", enableAdaptiveBatch, errorMsg)) {
+            PARAM_WARNING_DEFAULT(ctx.GetLogger(),
+                                  ctx.GetAlarm(),
+                                  errorMsg,
+                                  enableAdaptiveBatch,
+                                  flusher->Name(),
+                                  ctx.GetConfigName(),
+                                  ctx.GetProjectName(),
+                                  ctx.GetLogstoreName(),
+                                  ctx.GetRegion());
+        }
+        if (enableAdaptiveBatch) {
+            InitAdaptiveFlushStrategy(config, flusher, minSizeBytes, minCnt, strategy.mMaxSizeBytes);
+        }
+
         mFlusher = flusher;
+        mShardHashKeys = shardHashKeys;
 
         std::vector<std::pair<std::string, std::string>> labels{
             {METRIC_LABEL_KEY_PROJECT, ctx.GetProjectName()},
@@ -121,19 +148,47 @@ public:
         mBufferedEventsTotal = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_BUFFERED_EVENTS_TOTAL);
         mBufferedDataSizeByte = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_BUFFERED_SIZE_BYTES);
         mTotalAddTimeMs = mMetricsRecordRef.CreateTimeCounter(METRIC_COMPONENT_BATCHER_TOTAL_ADD_TIME_MS);
+        mTotalCpuTimeMs = mMetricsRecordRef.CreateShardedTimeCounter(METRIC_COMPONENT_TOTAL_CPU_TIME_MS);
+        if (mAdaptiveFlushStrategy) {
+            mTargetSizeBytes = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_TARGET_SIZE_BYTES);
+            mTargetCnt = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_TARGET_CNT);
+            mTargetSizeBytes->Set(mEventFlushStrategy.GetMinSizeBytes());
+            mTargetCnt->Set(mEventFlushStrategy.GetMinCnt());
+        }
+        if (!mShardHashKeys.empty()) {
+            mShardHashKeysTotal = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_SHARD_HASH_KEYS_TOTAL);
+            mMaxShardHashKeyBatchesTotal
+                = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_BATCHER_MAX_SHARD_HASH_KEY_BATCHES_TOTAL);
+        }
 
         return true;
     }
 
     // when group level batch is disabled, there should be only 1 element in BatchedEventsList
+    // event queues are striped by tags hash, so that groups with different tags can be added concurrently, while events
+    // with the same tags are still batched in order
     void Add(PipelineEventGroup&& g, std::vector<BatchedEventsList>& res) {
+        ScopedCpuTimer<ShardedTimeCounterPtr> cpuTimer(mTotalCpuTimeMs);
         auto before = std::chrono::system_clock::now();
-        std::lock_guard<std::mutex> lock(mMux);
+        if (mAdaptiveFlushStrategy) {
+            AdjustFlushStrategy();
+        }
         size_t key = g.GetTagsHash();
-        EventBatchItem<T>& item = mEventQueueMap[key];
+        // all events in the group share the same tags, so shard hash key is calculated only once per group
+        std::optional<uint64_t> shardHashKey;
+        if (!mShardHashKeys.empty()) {
+            shardHashKey = CalculateShardHashKey(g);
+        }
         mInEventsTotal->Add(g.GetEvents().size());
         mInGroupDataSizeBytes->Add(g.DataSize());
-        mEventBatchItemsTotal->Set(mEventQueueMap.size());
+
+        EventQueueStripe& stripe = GetStripe(key);
+        std::lock_guard<std::mutex> lock(stripe.mMux);
+        auto [iter, inserted] = stripe.mEventQueueMap.try_emplace(key);
+        if (inserted) {
+            mEventBatchItemsTotal->Add(1);
+        }
+        EventBatchItem<T>& item = iter->second;
 
         if (g.DataSize() > mEventFlushStrategy.GetMinSizeBytes()) {
             // for group size larger than min batch size, separate group only if size is larger than max batch size
@@ -145,6 +200,7 @@ public:
                 // should consider time condition here because sls require this
                 if (!item.IsEmpty() && mEventFlushStrategy.NeedFlushByTime(item.GetStatus(), e)) {
                     mOutEventsTotal->Add(item.EventSize());
+                    UpdateShardHashKeyMetrics(item);
                     item.Flush(res);
                 }
                 if (item.IsEmpty()) {
@@ -152,14 +208,19 @@ public:
                                g.GetSourceBuffer(),
                                g.GetExactlyOnceCheckpoint(),
                                g.GetMetadata(EventGroupMetaKey::SOURCE_ID));
+                    if (shardHashKey) {
+                        item.SetShardHashKey(*shardHashKey);
+                    }
                 }
                 item.Add(std::move(e));
                 if (mEventFlushStrategy.SizeReachingUpperLimit(item.GetStatus())) {
                     mOutEventsTotal->Add(item.EventSize());
+                    UpdateShardHashKeyMetrics(item);
                     item.Flush(res);
                 }
             }
             mOutEventsTotal->Add(item.EventSize());
+            UpdateShardHashKeyMetrics(item);
             item.Flush(res);
         } else {
             size_t eventsSize = g.GetEvents().size();
@@ -170,6 +231,7 @@ public:
                         UpdateMetricsOnFlushingEventQueue(item);
                         item.Flush(res);
                     } else {
+                        std::lock_guard<std::mutex> groupLock(mGroupMux);
                         if (!mGroupQueue->IsEmpty() && mGroupFlushStrategy->NeedFlushByTime(mGroupQueue->GetStatus())) {
                             UpdateMetricsOnFlushingGroupQueue();
                             mGroupQueue->Flush(res);
@@ -193,6 +255,9 @@ public:
                                g.GetSourceBuffer(),
                                g.GetExactlyOnceCheckpoint(),
                                g.GetMetadata(EventGroupMetaKey::SOURCE_ID));
+                    if (shardHashKey) {
+                        item.SetShardHashKey(*shardHashKey);
+                    }
                     TimeoutFlushManager::GetInstance()->UpdateRecord(mFlusher->GetContext().GetConfigName(),
                                                                      mFlusher->GetFlusherIndex(),
                                                                      key,
@@ -200,11 +265,15 @@ public:
                                                                      mFlusher);
                     mBufferedGroupsTotal->Add(1);
                     mBufferedDataSizeByte->Add(item.DataSize());
+                    MemoryBudget::GetInstance()->Add(MemoryBudget::Component::BATCHER, item.DataSize());
                 } else if (i == 0) {
                     item.AddSourceBuffer(g.GetSourceBuffer());
                 }
+                // read through const so that events shared with other flushers are not copied
+                auto eventSize = std::as_const(e)->DataSize();
                 mBufferedEventsTotal->Add(1);
-                mBufferedDataSizeByte->Add(e->DataSize());
+                mBufferedDataSizeByte->Add(eventSize);
+                MemoryBudget::GetInstance()->Add(MemoryBudget::Component::BATCHER, eventSize);
                 item.Add(std::move(e));
                 if (mEventFlushStrategy.NeedFlushBySize(item.GetStatus())
                     || mEventFlushStrategy.NeedFlushByCnt(item.GetStatus())) {
@@ -219,28 +288,31 @@ public:
     // key != 0: event level queue
     // key = 0: group level queue
     void FlushQueue(size_t key, BatchedEventsList& res) {
-        std::lock_guard<std::mutex> lock(mMux);
         if (key == 0) {
             if (!mGroupQueue) {
                 return;
             }
+            std::lock_guard<std::mutex> groupLock(mGroupMux);
             UpdateMetricsOnFlushingGroupQueue();
             return mGroupQueue->Flush(res);
         }
 
-        auto iter = mEventQueueMap.find(key);
-        if (iter == mEventQueueMap.end()) {
+        EventQueueStripe& stripe = GetStripe(key);
+        std::lock_guard<std::mutex> lock(stripe.mMux);
+        auto iter = stripe.mEventQueueMap.find(key);
+        if (iter == stripe.mEventQueueMap.end()) {
             return;
         }
 
         if (!mGroupQueue) {
             UpdateMetricsOnFlushingEventQueue(iter->second);
             iter->second.Flush(res);
-            mEventQueueMap.erase(iter);
-            mEventBatchItemsTotal->Set(mEventQueueMap.size());
+            stripe.mEventQueueMap.erase(iter);
+            mEventBatchItemsTotal->Sub(1);
             return;
         }
 
+        std::lock_guard<std::mutex> groupLock(mGroupMux);
         if (!mGroupQueue->IsEmpty() && mGroupFlushStrategy->NeedFlushByTime(mGroupQueue->GetStatus())) {
             UpdateMetricsOnFlushingGroupQueue();
             mGroupQueue->Flush(res);
@@ -253,8 +325,8 @@ public:
                                                              mFlusher);
         }
         iter->second.Flush(mGroupQueue.value());
-        mEventQueueMap.erase(iter);
-        mEventBatchItemsTotal->Set(mEventQueueMap.size());
+        stripe.mEventQueueMap.erase(iter);
+        mEventBatchItemsTotal->Sub(1);
         if (mGroupFlushStrategy->NeedFlushBySize(mGroupQueue->GetStatus())) {
             UpdateMetricsOnFlushingGroupQueue();
             mGroupQueue->Flush(res);
@@ -262,39 +334,159 @@ public:
     }
 
     void FlushAll(std::vector<BatchedEventsList>& res) {
-        std::lock_guard<std::mutex> lock(mMux);
-        for (auto& item : mEventQueueMap) {
-            if (!mGroupQueue) {
-                UpdateMetricsOnFlushingEventQueue(item.second);
-                item.second.Flush(res);
-            } else {
-                if (!mGroupQueue->IsEmpty() && mGroupFlushStrategy->NeedFlushByTime(mGroupQueue->GetStatus())) {
-                    UpdateMetricsOnFlushingGroupQueue();
-                    mGroupQueue->Flush(res);
-                }
-                item.second.Flush(mGroupQueue.value());
-                if (mGroupFlushStrategy->NeedFlushBySize(mGroupQueue->GetStatus())) {
-                    UpdateMetricsOnFlushingGroupQueue();
-                    mGroupQueue->Flush(res);
+        for (auto& stripe : mStripes) {
+            std::lock_guard<std::mutex> lock(stripe.mMux);
+            for (auto& item : stripe.mEventQueueMap) {
+                if (!mGroupQueue) {
+                    UpdateMetricsOnFlushingEventQueue(item.second);
+                    item.second.Flush(res);
+                } else {
+                    std::lock_guard<std::mutex> groupLock(mGroupMux);
+                    if (!mGroupQueue->IsEmpty() && mGroupFlushStrategy->NeedFlushByTime(mGroupQueue->GetStatus())) {
+                        UpdateMetricsOnFlushingGroupQueue();
+                        mGroupQueue->Flush(res);
+                    }
+                    item.second.Flush(mGroupQueue.value());
+                    if (mGroupFlushStrategy->NeedFlushBySize(mGroupQueue->GetStatus())) {
+                        UpdateMetricsOnFlushingGroupQueue();
+                        mGroupQueue->Flush(res);
+                    }
                 }
             }
+            mEventBatchItemsTotal->Sub(stripe.mEventQueueMap.size());
+            stripe.mEventQueueMap.clear();
         }
         if (mGroupQueue) {
+            std::lock_guard<std::mutex> groupLock(mGroupMux);
             UpdateMetricsOnFlushingGroupQueue();
             mGroupQueue->Flush(res);
         }
-        mEventBatchItemsTotal->Set(0);
-        mEventQueueMap.clear();
+    }
+
+    // feedback from the flusher on each successful request, used to tune batch size when adaptive batch is enabled
+    void OnSendDone(uint64_t responseTimeMs, size_t rawSize, size_t sentSize) {
+        if (mAdaptiveFlushStrategy) {
+            mAdaptiveFlushStrategy->OnSendDone(responseTimeMs, rawSize, sentSize);
+        }
     }
 
 #ifdef APSARA_UNIT_TEST_MAIN
     EventFlushStrategy<T>& GetEventFlushStrategy() { return mEventFlushStrategy; }
     std::optional<GroupFlushStrategy>& GetGroupFlushStrategy() { return mGroupFlushStrategy; }
+    size_t GetEventQueueCnt() {
+        size_t cnt = 0;
+        for (auto& stripe : mStripes) {
+            std::lock_guard<std::mutex> lock(stripe.mMux);
+            cnt += stripe.mEventQueueMap.size();
+        }
+        return cnt;
+    }
+    EventBatchItem<T>& GetEventQueue(size_t key) { return GetStripe(key).mEventQueueMap[key]; }
 #endif
 
 private:
+    void InitAdaptiveFlushStrategy(
+        const Json::Value& config, Flusher* flusher, uint32_t minSizeBytes, uint32_t minCnt, uint32_t maxSizeBytes) {
+        std::string errorMsg;
+        PipelineContext& ctx = flusher->GetContext();
+        if (minSizeBytes == 0) {
+            LOG_WARNING(ctx.GetLogger(),
+                        ("problem encountered in config parsing",
+                         "param EnableAdaptiveBatch is ignored because MinSizeBytes is 0")("module", flusher->Name())(
+                            "config", ctx.GetConfigName()));
+            return;
+        }
+
+        uint32_t adaptiveMinSizeBytes = std::max(minSizeBytes / 4, 1U);
+        if (!GetOptionalUIntParam(config, "AdaptiveMinSizeBytes", adaptiveMinSizeBytes, errorMsg)) {
+            PARAM_WARNING_DEFAULT(ctx.GetLogger(),
+                                  ctx.GetAlarm(),
+                                  errorMsg,
+                                  adaptiveMinSizeBytes,
+                                  flusher->Name(),
+                                  ctx.GetConfigName(),
+                                  ctx.GetProjectName(),
+                                  ctx.GetLogstoreName(),
+                                  ctx.GetRegion());
+        }
+        uint32_t adaptiveMaxSizeBytes = minSizeBytes > maxSizeBytes / 4 ? maxSizeBytes : minSizeBytes * 4;
+        if (!GetOptionalUIntParam(config, "AdaptiveMaxSizeBytes", adaptiveMaxSizeBytes, errorMsg)) {
+            PARAM_WARNING_DEFAULT(ctx.GetLogger(),
+                                  ctx.GetAlarm(),
+                                  errorMsg,
+                                  adaptiveMaxSizeBytes,
+                                  flusher->Name(),
+                                  ctx.GetConfigName(),
+                                  ctx.GetProjectName(),
+                                  ctx.GetLogstoreName(),
+                                  ctx.GetRegion());
+        }
+        uint32_t targetLatencyMs = 1000;
+        if (!GetOptionalUIntParam(config, "AdaptiveTargetLatencyMs", targetLatencyMs, errorMsg)) {
+            PARAM_WARNING_DEFAULT(ctx.GetLogger(),
+                                  ctx.GetAlarm(),
+                                  errorMsg,
+                                  targetLatencyMs,
+                                  flusher->Name(),
+                                  ctx.GetConfigName(),
+                                  ctx.GetProjectName(),
+                                  ctx.GetLogstoreName(),
+                                  ctx.GetRegion());
+        }
+        // batch size should never exceed the hard limit
+        adaptiveMaxSizeBytes = std::min(adaptiveMaxSizeBytes, maxSizeBytes);
+        if (adaptiveMinSizeBytes > adaptiveMaxSizeBytes) {
+            LOG_WARNING(ctx.GetLogger(),
+                        ("problem encountered in config parsing",
+                         "param AdaptiveMinSizeBytes is larger than AdaptiveMaxSizeBytes")(
+                            "action", "ignore param EnableAdaptiveBatch")("module", flusher->Name())(
+                            "config", ctx.GetConfigName()));
+            return;
+        }
+        mAdaptiveFlushStrategy.emplace(adaptiveMinSizeBytes, adaptiveMaxSizeBytes, minSizeBytes, targetLatencyMs);
+        mInitMinSizeBytes = minSizeBytes;
+        mInitMinCnt = minCnt;
+        AdjustFlushThresholds(mAdaptiveFlushStrategy->GetTargetSizeBytes());
+    }
+
+    void AdjustFlushStrategy() {
+        // only one thread adjusts at a time, others just go on with the current thresholds
+        std::unique_lock<std::mutex> adjustLock(mAdjustMux, std::try_to_lock);
+        if (!adjustLock.owns_lock()) {
+            return;
+        }
+        uint32_t targetSizeBytes = 0;
+        if (!mAdaptiveFlushStrategy->UpdateTarget(targetSizeBytes)) {
+            return;
+        }
+        // thresholds are read by all stripes, so all of them must be locked in order before modification
+        std::vector<std::unique_lock<std::mutex>> locks;
+        locks.reserve(sStripeCnt + 1);
+        for (auto& stripe : mStripes) {
+            locks.emplace_back(stripe.mMux);
+        }
+        locks.emplace_back(mGroupMux);
+        AdjustFlushThresholds(targetSizeBytes);
+        mTargetSizeBytes->Set(mEventFlushStrategy.GetMinSizeBytes());
+        mTargetCnt->Set(mEventFlushStrategy.GetMinCnt());
+    }
+
+    // min cnt is scaled together with min size, so that the size target is not bypassed by count
+    void AdjustFlushThresholds(uint32_t targetSizeBytes) {
+        mEventFlushStrategy.SetMinSizeBytes(targetSizeBytes);
+        if (mInitMinCnt != 0) {
+            uint64_t cnt = static_cast<uint64_t>(mInitMinCnt) * targetSizeBytes / mInitMinSizeBytes;
+            mEventFlushStrategy.SetMinCnt(static_cast<uint32_t>(
+                std::max<uint64_t>(1, std::min<uint64_t>(cnt, std::numeric_limits<uint32_t>::max()))));
+        }
+        if (mGroupFlushStrategy) {
+            mGroupFlushStrategy->SetMinSizeBytes(targetSizeBytes);
+        }
+    }
+
     void UpdateMetricsOnFlushingEventQueue(const EventBatchItem<T>& item) {
         mOutEventsTotal->Add(item.EventSize());
+        UpdateShardHashKeyMetrics(item);
         // mTotalDelayMs->Add(
         //     item.EventSize()
         //         * std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::system_clock::now())
@@ -304,6 +496,37 @@ private:
         mBufferedGroupsTotal->Sub(1);
         mBufferedEventsTotal->Sub(item.EventSize());
         mBufferedDataSizeByte->Sub(item.DataSize());
+        MemoryBudget::GetInstance()->Sub(MemoryBudget::Component::BATCHER, item.DataSize());
+    }
+
+    // values of ShardHashKeys are joined by chaining the seed, so that no temporary string is needed
+    uint64_t CalculateShardHashKey(const PipelineEventGroup& g) const {
+        uint64_t res = 0;
+        for (const auto& key : mShardHashKeys) {
+            StringView value = g.GetTag(key);
+            res = XXH64(value.data(), value.size(), res);
+        }
+        return res;
+    }
+
+    // batches flushed per shard hash key within a stat window, used to find out skewed keys
+    void UpdateShardHashKeyMetrics(const EventBatchItem<T>& item) {
+        if (!item.GetShardHashKey()) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mShardHashKeyStatMux);
+        time_t now = time(nullptr);
+        if (now - mShardHashKeyStatStartTime >= sShardHashKeyStatIntervalSecs) {
+            mShardHashKeyBatchCnts.clear();
+            mMaxShardHashKeyBatchCnt = 0;
+            mShardHashKeyStatStartTime = now;
+        }
+        uint32_t cnt = ++mShardHashKeyBatchCnts[*item.GetShardHashKey()];
+        mShardHashKeysTotal->Set(mShardHashKeyBatchCnts.size());
+        if (cnt > mMaxShardHashKeyBatchCnt) {
+            mMaxShardHashKeyBatchCnt = cnt;
+            mMaxShardHashKeyBatchesTotal->Set(cnt);
+        }
     }
 
     void UpdateMetricsOnFlushingGroupQueue() {
@@ -317,17 +540,39 @@ private:
         mBufferedGroupsTotal->Sub(mGroupQueue->GroupSize());
         mBufferedEventsTotal->Sub(mGroupQueue->EventSize());
         mBufferedDataSizeByte->Sub(mGroupQueue->DataSize());
+        MemoryBudget::GetInstance()->Sub(MemoryBudget::Component::BATCHER, mGroupQueue->DataSize());
     }
 
-    std::mutex mMux;
-    std::map<size_t, EventBatchItem<T>> mEventQueueMap;
+    struct EventQueueStripe {
+        std::mutex mMux;
+        std::map<size_t, EventBatchItem<T>> mEventQueueMap;
+    };
+
+    EventQueueStripe& GetStripe(size_t key) { return mStripes[key % sStripeCnt]; }
+
+    static constexpr size_t sStripeCnt = 16;
+    // lock order: stripes in ascending order, then group queue
+    std::array<EventQueueStripe, sStripeCnt> mStripes;
     EventFlushStrategy<T> mEventFlushStrategy;
 
+    std::mutex mGroupMux;
     std::optional<GroupBatchItem> mGroupQueue;
     std::optional<GroupFlushStrategy> mGroupFlushStrategy;
 
     Flusher* mFlusher = nullptr;
 
+    std::mutex mAdjustMux;
+    std::optional<AdaptiveFlushStrategy> mAdaptiveFlushStrategy;
+    uint32_t mInitMinSizeBytes = 0;
+    uint32_t mInitMinCnt = 0;
+
+    static constexpr time_t sShardHashKeyStatIntervalSecs = 60;
+    std::vector<std::string> mShardHashKeys;
+    std::mutex mShardHashKeyStatMux;
+    std::unordered_map<uint64_t, uint32_t> mShardHashKeyBatchCnts;
+    uint32_t mMaxShardHashKeyBatchCnt = 0;
+    time_t mShardHashKeyStatStartTime = 0;
+
     mutable MetricsRecordRef mMetricsRecordRef;
     CounterPtr mInEventsTotal;
     CounterPtr mInGroupDataSizeBytes;
@@ -338,6 +583,11 @@ private:
     IntGaugePtr mBufferedEventsTotal;
     IntGaugePtr mBufferedDataSizeByte;
     TimeCounterPtr mTotalAddTimeMs;
+    ShardedTimeCounterPtr mTotalCpuTimeMs;
+    IntGaugePtr mTargetSizeBytes;
+    IntGaugePtr mTargetCnt;
+    IntGaugePtr mShardHashKeysTotal;
+    IntGaugePtr mMaxShardHashKeyBatchesTotal;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class BatcherUnittest;
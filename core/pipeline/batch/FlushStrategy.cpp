@@ -14,10 +14,80 @@
 
 #include "pipeline/batch/FlushStrategy.h"
 
+#include <algorithm>
+
 using namespace std;
 
 namespace logtail {
 
+// weight of the latest sample in the moving average
+static constexpr double kSampleWeight = 0.2;
+static constexpr double kGrowFactor = 1.25;
+static constexpr double kShrinkFactor = 0.75;
+
+AdaptiveFlushStrategy::AdaptiveFlushStrategy(uint32_t minSizeBytes,
+                                             uint32_t maxSizeBytes,
+                                             uint32_t initSizeBytes,
+                                             uint32_t targetLatencyMs)
+    : mMinSizeBytes(minSizeBytes),
+      mMaxSizeBytes(maxSizeBytes),
+      mTargetLatencyMs(targetLatencyMs),
+      mTargetSizeBytes(min(max(initSizeBytes, minSizeBytes), maxSizeBytes)),
+      mLastAdjustTime(time(nullptr)) {
+}
+
+void AdaptiveFlushStrategy::OnSendDone(uint64_t responseTimeMs, size_t rawSize, size_t sentSize) {
+    lock_guard<mutex> lock(mMux);
+    if (mSampleCnt == 0) {
+        mLatencyMs = static_cast<double>(responseTimeMs);
+    } else {
+        mLatencyMs = (1 - kSampleWeight) * mLatencyMs + kSampleWeight * static_cast<double>(responseTimeMs);
+    }
+    if (rawSize > 0 && sentSize > 0) {
+        double ratio = static_cast<double>(sentSize) / static_cast<double>(rawSize);
+        mCompressionRatio = (1 - kSampleWeight) * mCompressionRatio + kSampleWeight * ratio;
+    }
+    ++mSampleCnt;
+}
+
+bool AdaptiveFlushStrategy::UpdateTarget(uint32_t& targetSizeBytes) {
+    time_t now = time(nullptr);
+    if (now - mLastAdjustTime < sAdjustIntervalSecs) {
+        return false;
+    }
+    double latencyMs = 0.0, ratio = 1.0;
+    {
+        lock_guard<mutex> lock(mMux);
+        if (mSampleCnt < sMinSampleCnt) {
+            return false;
+        }
+        latencyMs = mLatencyMs;
+        ratio = mCompressionRatio;
+        mSampleCnt = 0;
+    }
+    mLastAdjustTime = now;
+
+    ratio = max(ratio, 0.001);
+    if (mTargetSentBytes == 0.0) {
+        mTargetSentBytes = mTargetSizeBytes * ratio;
+    }
+    if (latencyMs > mTargetLatencyMs) {
+        mTargetSentBytes *= kShrinkFactor;
+    } else if (latencyMs < mTargetLatencyMs / 2.0) {
+        mTargetSentBytes *= kGrowFactor;
+    }
+    // when compression ratio changes, min batch size follows so that the size of data sent stays the same
+    uint32_t res = static_cast<uint32_t>(
+        min(max(mTargetSentBytes / ratio, static_cast<double>(mMinSizeBytes)), static_cast<double>(mMaxSizeBytes)));
+    // avoid accumulating beyond bounds
+    mTargetSentBytes = res * ratio;
+    if (res == mTargetSizeBytes) {
+        return false;
+    }
+    targetSizeBytes = mTargetSizeBytes = res;
+    return true;
+}
+
 template <>
 bool EventFlushStrategy<SLSEventBatchStatus>::NeedFlushByTime(const SLSEventBatchStatus& status,
                                                                      const PipelineEventPtr& e) {
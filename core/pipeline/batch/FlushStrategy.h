@@ -21,6 +21,7 @@
 #include <cstdint>
 #include <ctime>
 #include <limits>
+#include <mutex>
 
 #include "models/PipelineEventPtr.h"
 #include "pipeline/batch/BatchStatus.h"
@@ -48,7 +49,8 @@ public:
 
     // should be called after event is added
     bool NeedFlushBySize(const T& status) { return status.GetSize() >= mMinSizeBytes; }
-    bool NeedFlushByCnt(const T& status) { return status.GetCnt() == mMinCnt; }
+    // min cnt may be lowered by adaptive flush strategy when the batch is not empty, and 0 means no flush by cnt
+    bool NeedFlushByCnt(const T& status) { return mMinCnt != 0 && status.GetCnt() >= mMinCnt; }
     // should be called before event is added
     bool NeedFlushByTime(const T& status, const PipelineEventPtr& e) {
         return time(nullptr) - status.GetCreateTime() >= mTimeoutSecs;
@@ -83,6 +85,48 @@ private:
     uint32_t mTimeoutSecs = 0;
 };
 
+// AdaptiveFlushStrategy tunes the min batch size within [minSizeBytes, maxSizeBytes] according to the response time
+// and compression ratio of the requests sent. What matters to the backend is the size of data actually sent, so the
+// strategy keeps a target of sent bytes per request, which grows when the response time is well below the target
+// latency and shrinks when it exceeds the target. The min batch size is the sent target divided by the compression
+// ratio.
+class AdaptiveFlushStrategy {
+public:
+    static constexpr time_t sAdjustIntervalSecs = 5;
+    static constexpr uint32_t sMinSampleCnt = 3;
+
+    AdaptiveFlushStrategy(uint32_t minSizeBytes,
+                          uint32_t maxSizeBytes,
+                          uint32_t initSizeBytes,
+                          uint32_t targetLatencyMs);
+
+    // should be called when the request is successfully sent, sentSize is the size after compression
+    void OnSendDone(uint64_t responseTimeMs, size_t rawSize, size_t sentSize);
+    // return true if the target size is changed since last call
+    bool UpdateTarget(uint32_t& targetSizeBytes);
+
+    uint32_t GetTargetSizeBytes() const { return mTargetSizeBytes; }
+
+private:
+    const uint32_t mMinSizeBytes = 0;
+    const uint32_t mMaxSizeBytes = 0;
+    const uint32_t mTargetLatencyMs = 0;
+    uint32_t mTargetSizeBytes = 0;
+    double mTargetSentBytes = 0.0;
+    time_t mLastAdjustTime = 0;
+
+    // the following members are updated by sending thread
+    std::mutex mMux;
+    double mLatencyMs = 0.0;
+    double mCompressionRatio = 1.0;
+    uint32_t mSampleCnt = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class AdaptiveFlushStrategyUnittest;
+    friend class BatcherUnittest;
+#endif
+};
+
 template <>
 bool EventFlushStrategy<SLSEventBatchStatus>::NeedFlushByTime(const SLSEventBatchStatus& status,
                                                               const PipelineEventPtr& e);
@@ -0,0 +1,102 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pipeline/limiter/MemoryBudget.h"
+
+#include "app_config/AppConfig.h"
+#include "common/Flags.h"
+#include "monitor/metric_constants/MetricConstants.h"
+
+DEFINE_FLAG_INT64(pipeline_memory_budget_mb,
+                  "max memory in MB held by data in pipelines, 0 means half of the agent memory limit",
+                  0);
+
+using namespace std;
+
+namespace logtail {
+
+// fraction of the limit above which data from pipelines of the corresponding priority is blocked
+static constexpr double kPriorityThresholds[] = {0.9, 0.8, 0.7};
+
+MemoryBudget::MemoryBudget() {
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
+        mMetricsRecordRef,
+        MetricCategory::METRIC_CATEGORY_COMPONENT,
+        {{METRIC_LABEL_KEY_COMPONENT_NAME, METRIC_LABEL_VALUE_COMPONENT_NAME_MEMORY_BUDGET}});
+    mUsageGauges[static_cast<size_t>(Component::PROCESS_QUEUE)]
+        = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_MEMORY_BUDGET_PROCESS_QUEUE_SIZE_BYTES);
+    mUsageGauges[static_cast<size_t>(Component::BATCHER)]
+        = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_MEMORY_BUDGET_BATCHER_SIZE_BYTES);
+    mUsageGauges[static_cast<size_t>(Component::SENDER_QUEUE)]
+        = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_MEMORY_BUDGET_SENDER_QUEUE_SIZE_BYTES);
+    mTotalUsageGauge = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_MEMORY_BUDGET_TOTAL_SIZE_BYTES);
+    mLimitGauge = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_MEMORY_BUDGET_LIMIT_SIZE_BYTES);
+    mRejectedPushTimesTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_MEMORY_BUDGET_REJECTED_PUSH_TIMES_TOTAL);
+    mDiscardedGroupsTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_MEMORY_BUDGET_DISCARDED_GROUPS_TOTAL);
+}
+
+void MemoryBudget::Add(Component component, size_t bytes) {
+    if (bytes == 0) {
+        return;
+    }
+    auto idx = static_cast<size_t>(component);
+    mUsages[idx] += bytes;
+    mTotalUsage += bytes;
+    mUsageGauges[idx]->Add(bytes);
+    mTotalUsageGauge->Add(bytes);
+}
+
+void MemoryBudget::Sub(Component component, size_t bytes) {
+    if (bytes == 0) {
+        return;
+    }
+    auto idx = static_cast<size_t>(component);
+    mUsages[idx] -= bytes;
+    mTotalUsage -= bytes;
+    mUsageGauges[idx]->Sub(bytes);
+    mTotalUsageGauge->Sub(bytes);
+}
+
+size_t MemoryBudget::GetLimit() const {
+    int64_t limitMb = INT64_FLAG(pipeline_memory_budget_mb);
+    if (limitMb <= 0) {
+        limitMb = AppConfig::GetInstance()->GetMemUsageUpLimit() / 2;
+    }
+    return static_cast<size_t>(max<int64_t>(limitMb, 1)) * 1024 * 1024;
+}
+
+bool MemoryBudget::IsValidToPush(uint32_t priority) {
+    size_t limit = GetLimit();
+    mLimitGauge->Set(limit);
+    size_t maxIdx = sizeof(kPriorityThresholds) / sizeof(kPriorityThresholds[0]) - 1;
+    double threshold = kPriorityThresholds[min<size_t>(priority, maxIdx)];
+    if (mTotalUsage.load() < limit * threshold) {
+        return true;
+    }
+    mRejectedPushTimesTotal->Add(1);
+    return false;
+}
+
+#ifdef APSARA_UNIT_TEST_MAIN
+void MemoryBudget::Clear() {
+    for (size_t i = 0; i < mUsages.size(); ++i) {
+        mUsages[i] = 0;
+        mUsageGauges[i]->Set(0);
+    }
+    mTotalUsage = 0;
+    mTotalUsageGauge->Set(0);
+}
+#endif
+
+} // namespace logtail
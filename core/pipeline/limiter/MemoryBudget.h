@@ -0,0 +1,77 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "monitor/MetricManager.h"
+
+namespace logtail {
+
+// MemoryBudget accounts the bytes of data held by the pipelines, i.e., event groups in process queues, events buffered
+// in batchers and data held by sender queue items, against a global limit. When the usage approaches the limit,
+// bounded process queues of low priority pipelines are regarded as full first, so that inputs are blocked before the
+// agent exceeds its memory limit.
+class MemoryBudget {
+public:
+    enum class Component { PROCESS_QUEUE, BATCHER, SENDER_QUEUE, COUNT };
+
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+    static MemoryBudget* GetInstance() {
+        // never destructed, since items may still be released by other static objects on exit
+        static MemoryBudget* ptr = new MemoryBudget();
+        return ptr;
+    }
+
+    void Add(Component component, size_t bytes);
+    void Sub(Component component, size_t bytes);
+    // priority 0 is the highest, whose threshold is closest to the limit
+    bool IsValidToPush(uint32_t priority);
+    // called by pushers which can not wait, e.g., self monitor and ebpf, when data rejected by the budget is discarded
+    void AddDiscardedGroups(size_t cnt) { mDiscardedGroupsTotal->Add(cnt); }
+
+    size_t GetUsage() const { return mTotalUsage.load(); }
+    size_t GetUsage(Component component) const { return mUsages[static_cast<size_t>(component)].load(); }
+    size_t GetLimit() const;
+
+private:
+    MemoryBudget();
+    ~MemoryBudget() = default;
+
+    std::array<std::atomic_size_t, static_cast<size_t>(Component::COUNT)> mUsages{};
+    std::atomic_size_t mTotalUsage = 0;
+
+    mutable MetricsRecordRef mMetricsRecordRef;
+    std::array<IntGaugePtr, static_cast<size_t>(Component::COUNT)> mUsageGauges;
+    IntGaugePtr mTotalUsageGauge;
+    IntGaugePtr mLimitGauge;
+    CounterPtr mRejectedPushTimesTotal;
+    CounterPtr mDiscardedGroupsTotal;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    void Clear();
+
+    friend class MemoryBudgetUnittest;
+#endif
+};
+
+} // namespace logtail
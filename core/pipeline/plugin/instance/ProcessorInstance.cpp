@@ -21,6 +21,7 @@
 #include "common/TimeUtil.h"
 #include "logger/Logger.h"
 #include "monitor/metric_constants/MetricConstants.h"
+#include "monitor/metric_models/ScopedCpuTimer.h"
 
 using namespace std;
 
@@ -39,6 +40,7 @@ bool ProcessorInstance::Init(const Json::Value& config, PipelineContext& context
     mInSizeBytes = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_IN_SIZE_BYTES);
     mOutSizeBytes = mPlugin->GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_SIZE_BYTES);
     mTotalProcessTimeMs = mPlugin->GetMetricsRecordRef().CreateTimeCounter(METRIC_PLUGIN_TOTAL_PROCESS_TIME_MS);
+    mTotalCpuTimeMs = mPlugin->GetMetricsRecordRef().CreateShardedTimeCounter(METRIC_PLUGIN_TOTAL_CPU_TIME_MS);
 
     return true;
 }
@@ -53,7 +55,10 @@ void ProcessorInstance::Process(vector<PipelineEventGroup>& eventGroupList) {
     }
 
     auto before = chrono::system_clock::now();
-    mPlugin->Process(eventGroupList);
+    {
+        ScopedCpuTimer<ShardedTimeCounterPtr> cpuTimer(mTotalCpuTimeMs);
+        mPlugin->Process(eventGroupList);
+    }
     mTotalProcessTimeMs->Add(chrono::system_clock::now() - before);
 
     for (const auto& eventGroup : eventGroupList) {
@@ -15,6 +15,7 @@
 #include "pipeline/queue/BoundedProcessQueue.h"
 
 #include "pipeline/PipelineManager.h"
+#include "pipeline/limiter/MemoryBudget.h"
 
 using namespace std;
 
@@ -31,6 +32,12 @@ BoundedProcessQueue::BoundedProcessQueue(
     WriteMetrics::GetInstance()->CommitMetricsRecordRef(mMetricsRecordRef);
 }
 
+BoundedProcessQueue::~BoundedProcessQueue() {
+    for (const auto& item : mQueue) {
+        MemoryBudget::GetInstance()->Sub(MemoryBudget::Component::PROCESS_QUEUE, item->mEventGroup.DataSize());
+    }
+}
+
 bool BoundedProcessQueue::Push(unique_ptr<ProcessQueueItem>&& item) {
     if (!IsValidToPush()) {
         return false;
@@ -45,6 +52,7 @@ bool BoundedProcessQueue::Push(unique_ptr<ProcessQueueItem>&& item) {
     mQueueSizeTotal->Set(Size());
     mQueueDataSizeByte->Add(size);
     mValidToPushFlag->Set(IsValidToPush());
+    MemoryBudget::GetInstance()->Add(MemoryBudget::Component::PROCESS_QUEUE, size);
     return true;
 }
 
@@ -65,10 +73,14 @@ bool BoundedProcessQueue::Pop(unique_ptr<ProcessQueueItem>& item) {
     }
 
     mOutItemsTotal->Add(1);
-    mTotalDelayMs->Add(chrono::system_clock::now() - item->mEnqueTime);
+    auto delay = chrono::system_clock::now() - item->mEnqueTime;
+    mTotalDelayMs->Add(delay);
+    mDelayMs->Observe(delay);
     mQueueSizeTotal->Set(Size());
-    mQueueDataSizeByte->Sub(item->mEventGroup.DataSize());
+    auto size = item->mEventGroup.DataSize();
+    mQueueDataSizeByte->Sub(size);
     mValidToPushFlag->Set(IsValidToPush());
+    MemoryBudget::GetInstance()->Sub(MemoryBudget::Component::PROCESS_QUEUE, size);
     return true;
 }
 
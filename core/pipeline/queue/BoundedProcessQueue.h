@@ -33,6 +33,7 @@ class BoundedProcessQueue : public BoundedQueueInterface<std::unique_ptr<Process
 public:
     BoundedProcessQueue(
         size_t cap, size_t low, size_t high, int64_t key, uint32_t priority, const PipelineContext& ctx);
+    ~BoundedProcessQueue() override;
 
     bool Push(std::unique_ptr<ProcessQueueItem>&& item) override;
     bool Pop(std::unique_ptr<ProcessQueueItem>& item) override;
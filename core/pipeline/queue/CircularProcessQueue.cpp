@@ -16,6 +16,7 @@
 
 #include "logger/Logger.h"
 #include "pipeline/PipelineManager.h"
+#include "pipeline/limiter/MemoryBudget.h"
 #include "pipeline/queue/QueueKeyManager.h"
 
 using namespace std;
@@ -29,6 +30,12 @@ CircularProcessQueue::CircularProcessQueue(size_t cap, int64_t key, uint32_t pri
     WriteMetrics::GetInstance()->CommitMetricsRecordRef(mMetricsRecordRef);
 }
 
+CircularProcessQueue::~CircularProcessQueue() {
+    for (const auto& item : mQueue) {
+        MemoryBudget::GetInstance()->Sub(MemoryBudget::Component::PROCESS_QUEUE, item->mEventGroup.DataSize());
+    }
+}
+
 bool CircularProcessQueue::Push(unique_ptr<ProcessQueueItem>&& item) {
     size_t newCnt = item->mEventGroup.GetEvents().size();
     while (!mQueue.empty() && mEventCnt + newCnt > mCapacity) {
@@ -39,6 +46,7 @@ bool CircularProcessQueue::Push(unique_ptr<ProcessQueueItem>&& item) {
         mQueueSizeTotal->Set(Size());
         mQueueDataSizeByte->Sub(size);
         mDiscardedEventsTotal->Add(cnt);
+        MemoryBudget::GetInstance()->Sub(MemoryBudget::Component::PROCESS_QUEUE, size);
     }
     if (mEventCnt + newCnt > mCapacity) {
         return false;
@@ -52,6 +60,7 @@ bool CircularProcessQueue::Push(unique_ptr<ProcessQueueItem>&& item) {
     mInItemDataSizeBytes->Add(size);
     mQueueSizeTotal->Set(Size());
     mQueueDataSizeByte->Add(size);
+    MemoryBudget::GetInstance()->Add(MemoryBudget::Component::PROCESS_QUEUE, size);
     return true;
 }
 
@@ -70,9 +79,13 @@ bool CircularProcessQueue::Pop(unique_ptr<ProcessQueueItem>& item) {
     mEventCnt -= item->mEventGroup.GetEvents().size();
 
     mOutItemsTotal->Add(1);
-    mTotalDelayMs->Add(std::chrono::system_clock::now() - item->mEnqueTime);
+    auto delay = std::chrono::system_clock::now() - item->mEnqueTime;
+    mTotalDelayMs->Add(delay);
+    mDelayMs->Observe(delay);
     mQueueSizeTotal->Set(Size());
-    mQueueDataSizeByte->Sub(item->mEventGroup.DataSize());
+    auto size = item->mEventGroup.DataSize();
+    mQueueDataSizeByte->Sub(size);
+    MemoryBudget::GetInstance()->Sub(MemoryBudget::Component::PROCESS_QUEUE, size);
     return true;
 }
 
@@ -90,6 +103,9 @@ void CircularProcessQueue::Reset(size_t cap) {
     uint32_t cnt = 0;
     while (!mQueue.empty() && mEventCnt > cap) {
         mEventCnt -= mQueue.front()->mEventGroup.GetEvents().size();
+        auto size = mQueue.front()->mEventGroup.DataSize();
+        mQueueDataSizeByte->Sub(size);
+        MemoryBudget::GetInstance()->Sub(MemoryBudget::Component::PROCESS_QUEUE, size);
         mQueue.pop_front();
         ++cnt;
     }
@@ -30,6 +30,7 @@ class CircularProcessQueue : virtual public QueueInterface<std::unique_ptr<Proce
                              public ProcessQueueInterface {
 public:
     CircularProcessQueue(size_t cap, int64_t key, uint32_t priority, const PipelineContext& ctx);
+    ~CircularProcessQueue() override;
 
     bool Push(std::unique_ptr<ProcessQueueItem>&& item) override;
     bool Pop(std::unique_ptr<ProcessQueueItem>& item) override;
@@ -15,6 +15,7 @@
 #include "pipeline/queue/ProcessQueueManager.h"
 
 #include "common/Flags.h"
+#include "pipeline/limiter/MemoryBudget.h"
 #include "pipeline/queue/BoundedProcessQueue.h"
 #include "pipeline/queue/CircularProcessQueue.h"
 #include "pipeline/queue/ExactlyOnceQueueManager.h"
@@ -101,7 +102,8 @@ bool ProcessQueueManager::IsValidToPush(QueueKey key) const {
     auto iter = mQueues.find(key);
     if (iter != mQueues.end()) {
         if (iter->second.second == QueueType::BOUNDED) {
-            return static_cast<BoundedProcessQueue*>(iter->second.first->get())->IsValidToPush();
+            return static_cast<BoundedProcessQueue*>(iter->second.first->get())->IsValidToPush()
+                && MemoryBudget::GetInstance()->IsValidToPush((*iter->second.first)->GetPriority());
         } else {
             return true;
         }
@@ -114,6 +116,11 @@ int ProcessQueueManager::PushQueue(QueueKey key, unique_ptr<ProcessQueueItem>&&
         lock_guard<mutex> lock(mQueueMux);
         auto iter = mQueues.find(key);
         if (iter != mQueues.end()) {
+            // circular queues bound themselves by discarding old data, so memory budget only applies to bounded ones
+            if (iter->second.second == QueueType::BOUNDED
+                && !MemoryBudget::GetInstance()->IsValidToPush((*iter->second.first)->GetPriority())) {
+                return 3;
+            }
             if (!(*iter->second.first)->Push(std::move(item))) {
                 return 1;
             }
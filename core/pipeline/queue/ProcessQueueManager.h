@@ -56,7 +56,7 @@ public:
     bool CreateOrUpdateCircularQueue(QueueKey key, uint32_t priority, size_t capacity, const PipelineContext& ctx);
     bool DeleteQueue(QueueKey key);
     bool IsValidToPush(QueueKey key) const;
-    // 0: success, 1: queue is full, 2: queue not found
+    // 0: success, 1: queue is full, 2: queue not found, 3: rejected by memory budget
     int PushQueue(QueueKey key, std::unique_ptr<ProcessQueueItem>&& item);
     bool PopItem(int64_t threadNo, std::unique_ptr<ProcessQueueItem>& item, std::string& configName);
     bool IsAllQueueEmpty() const;
@@ -93,6 +93,7 @@ private:
     void Clear();
     friend class ProcessQueueManagerUnittest;
     friend class PipelineUnittest;
+    friend class MemoryBudgetUnittest;
 #endif
 };
 
@@ -38,6 +38,7 @@ public:
         mInItemDataSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_IN_SIZE_BYTES);
         mOutItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_OUT_ITEMS_TOTAL);
         mTotalDelayMs = mMetricsRecordRef.CreateTimeCounter(METRIC_COMPONENT_TOTAL_DELAY_MS);
+        mDelayMs = mMetricsRecordRef.CreateHistogram(METRIC_COMPONENT_DELAY_MS);
         mQueueSizeTotal = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_QUEUE_SIZE);
         mQueueDataSizeByte = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_QUEUE_SIZE_BYTES);
     }
@@ -64,6 +65,7 @@ protected:
     CounterPtr mInItemDataSizeBytes;
     CounterPtr mOutItemsTotal;
     TimeCounterPtr mTotalDelayMs;
+    HistogramPtr mDelayMs;
     IntGaugePtr mQueueSizeTotal;
     IntGaugePtr mQueueDataSizeByte;
 
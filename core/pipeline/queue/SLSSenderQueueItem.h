@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <cstdint>
+#include <optional>
+#include <string>
+
 #include "checkpoint/RangeCheckpoint.h"
 #include "pipeline/queue/SenderQueueItem.h"
 
@@ -26,6 +30,8 @@ class Pipeline;
 
 struct SLSSenderQueueItem : public SenderQueueItem {
     std::string mShardHashKey;
+    // digest calculated by batcher, only converted to hex string when needed
+    std::optional<uint64_t> mShardHashKeyDigest;
     // it normally equals to flusher_sls.Logstore, except for the following situations:
     // 1. when route is enabled in Go pipeline, it is designated explicitly
     // 2. self telemetry data from C++ pipelines
@@ -51,6 +57,22 @@ struct SLSSenderQueueItem : public SenderQueueItem {
           mExactlyOnceCheckpoint(std::move(exactlyOnceCheckpoint)) {}
 
     SenderQueueItem* Clone() override { return new SLSSenderQueueItem(*this); }
+
+    std::string GetShardHashKey() const {
+        if (!mShardHashKeyDigest) {
+            return mShardHashKey;
+        }
+        // shard hash key should be 128-bit hex string, the digest is placed at the high bits so that shards can be
+        // located by range
+        static const char* table = "0123456789ABCDEF";
+        std::string res(32, '0');
+        uint64_t digest = *mShardHashKeyDigest;
+        for (int i = 15; i >= 0; --i) {
+            res[i] = table[digest & 0x0F];
+            digest >>= 4;
+        }
+        return res;
+    }
 };
 
 } // namespace logtail
@@ -0,0 +1,55 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pipeline/queue/SenderQueueItem.h"
+
+#include "common/memory/BufferPool.h"
+#include "pipeline/limiter/MemoryBudget.h"
+
+namespace logtail {
+
+SenderQueueItem::SenderQueueItem(
+    std::string&& data, size_t rawSize, Flusher* flusher, QueueKey key, RawDataType type, bool bufferOrNot)
+    : mData(std::move(data)),
+      mRawSize(rawSize),
+      mType(type),
+      mBufferOrNot(bufferOrNot),
+      mFlusher(flusher),
+      mQueueKey(key),
+      mStatus(SendingStatus::IDLE) {
+    MemoryBudget::GetInstance()->Add(MemoryBudget::Component::SENDER_QUEUE, mData.size());
+}
+
+SenderQueueItem::SenderQueueItem(const SenderQueueItem& item)
+    : mData(item.mData),
+      mDataMd5(item.mDataMd5),
+      mRawSize(item.mRawSize),
+      mType(item.mType),
+      mBufferOrNot(item.mBufferOrNot),
+      mPipeline(item.mPipeline),
+      mFlusher(item.mFlusher),
+      mQueueKey(item.mQueueKey),
+      mStatus(item.mStatus.load()),
+      mFirstEnqueTime(item.mFirstEnqueTime),
+      mLastSendTime(item.mLastSendTime),
+      mTryCnt(item.mTryCnt) {
+    MemoryBudget::GetInstance()->Add(MemoryBudget::Component::SENDER_QUEUE, mData.size());
+}
+
+SenderQueueItem::~SenderQueueItem() {
+    MemoryBudget::GetInstance()->Sub(MemoryBudget::Component::SENDER_QUEUE, mData.size());
+    BufferPool::GetInstance()->Release(std::move(mData));
+}
+
+} // namespace logtail
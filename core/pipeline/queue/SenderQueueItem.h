@@ -34,6 +34,8 @@ enum class RawDataType { EVENT_GROUP_LIST, EVENT_GROUP }; // the order must not
 
 struct SenderQueueItem {
     std::string mData;
+    // hex md5 of data, calculated in advance by some flushers so that it is not calculated on the sending thread
+    std::string mDataMd5;
     size_t mRawSize = 0;
     RawDataType mType = RawDataType::EVENT_GROUP;
     bool mBufferOrNot = true;
@@ -46,34 +48,18 @@ struct SenderQueueItem {
     std::chrono::system_clock::time_point mLastSendTime;
     uint32_t mTryCnt = 1;
 
+    // size of data is accounted in memory budget during the lifetime of the item
     SenderQueueItem(std::string&& data,
                     size_t rawSize,
                     Flusher* flusher,
                     QueueKey key,
                     RawDataType type = RawDataType::EVENT_GROUP,
-                    bool bufferOrNot = true)
-        : mData(std::move(data)),
-          mRawSize(rawSize),
-          mType(type),
-          mBufferOrNot(bufferOrNot),
-          mFlusher(flusher),
-          mQueueKey(key),
-          mStatus(SendingStatus::IDLE) {}
-    virtual ~SenderQueueItem() = default;
+                    bool bufferOrNot = true);
+    // data is given back to BufferPool, so that it can be reused for the next serialization
+    virtual ~SenderQueueItem();
 
     // for Clone only
-    SenderQueueItem(const SenderQueueItem& item)
-        : mData(item.mData),
-          mRawSize(item.mRawSize),
-          mType(item.mType),
-          mBufferOrNot(item.mBufferOrNot),
-          mPipeline(item.mPipeline),
-          mFlusher(item.mFlusher),
-          mQueueKey(item.mQueueKey),
-          mStatus(item.mStatus.load()),
-          mFirstEnqueTime(item.mFirstEnqueTime),
-          mLastSendTime(item.mLastSendTime),
-          mTryCnt(item.mTryCnt) {}
+    SenderQueueItem(const SenderQueueItem& item);
 
     virtual SenderQueueItem* Clone() { return new SenderQueueItem(*this); }
 };
@@ -15,6 +15,7 @@
 #include "pipeline/route/Condition.h"
 
 #include "common/ParamExtractor.h"
+#include "common/StringTools.h"
 
 using namespace std;
 
@@ -112,6 +113,100 @@ void TagCondition::DiscardTagIfRequired(PipelineEventGroup& g) const {
     }
 }
 
+bool ContentCondition::Init(const Json::Value& config, const PipelineContext& ctx) {
+    string errorMsg;
+
+    // Key
+    if (!GetMandatoryStringParam(config, "Match.Key", mKey, errorMsg)) {
+        PARAM_ERROR_RETURN(ctx.GetLogger(),
+                           ctx.GetAlarm(),
+                           errorMsg,
+                           noModule,
+                           ctx.GetConfigName(),
+                           ctx.GetProjectName(),
+                           ctx.GetLogstoreName(),
+                           ctx.GetRegion());
+    }
+
+    // Value
+    if (!GetMandatoryStringParam(config, "Match.Value", mValue, errorMsg)) {
+        PARAM_ERROR_RETURN(ctx.GetLogger(),
+                           ctx.GetAlarm(),
+                           errorMsg,
+                           noModule,
+                           ctx.GetConfigName(),
+                           ctx.GetProjectName(),
+                           ctx.GetLogstoreName(),
+                           ctx.GetRegion());
+    }
+
+    // Operator
+    string op = "equals";
+    if (!GetOptionalStringParam(config, "Match.Operator", op, errorMsg)) {
+        PARAM_ERROR_RETURN(ctx.GetLogger(),
+                           ctx.GetAlarm(),
+                           errorMsg,
+                           noModule,
+                           ctx.GetConfigName(),
+                           ctx.GetProjectName(),
+                           ctx.GetLogstoreName(),
+                           ctx.GetRegion());
+    }
+    if (op == "equals") {
+        mOperator = Operator::EQUALS;
+    } else if (op == "prefix") {
+        mOperator = Operator::PREFIX;
+    } else if (op == "regex") {
+        if (!IsRegexValid(mValue)) {
+            PARAM_ERROR_RETURN(ctx.GetLogger(),
+                               ctx.GetAlarm(),
+                               "string param Match.Value is not a valid regex",
+                               noModule,
+                               ctx.GetConfigName(),
+                               ctx.GetProjectName(),
+                               ctx.GetLogstoreName(),
+                               ctx.GetRegion());
+        }
+        mOperator = Operator::REGEX;
+        mReg = boost::regex(mValue);
+    } else {
+        PARAM_ERROR_RETURN(ctx.GetLogger(),
+                           ctx.GetAlarm(),
+                           "string param Match.Operator is not valid",
+                           noModule,
+                           ctx.GetConfigName(),
+                           ctx.GetProjectName(),
+                           ctx.GetLogstoreName(),
+                           ctx.GetRegion());
+    }
+
+    return true;
+}
+
+bool ContentCondition::Check(const PipelineEventPtr& e) const {
+    if (!e.Is<LogEvent>()) {
+        return false;
+    }
+    const auto& log = e.Cast<LogEvent>();
+    auto it = log.FindContent(mKey);
+    if (it == log.cend()) {
+        return false;
+    }
+    StringView content = it->second;
+    switch (mOperator) {
+        case Operator::EQUALS:
+            return content == mValue;
+        case Operator::PREFIX:
+            return content.starts_with(StringView(mValue));
+        case Operator::REGEX: {
+            string exception;
+            return BoostRegexMatch(content.data(), content.size(), mReg, exception);
+        }
+        default:
+            return false;
+    }
+}
+
 bool Condition::Init(const Json::Value& config, const PipelineContext& ctx) {
     string errorMsg;
 
@@ -141,6 +236,8 @@ bool Condition::Init(const Json::Value& config, const PipelineContext& ctx) {
         mType = Type::EVENT_TYPE;
     } else if (type == "tag") {
         mType = Type::TAG;
+    } else if (type == "content") {
+        mType = Type::CONTENT;
     } else {
         PARAM_ERROR_RETURN(ctx.GetLogger(),
                            ctx.GetAlarm(),
@@ -163,6 +260,11 @@ bool Condition::Init(const Json::Value& config, const PipelineContext& ctx) {
                 return false;
             }
             break;
+        case Type::CONTENT:
+            if (!mDetail.emplace<ContentCondition>().Init(config, ctx)) {
+                return false;
+            }
+            break;
         default:
             return false;
     }
@@ -181,6 +283,15 @@ bool Condition::Check(const PipelineEventGroup& g) const {
     }
 }
 
+bool Condition::Check(const PipelineEventPtr& e) const {
+    switch (mType) {
+        case Type::CONTENT:
+            return get_if<ContentCondition>(&mDetail)->Check(e);
+        default:
+            return false;
+    }
+}
+
 void Condition::GetResult(PipelineEventGroup& g) const {
     switch (mType) {
         case Type::TAG:
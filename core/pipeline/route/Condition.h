@@ -18,6 +18,8 @@
 
 #include <json/json.h>
 
+#include <boost/regex.hpp>
+#include <string>
 #include <variant>
 
 #include "models/PipelineEventGroup.h"
@@ -55,17 +57,40 @@ private:
 #endif
 };
 
+// ContentCondition is checked against each log event instead of the whole group, events of other types never match
+class ContentCondition {
+public:
+    bool Init(const Json::Value& config, const PipelineContext& ctx);
+    bool Check(const PipelineEventPtr& e) const;
+
+private:
+    enum class Operator { EQUALS, PREFIX, REGEX };
+
+    std::string mKey;
+    std::string mValue;
+    Operator mOperator = Operator::EQUALS;
+    boost::regex mReg;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ContentConditionUnittest;
+#endif
+};
+
 class Condition {
 public:
     bool Init(const Json::Value& config, const PipelineContext& ctx);
+    bool IsEventLevel() const { return mType == Type::CONTENT; }
+    // for group level condition
     bool Check(const PipelineEventGroup& g) const;
+    // for event level condition
+    bool Check(const PipelineEventPtr& e) const;
     void GetResult(PipelineEventGroup& g) const;
 
 private:
-    enum class Type { EVENT_TYPE, TAG };
+    enum class Type { EVENT_TYPE, TAG, CONTENT };
 
     Type mType;
-    std::variant<EventTypeCondition, TagCondition> mDetail;
+    std::variant<EventTypeCondition, TagCondition, ContentCondition> mDetail;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ConditionUnittest;
@@ -26,10 +26,15 @@ namespace logtail {
 bool Router::Init(std::vector<pair<size_t, const Json::Value*>> configs, const PipelineContext& ctx) {
     for (auto& item : configs) {
         if (item.second != nullptr) {
-            mConditions.emplace_back(item.first, Condition());
-            if (!mConditions.back().second.Init(*item.second, ctx)) {
+            Condition cond;
+            if (!cond.Init(*item.second, ctx)) {
                 return false;
             }
+            if (cond.IsEventLevel()) {
+                mEventConditions.emplace_back(item.first, std::move(cond));
+            } else {
+                mConditions.emplace_back(item.first, std::move(cond));
+            }
         } else {
             mAlwaysMatchedFlusherIdx.push_back(item.first);
         }
@@ -43,6 +48,7 @@ bool Router::Init(std::vector<pair<size_t, const Json::Value*>> configs, const P
          {METRIC_LABEL_KEY_COMPONENT_NAME, METRIC_LABEL_VALUE_COMPONENT_NAME_ROUTER}});
     mInEventsTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_IN_EVENTS_TOTAL);
     mInGroupDataSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_IN_SIZE_BYTES);
+    mPartitionedEventsTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_ROUTER_PARTITIONED_EVENTS_TOTAL);
     return true;
 }
 
@@ -58,13 +64,19 @@ vector<pair<size_t, PipelineEventGroup>> Router::Route(PipelineEventGroup& g) co
     }
     auto resSz = dest.size() + mAlwaysMatchedFlusherIdx.size();
 
+    // events are shared among destinations and only copied when modified by some flusher, while tags are copied for
+    // each destination so that they can be discarded independently
     vector<pair<size_t, PipelineEventGroup>> res;
-    res.reserve(resSz);
+    res.reserve(resSz + mEventConditions.size());
+    if (!mEventConditions.empty()) {
+        // must be done before the original group is moved to its last destination
+        Partition(g, resSz > 0, res);
+    }
     for (size_t i = 0; i < mAlwaysMatchedFlusherIdx.size(); ++i, --resSz) {
         if (resSz == 1) {
             res.emplace_back(mAlwaysMatchedFlusherIdx[i], std::move(g));
         } else {
-            res.emplace_back(mAlwaysMatchedFlusherIdx[i], g.Copy());
+            res.emplace_back(mAlwaysMatchedFlusherIdx[i], g.Share());
         }
     }
     for (size_t i = 0; i < dest.size(); ++i, --resSz) {
@@ -72,12 +84,54 @@ vector<pair<size_t, PipelineEventGroup>> Router::Route(PipelineEventGroup& g) co
             mConditions[dest[i]].second.GetResult(g);
             res.emplace_back(dest[i], std::move(g));
         } else {
-            auto copy = g.Copy();
-            mConditions[dest[i]].second.GetResult(copy);
-            res.emplace_back(dest[i], std::move(copy));
+            auto shared = g.Share();
+            mConditions[dest[i]].second.GetResult(shared);
+            res.emplace_back(dest[i], std::move(shared));
         }
     }
     return res;
 }
 
+void Router::Partition(PipelineEventGroup& g, bool keepOriginal, vector<pair<size_t, PipelineEventGroup>>& res) const {
+    vector<PipelineEventGroup> parts;
+    parts.reserve(mEventConditions.size());
+    for (size_t i = 0; i < mEventConditions.size(); ++i) {
+        parts.emplace_back(g.GetSourceBuffer());
+        auto& part = parts.back();
+        part.SetAllMetadata(g.GetAllMetadata());
+        part.GetSizedTags() = g.GetSizedTags();
+    }
+
+    // single pass over events, an event matched by several conditions is shared rather than copied, and is moved to
+    // its only destination if the original group is not needed anymore
+    vector<size_t> matched;
+    matched.reserve(mEventConditions.size());
+    size_t partitionedCnt = 0;
+    for (auto& e : g.MutableEvents()) {
+        matched.clear();
+        for (size_t i = 0; i < mEventConditions.size(); ++i) {
+            if (mEventConditions[i].second.Check(e)) {
+                matched.push_back(i);
+            }
+        }
+        for (size_t i = 0; i < matched.size(); ++i) {
+            auto& events = parts[matched[i]].MutableEvents();
+            if (!keepOriginal && i + 1 == matched.size()) {
+                events.emplace_back(std::move(e));
+            } else {
+                events.emplace_back(e.Share());
+            }
+            events.back().ResetPipelineEventGroup(&parts[matched[i]]);
+        }
+        partitionedCnt += matched.size();
+    }
+    mPartitionedEventsTotal->Add(partitionedCnt);
+
+    for (size_t i = 0; i < parts.size(); ++i) {
+        if (!parts[i].GetEvents().empty()) {
+            res.emplace_back(mEventConditions[i].first, std::move(parts[i]));
+        }
+    }
+}
+
 } // namespace logtail
@@ -35,12 +35,19 @@ public:
     std::vector<std::pair<size_t, PipelineEventGroup>> Route(PipelineEventGroup& g) const;
 
 private:
+    void Partition(PipelineEventGroup& g,
+                   bool keepOriginal,
+                   std::vector<std::pair<size_t, PipelineEventGroup>>& res) const;
+
     std::vector<std::pair<size_t, Condition>> mConditions;
+    // conditions checked against each event, matched events are partitioned into a new group for each flusher
+    std::vector<std::pair<size_t, Condition>> mEventConditions;
     std::vector<size_t> mAlwaysMatchedFlusherIdx;
 
     mutable MetricsRecordRef mMetricsRecordRef;
     CounterPtr mInEventsTotal;
     CounterPtr mInGroupDataSizeBytes;
+    CounterPtr mPartitionedEventsTotal;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class RouterUnittest;
@@ -29,7 +29,9 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
         return false;
     }
 
-    PipelineEvent::Type eventType = group.mEvents[0]->GetType();
+    // events may be shared with other flushers, so they should only be accessed through const reference
+    const auto& events = group.mEvents;
+    PipelineEvent::Type eventType = events[0]->GetType();
     if (eventType == PipelineEvent::Type::NONE) {
         // should not happen
         errorMsg = "unsupported event type in event group";
@@ -45,7 +47,7 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
     switch (eventType) {
         case PipelineEvent::Type::LOG:
             for (size_t i = 0; i < group.mEvents.size(); ++i) {
-                const auto& e = group.mEvents[i].Cast<LogEvent>();
+                const auto& e = events[i].Cast<LogEvent>();
                 Json::Value eventJson;
                 // tags
                 eventJson.copy(groupTags);
@@ -62,7 +64,7 @@ bool JsonEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, str
             break;
         case PipelineEvent::Type::METRIC:
             for (size_t i = 0; i < group.mEvents.size(); ++i) {
-                const auto& e = group.mEvents[i].Cast<MetricEvent>();
+                const auto& e = events[i].Cast<MetricEvent>();
                 if (e.Is<std::monostate>()) {
                     continue;
                 }
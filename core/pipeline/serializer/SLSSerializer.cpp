@@ -66,7 +66,9 @@ bool Serializer<vector<CompressedLogGroup>>::DoSerialize(vector<CompressedLogGro
 
     auto before = std::chrono::system_clock::now();
     auto res = Serialize(std::move(p), output, errorMsg);
-    mTotalProcessMs->Add(std::chrono::system_clock::now() - before);
+    auto cost = std::chrono::system_clock::now() - before;
+    mTotalProcessMs->Add(cost);
+    mProcessMs->Observe(cost);
 
     if (res) {
         mOutItemsTotal->Add(1);
@@ -84,7 +86,9 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
         return false;
     }
 
-    PipelineEvent::Type eventType = group.mEvents[0]->GetType();
+    // events may be shared with other flushers, so they should only be accessed through const reference
+    const auto& events = group.mEvents;
+    PipelineEvent::Type eventType = events[0]->GetType();
     if (eventType == PipelineEvent::Type::NONE) {
         // should not happen
         errorMsg = "unsupported event type in event group";
@@ -101,7 +105,7 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
     switch (eventType) {
         case PipelineEvent::Type::LOG: {
             for (size_t i = 0; i < group.mEvents.size(); ++i) {
-                const auto& e = group.mEvents[i].Cast<LogEvent>();
+                const auto& e = events[i].Cast<LogEvent>();
                 if (e.Empty()) {
                     continue;
                 }
@@ -115,7 +119,7 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
         }
         case PipelineEvent::Type::METRIC: {
             for (size_t i = 0; i < group.mEvents.size(); ++i) {
-                const auto& e = group.mEvents[i].Cast<MetricEvent>();
+                const auto& e = events[i].Cast<MetricEvent>();
                 if (e.Is<UntypedSingleValue>()) {
                     metricEventContentCache[i].first = to_string(e.GetValue<UntypedSingleValue>()->mValue);
                 } else {
@@ -140,7 +144,7 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
         }
         case PipelineEvent::Type::SPAN:
             for (size_t i = 0; i < group.mEvents.size(); ++i) {
-                const auto& e = group.mEvents[i].Cast<SpanEvent>();
+                const auto& e = events[i].Cast<SpanEvent>();
                 size_t contentSZ = 0;
                 contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_TRACE_ID.size(), e.GetTraceId().size());
                 contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_SPAN_ID.size(), e.GetSpanId().size());
@@ -185,7 +189,7 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
             break;
         case PipelineEvent::Type::RAW:
             for (size_t i = 0; i < group.mEvents.size(); ++i) {
-                const auto& e = group.mEvents[i].Cast<RawEvent>();
+                const auto& e = events[i].Cast<RawEvent>();
                 if (e.GetContent().empty()) {
                     continue;
                 }
@@ -222,7 +226,7 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
     switch (eventType) {
         case PipelineEvent::Type::LOG:
             for (size_t i = 0; i < group.mEvents.size(); ++i) {
-                const auto& e = group.mEvents[i].Cast<LogEvent>();
+                const auto& e = events[i].Cast<LogEvent>();
                 serializer.StartToAddLog(logSZ[i]);
                 serializer.AddLogTime(e.GetTimestamp());
                 for (const auto& kv : e) {
@@ -235,7 +239,7 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
             break;
         case PipelineEvent::Type::METRIC:
             for (size_t i = 0; i < group.mEvents.size(); ++i) {
-                const auto& e = group.mEvents[i].Cast<MetricEvent>();
+                const auto& e = events[i].Cast<MetricEvent>();
                 if (e.Is<std::monostate>()) {
                     continue;
                 }
@@ -249,7 +253,7 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
             break;
         case PipelineEvent::Type::SPAN:
             for (size_t i = 0; i < group.mEvents.size(); ++i) {
-                const auto& spanEvent = group.mEvents[i].Cast<SpanEvent>();
+                const auto& spanEvent = events[i].Cast<SpanEvent>();
 
                 serializer.StartToAddLog(logSZ[i]);
                 serializer.AddLogTime(spanEvent.GetTimestamp());
@@ -281,7 +285,7 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
             break;
         case PipelineEvent::Type::RAW:
             for (size_t i = 0; i < group.mEvents.size(); ++i) {
-                const auto& e = group.mEvents[i].Cast<RawEvent>();
+                const auto& e = events[i].Cast<RawEvent>();
                 serializer.StartToAddLog(logSZ[i]);
                 serializer.AddLogTime(e.GetTimestamp());
                 serializer.AddLogContent(DEFAULT_CONTENT_KEY, e.GetContent());
@@ -304,7 +308,8 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
             serializer.AddLogTag(tag.first, tag.second);
         }
     }
-    res = std::move(serializer.GetResult());
+    // the previous buffer of res is handed back to the per-thread serializer for reuse
+    res.swap(serializer.GetResult());
     return true;
 }
 
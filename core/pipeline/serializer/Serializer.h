@@ -21,6 +21,7 @@
 
 #include "models/PipelineEventPtr.h"
 #include "monitor/metric_constants/MetricConstants.h"
+#include "monitor/metric_models/ScopedCpuTimer.h"
 #include "pipeline/batch/BatchedEvents.h"
 #include "pipeline/plugin/interface/Flusher.h"
 
@@ -59,6 +60,8 @@ public:
         mOutItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_OUT_ITEMS_TOTAL);
         mOutItemSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_OUT_SIZE_BYTES);
         mTotalProcessMs = mMetricsRecordRef.CreateTimeCounter(METRIC_COMPONENT_TOTAL_PROCESS_TIME_MS);
+        mProcessMs = mMetricsRecordRef.CreateHistogram(METRIC_COMPONENT_PROCESS_TIME_MS);
+        mTotalCpuTimeMs = mMetricsRecordRef.CreateShardedTimeCounter(METRIC_COMPONENT_TOTAL_CPU_TIME_MS);
         mDiscardedItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_DISCARDED_ITEMS_TOTAL);
         mDiscardedItemSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_DISCARDED_SIZE_BYTES);
     }
@@ -70,8 +73,14 @@ public:
         mInItemSizeBytes->Add(inputSize);
 
         auto before = std::chrono::system_clock::now();
-        auto res = Serialize(std::move(p), output, errorMsg);
-        mTotalProcessMs->Add(std::chrono::system_clock::now() - before);
+        bool res = false;
+        {
+            ScopedCpuTimer<ShardedTimeCounterPtr> cpuTimer(mTotalCpuTimeMs);
+            res = Serialize(std::move(p), output, errorMsg);
+        }
+        auto cost = std::chrono::system_clock::now() - before;
+        mTotalProcessMs->Add(cost);
+        mProcessMs->Observe(cost);
 
         if (res) {
             mOutItemsTotal->Add(1);
@@ -95,6 +104,8 @@ protected:
     CounterPtr mDiscardedItemsTotal;
     CounterPtr mDiscardedItemSizeBytes;
     TimeCounterPtr mTotalProcessMs;
+    HistogramPtr mProcessMs;
+    ShardedTimeCounterPtr mTotalCpuTimeMs;
 
 private:
     virtual bool Serialize(T&& p, std::string& res, std::string& errorMsg) = 0;
@@ -14,8 +14,20 @@
 
 #include "plugin/flusher/blackhole/FlusherBlackHole.h"
 
+#include <cstring>
+
+#include "common/Flags.h"
+#include "common/ParamExtractor.h"
+#include "common/compression/CompressorFactory.h"
+#include "common/memory/BufferPool.h"
 #include "pipeline/queue/SenderQueueManager.h"
 
+DECLARE_FLAG_INT32(max_send_log_group_size);
+DECLARE_FLAG_INT32(batch_send_metric_size);
+DECLARE_FLAG_INT32(merge_log_count_limit);
+DECLARE_FLAG_INT32(batch_send_interval);
+DECLARE_FLAG_DOUBLE(sls_serialize_size_expansion_ratio);
+
 using namespace std;
 
 namespace logtail {
@@ -24,13 +36,106 @@ const string FlusherBlackHole::sName = "flusher_blackhole";
 
 bool FlusherBlackHole::Init(const Json::Value& config, Json::Value& optionalGoPipeline) {
     static uint32_t cnt = 0;
+    string errorMsg;
+
+    // Serialize
+    if (!GetOptionalBoolParam(config, "Serialize", mSerialize, errorMsg)) {
+        PARAM_WARNING_DEFAULT(mContext->GetLogger(),
+                              mContext->GetAlarm(),
+                              errorMsg,
+                              mSerialize,
+                              sName,
+                              mContext->GetConfigName(),
+                              mContext->GetProjectName(),
+                              mContext->GetLogstoreName(),
+                              mContext->GetRegion());
+    }
+
+    if (mSerialize) {
+        DefaultFlushStrategyOptions strategy{
+            static_cast<uint32_t>(INT32_FLAG(max_send_log_group_size)
+                                  / DOUBLE_FLAG(sls_serialize_size_expansion_ratio)),
+            static_cast<uint32_t>(INT32_FLAG(batch_send_metric_size)),
+            static_cast<uint32_t>(INT32_FLAG(merge_log_count_limit)),
+            static_cast<uint32_t>(INT32_FLAG(batch_send_interval))};
+        const char* key = "Batch";
+        const Json::Value* itr = config.find(key, key + strlen(key));
+        if (!mBatcher.Init(itr ? *itr : Json::Value(), this, strategy)) {
+            return false;
+        }
+        mGroupSerializer = make_unique<SLSEventGroupSerializer>(this);
+        mCompressor = CompressorFactory::GetInstance()->Create(config, *mContext, sName, mPluginID, CompressType::LZ4);
+    }
+
     GenerateQueueKey(to_string(++cnt));
     SenderQueueManager::GetInstance()->CreateQueue(mQueueKey, mPluginID, *mContext);
     return true;
 }
 
 bool FlusherBlackHole::Send(PipelineEventGroup&& g) {
-    return PushToQueue(make_unique<SenderQueueItem>("", 0, this, mQueueKey));
+    if (!mSerialize) {
+        return PushToQueue(make_unique<SenderQueueItem>("", 0, this, mQueueKey));
+    }
+    vector<BatchedEventsList> res;
+    mBatcher.Add(std::move(g), res);
+    return SerializeAndPush(std::move(res));
+}
+
+bool FlusherBlackHole::Flush(size_t key) {
+    if (!mSerialize) {
+        return true;
+    }
+    BatchedEventsList res;
+    mBatcher.FlushQueue(key, res);
+    return SerializeAndPush(std::move(res));
+}
+
+bool FlusherBlackHole::FlushAll() {
+    if (!mSerialize) {
+        return true;
+    }
+    vector<BatchedEventsList> res;
+    mBatcher.FlushAll(res);
+    return SerializeAndPush(std::move(res));
+}
+
+bool FlusherBlackHole::SerializeAndPush(vector<BatchedEventsList>&& groupLists) {
+    bool allSucceeded = true;
+    for (auto& groupList : groupLists) {
+        allSucceeded = SerializeAndPush(std::move(groupList)) && allSucceeded;
+    }
+    return allSucceeded;
+}
+
+bool FlusherBlackHole::SerializeAndPush(BatchedEventsList&& groupList) {
+    bool allSucceeded = true;
+    for (auto& batch : groupList) {
+        string serializedData, compressedData, errorMsg;
+        if (!mGroupSerializer->DoSerialize(std::move(batch), serializedData, errorMsg)) {
+            LOG_WARNING(mContext->GetLogger(),
+                        ("failed to serialize event group",
+                         errorMsg)("action", "discard data")("plugin", sName)("config", mContext->GetConfigName()));
+            allSucceeded = false;
+            continue;
+        }
+        size_t rawSize = serializedData.size();
+        if (mCompressor) {
+            if (!mCompressor->DoCompress(serializedData, compressedData, errorMsg)) {
+                LOG_WARNING(mContext->GetLogger(),
+                            ("failed to compress event group", errorMsg)("action", "discard data")("plugin", sName)(
+                                "config", mContext->GetConfigName()));
+                allSucceeded = false;
+                continue;
+            }
+            BufferPool::GetInstance()->Release(std::move(serializedData));
+        } else {
+            compressedData.swap(serializedData);
+        }
+        allSucceeded
+            = PushToQueue(make_unique<SenderQueueItem>(std::move(compressedData), rawSize, this, mQueueKey))
+            && allSucceeded;
+    }
+    return allSucceeded;
 }
 
 } // namespace logtail
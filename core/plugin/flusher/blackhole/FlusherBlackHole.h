@@ -16,7 +16,13 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
+#include "common/compression/Compressor.h"
+#include "pipeline/batch/Batcher.h"
 #include "pipeline/plugin/interface/Flusher.h"
+#include "pipeline/serializer/SLSSerializer.h"
 
 namespace logtail {
 
@@ -27,8 +33,24 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config, Json::Value& optionalGoPipeline) override;
     bool Send(PipelineEventGroup&& g) override;
-    bool Flush(size_t key) override { return true; }
-    bool FlushAll() override { return true; }
+    bool Flush(size_t key) override;
+    bool FlushAll() override;
+
+    // when enabled, events are batched, serialized and compressed the same way as flusher_sls before being discarded,
+    // which makes the flusher suitable for measuring the throughput of the whole pipeline
+    bool mSerialize = false;
+
+private:
+    bool SerializeAndPush(std::vector<BatchedEventsList>&& groupLists);
+    bool SerializeAndPush(BatchedEventsList&& groupList);
+
+    Batcher<SLSEventBatchStatus> mBatcher;
+    std::unique_ptr<EventGroupSerializer> mGroupSerializer;
+    std::unique_ptr<Compressor> mCompressor;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class FlusherBlackHoleUnittest;
+#endif
 };
 
 } // namespace logtail
@@ -661,7 +661,7 @@ bool DiskBufferWriter::SendToBufferFile(SenderQueueItem* dataPtr) {
     bufferMeta.set_logstore(data->mLogstore);
     bufferMeta.set_datatype(int32_t(data->mType));
     bufferMeta.set_rawsize(data->mRawSize);
-    bufferMeta.set_shardhashkey(data->mShardHashKey);
+    bufferMeta.set_shardhashkey(data->GetShardHashKey());
     bufferMeta.set_compresstype(ConvertCompressType(flusher->GetCompressType()));
     bufferMeta.set_telemetrytype(flusher->mTelemetryType);
     string encodedInfo;
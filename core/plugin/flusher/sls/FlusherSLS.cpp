@@ -21,6 +21,7 @@
 #include "common/ParamExtractor.h"
 #include "common/TimeUtil.h"
 #include "common/compression/CompressorFactory.h"
+#include "common/memory/BufferPool.h"
 #include "sls_logs.pb.h"
 #ifdef __ENTERPRISE__
 #include "config/provider/EnterpriseConfigProvider.h"
@@ -62,6 +63,9 @@ DEFINE_FLAG_BOOL(global_network_success, "global network success flag, default f
 DEFINE_FLAG_BOOL(enable_metricstore_channel, "only works for metrics data for enhance metrics query performance", true);
 DEFINE_FLAG_INT32(max_send_log_group_size, "bytes", 10 * 1024 * 1024);
 DEFINE_FLAG_DOUBLE(sls_serialize_size_expansion_ratio, "", 1.2);
+DEFINE_FLAG_BOOL(sls_flusher_precompute_data_md5,
+                 "calculate md5 of data right after compression on processor threads, instead of on the sending thread",
+                 true);
 
 DECLARE_FLAG_BOOL(send_prefer_real_ip);
 
@@ -71,6 +75,14 @@ enum class OperationOnFail { RETRY_IMMEDIATELY, RETRY_LATER, DISCARD };
 
 static const int ON_FAIL_LOG_WARNING_INTERVAL_SECOND = 10;
 
+// data is still hot in cache right after compression, and there are more processor threads than sending threads
+static unique_ptr<SLSSenderQueueItem> CalcDataMd5(unique_ptr<SLSSenderQueueItem>&& item) {
+    if (BOOL_FLAG(sls_flusher_precompute_data_md5)) {
+        item->mDataMd5 = sdk::CalcMD5(item->mData);
+    }
+    return std::move(item);
+}
+
 static const char* GetOperationString(OperationOnFail op) {
     switch (op) {
         case OperationOnFail::RETRY_IMMEDIATELY:
@@ -478,8 +490,11 @@ bool FlusherSLS::Init(const Json::Value& config, Json::Value& optionalGoPipeline
         static_cast<uint32_t>(INT32_FLAG(batch_send_metric_size)),
         static_cast<uint32_t>(INT32_FLAG(merge_log_count_limit)),
         static_cast<uint32_t>(INT32_FLAG(batch_send_interval))};
-    if (!mBatcher.Init(
-            itr ? *itr : Json::Value(), this, strategy, !mContext->IsExactlyOnceEnabled() && mShardHashKeys.empty())) {
+    if (!mBatcher.Init(itr ? *itr : Json::Value(),
+                       this,
+                       strategy,
+                       !mContext->IsExactlyOnceEnabled() && mShardHashKeys.empty(),
+                       mShardHashKeys)) {
         // when either exactly once is enabled or ShardHashKeys is not empty, we don't enable group batch
         return false;
     }
@@ -603,12 +618,13 @@ bool FlusherSLS::BuildRequest(SenderQueueItem* item, unique_ptr<HttpSinkRequest>
         data->mRealIpFlag = sendClient->GetRawSlsHostFlag();
     }
 
+    const string shardHashKey = data->GetShardHashKey();
     if (data->mType == RawDataType::EVENT_GROUP) {
         if (mTelemetryType == sls_logs::SLS_TELEMETRY_TYPE_METRICS) {
             req = sendClient->CreatePostMetricStoreLogsRequest(
                 mProject, data->mLogstore, ConvertCompressType(GetCompressType()), data->mData, data->mRawSize, item);
         } else {
-            if (data->mShardHashKey.empty()) {
+            if (shardHashKey.empty()) {
                 req = sendClient->CreatePostLogStoreLogsRequest(mProject,
                                                                 data->mLogstore,
                                                                 ConvertCompressType(GetCompressType()),
@@ -624,12 +640,12 @@ bool FlusherSLS::BuildRequest(SenderQueueItem* item, unique_ptr<HttpSinkRequest>
                                                                 data->mData,
                                                                 data->mRawSize,
                                                                 item,
-                                                                data->mShardHashKey,
+                                                                shardHashKey,
                                                                 hashKeySeqID);
             }
         }
     } else {
-        if (data->mShardHashKey.empty())
+        if (shardHashKey.empty())
             req = sendClient->CreatePostLogStoreLogPackageListRequest(
                 mProject, data->mLogstore, ConvertCompressType(GetCompressType()), data->mData, item);
         else
@@ -638,7 +654,7 @@ bool FlusherSLS::BuildRequest(SenderQueueItem* item, unique_ptr<HttpSinkRequest>
                                                                       ConvertCompressType(GetCompressType()),
                                                                       data->mData,
                                                                       item,
-                                                                      data->mShardHashKey);
+                                                                      shardHashKey);
     }
     if (!req) {
         *keepItem = true;
@@ -700,6 +716,9 @@ void FlusherSLS::OnSendDone(const HttpResponse& response, SenderQueueItem* item)
         if (mSuccessCnt) {
             mSuccessCnt->Add(1);
         }
+        mBatcher.OnSendDone(chrono::duration_cast<chrono::milliseconds>(curSystemTime - item->mLastSendTime).count(),
+                            item->mRawSize,
+                            item->mData.size());
         DealSenderQueueItemAfterSend(item, false);
     } else {
         OperationOnFail operation;
@@ -933,13 +952,13 @@ bool FlusherSLS::Send(string&& data, const string& shardHashKey, const string& l
                 key, "", ctx, std::unordered_map<std::string, std::shared_ptr<ConcurrencyLimiter>>());
         }
     }
-    return Flusher::PushToQueue(make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                                data.size(),
-                                                                this,
-                                                                key,
-                                                                logstore.empty() ? mLogstore : logstore,
-                                                                RawDataType::EVENT_GROUP,
-                                                                shardHashKey));
+    return Flusher::PushToQueue(CalcDataMd5(make_unique<SLSSenderQueueItem>(std::move(compressedData),
+                                                                            data.size(),
+                                                                            this,
+                                                                            key,
+                                                                            logstore.empty() ? mLogstore : logstore,
+                                                                            RawDataType::EVENT_GROUP,
+                                                                            shardHashKey)));
 }
 
 void FlusherSLS::GenerateGoPlugin(const Json::Value& config, Json::Value& res) const {
@@ -979,6 +998,7 @@ bool FlusherSLS::SerializeAndPush(PipelineEventGroup&& group) {
                                        mContext->GetRegion());
         return false;
     }
+    size_t rawSize = serializedData.size();
     if (mCompressor) {
         if (!mCompressor->DoCompress(serializedData, compressedData, errorMsg)) {
             LOG_WARNING(mContext->GetLogger(),
@@ -993,21 +1013,22 @@ bool FlusherSLS::SerializeAndPush(PipelineEventGroup&& group) {
                                            mContext->GetRegion());
             return false;
         }
+        BufferPool::GetInstance()->Release(std::move(serializedData));
     } else {
-        compressedData = serializedData;
+        compressedData.swap(serializedData);
     }
     // must create a tmp, because eoo checkpoint is moved in second param
     auto fbKey = g.mExactlyOnceCheckpoint->fbKey;
     return PushToQueue(fbKey,
-                       make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                       serializedData.size(),
-                                                       this,
-                                                       fbKey,
-                                                       mLogstore,
-                                                       RawDataType::EVENT_GROUP,
-                                                       g.mExactlyOnceCheckpoint->data.hash_key(),
-                                                       std::move(g.mExactlyOnceCheckpoint),
-                                                       false));
+                       CalcDataMd5(make_unique<SLSSenderQueueItem>(std::move(compressedData),
+                                                                   rawSize,
+                                                                   this,
+                                                                   fbKey,
+                                                                   mLogstore,
+                                                                   RawDataType::EVENT_GROUP,
+                                                                   g.mExactlyOnceCheckpoint->data.hash_key(),
+                                                                   std::move(g.mExactlyOnceCheckpoint),
+                                                                   false)));
 }
 
 bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
@@ -1015,15 +1036,14 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
         return true;
     }
     vector<CompressedLogGroup> compressedLogGroups;
-    string shardHashKey, serializedData, compressedData;
+    string serializedData, compressedData;
     size_t packageSize = 0;
     bool enablePackageList = groupList.size() > 1;
 
     bool allSucceeded = true;
     for (auto& group : groupList) {
-        if (!mShardHashKeys.empty()) {
-            shardHashKey = GetShardHashKey(group);
-        }
+        // shard hash key digest is calculated by batcher, and converted to string only when building request
+        optional<uint64_t> shardHashKey = group.mShardHashKey;
         AddPackId(group);
         string errorMsg;
         if (!mGroupSerializer->DoSerialize(std::move(group), serializedData, errorMsg)) {
@@ -1040,6 +1060,7 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
             allSucceeded = false;
             continue;
         }
+        size_t rawSize = serializedData.size();
         if (mCompressor) {
             if (!mCompressor->DoCompress(serializedData, compressedData, errorMsg)) {
                 LOG_WARNING(mContext->GetLogger(),
@@ -1055,37 +1076,36 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
                 allSucceeded = false;
                 continue;
             }
+            // serialized data is no longer needed, give it back for the next serialization
+            BufferPool::GetInstance()->Release(std::move(serializedData));
         } else {
-            compressedData = serializedData;
+            compressedData.swap(serializedData);
         }
         if (enablePackageList) {
-            packageSize += serializedData.size();
-            compressedLogGroups.emplace_back(std::move(compressedData), serializedData.size());
+            packageSize += rawSize;
+            compressedLogGroups.emplace_back(std::move(compressedData), rawSize);
         } else {
             if (group.mExactlyOnceCheckpoint) {
                 // must create a tmp, because eoo checkpoint is moved in second param
                 auto fbKey = group.mExactlyOnceCheckpoint->fbKey;
                 allSucceeded
                     = PushToQueue(fbKey,
-                                  make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                                  serializedData.size(),
-                                                                  this,
-                                                                  fbKey,
-                                                                  mLogstore,
-                                                                  RawDataType::EVENT_GROUP,
-                                                                  group.mExactlyOnceCheckpoint->data.hash_key(),
-                                                                  std::move(group.mExactlyOnceCheckpoint),
-                                                                  false))
+                                  CalcDataMd5(make_unique<SLSSenderQueueItem>(
+                                      std::move(compressedData),
+                                      rawSize,
+                                      this,
+                                      fbKey,
+                                      mLogstore,
+                                      RawDataType::EVENT_GROUP,
+                                      group.mExactlyOnceCheckpoint->data.hash_key(),
+                                      std::move(group.mExactlyOnceCheckpoint),
+                                      false)))
                     && allSucceeded;
             } else {
-                allSucceeded = Flusher::PushToQueue(make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                                                    serializedData.size(),
-                                                                                    this,
-                                                                                    mQueueKey,
-                                                                                    mLogstore,
-                                                                                    RawDataType::EVENT_GROUP,
-                                                                                    shardHashKey))
-                    && allSucceeded;
+                auto item = CalcDataMd5(
+                    make_unique<SLSSenderQueueItem>(std::move(compressedData), rawSize, this, mQueueKey, mLogstore));
+                item->mShardHashKeyDigest = shardHashKey;
+                allSucceeded = Flusher::PushToQueue(std::move(item)) && allSucceeded;
             }
         }
     }
@@ -1093,8 +1113,8 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
         string errorMsg;
         mGroupListSerializer->DoSerialize(std::move(compressedLogGroups), serializedData, errorMsg);
         allSucceeded
-            = Flusher::PushToQueue(make_unique<SLSSenderQueueItem>(
-                  std::move(serializedData), packageSize, this, mQueueKey, mLogstore, RawDataType::EVENT_GROUP_LIST))
+            = Flusher::PushToQueue(CalcDataMd5(make_unique<SLSSenderQueueItem>(
+                  std::move(serializedData), packageSize, this, mQueueKey, mLogstore, RawDataType::EVENT_GROUP_LIST)))
             && allSucceeded;
     }
     return allSucceeded;
@@ -1141,23 +1161,6 @@ bool FlusherSLS::PushToQueue(QueueKey key, unique_ptr<SenderQueueItem>&& item, u
     return false;
 }
 
-string FlusherSLS::GetShardHashKey(const BatchedEvents& g) const {
-    // TODO: improve performance
-    string key;
-    for (size_t i = 0; i < mShardHashKeys.size(); ++i) {
-        for (auto& item : g.mTags.mInner) {
-            if (item.first == mShardHashKeys[i]) {
-                key += item.second.to_string();
-                break;
-            }
-        }
-        if (i != mShardHashKeys.size() - 1) {
-            key += "_";
-        }
-    }
-    return sdk::CalcMD5(key);
-}
-
 void FlusherSLS::AddPackId(BatchedEvents& g) const {
     string packIdPrefixStr = g.mPackIdPrefix.to_string();
     int64_t packidPrefix = HashString(packIdPrefixStr);
@@ -167,6 +167,7 @@ bool InputContainerStdio::Init(const Json::Value& config, Json::Value& optionalG
         {METRIC_PLUGIN_OUT_SIZE_BYTES, MetricType::METRIC_TYPE_COUNTER},
         {METRIC_PLUGIN_SOURCE_SIZE_BYTES, MetricType::METRIC_TYPE_INT_GAUGE},
         {METRIC_PLUGIN_SOURCE_READ_OFFSET_BYTES, MetricType::METRIC_TYPE_INT_GAUGE},
+        {METRIC_PLUGIN_TOTAL_CPU_TIME_MS, MetricType::METRIC_TYPE_TIME_COUNTER},
     };
     mPluginMetricManager = std::make_shared<PluginMetricManager>(
         GetMetricsRecordRef()->GetLabels(), inputFileMetricKeys, MetricCategory::METRIC_CATEGORY_PLUGIN_SOURCE);
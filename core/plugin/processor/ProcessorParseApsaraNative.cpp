@@ -17,6 +17,7 @@
 #include "plugin/processor/ProcessorParseApsaraNative.h"
 
 #include "app_config/AppConfig.h"
+#include "common/CompiledTimeFormat.h"
 #include "common/LogtailCommonFlags.h"
 #include "common/ParamExtractor.h"
 #include "common/TimeUtil.h"
@@ -30,6 +31,8 @@ const std::string ProcessorParseApsaraNative::sName = "processor_parse_apsara_na
 
 const std::string SLS_KEY_LEVEL = "__LEVEL__";
 const std::string SLS_KEY_THREAD = "__THREAD__";
+
+static const CompiledTimeFormat sApsaraTimeFormat("%Y-%m-%d %H:%M:%S");
 const std::string SLS_KEY_FILE = "__FILE__";
 const std::string SLS_KEY_LINE = "__LINE__";
 const int32_t MAX_BASE_FIELD_NUM = 10;
@@ -261,9 +264,8 @@ time_t ProcessorParseApsaraNative::ApsaraEasyReadLogTimeParser(StringView& buffe
             LOG_WARNING(sLogger, ("parse apsara log time", "fail")("string", buffer));
             return 0;
         }
-        // strTime is the content between '[' and ']' and ends with '\0'
-        std::string strTime = buffer.substr(1, pos).to_string();
-        auto strptimeResult = Strptime(strTime.c_str(), "%s", &logTime, nanosecondLength);
+        // parsing stops at ']'
+        auto strptimeResult = Strptime(buffer.data() + 1, "%s", &logTime, nanosecondLength);
         if (NULL == strptimeResult || strptimeResult[0] != ']') {
             LOG_WARNING(sLogger, ("parse apsara log time", "fail")("string", buffer)("timeformat", "%s"));
             return 0;
@@ -278,13 +280,13 @@ time_t ProcessorParseApsaraNative::ApsaraEasyReadLogTimeParser(StringView& buffe
             LOG_WARNING(sLogger, ("parse apsara log time", "fail")("string", buffer));
             return 0;
         }
-        // strTime is the content between '[' and ']' and ends with '\0'
-        std::string strTime = buffer.substr(1, pos).to_string();
+        // strTime is the content between '[' and ']', and parsing with Strptime stops at ']'
+        StringView strTime = buffer.substr(1, pos - 1);
         int nanosecondLength = 0;
         if (IsPrefixString(strTime, cachedTimeStr) == true) {
             if (strTime.size() > cachedTimeStr.size()) {
                 auto strptimeResult
-                    = Strptime(strTime.c_str() + cachedTimeStr.size() + 1, "%f", &logTime, nanosecondLength);
+                    = Strptime(strTime.data() + cachedTimeStr.size() + 1, "%f", &logTime, nanosecondLength);
                 if (NULL == strptimeResult) {
                     LOG_WARNING(sLogger,
                                 ("parse apsara log time microsecond",
@@ -295,14 +297,14 @@ time_t ProcessorParseApsaraNative::ApsaraEasyReadLogTimeParser(StringView& buffe
             return cachedLogTime.tv_sec;
         }
         // parse second part
-        auto strptimeResult = Strptime(strTime.c_str(), "%Y-%m-%d %H:%M:%S", &logTime, nanosecondLength);
+        auto strptimeResult = sApsaraTimeFormat.Parse(strTime.data(), strTime.size(), &logTime, nanosecondLength);
         if (NULL == strptimeResult) {
             LOG_WARNING(sLogger,
                         ("parse apsara log time", "fail")("string", buffer)("timeformat", "%Y-%m-%d %H:%M:%S"));
             return 0;
         }
         // parse nanosecond part (optional)
-        if (*strptimeResult != '\0') {
+        if (strptimeResult < strTime.data() + strTime.size()) {
             strptimeResult = Strptime(strptimeResult + 1, "%f", &logTime, nanosecondLength);
             if (NULL == strptimeResult) {
                 LOG_WARNING(sLogger,
@@ -325,8 +327,8 @@ time_t ProcessorParseApsaraNative::ApsaraEasyReadLogTimeParser(StringView& buffe
  * @param prefix - 要检查的前缀。
  * @return 如果字符串以指定前缀开头，则返回true；否则返回false。
  */
-bool ProcessorParseApsaraNative::IsPrefixString(const std::string& all, const StringView& prefix) {
-    return !prefix.empty() && std::equal(prefix.begin(), prefix.end(), all.begin());
+bool ProcessorParseApsaraNative::IsPrefixString(const StringView& all, const StringView& prefix) {
+    return !prefix.empty() && all.size() >= prefix.size() && std::equal(prefix.begin(), prefix.end(), all.begin());
 }
 
 /*
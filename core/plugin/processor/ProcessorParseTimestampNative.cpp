@@ -86,6 +86,7 @@ bool ProcessorParseTimestampNative::Init(const Json::Value& config) {
                               mContext->GetLogstoreName(),
                               mContext->GetRegion());
     }
+    mCompiledSourceFormat = CompiledTimeFormat(mSourceFormat, mSourceYear);
 
     mDiscardedEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_DISCARDED_EVENTS_TOTAL);
     mOutFailedEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_FAILED_EVENTS_TOTAL);
@@ -198,7 +199,7 @@ bool ProcessorParseTimestampNative::ParseLogTime(const StringView& curTimeStr, /
             logTime.tv_nsec = 0;
         }
     } else {
-        strptimeResult = Strptime(curTimeStr.data(), mSourceFormat.c_str(), &logTime, nanosecondLength, mSourceYear);
+        strptimeResult = mCompiledSourceFormat.Parse(curTimeStr.data(), curTimeStr.size(), &logTime, nanosecondLength);
         if (NULL != strptimeResult) {
             timeStrCache = curTimeStr.substr(0, curTimeStr.length() - nanosecondLength);
             logTime.tv_sec = logTime.tv_sec - mLogTimeZoneOffsetSecond;
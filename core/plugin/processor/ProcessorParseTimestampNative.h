@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "common/CompiledTimeFormat.h"
 #include "common/TimeUtil.h"
 #include "pipeline/plugin/interface/Processor.h"
 
@@ -52,6 +53,7 @@ private:
     bool IsPrefixString(const StringView& all, const StringView& prefix);
 
     int32_t mLogTimeZoneOffsetSecond = 0;
+    CompiledTimeFormat mCompiledSourceFormat;
 
     CounterPtr mDiscardedEventsTotal;
     CounterPtr mOutFailedEventsTotal;
@@ -80,6 +80,9 @@ bool ProcessorSplitMultilineLogStringNative::Init(const Json::Value& config) {
     mMatchedEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_MATCHED_EVENTS_TOTAL);
     mMatchedLinesTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_MATCHED_LINES_TOTAL);
     mUnmatchedLinesTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_UNMATCHED_LINES_TOTAL);
+    mPatternChecksTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_PATTERN_CHECKS_TOTAL);
+    mPrefilteredPatternChecksTotal
+        = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_PREFILTERED_PATTERN_CHECKS_TOTAL);
 
     return true;
 }
@@ -156,6 +159,17 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
     StringBuffer sourceKey = logGroup.GetSourceBuffer()->CopyString(mSourceKey);
 
     std::string exception;
+    // lines rejected by the prefilter of a pattern are not passed to the regex engine
+    int patternChecks = 0;
+    int prefilteredChecks = 0;
+    auto isMatched = [&](StringView line, const boost::regex& reg, const RegexPrefilter& filter) {
+        ++patternChecks;
+        if (!filter.MayMatch(line.data(), line.size())) {
+            ++prefilteredChecks;
+            return false;
+        }
+        return BoostRegexSearch(line.data(), line.size(), reg, exception);
+    };
     const char* multiStartIndex = nullptr;
     bool isPartialLog = false;
     if (mMultiline.GetStartPatternReg() == nullptr && mMultiline.GetContinuePatternReg() == nullptr
@@ -172,18 +186,15 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
         ++(*inputLines);
         if (!isPartialLog) {
             // it is impossible to enter this state if only end pattern is given
-            boost::regex regex;
-            if (mMultiline.GetStartPatternReg() != nullptr) {
-                regex = *mMultiline.GetStartPatternReg();
-            } else {
-                regex = *mMultiline.GetContinuePatternReg();
-            }
-            if (BoostRegexSearch(content.data(), content.size(), regex, exception)) {
+            bool matched = mMultiline.GetStartPatternReg() != nullptr
+                ? isMatched(content, *mMultiline.GetStartPatternReg(), mMultiline.GetStartPatternFilter())
+                : isMatched(content, *mMultiline.GetContinuePatternReg(), mMultiline.GetContinuePatternFilter());
+            if (matched) {
                 multiStartIndex = content.data();
                 isPartialLog = true;
             } else if (mMultiline.GetEndPatternReg() != nullptr && mMultiline.GetStartPatternReg() == nullptr
                        && mMultiline.GetContinuePatternReg() != nullptr
-                       && BoostRegexSearch(content.data(), content.size(), *mMultiline.GetEndPatternReg(), exception)) {
+                       && isMatched(content, *mMultiline.GetEndPatternReg(), mMultiline.GetEndPatternFilter())) {
                 // case: continue + end
                 CreateNewEvent(content, isLastLog, sourceKey, sourceEvent, logGroup, newEvents);
                 multiStartIndex = content.data() + content.size() + 1;
@@ -195,7 +206,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
         } else {
             // case: start + continue or continue + end
             if (mMultiline.GetContinuePatternReg() != nullptr
-                && BoostRegexSearch(content.data(), content.size(), *mMultiline.GetContinuePatternReg(), exception)) {
+                && isMatched(content, *mMultiline.GetContinuePatternReg(), mMultiline.GetContinuePatternFilter())) {
                 begin += content.size() + 1;
                 continue;
             }
@@ -204,7 +215,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                 if (mMultiline.GetContinuePatternReg() != nullptr) {
                     // current line is not matched against the continue pattern, so the end pattern will decide
                     // if the current log is a match or not
-                    if (BoostRegexSearch(content.data(), content.size(), *mMultiline.GetEndPatternReg(), exception)) {
+                    if (isMatched(content, *mMultiline.GetEndPatternReg(), mMultiline.GetEndPatternFilter())) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() + content.size() - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -226,7 +237,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                     isPartialLog = false;
                 } else {
                     // case: start + end or end
-                    if (BoostRegexSearch(content.data(), content.size(), *mMultiline.GetEndPatternReg(), exception)) {
+                    if (isMatched(content, *mMultiline.GetEndPatternReg(), mMultiline.GetEndPatternFilter())) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() + content.size() - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -247,7 +258,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
             } else {
                 if (mMultiline.GetContinuePatternReg() == nullptr) {
                     // case: start
-                    if (BoostRegexSearch(content.data(), content.size(), *mMultiline.GetStartPatternReg(), exception)) {
+                    if (isMatched(content, *mMultiline.GetStartPatternReg(), mMultiline.GetStartPatternFilter())) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() - 1 - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -267,8 +278,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                                    logGroup,
                                    newEvents);
                     mMatchedEventsTotal->Add(1);
-                    if (!BoostRegexSearch(
-                            content.data(), content.size(), *mMultiline.GetStartPatternReg(), exception)) {
+                    if (!isMatched(content, *mMultiline.GetStartPatternReg(), mMultiline.GetStartPatternFilter())) {
                         // when no end pattern is given, the only chance to enter unmatched state is when both
                         // start and continue pattern are given, and the current line is not matched against the
                         // start pattern
@@ -305,6 +315,8 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                               unmatchLines);
         }
     }
+    mPatternChecksTotal->Add(patternChecks);
+    mPrefilteredPatternChecksTotal->Add(prefilteredChecks);
 }
 
 void ProcessorSplitMultilineLogStringNative::CreateNewEvent(const StringView& content,
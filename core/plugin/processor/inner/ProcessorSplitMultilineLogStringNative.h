@@ -68,11 +68,15 @@ private:
     CounterPtr mMatchedEventsTotal;
     CounterPtr mMatchedLinesTotal;
     CounterPtr mUnmatchedLinesTotal;
+    // prefiltered / pattern checks is the fraction of lines rejected without running the regex engine
+    CounterPtr mPatternChecksTotal;
+    CounterPtr mPrefilteredPatternChecksTotal;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ProcessorSplitMultilineLogStringNativeUnittest;
     friend class ProcessorSplitMultilineLogDisacardUnmatchUnittest;
     friend class ProcessorSplitMultilineLogKeepUnmatchUnittest;
+    friend class SplitMultilinePrefilterBenchmark;
 #endif
 };
 
@@ -15,6 +15,7 @@
 #include "protobuf/sls/LogGroupSerializer.h"
 
 #include "common/TimeUtil.h"
+#include "common/memory/BufferPool.h"
 
 using namespace std;
 
@@ -98,8 +99,9 @@ static inline void fixed32_pack(uint32_t value, string& output) {
 }
 
 void LogGroupSerializer::Prepare(size_t size) {
+    // result is usually moved out after serialization, so buffer is taken from pool to avoid allocation
+    BufferPool::GetInstance()->Reserve(mRes, size);
     mRes.clear();
-    mRes.reserve(size);
 }
 
 void LogGroupSerializer::StartToAddLog(size_t size) {
@@ -50,6 +50,7 @@ bool HttpSink::Init() {
         = mMetricsRecordRef.CreateTimeCounter(METRIC_RUNNER_SINK_SUCCESSFUL_ITEM_TOTAL_RESPONSE_TIME_MS);
     mFailedItemTotalResponseTimeMs
         = mMetricsRecordRef.CreateTimeCounter(METRIC_RUNNER_SINK_FAILED_ITEM_TOTAL_RESPONSE_TIME_MS);
+    mItemResponseTimeMs = mMetricsRecordRef.CreateHistogram(METRIC_RUNNER_SINK_ITEM_RESPONSE_TIME_MS);
     mSendingItemsTotal = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_SINK_SENDING_ITEMS_TOTAL);
     mSendConcurrency = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_SINK_SEND_CONCURRENCY);
 
@@ -114,7 +115,7 @@ bool HttpSink::AddRequestToClient(unique_ptr<HttpSinkRequest>&& request) {
                                    request->mUrl,
                                    request->mQueryString,
                                    request->mHeader,
-                                   request->mBody,
+                                   request->GetBody(),
                                    request->mResponse,
                                    headers,
                                    request->mTimeout,
@@ -256,6 +257,7 @@ void HttpSink::HandleCompletedRequests(int& runningHandlers) {
                     FlusherRunner::GetInstance()->DecreaseHttpSendingCnt();
                     mOutSuccessfulItemsTotal->Add(1);
                     mSuccessfulItemTotalResponseTimeMs->Add(responseTime);
+                    mItemResponseTimeMs->Observe(responseTime);
                     mSendingItemsTotal->Sub(1);
                     break;
                 }
@@ -291,6 +293,7 @@ void HttpSink::HandleCompletedRequests(int& runningHandlers) {
                     }
                     mOutFailedItemsTotal->Add(1);
                     mFailedItemTotalResponseTimeMs->Add(responseTime);
+                    mItemResponseTimeMs->Observe(responseTime);
                     mSendingItemsTotal->Sub(1);
                     break;
             }
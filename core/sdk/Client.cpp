@@ -32,6 +32,14 @@ namespace sdk {
 
     using namespace std;
 
+    // md5 of the item data may have been calculated by the flusher before pushed to sender queue
+    static string GetContentMd5(const string& body, const SenderQueueItem* item) {
+        if (item != nullptr && &item->mData == &body && !item->mDataMd5.empty()) {
+            return item->mDataMd5;
+        }
+        return CalcMD5(body);
+    }
+
     Client::Client(const string& aliuid, const string& slsHost, int32_t timeout)
         : mTimeout(timeout), mHostFieldSuffix(""), mIsHostRawIp(false), mPort(80), mUsingHTTPS(false), mAliuid(aliuid) {
         mClient = new CurlClient();
@@ -283,13 +291,15 @@ namespace sdk {
 
         string operation = METRICSTORES;
         operation.append("/").append(project).append("/").append(logstore).append("/api/v1/write");
-        httpHeader[CONTENT_MD5] = CalcMD5(body);
+        httpHeader[CONTENT_MD5] = GetContentMd5(body, item);
         map<string, string> parameterList;
         string host = GetSlsHost();
         SetCommonHeader(httpHeader, (int32_t)(body.length()), "");
         string signature = GetUrlSignature(HTTP_POST, operation, httpHeader, parameterList, body, accessKeySecret);
         httpHeader[AUTHORIZATION] = LOG_HEADSIGNATURE_PREFIX + accessKeyId + ':' + signature;
-        return make_unique<HttpSinkRequest>(HTTP_POST, mUsingHTTPS, host, mPort, operation, "", httpHeader, body, item);
+        auto req = make_unique<HttpSinkRequest>(HTTP_POST, mUsingHTTPS, host, mPort, operation, "", httpHeader, "", item);
+        req->mBodyRef = &body;
+        return req;
     }
 
     unique_ptr<HttpSinkRequest>
@@ -321,7 +331,7 @@ namespace sdk {
         else
             operation.append("/shards/route");
 
-        httpHeader[CONTENT_MD5] = CalcMD5(body);
+        httpHeader[CONTENT_MD5] = GetContentMd5(body, item);
 
         map<string, string> parameterList;
         if (!hashKey.empty()) {
@@ -339,8 +349,11 @@ namespace sdk {
         string queryString;
         GetQueryString(parameterList, queryString);
 
-        return make_unique<HttpSinkRequest>(
-            HTTP_POST, mUsingHTTPS, host, mPort, operation, queryString, httpHeader, body, item);
+        auto req = make_unique<HttpSinkRequest>(
+            HTTP_POST, mUsingHTTPS, host, mPort, operation, queryString, httpHeader, "", item);
+        // body is held by item, which is not removed until the request is done, so it is not copied
+        req->mBodyRef = &body;
+        return req;
     }
 
     PostLogStoreLogsResponse
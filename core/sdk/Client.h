@@ -164,6 +164,8 @@ namespace sdk {
                          HttpMessage& httpMessage,
                          std::string* realIpPtr = NULL);
 
+        // body is referenced rather than copied by the returned request, so it must be held by item, which outlives
+        // the request
         std::unique_ptr<HttpSinkRequest>
         CreateAsynPostLogStoreLogsRequest(const std::string& project,
                                           const std::string& logstore,
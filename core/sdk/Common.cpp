@@ -13,12 +13,21 @@
 // limitations under the License.
 
 #include "Common.h"
+
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+
 #include "app_config/AppConfig.h"
 #include "common/TimeUtil.h"
 #include "common/StringTools.h"
 #include "common/ErrorUtil.h"
+#include "common/Flags.h"
 #include "logger/Logger.h"
 
+DEFINE_FLAG_BOOL(sls_client_openssl_digest,
+                 "calculate md5 and hmac-sha1 with openssl, which picks sha-ni or avx2 implementations when available",
+                 true);
+
 using namespace std;
 using namespace logtail::sdk;
 
@@ -185,13 +194,38 @@ namespace sdk {
         return ss;
     }
 
+    // openssl may refuse some digests, e.g. md5 in fips mode, in which case the bundled implementations are used
+    static bool OpensslMd5(const std::string& message, uint8_t md5[MD5_BYTES]) {
+        unsigned int len = 0;
+        return EVP_Digest(message.data(), message.size(), md5, &len, EVP_md5(), nullptr) == 1 && len == MD5_BYTES;
+    }
+
+    static bool OpensslHmacSha1(const std::string& message, const std::string& key, uint8_t res[SHA1_DIGEST_BYTES]) {
+        unsigned int len = 0;
+        return ::HMAC(EVP_sha1(),
+                      key.data(),
+                      static_cast<int>(key.size()),
+                      reinterpret_cast<const unsigned char*>(message.data()),
+                      message.size(),
+                      res,
+                      &len)
+            != nullptr
+            && len == SHA1_DIGEST_BYTES;
+    }
+
     std::string CalcMD5(const std::string& message) {
         uint8_t md5[MD5_BYTES];
-        DoMd5((const uint8_t*)message.data(), message.length(), md5);
+        if (!BOOL_FLAG(sls_client_openssl_digest) || !OpensslMd5(message, md5)) {
+            DoMd5((const uint8_t*)message.data(), message.length(), md5);
+        }
         return HexToString(md5);
     }
 
     std::string CalcSHA1(const std::string& message, const std::string& key) {
+        uint8_t res[SHA1_DIGEST_BYTES];
+        if (BOOL_FLAG(sls_client_openssl_digest) && OpensslHmacSha1(message, key, res)) {
+            return string(reinterpret_cast<const char*>(res), SHA1_DIGEST_BYTES);
+        }
         HMAC hmac(reinterpret_cast<const uint8_t*>(key.data()), key.size());
         hmac.add(reinterpret_cast<const uint8_t*>(message.data()), message.size());
         return string(reinterpret_cast<const char*>(hmac.result()), SHA1_DIGEST_BYTES);
@@ -361,7 +395,9 @@ namespace sdk {
         string signature;
         string osstream;
         if (!content.empty()) {
-            contentMd5 = CalcMD5(content);
+            // content md5 is normally put in header by the caller already, no need to scan the content again
+            auto md5Iter = httpHeader.find(CONTENT_MD5);
+            contentMd5 = md5Iter != httpHeader.end() ? md5Iter->second : CalcMD5(content);
         }
         string contentType;
         map<string, string>::iterator iter = httpHeader.find(CONTENT_TYPE);
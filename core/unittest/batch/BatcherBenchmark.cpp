@@ -0,0 +1,121 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "common/TimeUtil.h"
+#include "pipeline/batch/Batcher.h"
+#include "unittest/plugin/PluginMock.h"
+
+#ifdef ENABLE_COMPATIBLE_MODE
+extern "C" {
+#include <string.h>
+asm(".symver memcpy, memcpy@GLIBC_2.2.5");
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+    return memcpy(dest, src, n);
+}
+}
+#endif
+
+using namespace std;
+
+namespace logtail {
+
+// measures the throughput of Batcher::Add when several processor threads feed the same flusher
+class BatcherBenchmark {
+public:
+    BatcherBenchmark() {
+        mCtx.SetConfigName("test_config");
+        mFlusher.SetContext(mCtx);
+        mFlusher.SetMetricsRecordRef(FlusherMock::sName, "1");
+        mFlusher.SetPluginID("1");
+    }
+
+    // each thread adds groups with its own tags, so that batches of different threads do not share keys
+    void TestAddWithDistinctKeys(size_t threadCnt) { Run(threadCnt, true, __func__); }
+    // all threads add groups with the same tags, which is the worst case for striping
+    void TestAddWithSameKey(size_t threadCnt) { Run(threadCnt, false, __func__); }
+
+private:
+    static constexpr size_t sGroupCntPerThread = 2000;
+    static constexpr size_t sEventCntPerGroup = 10;
+
+    void Run(size_t threadCnt, bool distinctKeys, const char* name) {
+        DefaultFlushStrategyOptions strategy;
+        strategy.mMinCnt = 1000;
+        strategy.mMinSizeBytes = 256 * 1024;
+        strategy.mTimeoutSecs = 3;
+        Batcher<> batch;
+        batch.Init(Json::Value(), &mFlusher, strategy);
+
+        // SetUp
+        vector<vector<PipelineEventGroup>> groups(threadCnt);
+        for (size_t i = 0; i < threadCnt; ++i) {
+            groups[i].reserve(sGroupCntPerThread);
+            for (size_t j = 0; j < sGroupCntPerThread; ++j) {
+                groups[i].emplace_back(CreateEventGroup(distinctKeys ? "val_" + to_string(i) : "val"));
+            }
+        }
+        // Test
+        vector<thread> threads;
+        uint64_t starttime = GetCurrentTimeInMicroSeconds();
+        for (size_t i = 0; i < threadCnt; ++i) {
+            threads.emplace_back([&batch, &groups, i]() {
+                vector<BatchedEventsList> res;
+                for (auto& group : groups[i]) {
+                    batch.Add(std::move(group), res);
+                    res.clear();
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        uint64_t timeelapsed = GetCurrentTimeInMicroSeconds() - starttime;
+        vector<BatchedEventsList> res;
+        batch.FlushAll(res);
+        printf("%s with %lu threads costs %lums, %.0f groups/s\n",
+               name,
+               threadCnt,
+               timeelapsed / 1000,
+               threadCnt * sGroupCntPerThread * 1000000.0 / max<uint64_t>(timeelapsed, 1));
+    }
+
+    PipelineEventGroup CreateEventGroup(const string& tagValue) {
+        PipelineEventGroup group(make_shared<SourceBuffer>());
+        group.SetTag(string("key"), tagValue);
+        for (size_t i = 0; i < sEventCntPerGroup; ++i) {
+            auto e = group.AddLogEvent();
+            e->SetTimestamp(time(nullptr));
+            e->SetContent(string("content"), string("a log line of moderate length for benchmark"));
+        }
+        return group;
+    }
+
+    PipelineContext mCtx;
+    FlusherMock mFlusher;
+};
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    logtail::BatcherBenchmark benchmark;
+    for (size_t threadCnt : {8, 16, 32}) {
+        benchmark.TestAddWithDistinctKeys(threadCnt);
+        benchmark.TestAddWithSameKey(threadCnt);
+    }
+    return 0;
+}
@@ -29,6 +29,8 @@ public:
     void TestAddWithoutGroupBatch();
     void TestAddWithGroupBatch();
     void TestAddWithOversizedGroup();
+    void TestAddWithShardHashKeys();
+    void TestAddWithAdaptiveBatch();
     void TestFlushEventQueueWithoutGroupBatch();
     void TestFlushEventQueueWithGroupBatch();
     void TestFlushGroupQueue();
@@ -157,8 +159,8 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     SourceBuffer* buffer1 = group1.GetSourceBuffer().get();
     RangeCheckpoint* eoo1 = group1.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group1), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(2U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.GetEventQueueCnt());
+    APSARA_TEST_EQUAL(2U, batch.GetEventQueue(key).mBatch.mEvents.size());
     APSARA_TEST_EQUAL(0U, res.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
@@ -174,8 +176,8 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     SourceBuffer* buffer2 = group2.GetSourceBuffer().get();
     RangeCheckpoint* eoo2 = group2.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group2), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.GetEventQueueCnt());
+    APSARA_TEST_EQUAL(1U, batch.GetEventQueue(key).mBatch.mEvents.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(3U, res[0][0].mEvents.size());
@@ -197,8 +199,8 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     SourceBuffer* buffer3 = group3.GetSourceBuffer().get();
     RangeCheckpoint* eoo3 = group3.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group3), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.GetEventQueueCnt());
+    APSARA_TEST_EQUAL(0U, batch.GetEventQueue(key).mBatch.mEvents.size());
     APSARA_TEST_EQUAL(2U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(1U, res[0][0].mEvents.size());
@@ -238,8 +240,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     SourceBuffer* buffer1 = group1.GetSourceBuffer().get();
     RangeCheckpoint* eoo1 = group1.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group1), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(2U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.GetEventQueueCnt());
+    APSARA_TEST_EQUAL(2U, batch.GetEventQueue(key).mBatch.mEvents.size());
     APSARA_TEST_EQUAL(0U, res.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
@@ -255,8 +257,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     SourceBuffer* buffer2 = group2.GetSourceBuffer().get();
     RangeCheckpoint* eoo2 = group2.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group2), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.GetEventQueueCnt());
+    APSARA_TEST_EQUAL(1U, batch.GetEventQueue(key).mBatch.mEvents.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(3U, res[0][0].mEvents.size());
@@ -278,8 +280,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     RangeCheckpoint* eoo3 = group3.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group3), res);
     APSARA_TEST_EQUAL(0U, res.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.GetEventQueueCnt());
+    APSARA_TEST_EQUAL(1U, batch.GetEventQueue(key).mBatch.mEvents.size());
 
     // flush by time to group batch, and then group flush by time
     batch.mGroupFlushStrategy->SetTimeoutSecs(0);
@@ -287,8 +289,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     SourceBuffer* buffer4 = group4.GetSourceBuffer().get();
     RangeCheckpoint* eoo4 = group4.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group4), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.GetEventQueueCnt());
+    APSARA_TEST_EQUAL(1U, batch.GetEventQueue(key).mBatch.mEvents.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(1U, res[0][0].mEvents.size());
@@ -309,8 +311,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     SourceBuffer* buffer5 = group5.GetSourceBuffer().get();
     RangeCheckpoint* eoo5 = group5.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group5), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.GetEventQueueCnt());
+    APSARA_TEST_EQUAL(1U, batch.GetEventQueue(key).mBatch.mEvents.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(2U, res[0].size());
     APSARA_TEST_EQUAL(1U, res[0][0].mEvents.size());
@@ -342,8 +344,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     PipelineEventGroup group7 = CreateEventGroup(2);
     SourceBuffer* buffer7 = group7.GetSourceBuffer().get();
     batch.Add(std::move(group7), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.GetEventQueueCnt());
+    APSARA_TEST_EQUAL(1U, batch.GetEventQueue(key).mBatch.mEvents.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(3U, res[0][0].mEvents.size());
@@ -376,8 +378,8 @@ void BatcherUnittest::TestAddWithOversizedGroup() {
 
     PipelineEventGroup group2 = CreateEventGroup(20);
     batch.Add(std::move(group2), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.GetEventQueueCnt());
+    APSARA_TEST_EQUAL(0U, batch.GetEventQueue(key).mBatch.mEvents.size());
     APSARA_TEST_EQUAL(3U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(2U, res[0][0].mEvents.size());
@@ -387,6 +389,104 @@ void BatcherUnittest::TestAddWithOversizedGroup() {
     APSARA_TEST_EQUAL(7U, res[2][0].mEvents.size());
 }
 
+void BatcherUnittest::TestAddWithShardHashKeys() {
+    DefaultFlushStrategyOptions strategy;
+    strategy.mMinCnt = 2;
+    strategy.mMinSizeBytes = 1000;
+    strategy.mTimeoutSecs = 3;
+
+    Batcher<> batch;
+    batch.Init(Json::Value(), sFlusher.get(), strategy, false, {"key", "missing_key"});
+    APSARA_TEST_NOT_EQUAL(nullptr, batch.mShardHashKeysTotal);
+    APSARA_TEST_NOT_EQUAL(nullptr, batch.mMaxShardHashKeyBatchesTotal);
+
+    vector<BatchedEventsList> res;
+    PipelineEventGroup group1 = CreateEventGroup(1);
+    size_t key = group1.GetTagsHash();
+    uint64_t shardHashKey = XXH64("", 0, XXH64("val", 3, 0));
+    batch.Add(std::move(group1), res);
+    APSARA_TEST_EQUAL(shardHashKey, *batch.GetEventQueue(key).GetShardHashKey());
+
+    batch.Add(CreateEventGroup(3), res);
+    APSARA_TEST_EQUAL(2U, res.size());
+    APSARA_TEST_EQUAL(shardHashKey, *res[0][0].mShardHashKey);
+    APSARA_TEST_EQUAL(shardHashKey, *res[1][0].mShardHashKey);
+    APSARA_TEST_EQUAL(1U, batch.mShardHashKeysTotal->GetValue());
+    APSARA_TEST_EQUAL(2U, batch.mMaxShardHashKeyBatchesTotal->GetValue());
+
+    PipelineEventGroup group2 = CreateEventGroup(2);
+    group2.SetTag(string("key"), string("another_val"));
+    batch.Add(std::move(group2), res);
+    APSARA_TEST_EQUAL(3U, res.size());
+    APSARA_TEST_EQUAL(XXH64("", 0, XXH64("another_val", 11, 0)), *res[2][0].mShardHashKey);
+    APSARA_TEST_EQUAL(2U, batch.mShardHashKeysTotal->GetValue());
+    APSARA_TEST_EQUAL(2U, batch.mMaxShardHashKeyBatchesTotal->GetValue());
+}
+
+void BatcherUnittest::TestAddWithAdaptiveBatch() {
+    DefaultFlushStrategyOptions strategy;
+    strategy.mMinCnt = 10;
+    strategy.mMaxSizeBytes = 10000;
+    strategy.mMinSizeBytes = 1000;
+    strategy.mTimeoutSecs = 3;
+
+    Json::Value configJson;
+    string configStr, errorMsg;
+    {
+        // invalid bounds
+        configStr = R"(
+            {
+                "EnableAdaptiveBatch": true,
+                "AdaptiveMinSizeBytes": 2000,
+                "AdaptiveMaxSizeBytes": 1500
+            }
+        )";
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+        Batcher<> batch;
+        batch.Init(configJson, sFlusher.get(), strategy);
+        APSARA_TEST_FALSE(batch.mAdaptiveFlushStrategy.has_value());
+        APSARA_TEST_EQUAL(1000U, batch.mEventFlushStrategy.GetMinSizeBytes());
+    }
+    {
+        configStr = R"(
+            {
+                "EnableAdaptiveBatch": true,
+                "AdaptiveMinSizeBytes": 100,
+                "AdaptiveMaxSizeBytes": 4000,
+                "AdaptiveTargetLatencyMs": 1000
+            }
+        )";
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+        Batcher<> batch;
+        batch.Init(configJson, sFlusher.get(), strategy, true);
+        APSARA_TEST_TRUE(batch.mAdaptiveFlushStrategy.has_value());
+        APSARA_TEST_EQUAL(1000U, batch.mTargetSizeBytes->GetValue());
+        APSARA_TEST_EQUAL(10U, batch.mTargetCnt->GetValue());
+
+        // fast response, batch grows
+        for (int i = 0; i < 20; ++i) {
+            batch.OnSendDone(10, 1000, 1000);
+        }
+        batch.mAdaptiveFlushStrategy->mLastAdjustTime -= AdaptiveFlushStrategy::sAdjustIntervalSecs;
+        vector<BatchedEventsList> res;
+        batch.Add(CreateEventGroup(1), res);
+        APSARA_TEST_EQUAL(1250U, batch.mEventFlushStrategy.GetMinSizeBytes());
+        APSARA_TEST_EQUAL(12U, batch.mEventFlushStrategy.GetMinCnt());
+        APSARA_TEST_EQUAL(1250U, batch.mGroupFlushStrategy->GetMinSizeBytes());
+        APSARA_TEST_EQUAL(1250U, batch.mTargetSizeBytes->GetValue());
+        APSARA_TEST_EQUAL(12U, batch.mTargetCnt->GetValue());
+
+        // slow response, batch shrinks
+        for (int i = 0; i < 20; ++i) {
+            batch.OnSendDone(5000, 1000, 1000);
+        }
+        batch.mAdaptiveFlushStrategy->mLastAdjustTime -= AdaptiveFlushStrategy::sAdjustIntervalSecs;
+        batch.Add(CreateEventGroup(1), res);
+        APSARA_TEST_LT(batch.mEventFlushStrategy.GetMinSizeBytes(), 1250U);
+        APSARA_TEST_LT(batch.mEventFlushStrategy.GetMinCnt(), 12U);
+    }
+}
+
 void BatcherUnittest::TestFlushEventQueueWithoutGroupBatch() {
     DefaultFlushStrategyOptions strategy;
     strategy.mMinCnt = 3;
@@ -410,7 +510,7 @@ void BatcherUnittest::TestFlushEventQueueWithoutGroupBatch() {
 
     // key existed
     batch.FlushQueue(key, res);
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.GetEventQueueCnt());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(2U, res[0].mEvents.size());
     APSARA_TEST_EQUAL(1U, res[0].mTags.mInner.size());
@@ -439,7 +539,7 @@ void BatcherUnittest::TestFlushEventQueueWithGroupBatch() {
     RangeCheckpoint* eoo1 = group1.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group1), tmp);
     batch.FlushQueue(key, res);
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.GetEventQueueCnt());
     APSARA_TEST_EQUAL(0U, res.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(2U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
@@ -459,7 +559,7 @@ void BatcherUnittest::TestFlushEventQueueWithGroupBatch() {
     RangeCheckpoint* eoo2 = group2.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group2), tmp);
     batch.FlushQueue(key, res);
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.GetEventQueueCnt());
     APSARA_TEST_EQUAL(2U, res.size());
     APSARA_TEST_EQUAL(2U, res[0].mEvents.size());
     APSARA_TEST_EQUAL(1U, res[0].mTags.mInner.size());
@@ -533,7 +633,7 @@ void BatcherUnittest::TestFlushAllWithoutGroupBatch() {
 
     vector<BatchedEventsList> res;
     batch.FlushAll(res);
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.GetEventQueueCnt());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(2U, res[0][0].mEvents.size());
@@ -578,7 +678,7 @@ void BatcherUnittest::TestFlushAllWithGroupBatch() {
     batch.mGroupFlushStrategy->SetMinSizeBytes(10);
     vector<BatchedEventsList> res;
     batch.FlushAll(res);
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.GetEventQueueCnt());
     APSARA_TEST_EQUAL(2U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(2U, res[0][0].mEvents.size());
@@ -672,6 +772,8 @@ UNIT_TEST_CASE(BatcherUnittest, TestParamInit)
 UNIT_TEST_CASE(BatcherUnittest, TestInitWithoutGroupBatch)
 UNIT_TEST_CASE(BatcherUnittest, TestInitWithGroupBatch)
 UNIT_TEST_CASE(BatcherUnittest, TestAddWithOversizedGroup)
+UNIT_TEST_CASE(BatcherUnittest, TestAddWithShardHashKeys)
+UNIT_TEST_CASE(BatcherUnittest, TestAddWithAdaptiveBatch)
 UNIT_TEST_CASE(BatcherUnittest, TestAddWithoutGroupBatch)
 UNIT_TEST_CASE(BatcherUnittest, TestAddWithGroupBatch)
 UNIT_TEST_CASE(BatcherUnittest, TestFlushEventQueueWithoutGroupBatch)
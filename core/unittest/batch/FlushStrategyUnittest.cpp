@@ -24,6 +24,7 @@ namespace logtail {
 class EventFlushStrategyUnittest : public ::testing::Test {
 public:
     void TestNeedFlush();
+    void TestZeroMinCnt();
 
 protected:
     void SetUp() override {
@@ -70,7 +71,18 @@ void EventFlushStrategyUnittest::TestNeedFlush() {
     APSARA_TEST_TRUE(mStrategy.SizeReachingUpperLimit(status));
 }
 
+void EventFlushStrategyUnittest::TestZeroMinCnt() {
+    // e.g., DefaultFlushStrategyOptions
+    EventFlushStrategy<EventBatchStatus> strategy;
+    EventBatchStatus status;
+    for (uint32_t cnt : {0U, 1U, 1000U}) {
+        status.mCnt = cnt;
+        APSARA_TEST_FALSE(strategy.NeedFlushByCnt(status));
+    }
+}
+
 UNIT_TEST_CASE(EventFlushStrategyUnittest, TestNeedFlush)
+UNIT_TEST_CASE(EventFlushStrategyUnittest, TestZeroMinCnt)
 
 class GroupFlushStrategyUnittest : public ::testing::Test {
 public:
@@ -150,6 +162,96 @@ void SLSEventFlushStrategyUnittest::TestNeedFlush() {
 
 UNIT_TEST_CASE(SLSEventFlushStrategyUnittest, TestNeedFlush)
 
+class AdaptiveFlushStrategyUnittest : public ::testing::Test {
+public:
+    void TestInit();
+    void TestUpdateTargetByLatency();
+    void TestUpdateTargetByCompressionRatio();
+
+private:
+    // enough samples for the moving average to converge, and the adjust interval is reached
+    void AddSamples(AdaptiveFlushStrategy& strategy, uint64_t latencyMs, size_t rawSize, size_t sentSize) {
+        for (uint32_t i = 0; i < 20; ++i) {
+            strategy.OnSendDone(latencyMs, rawSize, sentSize);
+        }
+        strategy.mLastAdjustTime -= AdaptiveFlushStrategy::sAdjustIntervalSecs;
+    }
+};
+
+void AdaptiveFlushStrategyUnittest::TestInit() {
+    {
+        AdaptiveFlushStrategy strategy(100, 400, 200, 1000);
+        APSARA_TEST_EQUAL(200U, strategy.GetTargetSizeBytes());
+    }
+    {
+        AdaptiveFlushStrategy strategy(100, 400, 500, 1000);
+        APSARA_TEST_EQUAL(400U, strategy.GetTargetSizeBytes());
+    }
+    {
+        AdaptiveFlushStrategy strategy(100, 400, 50, 1000);
+        APSARA_TEST_EQUAL(100U, strategy.GetTargetSizeBytes());
+    }
+}
+
+void AdaptiveFlushStrategyUnittest::TestUpdateTargetByLatency() {
+    AdaptiveFlushStrategy strategy(100, 400, 200, 1000);
+    uint32_t target = 0;
+
+    // not enough samples
+    strategy.OnSendDone(100, 1000, 1000);
+    strategy.mLastAdjustTime -= AdaptiveFlushStrategy::sAdjustIntervalSecs;
+    APSARA_TEST_FALSE(strategy.UpdateTarget(target));
+
+    // not reaching adjust interval
+    strategy.mLastAdjustTime = time(nullptr);
+    for (uint32_t i = 0; i < AdaptiveFlushStrategy::sMinSampleCnt; ++i) {
+        strategy.OnSendDone(100, 1000, 1000);
+    }
+    APSARA_TEST_FALSE(strategy.UpdateTarget(target));
+
+    // low latency
+    AddSamples(strategy, 100, 1000, 1000);
+    APSARA_TEST_TRUE(strategy.UpdateTarget(target));
+    APSARA_TEST_EQUAL(250U, target);
+
+    // latency within range
+    AddSamples(strategy, 700, 1000, 1000);
+    APSARA_TEST_FALSE(strategy.UpdateTarget(target));
+    APSARA_TEST_EQUAL(250U, strategy.GetTargetSizeBytes());
+
+    // high latency
+    AddSamples(strategy, 5000, 1000, 1000);
+    APSARA_TEST_TRUE(strategy.UpdateTarget(target));
+    APSARA_TEST_LT(target, 250U);
+
+    // lower bound
+    for (int i = 0; i < 10; ++i) {
+        AddSamples(strategy, 5000, 1000, 1000);
+        strategy.UpdateTarget(target);
+    }
+    APSARA_TEST_EQUAL(100U, strategy.GetTargetSizeBytes());
+}
+
+void AdaptiveFlushStrategyUnittest::TestUpdateTargetByCompressionRatio() {
+    AdaptiveFlushStrategy strategy(100, 1000, 200, 1000);
+    uint32_t target = 0;
+
+    AddSamples(strategy, 700, 1000, 1000);
+    APSARA_TEST_FALSE(strategy.UpdateTarget(target));
+
+    // data compresses better, so more raw data can be sent at the same cost
+    for (int i = 0; i < 10; ++i) {
+        AddSamples(strategy, 700, 1000, 250);
+        strategy.UpdateTarget(target);
+    }
+    APSARA_TEST_GT(strategy.GetTargetSizeBytes(), 600U);
+    APSARA_TEST_LE(strategy.GetTargetSizeBytes(), 1000U);
+}
+
+UNIT_TEST_CASE(AdaptiveFlushStrategyUnittest, TestInit)
+UNIT_TEST_CASE(AdaptiveFlushStrategyUnittest, TestUpdateTargetByLatency)
+UNIT_TEST_CASE(AdaptiveFlushStrategyUnittest, TestUpdateTargetByCompressionRatio)
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
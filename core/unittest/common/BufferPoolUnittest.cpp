@@ -0,0 +1,151 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/memory/BufferPool.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT64(buffer_pool_max_size_bytes);
+
+using namespace std;
+
+namespace logtail {
+
+class BufferPoolUnittest : public ::testing::Test {
+public:
+    void TestAcquire();
+    void TestRelease();
+    void TestReserve();
+    void TestShrink();
+
+protected:
+    void SetUp() override { BufferPool::GetInstance()->Clear(); }
+    void TearDown() override {
+        BufferPool::GetInstance()->Clear();
+        INT64_FLAG(buffer_pool_max_size_bytes) = 64 * 1024 * 1024;
+    }
+};
+
+void BufferPoolUnittest::TestAcquire() {
+    auto pool = BufferPool::GetInstance();
+    {
+        // rounded up to size class
+        string buf = pool->Acquire(5000);
+        APSARA_TEST_TRUE(buf.empty());
+        APSARA_TEST_GE(buf.capacity(), 8192U);
+    }
+    {
+        // larger than the largest size class
+        string buf = pool->Acquire(32 * 1024 * 1024);
+        APSARA_TEST_GE(buf.capacity(), 32U * 1024 * 1024);
+        pool->Release(std::move(buf));
+        APSARA_TEST_EQUAL(0U, pool->GetPooledSizeBytes());
+    }
+    {
+        // pooled buffer is reused
+        string buf = pool->Acquire(5000);
+        buf.append(100, 'a');
+        const char* addr = buf.data();
+        pool->Release(std::move(buf));
+        APSARA_TEST_EQUAL(1U, pool->mPooledBuffersTotal->GetValue());
+
+        string res = pool->Acquire(6000);
+        APSARA_TEST_TRUE(res.empty());
+        APSARA_TEST_EQUAL(addr, res.data());
+        APSARA_TEST_EQUAL(0U, pool->GetPooledSizeBytes());
+        APSARA_TEST_EQUAL(0U, pool->mPooledBuffersTotal->GetValue());
+    }
+}
+
+void BufferPoolUnittest::TestRelease() {
+    auto pool = BufferPool::GetInstance();
+    {
+        // too small to be pooled
+        string buf(100, 'a');
+        pool->Release(std::move(buf));
+        APSARA_TEST_EQUAL(0U, pool->GetPooledSizeBytes());
+    }
+    {
+        // placed in the largest size class it can serve
+        string buf;
+        buf.reserve(12000);
+        size_t capacity = buf.capacity();
+        pool->Release(std::move(buf));
+        APSARA_TEST_EQUAL(capacity, pool->GetPooledSizeBytes());
+        APSARA_TEST_EQUAL(1U, pool->mClasses[1].mBuffers.size());
+        APSARA_TEST_EQUAL(capacity, static_cast<size_t>(pool->mPooledSizeBytesGauge->GetValue()));
+    }
+    {
+        // pool is full
+        INT64_FLAG(buffer_pool_max_size_bytes) = 16 * 1024;
+        uint64_t discarded = pool->mDiscardedBuffersTotal->GetValue();
+        string buf;
+        buf.reserve(8192);
+        pool->Release(std::move(buf));
+        APSARA_TEST_EQUAL(discarded + 1, pool->mDiscardedBuffersTotal->GetValue());
+        APSARA_TEST_EQUAL(1U, pool->mPooledBuffersTotal->GetValue());
+    }
+}
+
+void BufferPoolUnittest::TestReserve() {
+    auto pool = BufferPool::GetInstance();
+    {
+        // capacity is enough, content is kept
+        string buf = pool->Acquire(4096);
+        buf.append("hello");
+        pool->Reserve(buf, 100);
+        APSARA_TEST_EQUAL("hello", buf);
+        APSARA_TEST_EQUAL(0U, pool->GetPooledSizeBytes());
+    }
+    {
+        // capacity is not enough, the old buffer goes to the pool
+        string buf = pool->Acquire(4096);
+        size_t capacity = buf.capacity();
+        pool->Reserve(buf, 10000);
+        APSARA_TEST_GE(buf.capacity(), 10000U);
+        APSARA_TEST_EQUAL(capacity, pool->GetPooledSizeBytes());
+    }
+}
+
+void BufferPoolUnittest::TestShrink() {
+    auto pool = BufferPool::GetInstance();
+    {
+        // capacity is less than twice of the class fitting the content, nothing is done
+        string buf = pool->Acquire(8192);
+        buf.assign(5000, 'a');
+        size_t capacity = buf.capacity();
+        pool->Shrink(buf);
+        APSARA_TEST_EQUAL(capacity, buf.capacity());
+        APSARA_TEST_EQUAL(0U, pool->GetPooledSizeBytes());
+    }
+    {
+        // content is moved to a buffer of the fitting class, and the old buffer goes to the pool
+        string buf = pool->Acquire(1024 * 1024);
+        buf.assign(100000, 'a');
+        size_t capacity = buf.capacity();
+        pool->Shrink(buf);
+        APSARA_TEST_EQUAL(string(100000, 'a'), buf);
+        APSARA_TEST_GE(buf.capacity(), 100000U);
+        APSARA_TEST_TRUE(buf.capacity() < 2 * 128 * 1024U);
+        APSARA_TEST_EQUAL(capacity, pool->GetPooledSizeBytes());
+    }
+}
+
+UNIT_TEST_CASE(BufferPoolUnittest, TestAcquire)
+UNIT_TEST_CASE(BufferPoolUnittest, TestRelease)
+UNIT_TEST_CASE(BufferPoolUnittest, TestReserve)
+UNIT_TEST_CASE(BufferPoolUnittest, TestShrink)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
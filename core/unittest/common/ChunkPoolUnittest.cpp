@@ -0,0 +1,115 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <thread>
+
+#include "common/memory/ChunkPool.h"
+#include "common/memory/SourceBuffer.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT64(chunk_pool_max_size_bytes);
+
+using namespace std;
+
+namespace logtail {
+
+class ChunkPoolUnittest : public ::testing::Test {
+public:
+    void TestAcquire();
+    void TestRelease();
+    void TestSourceBufferRecycle();
+
+protected:
+    void SetUp() override { ChunkPool::GetInstance()->Clear(); }
+    void TearDown() override {
+        ChunkPool::GetInstance()->Clear();
+        INT64_FLAG(chunk_pool_max_size_bytes) = 64 * 1024 * 1024;
+    }
+};
+
+void ChunkPoolUnittest::TestAcquire() {
+    auto pool = ChunkPool::GetInstance();
+    {
+        // larger than the largest size class
+        uint8_t* chunk = pool->Acquire(32 * 1024 * 1024);
+        APSARA_TEST_NOT_EQUAL(nullptr, chunk);
+        pool->Release(chunk, 32 * 1024 * 1024);
+        APSARA_TEST_EQUAL(0U, pool->GetPooledSizeBytes());
+    }
+    {
+        // pooled chunk is reused by requests of the same size class
+        uint8_t* chunk = pool->Acquire(5000);
+        pool->Release(chunk, 5000);
+        APSARA_TEST_EQUAL(8192U, pool->GetPooledSizeBytes());
+        APSARA_TEST_EQUAL(1U, pool->mPooledChunksTotal->GetValue());
+
+        uint64_t reused = pool->mReusedChunksTotal->GetValue();
+        APSARA_TEST_EQUAL(chunk, pool->Acquire(6000));
+        APSARA_TEST_EQUAL(reused + 1, pool->mReusedChunksTotal->GetValue());
+        APSARA_TEST_EQUAL(0U, pool->GetPooledSizeBytes());
+        APSARA_TEST_EQUAL(0U, pool->mPooledChunksTotal->GetValue());
+        pool->Release(chunk, 6000);
+    }
+    {
+        // a request slightly larger than the class size stays in the class
+        uint8_t* chunk = pool->Acquire(512 * 1024 + 1);
+        pool->Release(chunk, 512 * 1024 + 1);
+        APSARA_TEST_EQUAL(1U, pool->mClasses[7].mChunks.size());
+    }
+}
+
+void ChunkPoolUnittest::TestRelease() {
+    auto pool = ChunkPool::GetInstance();
+    pool->Release(nullptr, 4096);
+    APSARA_TEST_EQUAL(0U, pool->GetPooledSizeBytes());
+
+    INT64_FLAG(chunk_pool_max_size_bytes) = 8192;
+    uint8_t* chunk1 = pool->Acquire(4096);
+    uint8_t* chunk2 = pool->Acquire(4096);
+    uint8_t* chunk3 = pool->Acquire(4096);
+    pool->Release(chunk1, 4096);
+    pool->Release(chunk2, 4096);
+    APSARA_TEST_EQUAL(8192U, pool->GetPooledSizeBytes());
+    APSARA_TEST_EQUAL(8192U, pool->mPooledSizeBytesGauge->GetValue());
+    // pool is full
+    uint64_t discarded = pool->mDiscardedChunksTotal->GetValue();
+    pool->Release(chunk3, 4096);
+    APSARA_TEST_EQUAL(discarded + 1, pool->mDiscardedChunksTotal->GetValue());
+    APSARA_TEST_EQUAL(2U, pool->mPooledChunksTotal->GetValue());
+}
+
+void ChunkPoolUnittest::TestSourceBufferRecycle() {
+    auto pool = ChunkPool::GetInstance();
+    const size_t readSize = 512 * 1024;
+    auto sourceBuffer = make_shared<SourceBuffer>();
+    char* data = sourceBuffer->AllocateStringBuffer(readSize).data;
+    // released by the last holder on another thread
+    thread([buffer = std::move(sourceBuffer)]() mutable { buffer.reset(); }).join();
+    APSARA_TEST_EQUAL(readSize + 4096, pool->GetPooledSizeBytes());
+
+    uint64_t allocated = pool->mAllocatedChunksTotal->GetValue();
+    auto next = make_shared<SourceBuffer>();
+    APSARA_TEST_EQUAL(data, next->AllocateStringBuffer(readSize).data);
+    APSARA_TEST_EQUAL(allocated, pool->mAllocatedChunksTotal->GetValue());
+    APSARA_TEST_EQUAL(0U, pool->GetPooledSizeBytes());
+}
+
+UNIT_TEST_CASE(ChunkPoolUnittest, TestAcquire)
+UNIT_TEST_CASE(ChunkPoolUnittest, TestRelease)
+UNIT_TEST_CASE(ChunkPoolUnittest, TestSourceBufferRecycle)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
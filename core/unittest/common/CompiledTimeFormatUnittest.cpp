@@ -0,0 +1,175 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <ctime>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/CompiledTimeFormat.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class CompiledTimeFormatUnittest : public ::testing::Test {
+public:
+    void TestCompile();
+    void TestSameAsStrptime();
+    void TestRandomInput();
+    void TestDaylightSavingTime();
+
+private:
+    // compares the results of the compiled format and Strptime
+    static void ExpectSameAsStrptime(const string& format, const string& input) {
+        CompiledTimeFormat compiled(format);
+        LogtailTime expected = {0, 0};
+        LogtailTime actual = {0, 0};
+        int expectedLength = -1;
+        int actualLength = -1;
+        const char* expectedEnd = Strptime(input.c_str(), format.c_str(), &expected, expectedLength);
+        const char* actualEnd = compiled.Parse(input.c_str(), input.size(), &actual, actualLength);
+        EXPECT_EQ(expectedEnd == nullptr ? -1 : expectedEnd - input.c_str(),
+                  actualEnd == nullptr ? -1 : actualEnd - input.c_str())
+            << format << " " << input;
+        if (expectedEnd == nullptr) {
+            return;
+        }
+        EXPECT_EQ(expected.tv_sec, actual.tv_sec) << format << " " << input;
+        EXPECT_EQ(expected.tv_nsec, actual.tv_nsec) << format << " " << input;
+        EXPECT_EQ(expectedLength, actualLength) << format << " " << input;
+    }
+};
+
+void CompiledTimeFormatUnittest::TestCompile() {
+    for (const auto& format : vector<string>{"%Y-%m-%d %H:%M:%S",
+                                             "%Y-%m-%d %H:%M:%S.%f",
+                                             "%FT%T.%fZ",
+                                             "[%Y-%m-%d %H:%M:%S.%f]",
+                                             "%Y%m%d%H%M%S",
+                                             "%d/%m/%y %k:%M",
+                                             "%Y-%m-%d %H:%M:%S 100%%"}) {
+        EXPECT_TRUE(CompiledTimeFormat(format).IsCompiled()) << format;
+    }
+    for (const auto& format : vector<string>{"",
+                                             "%s",
+                                             "%f",
+                                             "%H:%M:%S",
+                                             "%m-%d %H:%M:%S",
+                                             "%d %b %Y %H:%M:%S",
+                                             "%Y-%m-%d %H:%M:%S %z",
+                                             "%Y-%m-%d %H:%M:%S.%f %H",
+                                             "%Y-%y-%m-%d %H:%M",
+                                             "%Y-%m-%d %H:%M:%S %Y",
+                                             "%Y-%m-%d %H:%M:%S %"}) {
+        EXPECT_FALSE(CompiledTimeFormat(format).IsCompiled()) << format;
+    }
+}
+
+void CompiledTimeFormatUnittest::TestSameAsStrptime() {
+    vector<pair<string, vector<string>>> cases = {
+        {"%Y-%m-%d %H:%M:%S",
+         {"2024-01-02 03:04:05",
+          "2024-12-31 23:59:59 trailing",
+          "2024-02-31 10:00:00",
+          "2024-06-30 12:00:61",
+          "2024-1-02 03:04:05",
+          "2024-01-02  03:04:05",
+          "2024-01-02\t03:04:05",
+          "2024-01-0203:04:05",
+          "2024-13-02 03:04:05",
+          "2024-00-02 03:04:05",
+          "2024-01-00 03:04:05",
+          "2024-01-32 03:04:05",
+          "2024-01-02 24:04:05",
+          "2024-01-02 03:60:05",
+          "2024-01-02 03:04:62",
+          "2024/01/02 03:04:05",
+          "2024-01-02 03:04",
+          "0000-01-01 00:00:00",
+          "9999-12-31 23:59:59"}},
+        {"%Y-%m-%d %H:%M:%S.%f",
+         {"2024-01-02 03:04:05.1",
+          "2024-01-02 03:04:05.123456789",
+          "2024-01-02 03:04:05.123456789 more",
+          "2024-01-02 03:04:05.",
+          "2024-01-02 03:04:05",
+          "2024-01-02 03:04:05.x"}},
+        {"%FT%T.%fZ",
+         {"2024-01-02T03:04:05.123Z", "2024-01-02T03:04:05.123456Z+08:00", "2024-01-02T03:04:05.123+08:00"}},
+        {"[%Y-%m-%d %H:%M:%S.%f]", {"[2024-01-02 03:04:05.012]\t[INFO]", "[2024-01-02 03:04:05.012"}},
+        {"%Y%m%d%H%M%S", {"20240102030405", "2024010203040"}},
+        {"%d/%m/%y %k:%M", {"02/01/24 03:04", "02/01/68 03:04", "02/01/69 03:04", "02/01/24 3:04"}},
+        {"%Y-%m-%d %H:%M:%S 100%%", {"2024-01-02 03:04:05 100%", "2024-01-02 03:04:05 100"}},
+    };
+    for (const auto& item : cases) {
+        EXPECT_TRUE(CompiledTimeFormat(item.first).IsCompiled()) << item.first;
+        for (const auto& input : item.second) {
+            ExpectSameAsStrptime(item.first, input);
+        }
+    }
+}
+
+void CompiledTimeFormatUnittest::TestRandomInput() {
+    mt19937 rng(0);
+    string alphabet = "0123456789-: .T";
+    for (const auto& format : {"%Y-%m-%d %H:%M:%S", "%FT%T.%f", "%y%m%d %H%M"}) {
+        for (int i = 0; i < 10000; ++i) {
+            string input;
+            if (i % 2 == 0) {
+                // valid ones with a random byte changed
+                input = "2024-05-17T08:30:45.123";
+                input[rng() % input.size()] = alphabet[rng() % alphabet.size()];
+            } else {
+                for (size_t j = rng() % 30; j > 0; --j) {
+                    input += alphabet[rng() % (alphabet.size() - 4)];
+                }
+            }
+            ExpectSameAsStrptime(format, input);
+        }
+    }
+}
+
+void CompiledTimeFormatUnittest::TestDaylightSavingTime() {
+    const char* tz = getenv("TZ");
+    string originalTz = tz == nullptr ? "" : tz;
+    setenv("TZ", "America/New_York", 1);
+    tzset();
+    char buf[64];
+    // 2024-03-10 and 2024-11-03, when clocks go forward and back
+    for (int day : {10, 3}) {
+        int month = day == 10 ? 3 : 11;
+        for (int minute = 0; minute < 24 * 60; minute += 7) {
+            snprintf(buf, sizeof(buf), "2024-%02d-%02d %02d:%02d:17.5", month, day, minute / 60, minute % 60);
+            ExpectSameAsStrptime("%Y-%m-%d %H:%M:%S.%f", buf);
+        }
+    }
+    if (tz == nullptr) {
+        unsetenv("TZ");
+    } else {
+        setenv("TZ", originalTz.c_str(), 1);
+    }
+    tzset();
+}
+
+UNIT_TEST_CASE(CompiledTimeFormatUnittest, TestCompile)
+UNIT_TEST_CASE(CompiledTimeFormatUnittest, TestSameAsStrptime)
+UNIT_TEST_CASE(CompiledTimeFormatUnittest, TestRandomInput)
+UNIT_TEST_CASE(CompiledTimeFormatUnittest, TestDaylightSavingTime)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,91 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fnmatch.h>
+
+#include <string>
+#include <vector>
+
+#include "common/GlobPattern.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class GlobPatternUnittest : public ::testing::Test {};
+
+TEST_F(GlobPatternUnittest, TestType) {
+    EXPECT_EQ(GlobPattern::Type::LITERAL, GlobPattern("app.log", 0).GetType());
+    EXPECT_EQ(GlobPattern::Type::ANY, GlobPattern("*", 0).GetType());
+    EXPECT_EQ(GlobPattern::Type::ANY, GlobPattern("**", FNM_PATHNAME).GetType());
+    EXPECT_EQ(GlobPattern::Type::SUFFIX, GlobPattern("*.log", 0).GetType());
+    EXPECT_EQ(GlobPattern::Type::PREFIX, GlobPattern("app.log*", 0).GetType());
+    EXPECT_EQ(GlobPattern::Type::CONTAINS, GlobPattern("*error*", 0).GetType());
+    EXPECT_EQ(GlobPattern::Type::SUFFIX, GlobPattern("**.log", 0).GetType());
+    EXPECT_EQ(GlobPattern::Type::FNMATCH, GlobPattern("app*.log", 0).GetType());
+    EXPECT_EQ(GlobPattern::Type::FNMATCH, GlobPattern("app.?.log", 0).GetType());
+    EXPECT_EQ(GlobPattern::Type::FNMATCH, GlobPattern("app.[0-9].log", 0).GetType());
+    EXPECT_EQ(GlobPattern::Type::FNMATCH, GlobPattern("\\*.log", 0).GetType());
+    EXPECT_EQ(GlobPattern::Type::FNMATCH, GlobPattern("/var/log/*", FNM_PATHNAME).GetType());
+    EXPECT_EQ(GlobPattern::Type::PREFIX, GlobPattern("/var/log/*", 0).GetType());
+    EXPECT_EQ(GlobPattern::Type::FNMATCH, GlobPattern("*.log", FNM_PERIOD).GetType());
+}
+
+TEST_F(GlobPatternUnittest, TestMatchSameAsFnmatch) {
+    vector<string> patterns = {"",
+                               "*",
+                               "**",
+                               "app.log",
+                               "*.log",
+                               "app*",
+                               "*app*",
+                               "**app**",
+                               "app*.log",
+                               "app.?.log",
+                               "app.[0-9].log",
+                               "/var/log/*",
+                               "/var/log/**",
+                               "*/app.log",
+                               "/var/*/app.log",
+                               "/var/log/app.log"};
+    vector<string> strs = {"",
+                           "app.log",
+                           "app.log.1",
+                           "xapp.log",
+                           ".log",
+                           "app",
+                           "my_app_1",
+                           "app.1.log",
+                           "app.x.log",
+                           "/var/log/app.log",
+                           "/var/log/pods/app.log",
+                           "/var/log",
+                           "/var/log/",
+                           "log/app.log",
+                           "dir/app"};
+    for (int flags : {0, FNM_PATHNAME}) {
+        for (const auto& pattern : patterns) {
+            GlobPattern glob(pattern, flags);
+            for (const auto& str : strs) {
+                EXPECT_EQ(fnmatch(pattern.c_str(), str.c_str(), flags) == 0, glob.Match(str))
+                    << "pattern: " << pattern << ", str: " << str << ", flags: " << flags;
+            }
+        }
+    }
+}
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,94 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sys/stat.h>
+
+#include <cerrno>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "common/IoUring.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+// cases return early if io_uring is not available on the host
+class IoUringUnittest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mRootDir = filesystem::temp_directory_path() / "io_uring_unittest";
+        filesystem::remove_all(mRootDir);
+        filesystem::create_directories(mRootDir);
+        for (size_t i = 0; i < 20; ++i) {
+            mPaths.push_back((mRootDir / (to_string(i) + ".log")).string());
+            if (i % 3 != 0) {
+                ofstream(mPaths.back()) << string(i, 'a');
+            }
+        }
+    }
+
+    void TearDown() override { filesystem::remove_all(mRootDir); }
+
+    filesystem::path mRootDir;
+    vector<string> mPaths;
+};
+
+TEST_F(IoUringUnittest, TestStatx) {
+    IoUring ring;
+    if (!ring.Init(8)) {
+        return;
+    }
+    // more paths than ring entries
+    vector<FileStatResult> results;
+    uint64_t syscallCount = ring.GetSyscallCount();
+    EXPECT_TRUE(ring.Statx(mPaths, results));
+    EXPECT_LE(3U, ring.GetSyscallCount() - syscallCount);
+    ASSERT_EQ(mPaths.size(), results.size());
+    for (size_t i = 0; i < mPaths.size(); ++i) {
+        struct stat buf;
+        if (stat(mPaths[i].c_str(), &buf) != 0) {
+            EXPECT_EQ(ENOENT, results[i].mErrno);
+            continue;
+        }
+        EXPECT_EQ(0, results[i].mErrno);
+        EXPECT_EQ((uint64_t)buf.st_dev, results[i].mDev);
+        EXPECT_EQ((uint64_t)buf.st_ino, results[i].mInode);
+        EXPECT_EQ((uint64_t)buf.st_size, results[i].mSize);
+        EXPECT_EQ(buf.st_mtim.tv_sec, results[i].mModifySec);
+        EXPECT_EQ(buf.st_mtim.tv_nsec, results[i].mModifyNsec);
+    }
+
+    EXPECT_TRUE(ring.Statx({}, results));
+    EXPECT_TRUE(results.empty());
+}
+
+TEST_F(IoUringUnittest, TestNotInit) {
+    IoUring ring;
+    vector<FileStatResult> results;
+    EXPECT_FALSE(ring.IsInit());
+    EXPECT_FALSE(ring.Statx(mPaths, results));
+    if (ring.Init(8)) {
+        ring.Destroy();
+        EXPECT_FALSE(ring.IsInit());
+        EXPECT_FALSE(ring.Statx(mPaths, results));
+    }
+}
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,162 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <boost/regex.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/RegexPrefilter.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class RegexPrefilterUnittest : public ::testing::Test {
+protected:
+    static bool MayMatch(const RegexPrefilter& filter, const string& str) {
+        return filter.MayMatch(str.data(), str.size());
+    }
+};
+
+TEST_F(RegexPrefilterUnittest, TestPrefix) {
+    EXPECT_EQ("Exception", RegexPrefilter("Exception.*").GetPrefix());
+    EXPECT_EQ("[", RegexPrefilter(R"(\[\d+-\d+)").GetPrefix());
+    EXPECT_EQ("...", RegexPrefilter(R"(\.\.\.\d+ more)").GetPrefix());
+    EXPECT_EQ("ab", RegexPrefilter("^abc?").GetPrefix());
+    EXPECT_EQ("ab", RegexPrefilter("ab+c").GetPrefix());
+    EXPECT_EQ("", RegexPrefilter("a{2}b").GetPrefix());
+    // alternatives at the top level
+    EXPECT_EQ("", RegexPrefilter("abc|abd").GetPrefix());
+    EXPECT_EQ("", RegexPrefilter(R"(\d{4}-\d{2}-\d{2}.*)").GetPrefix());
+}
+
+TEST_F(RegexPrefilterUnittest, TestFirstBytes) {
+    RegexPrefilter date(R"(\d{4}-\d{2}-\d{2}.*)");
+    EXPECT_TRUE(date.IsValid());
+    EXPECT_TRUE(MayMatch(date, "2024-01-02 12:00:00"));
+    EXPECT_FALSE(MayMatch(date, "    at com.example.myproject.Book.getTitle(Book.java:16)"));
+    EXPECT_FALSE(MayMatch(date, ""));
+
+    RegexPrefilter level(R"((?:INFO|WARN|ERROR)\s)");
+    EXPECT_TRUE(MayMatch(level, "INFO x"));
+    EXPECT_TRUE(MayMatch(level, "WARN x"));
+    EXPECT_FALSE(MayMatch(level, "DEBUG x"));
+
+    RegexPrefilter bracket(R"([^\s\]])");
+    EXPECT_TRUE(MayMatch(bracket, "a"));
+    EXPECT_FALSE(MayMatch(bracket, " a"));
+    EXPECT_FALSE(MayMatch(bracket, "]a"));
+    // non-ascii bytes may be matched by locale dependent classes, so they are kept after negation
+    RegexPrefilter notSpace(R"([^\s].*)");
+    EXPECT_TRUE(MayMatch(notSpace, "\xe4\xb8\xad\xe6\x96\x87"));
+    EXPECT_FALSE(MayMatch(notSpace, " a"));
+
+    // assertions, not literals
+    RegexPrefilter wordBegin(R"(ab\<c)");
+    EXPECT_EQ("ab", wordBegin.GetPrefix());
+    EXPECT_TRUE(MayMatch(wordBegin, "abc"));
+    RegexPrefilter vertical(R"(\v)");
+    EXPECT_TRUE(MayMatch(vertical, "\r\n"));
+    EXPECT_TRUE(MayMatch(vertical, "\n"));
+    EXPECT_FALSE(MayMatch(vertical, " "));
+
+    RegexPrefilter prefix("Exception");
+    EXPECT_TRUE(MayMatch(prefix, "Exception in thread"));
+    EXPECT_FALSE(MayMatch(prefix, "Exceptio"));
+    EXPECT_FALSE(MayMatch(prefix, "Error"));
+}
+
+TEST_F(RegexPrefilterUnittest, TestNotSupported) {
+    for (const auto& pattern : vector<string>{"",
+                                              ".*",
+                                              R"(\s*at)",
+                                              "a?b",
+                                              "a{0,2}b",
+                                              "(?i)abc",
+                                              "(?=a)abc",
+                                              "a|b*",
+                                              "[[:digit:]]+",
+                                              R"(\x41)",
+                                              R"(\<abc)",
+                                              R"(\>abc)",
+                                              R"((?:\<)x)",
+                                              R"(\`abc)",
+                                              R"(\'abc)"}) {
+        RegexPrefilter filter(pattern);
+        EXPECT_FALSE(filter.IsValid()) << pattern;
+        EXPECT_TRUE(MayMatch(filter, "")) << pattern;
+        EXPECT_TRUE(MayMatch(filter, "anything")) << pattern;
+    }
+}
+
+TEST_F(RegexPrefilterUnittest, TestNeverRejectsMatch) {
+    vector<string> patterns = {R"(\d{4}-\d{2}-\d{2}.*)",
+                               "Exception.*",
+                               R"(\[\d+)",
+                               R"((INFO|WARN|ERROR)\s)",
+                               R"([^\s])",
+                               R"([a-c\d]x)",
+                               R"(\w+:)",
+                               R"((?:a|[0-3])+b)",
+                               "a{2}b",
+                               "^ab",
+                               R"(\s+at\s.*)",
+                               R"(\s*\.\.\.\d+ more)",
+                               "[]a]b",
+                               "[^]a]b",
+                               "ab|cd",
+                               R"(\t\d)",
+                               "[a-]z",
+                               "x{1,}y",
+                               R"(\\d)",
+                               R"(ab\<c)",
+                               R"(ab\>c)",
+                               R"(\v+x)",
+                               R"([\v]x)",
+                               R"(\V)",
+                               R"(\h+x)",
+                               R"([^\h]x)",
+                               R"(\H)",
+                               R"([^\s]+)",
+                               R"([^\s].*)",
+                               R"([^\w])",
+                               R"([^\v]x)",
+                               R"([^\S])",
+                               R"([^\W\d])",
+                               R"([^\d])"};
+    // non-ascii bytes from utf-8 text, e.g. Chinese characters
+    string alphabet = "abcdxyz0123456789-:[] \t\r\n\f\v.\\<>INFOWARNERROR\xe4\xb8\xad\xc3\xa9";
+    mt19937 rng(0);
+    for (const auto& pattern : patterns) {
+        boost::regex reg(pattern);
+        RegexPrefilter filter(pattern);
+        for (int i = 0; i < 5000; ++i) {
+            string str = i % 3 == 0 ? "2024-01-02 " : (i % 3 == 1 ? "Exception " : "");
+            for (size_t j = rng() % 12; j > 0; --j) {
+                str += alphabet[rng() % alphabet.size()];
+            }
+            const char* begin = str.c_str();
+            boost::match_results<const char*> what;
+            if (boost::regex_search(begin, begin + str.size(), what, reg, boost::match_continuous)) {
+                EXPECT_TRUE(MayMatch(filter, str)) << pattern << " " << str;
+            }
+        }
+    }
+}
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,76 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+
+#include "ebpf/handler/ObserveHandler.h"
+#include "ebpf/handler/TagSet.h"
+#include "models/PipelineEventGroup.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+namespace ebpf {
+
+#ifdef __ENTERPRISE__
+void GenerateRequestsStatusMetrics(PipelineEventGroup& group,
+                                   const std::unique_ptr<Measure>& measure,
+                                   const SharedTagSet& tags,
+                                   uint64_t ts,
+                                   EventPool* pool);
+#endif
+
+class ObserveHandlerUnittest : public testing::Test {
+public:
+    void TestRequestsStatusMetrics();
+};
+
+void ObserveHandlerUnittest::TestRequestsStatusMetrics() {
+#ifdef __ENTERPRISE__
+    auto measure = make_unique<Measure>();
+    measure->type_ = MeasureType::MEASURE_TYPE_APP;
+    measure->tags_["rpc"] = "/api";
+    auto inner = make_unique<AppSingleMeasure>();
+    inner->status_2xx_count_ = 0;
+    inner->status_3xx_count_ = 1;
+    inner->status_4xx_count_ = 2;
+    inner->status_5xx_count_ = 3;
+    measure->inner_measure_ = std::move(inner);
+
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    SharedTagSet tags;
+    tags.Reset(*group.GetSourceBuffer(), measure->tags_);
+    GenerateRequestsStatusMetrics(group, measure, tags, 1000, nullptr);
+
+    // a zero count is skipped without dropping the classes after it
+    const string expected[] = {"3xx", "4xx", "5xx"};
+    APSARA_TEST_EQUAL_FATAL(3U, group.GetEvents().size());
+    for (size_t i = 0; i < 3; ++i) {
+        const auto& event = group.GetEvents()[i].Cast<MetricEvent>();
+        APSARA_TEST_EQUAL(expected[i], event.GetTag("status_code").to_string());
+        APSARA_TEST_EQUAL("/api", event.GetTag("rpc").to_string());
+        APSARA_TEST_EQUAL(1000, event.GetTimestamp());
+        APSARA_TEST_EQUAL(static_cast<double>(i + 1), event.GetValue<UntypedSingleValue>()->mValue);
+    }
+#endif
+}
+
+UNIT_TEST_CASE(ObserveHandlerUnittest, TestRequestsStatusMetrics)
+
+} // namespace ebpf
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,171 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+
+#include "ebpf/handler/SpillRing.h"
+#include "models/PipelineEventGroup.h"
+#include "pipeline/limiter/MemoryBudget.h"
+#include "pipeline/queue/ProcessQueueItem.h"
+#include "pipeline/queue/ProcessQueueManager.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+namespace ebpf {
+
+class SpillRingUnittest : public testing::Test {
+public:
+    void TestPushAndDrain();
+    void TestQueueNotFound();
+    void TestMemoryBudget();
+    void TestSample();
+    void TestNoSampleAfterRecovery();
+
+protected:
+    void SetUp() override {
+        PipelineContext ctx;
+        ctx.SetConfigName("test_config");
+        ProcessQueueManager::GetInstance()->CreateOrUpdateBoundedQueue(mKey, 0, ctx);
+        ProcessQueueManager::GetInstance()->EnablePop("test_config");
+    }
+
+    void TearDown() override { ProcessQueueManager::GetInstance()->DeleteQueue(mKey); }
+
+private:
+    static unique_ptr<ProcessQueueItem> GenerateItem() {
+        PipelineEventGroup g(make_shared<SourceBuffer>());
+        g.AddLogEvent()->SetContent(string("key"), string("value"));
+        return make_unique<ProcessQueueItem>(std::move(g), 0);
+    }
+
+    // fill the process queue and the ring, and discard one more group so that sampling starts
+    void Overflow(SpillRing& ring) {
+        size_t pushed = 0;
+        while (ring.Size() < 2 && pushed < 100) {
+            APSARA_TEST_TRUE(ring.Push(mKey, GenerateItem()));
+            ++pushed;
+        }
+        APSARA_TEST_FALSE(ring.Push(mKey, GenerateItem()));
+        APSARA_TEST_EQUAL(2U, ring.GetSampleInterval());
+    }
+
+    static void ClearQueue() {
+        unique_ptr<ProcessQueueItem> item;
+        string configName;
+        while (ProcessQueueManager::GetInstance()->PopItem(0, item, configName)) {
+        }
+    }
+
+    QueueKey mKey = 0;
+};
+
+void SpillRingUnittest::TestPushAndDrain() {
+    SpillRing ring("test", 2);
+    // fill the process queue until the ring starts to buffer
+    size_t queued = 0;
+    while (ring.Size() == 0 && queued < 100) {
+        APSARA_TEST_TRUE(ring.Push(mKey, GenerateItem()));
+        ++queued;
+    }
+    APSARA_TEST_EQUAL(1U, ring.Size());
+    APSARA_TEST_TRUE(ring.Push(mKey, GenerateItem()));
+    APSARA_TEST_EQUAL(2U, ring.Size());
+    APSARA_TEST_EQUAL(2U, ring.mSpilledGroupsTotal->GetValue());
+
+    // ring is full
+    APSARA_TEST_FALSE(ring.Push(mKey, GenerateItem()));
+    APSARA_TEST_EQUAL(1U, ring.mDiscardedGroupsTotal->GetValue());
+    APSARA_TEST_EQUAL(2U, ring.GetSampleInterval());
+
+    // queue is still full
+    ring.Drain();
+    APSARA_TEST_EQUAL(2U, ring.Size());
+    APSARA_TEST_EQUAL(2U, ring.GetSampleInterval());
+
+    ClearQueue();
+    ring.Drain();
+    APSARA_TEST_EQUAL(0U, ring.Size());
+    APSARA_TEST_EQUAL(2U, ring.mReplayedGroupsTotal->GetValue());
+    APSARA_TEST_EQUAL(1U, ring.GetSampleInterval());
+}
+
+void SpillRingUnittest::TestQueueNotFound() {
+    SpillRing ring("test", 2);
+    APSARA_TEST_FALSE(ring.Push(mKey + 1, GenerateItem()));
+    APSARA_TEST_FALSE(ring.Push(-1, GenerateItem()));
+    APSARA_TEST_EQUAL(0U, ring.Size());
+    APSARA_TEST_EQUAL(2U, ring.mDiscardedGroupsTotal->GetValue());
+}
+
+void SpillRingUnittest::TestMemoryBudget() {
+    SpillRing ring("test", 2);
+    // data rejected by the memory budget is buffered instead of discarded
+    size_t limit = MemoryBudget::GetInstance()->GetLimit();
+    MemoryBudget::GetInstance()->Add(MemoryBudget::Component::BATCHER, limit);
+    APSARA_TEST_TRUE(ring.Push(mKey, GenerateItem()));
+    APSARA_TEST_EQUAL(1U, ring.Size());
+    ring.Drain();
+    APSARA_TEST_EQUAL(1U, ring.Size());
+    APSARA_TEST_EQUAL(0U, ring.mDiscardedGroupsTotal->GetValue());
+
+    MemoryBudget::GetInstance()->Sub(MemoryBudget::Component::BATCHER, limit);
+    ring.Drain();
+    APSARA_TEST_EQUAL(0U, ring.Size());
+    APSARA_TEST_EQUAL(1U, ring.mReplayedGroupsTotal->GetValue());
+}
+
+void SpillRingUnittest::TestSample() {
+    SpillRing ring("test", 2);
+    for (size_t i = 0; i < 4; ++i) {
+        APSARA_TEST_TRUE(ring.Sample());
+    }
+    Overflow(ring);
+    ring.mSampleInterval = 4;
+    size_t sampled = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        sampled += ring.Sample() ? 1 : 0;
+    }
+    APSARA_TEST_EQUAL(2U, sampled);
+    APSARA_TEST_EQUAL(6U, ring.mSampledOutGroupsTotal->GetValue());
+}
+
+void SpillRingUnittest::TestNoSampleAfterRecovery() {
+    SpillRing ring("test", 2);
+    Overflow(ring);
+
+    // no batch is skipped once the queue accepts groups again, even before the next drain round
+    ClearQueue();
+    for (size_t i = 0; i < 8; ++i) {
+        APSARA_TEST_TRUE(ring.Sample());
+        APSARA_TEST_TRUE(ring.Push(mKey, GenerateItem()));
+        ClearQueue();
+    }
+    APSARA_TEST_EQUAL(0U, ring.mSampledOutGroupsTotal->GetValue());
+    APSARA_TEST_EQUAL(1U, ring.mDiscardedGroupsTotal->GetValue());
+    APSARA_TEST_EQUAL(0U, ring.Size());
+    APSARA_TEST_EQUAL(1U, ring.GetSampleInterval());
+}
+
+UNIT_TEST_CASE(SpillRingUnittest, TestPushAndDrain)
+UNIT_TEST_CASE(SpillRingUnittest, TestQueueNotFound)
+UNIT_TEST_CASE(SpillRingUnittest, TestMemoryBudget)
+UNIT_TEST_CASE(SpillRingUnittest, TestSample)
+UNIT_TEST_CASE(SpillRingUnittest, TestNoSampleAfterRecovery)
+
+} // namespace ebpf
+} // namespace logtail
+
+UNIT_TEST_MAIN
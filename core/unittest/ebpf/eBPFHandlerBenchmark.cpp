@@ -0,0 +1,204 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "common/TimeUtil.h"
+#include "ebpf/handler/ObserveHandler.h"
+#include "ebpf/handler/SecurityHandler.h"
+#include "models/EventPool.h"
+
+#ifdef ENABLE_COMPATIBLE_MODE
+extern "C" {
+#include <string.h>
+asm(".symver memcpy, memcpy@GLIBC_2.2.5");
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+    return memcpy(dest, src, n);
+}
+}
+#endif
+
+static std::atomic<size_t> gAllocCnt{0};
+
+void* operator new(size_t size) {
+    ++gAllocCnt;
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+using namespace std;
+
+namespace logtail {
+namespace ebpf {
+
+static const size_t kRoundCnt = 100;
+static const size_t kBatchCnt = 10;
+static const size_t kItemCnt = 100;
+
+// replays measures, spans and security events shaped like those reported by the network observer and security probes
+class eBPFHandlerBenchmark {
+public:
+    void TestMeterHandler(bool withPool);
+    void TestSpanHandler(bool withPool);
+    void TestSecurityHandler(bool withPool);
+
+private:
+    static map<string, string> GenerateTags(size_t i) {
+        return {{"workloadKind", "deployment"},
+                {"workloadName", "benchmark-workload-" + to_string(i % 5)},
+                {"namespace", "default"},
+                {"serviceName", "benchmark-service"},
+                {"rpc", "/api/v1/resource/" + to_string(i % 20)},
+                {"callType", "http"},
+                {"callKind", "http_server"},
+                {"peerWorkloadName", "peer-workload-" + to_string(i % 7)},
+                {"peerWorkloadKind", "deployment"},
+                {"peerNamespace", "default"},
+                {"source_ip", "10.0.0." + to_string(i % 255)},
+                {"dest_ip", "10.0.1." + to_string(i % 255)}};
+    }
+
+    static void Report(const char* func, bool withPool, size_t eventCnt, uint64_t timeElapsed, size_t allocCnt) {
+        printf("%s %s: %zu items handled, costs %lums, %.2f allocations per item\n",
+               func,
+               withPool ? "with pool" : "without pool",
+               eventCnt,
+               timeElapsed,
+               static_cast<double>(allocCnt) / eventCnt);
+    }
+};
+
+void eBPFHandlerBenchmark::TestMeterHandler(bool withPool) {
+    EventPool pool;
+    OtelMeterHandler handler(nullptr, 0, 0);
+    if (withPool) {
+        handler.SetEventPool(&pool);
+    }
+    vector<unique_ptr<ApplicationBatchMeasure>> measures;
+    for (size_t i = 0; i < kBatchCnt; ++i) {
+        auto batch = make_unique<ApplicationBatchMeasure>();
+        batch->app_id_ = "app_" + to_string(i);
+        for (size_t j = 0; j < kItemCnt; ++j) {
+            auto measure = make_unique<Measure>();
+            measure->tags_ = GenerateTags(j);
+            measure->type_ = MeasureType::MEASURE_TYPE_APP;
+            auto inner = make_unique<AppSingleMeasure>();
+            inner->request_total_ = j + 1;
+            measure->inner_measure_ = std::move(inner);
+            batch->measures_.emplace_back(std::move(measure));
+        }
+        measures.emplace_back(std::move(batch));
+    }
+
+    size_t allocStart = gAllocCnt;
+    uint64_t startTime = GetCurrentTimeInMilliSeconds();
+    for (size_t i = 0; i < kRoundCnt; ++i) {
+        handler.handle(measures, 1234567890);
+    }
+    Report(__func__,
+           withPool,
+           kRoundCnt * kBatchCnt * kItemCnt,
+           GetCurrentTimeInMilliSeconds() - startTime,
+           gAllocCnt - allocStart);
+}
+
+void eBPFHandlerBenchmark::TestSpanHandler(bool withPool) {
+    EventPool pool;
+    OtelSpanHandler handler(nullptr, 0, 0);
+    if (withPool) {
+        handler.SetEventPool(&pool);
+    }
+    vector<unique_ptr<ApplicationBatchSpan>> spans;
+    for (size_t i = 0; i < kBatchCnt; ++i) {
+        auto batch = make_unique<ApplicationBatchSpan>();
+        batch->app_id_ = "app_" + to_string(i);
+        for (size_t j = 0; j < kItemCnt; ++j) {
+            auto span = make_unique<SingleSpan>();
+            span->tags_ = GenerateTags(j);
+            span->trace_id_ = "4bf92f3577b34da6a3ce929d0e0e4736";
+            span->span_id_ = "00f067aa0ba902b7";
+            span->span_name_ = "/api/v1/resource/" + to_string(j % 20);
+            span->span_kind_ = SpanKindInner::Server;
+            span->start_timestamp_ = 1715826723000000000;
+            span->end_timestamp_ = 1715826725000000000;
+            batch->single_spans_.emplace_back(std::move(span));
+        }
+        spans.emplace_back(std::move(batch));
+    }
+
+    size_t allocStart = gAllocCnt;
+    uint64_t startTime = GetCurrentTimeInMilliSeconds();
+    for (size_t i = 0; i < kRoundCnt; ++i) {
+        handler.handle(spans);
+    }
+    Report(__func__,
+           withPool,
+           kRoundCnt * kBatchCnt * kItemCnt,
+           GetCurrentTimeInMilliSeconds() - startTime,
+           gAllocCnt - allocStart);
+}
+
+void eBPFHandlerBenchmark::TestSecurityHandler(bool withPool) {
+    EventPool pool;
+    SecurityHandler handler(nullptr, 0, 0);
+    if (withPool) {
+        handler.SetEventPool(&pool);
+    }
+    vector<unique_ptr<AbstractSecurityEvent>> events;
+    for (size_t j = 0; j < kBatchCnt * kItemCnt; ++j) {
+        auto tags = GenerateTags(j);
+        events.emplace_back(make_unique<AbstractSecurityEvent>(
+            vector<pair<string, string>>(tags.begin(), tags.end()), SecureEventType::SECURE_EVENT_TYPE_SOCKET_SECURE, j));
+    }
+
+    size_t allocStart = gAllocCnt;
+    uint64_t startTime = GetCurrentTimeInMilliSeconds();
+    for (size_t i = 0; i < kRoundCnt; ++i) {
+        handler.handle(events);
+    }
+    Report(__func__,
+           withPool,
+           kRoundCnt * kBatchCnt * kItemCnt,
+           GetCurrentTimeInMilliSeconds() - startTime,
+           gAllocCnt - allocStart);
+}
+
+} // namespace ebpf
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    logtail::ebpf::eBPFHandlerBenchmark benchmark;
+    for (bool withPool : {false, true}) {
+        benchmark.TestMeterHandler(withPool);
+        benchmark.TestSpanHandler(withPool);
+        benchmark.TestSecurityHandler(withPool);
+    }
+    return 0;
+}
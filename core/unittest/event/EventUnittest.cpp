@@ -35,9 +35,26 @@ public:
         Event event1("/source", "object", EVENT_CONTAINER_STOPPED, 0);
         APSARA_TEST_TRUE_FATAL(event1.IsContainerStopped());
     }
+
+    void TestEventBlockReused() {
+        LOG_INFO(sLogger, ("TestEventBlockReused() begin", time(NULL)));
+        Event* event0 = new Event("/source", "object", EVENT_MODIFY, 0);
+        size_t pooledCnt = Event::GetPooledBlockCount();
+        void* block = event0;
+        delete event0;
+        APSARA_TEST_EQUAL(pooledCnt + 1, Event::GetPooledBlockCount());
+
+        Event* event1 = new Event("/source", "object", EVENT_CREATE, 1);
+        APSARA_TEST_EQUAL(pooledCnt, Event::GetPooledBlockCount());
+        APSARA_TEST_EQUAL(block, (void*)event1);
+        APSARA_TEST_TRUE(event1->IsCreate());
+        APSARA_TEST_EQUAL(1, event1->GetWd());
+        delete event1;
+    }
 };
 
 APSARA_UNIT_TEST_CASE(EventUnittest, TestIsContainerStopped, 0);
+APSARA_UNIT_TEST_CASE(EventUnittest, TestEventBlockReused, 0);
 } // end of namespace logtail
 
 int main(int argc, char** argv) {
@@ -0,0 +1,279 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <sys/mount.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "common/Flags.h"
+#include "common/TimeUtil.h"
+#include "file_server/ConfigManager.h"
+#include "file_server/EventDispatcher.h"
+#include "file_server/FileDiscoveryOptions.h"
+#include "file_server/event/Event.h"
+#include "file_server/event_listener/EventListener.h"
+#include "pipeline/PipelineContext.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_BOOL(fs_events_fanotify_enable);
+DECLARE_FLAG_INT32(inotify_modify_event_coalesce_window);
+
+using namespace std;
+
+namespace logtail {
+
+// watches the same dir tree on tmpfs with inotify and fanotify, and compares kernel watches taken and the latency
+// from a write to the modify event. The cases are skipped if tmpfs can not be mounted or fanotify is not available.
+class FanotifyEventListenerUnittest : public ::testing::Test {
+public:
+    static void SetUpTestCase() {
+        sRoot = (filesystem::temp_directory_path() / ("fanotify_unittest_" + to_string(getpid()))).string();
+        filesystem::create_directories(sRoot);
+        sMounted = mount("tmpfs", sRoot.c_str(), "tmpfs", 0, "size=16m") == 0;
+        for (size_t i = 0; i < kDirCnt; ++i) {
+            // nested, so that registering the root doesn't register the others
+            sDirs.push_back(sRoot + "/d" + to_string(i / 8) + "/" + to_string(i % 8));
+            filesystem::create_directories(sDirs.back());
+        }
+    }
+
+    static void TearDownTestCase() {
+        if (sMounted) {
+            umount(sRoot.c_str());
+        }
+        error_code ec;
+        filesystem::remove_all(sRoot, ec);
+    }
+
+    void SetUp() override {
+        mCtx.SetConfigName("fanotify_unittest");
+        mOptions.mMaxDirSearchDepth = -1;
+        INT32_FLAG(inotify_modify_event_coalesce_window) = 0;
+    }
+
+    void TearDown() override {
+        BOOL_FLAG(fs_events_fanotify_enable) = false;
+        EventListener::GetInstance()->Destroy();
+        EventListener::GetInstance()->Init();
+    }
+
+    void TestWatchCount();
+    void TestEventsAndLatency();
+
+private:
+    static constexpr size_t kDirCnt = 64;
+
+    // restarts the listener and registers all dirs, returns false if fanotify is wanted but not available
+    bool Watch(bool fanotify) {
+        EventListener* listener = EventListener::GetInstance();
+        listener->Destroy();
+        BOOL_FLAG(fs_events_fanotify_enable) = fanotify;
+        listener->Init();
+        if (fanotify && !listener->IsFanotifyEnabled()) {
+            return false;
+        }
+        EventHandler* handler = ConfigManager::GetInstance()->GetSharedHandler();
+        for (const auto& dir : sDirs) {
+            APSARA_TEST_TRUE(
+                EventDispatcher::GetInstance()->RegisterEventHandler(dir, make_pair(&mOptions, &mCtx), handler));
+        }
+        return true;
+    }
+
+    void Unwatch() {
+        for (const auto& dir : sDirs) {
+            EventDispatcher::GetInstance()->UnregisterAllDir(dir);
+        }
+        vector<Event*> events;
+        EventListener::GetInstance()->ReadEvents(events);
+        Release(events);
+    }
+
+    // kernel objects behind the fd, read from /proc
+    static size_t CountKernelMarks(int fd, const string& prefix) {
+        ifstream fin("/proc/self/fdinfo/" + to_string(fd));
+        size_t cnt = 0;
+        string line;
+        while (getline(fin, line)) {
+            if (line.compare(0, prefix.size(), prefix) == 0 && line.find("flags:") != prefix.size()) {
+                ++cnt;
+            }
+        }
+        return cnt;
+    }
+
+    // returns microseconds from the write to the modify event of the file, or -1 if not seen
+    int64_t WriteAndWait(const string& dir, const string& name) {
+        vector<Event*> events;
+        EventListener::GetInstance()->ReadEvents(events);
+        Release(events);
+        int fd = open((dir + "/" + name).c_str(), O_CREAT | O_WRONLY | O_APPEND, 0644);
+        if (fd < 0) {
+            return -1;
+        }
+        // drop the create event
+        EventListener::GetInstance()->ReadEvents(events);
+        Release(events);
+        int64_t start = GetCurrentTimeInMicroSeconds();
+        APSARA_TEST_EQUAL(4, write(fd, "abc\n", 4));
+        close(fd);
+        int64_t latency = -1;
+        while (latency < 0 && GetCurrentTimeInMicroSeconds() - start < 1000000) {
+            EventListener::GetInstance()->ReadEvents(events);
+            for (auto ev : events) {
+                if (ev->IsModify() && ev->GetSource() == dir && ev->GetObject() == name) {
+                    latency = GetCurrentTimeInMicroSeconds() - start;
+                }
+            }
+            Release(events);
+        }
+        return latency;
+    }
+
+    static vector<string> Describe(const vector<Event*>& events, const string& dir) {
+        vector<string> res;
+        for (auto ev : events) {
+            if (ev->GetSource() != dir) {
+                continue;
+            }
+            if (ev->IsCreate()) {
+                res.push_back("create " + ev->GetObject());
+            } else if (ev->IsModify()) {
+                res.push_back("modify " + ev->GetObject());
+            } else if (ev->IsMoveFrom()) {
+                res.push_back("move_from " + ev->GetObject());
+            } else if (ev->IsMoveTo()) {
+                res.push_back("move_to " + ev->GetObject());
+            } else if (ev->IsDeleted()) {
+                res.push_back("delete " + ev->GetObject());
+            } else if (ev->IsTimeout()) {
+                res.push_back("timeout " + ev->GetObject());
+            }
+        }
+        return res;
+    }
+
+    static void Release(vector<Event*>& events) {
+        for (auto ev : events) {
+            delete ev;
+        }
+        events.clear();
+    }
+
+    static string sRoot;
+    static bool sMounted;
+    static vector<string> sDirs;
+
+    FileDiscoveryOptions mOptions;
+    PipelineContext mCtx;
+};
+
+string FanotifyEventListenerUnittest::sRoot;
+bool FanotifyEventListenerUnittest::sMounted = false;
+vector<string> FanotifyEventListenerUnittest::sDirs;
+
+void FanotifyEventListenerUnittest::TestWatchCount() {
+    if (!sMounted) {
+        return;
+    }
+    EventListener* listener = EventListener::GetInstance();
+    APSARA_TEST_TRUE_FATAL(Watch(false));
+    size_t inotifyWatches = CountKernelMarks(listener->mInotifyFd, "inotify ");
+    Unwatch();
+    if (!Watch(true)) {
+        LOG_WARNING(sLogger, ("fanotify is not available", "skip"));
+        Unwatch();
+        return;
+    }
+    size_t fanotifyMarks = CountKernelMarks(listener->mFanotifyFd, "fanotify ");
+    printf("%zu dirs: %zu inotify watches, %zu fanotify marks\n", kDirCnt, inotifyWatches, fanotifyMarks);
+    APSARA_TEST_EQUAL(kDirCnt, inotifyWatches);
+    APSARA_TEST_EQUAL(1U, fanotifyMarks);
+    APSARA_TEST_EQUAL(0U, CountKernelMarks(listener->mInotifyFd, "inotify "));
+    Unwatch();
+    APSARA_TEST_TRUE(listener->mFanotifyWdHandleMap.empty());
+}
+
+void FanotifyEventListenerUnittest::TestEventsAndLatency() {
+    if (!sMounted) {
+        return;
+    }
+    const string& dir = sDirs[kDirCnt / 2];
+    APSARA_TEST_TRUE_FATAL(Watch(false));
+    int64_t inotifyLatency = WriteAndWait(dir, "inotify.log");
+    Unwatch();
+    if (!Watch(true)) {
+        LOG_WARNING(sLogger, ("fanotify is not available", "skip"));
+        Unwatch();
+        return;
+    }
+    int64_t fanotifyLatency = WriteAndWait(dir, "fanotify.log");
+    printf("modify event latency: inotify %ldus, fanotify %ldus\n", inotifyLatency, fanotifyLatency);
+    APSARA_TEST_TRUE(inotifyLatency >= 0);
+    APSARA_TEST_TRUE(fanotifyLatency >= 0);
+    APSARA_TEST_TRUE(fanotifyLatency < 100000);
+
+    // events merged by kernel are split, and a deleted dir is reported as timeout of the dir
+    vector<Event*> events;
+    string subDir = sDirs[0];
+    string file = subDir + "/moved.log";
+    ofstream(subDir + "/a.log") << "abc\n";
+    filesystem::rename(subDir + "/a.log", file);
+    filesystem::remove(file);
+    filesystem::remove(subDir);
+    usleep(10000);
+    EventListener::GetInstance()->ReadEvents(events);
+    vector<string> seen = Describe(events, subDir);
+    Release(events);
+    vector<string> expected{"create a.log",
+                            "modify a.log",
+                            "move_from a.log",
+                            "move_to moved.log",
+                            "delete moved.log",
+                            "timeout "};
+    APSARA_TEST_EQUAL(expected, seen);
+    filesystem::create_directories(subDir);
+
+    // a file rotated by renaming and then created again, the create of the new file must follow the move_from of the
+    // old one, though the kernel may merge them into one event
+    string rotateDir = sDirs[1];
+    ofstream(rotateDir + "/app.log") << "abc\n";
+    filesystem::rename(rotateDir + "/app.log", rotateDir + "/app.log.1");
+    ofstream(rotateDir + "/app.log") << "def\n";
+    usleep(10000);
+    EventListener::GetInstance()->ReadEvents(events);
+    seen = Describe(events, rotateDir);
+    Release(events);
+    auto lastMoveFrom = find(seen.rbegin(), seen.rend(), "move_from app.log");
+    auto lastCreate = find(seen.rbegin(), seen.rend(), "create app.log");
+    APSARA_TEST_TRUE(lastMoveFrom != seen.rend());
+    APSARA_TEST_TRUE(lastCreate != seen.rend());
+    APSARA_TEST_TRUE(lastCreate < lastMoveFrom);
+    APSARA_TEST_TRUE(find(seen.begin(), seen.end(), "move_to app.log.1") != seen.end());
+    Unwatch();
+}
+
+UNIT_TEST_CASE(FanotifyEventListenerUnittest, TestWatchCount)
+UNIT_TEST_CASE(FanotifyEventListenerUnittest, TestEventsAndLatency)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,162 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "common/Flags.h"
+#include "common/TimeUtil.h"
+#include "file_server/ConfigManager.h"
+#include "file_server/EventDispatcher.h"
+#include "file_server/FileDiscoveryOptions.h"
+#include "file_server/event/Event.h"
+#include "file_server/event_listener/EventListener.h"
+#include "monitor/metric_models/ScopedCpuTimer.h"
+#include "pipeline/PipelineContext.h"
+
+#ifdef ENABLE_COMPATIBLE_MODE
+extern "C" {
+#include <string.h>
+asm(".symver memcpy, memcpy@GLIBC_2.2.5");
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+    return memcpy(dest, src, n);
+}
+}
+#endif
+
+DECLARE_FLAG_INT32(inotify_modify_event_coalesce_window);
+
+using namespace std;
+
+namespace logtail {
+
+// replays a write storm against temp files in a watched dir, and measures the cost of turning inotify records into
+// events on the LogInput thread, as well as how many events are left for LogInput to process.
+class InotifyEventBenchmark {
+public:
+    InotifyEventBenchmark(size_t fileCnt, size_t writesPerFile, size_t writesPerRead)
+        : mFileCnt(fileCnt), mWritesPerFile(writesPerFile), mWritesPerRead(writesPerRead) {
+        mDir = (filesystem::temp_directory_path() / ("inotify_event_benchmark_" + to_string(getpid()))).string();
+        filesystem::create_directories(mDir);
+        for (size_t i = 0; i < mFileCnt; ++i) {
+            string path = mDir + "/" + to_string(i) + ".log";
+            int fd = open(path.c_str(), O_CREAT | O_WRONLY | O_APPEND, 0644);
+            if (fd < 0) {
+                printf("error: failed to create %s\n", path.c_str());
+                exit(1);
+            }
+            mFds.push_back(fd);
+        }
+        mCtx.SetConfigName("inotify_event_benchmark");
+        // no depth limit, otherwise the dir is not under base path of the options
+        mOptions.mMaxDirSearchDepth = -1;
+        EventHandler* handler = ConfigManager::GetInstance()->GetSharedHandler();
+        if (!EventDispatcher::GetInstance()->RegisterEventHandler(mDir, make_pair(&mOptions, &mCtx), handler)) {
+            printf("error: failed to watch %s\n", mDir.c_str());
+            exit(1);
+        }
+        vector<Event*> events;
+        EventListener::GetInstance()->ReadEvents(events);
+        Release(events);
+    }
+
+    ~InotifyEventBenchmark() {
+        for (int fd : mFds) {
+            close(fd);
+        }
+        error_code ec;
+        filesystem::remove_all(mDir, ec);
+    }
+
+    void Run(int32_t window, const char* name) {
+        INT32_FLAG(inotify_modify_event_coalesce_window) = window;
+        EventListener* listener = EventListener::GetInstance();
+        uint64_t rawStart = listener->GetRawEventsTotal();
+        uint64_t coalescedStart = listener->GetCoalescedEventsTotal();
+        string line(127, 'a');
+        line.push_back('\n');
+        vector<Event*> events;
+        size_t eventCnt = 0;
+        uint64_t cpuTime = 0;
+        uint64_t starttime = GetCurrentTimeInMicroSeconds();
+        size_t totalWrites = mFileCnt * mWritesPerFile;
+        for (size_t i = 0; i < totalWrites; ++i) {
+            if (write(mFds[i % mFileCnt], line.data(), line.size()) < 0) {
+                printf("error: failed to write\n");
+                exit(1);
+            }
+            if ((i + 1) % mWritesPerRead == 0 || i + 1 == totalWrites) {
+                uint64_t cpuStart = CpuTimeSampler::GetThreadCpuTimeNs();
+                listener->ReadEvents(events);
+                cpuTime += CpuTimeSampler::GetThreadCpuTimeNs() - cpuStart;
+                eventCnt += events.size();
+                Release(events);
+            }
+        }
+        // pending events are dispatched once the window is passed
+        if (window > 0) {
+            usleep(window * 1000);
+            listener->ReadEvents(events);
+            eventCnt += events.size();
+            Release(events);
+        }
+        uint64_t timeelapsed = GetCurrentTimeInMicroSeconds() - starttime;
+        uint64_t raw = listener->GetRawEventsTotal() - rawStart;
+        printf("%s: %lu writes cost %lums, %lu inotify records, %lu coalesced, %lu events dispatched, "
+               "%.0fns cpu per record\n",
+               name,
+               totalWrites,
+               timeelapsed / 1000,
+               raw,
+               listener->GetCoalescedEventsTotal() - coalescedStart,
+               eventCnt,
+               cpuTime * 1.0 / max<uint64_t>(raw, 1));
+    }
+
+private:
+    static void Release(vector<Event*>& events) {
+        for (auto ev : events) {
+            delete ev;
+        }
+        events.clear();
+    }
+
+    size_t mFileCnt;
+    size_t mWritesPerFile;
+    size_t mWritesPerRead;
+    string mDir;
+    vector<int> mFds;
+    FileDiscoveryOptions mOptions;
+    PipelineContext mCtx;
+};
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    size_t fileCnt = argc > 1 ? strtoul(argv[1], nullptr, 10) : 100;
+    size_t writesPerFile = argc > 2 ? strtoul(argv[2], nullptr, 10) : 1000;
+    size_t writesPerRead = argc > 3 ? strtoul(argv[3], nullptr, 10) : 4096;
+    logtail::Logger::Instance().InitGlobalLoggers();
+    logtail::InotifyEventBenchmark benchmark(fileCnt, writesPerFile, writesPerRead);
+    benchmark.Run(-1, "no coalescing");
+    benchmark.Run(0, "coalesce per read");
+    benchmark.Run(50, "coalesce within 50ms");
+    return 0;
+}
@@ -0,0 +1,216 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fnmatch.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <json/json.h>
+
+#include "common/GlobPattern.h"
+#include "common/TimeUtil.h"
+#include "file_server/FileDiscoveryMatcherIndex.h"
+#include "file_server/FileDiscoveryOptions.h"
+#include "pipeline/PipelineContext.h"
+
+#ifdef ENABLE_COMPATIBLE_MODE
+extern "C" {
+#include <string.h>
+asm(".symver memcpy, memcpy@GLIBC_2.2.5");
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+    return memcpy(dest, src, n);
+}
+}
+#endif
+
+using namespace std;
+
+namespace logtail {
+
+// measures finding configs for paths with kubernetes layouts, i.e., /var/log/pods/<ns>_<pod>_<uid>/<container>/0.log
+// for pod logs and /var/log/containers/<pod>_<ns>_<container>-<id>.log for symlinks, where each config collects logs
+// of one workload.
+class FileDiscoveryMatcherBenchmark {
+public:
+    FileDiscoveryMatcherBenchmark(size_t configCnt, size_t podsPerConfig) {
+        for (size_t i = 0; i < configCnt; ++i) {
+            string ns = "ns-" + to_string(i % 50);
+            string workload = "workload-" + to_string(i);
+            string filePath;
+            switch (i % 4) {
+                case 0:
+                    // all pods of a workload
+                    filePath = "/var/log/pods/" + ns + "_" + workload + "-*/app/*.log";
+                    break;
+                case 1:
+                    // logs inside a pod dir, with sub dirs
+                    filePath = "/var/log/pods/" + PodDir(ns, workload, 0) + "/**/*.log";
+                    break;
+                case 2:
+                    filePath = "/var/log/containers/" + workload + "-*_" + ns + "_app-*.log";
+                    break;
+                default:
+                    filePath = "/var/log/pods/" + PodDir(ns, workload, 0) + "/sidecar/0.log";
+                    break;
+            }
+            AddConfig("config-" + to_string(i), filePath);
+            for (size_t j = 0; j < podsPerConfig; ++j) {
+                string podDir = "/var/log/pods/" + PodDir(ns, workload, j);
+                mPaths.emplace_back(podDir + "/app", "0.log");
+                mPaths.emplace_back(podDir + "/sidecar", "0.log");
+                mPaths.emplace_back(podDir + "/app/sub", "");
+                mPaths.emplace_back("/var/log/containers",
+                                    workload + "-" + to_string(j) + "_" + ns + "_app-" + to_string(i * 131 + j)
+                                        + ".log");
+            }
+        }
+    }
+
+    void Run(size_t rounds) {
+        printf("%lu configs, %lu paths, %lu rounds\n", mConfigs.size(), mPaths.size(), rounds);
+        size_t fullMatched = RunFullScan(rounds);
+        size_t indexMatched = RunIndex(rounds);
+        if (fullMatched != indexMatched) {
+            printf("error: matched %lu configs by full scan, but %lu by index\n", fullMatched, indexMatched);
+            exit(1);
+        }
+        RunFileNameMatch(rounds);
+    }
+
+private:
+    static string PodDir(const string& ns, const string& workload, size_t idx) {
+        return ns + "_" + workload + "-" + to_string(idx) + "_2f4b1c9e-8d6a-4e3b-9f10-" + to_string(100000000000 + idx);
+    }
+
+    void AddConfig(const string& name, const string& filePath) {
+        Json::Value configJson;
+        configJson["FilePaths"].append(Json::Value(filePath));
+        configJson["MaxDirSearchDepth"] = Json::Value(3);
+        mContexts.emplace_back(new PipelineContext());
+        mContexts.back()->SetConfigName(name);
+        mOptions.emplace_back(new FileDiscoveryOptions());
+        if (!mOptions.back()->Init(configJson, *mContexts.back(), "input_file")) {
+            printf("error: invalid file path %s\n", filePath.c_str());
+            exit(1);
+        }
+        mConfigs[name] = make_pair(mOptions.back().get(), mContexts.back().get());
+    }
+
+    // what ConfigManager::FindAllMatch does without the index
+    size_t RunFullScan(size_t rounds) {
+        size_t matched = 0;
+        uint64_t starttime = GetCurrentTimeInMicroSeconds();
+        for (size_t r = 0; r < rounds; ++r) {
+            for (const auto& path : mPaths) {
+                for (const auto& config : mConfigs) {
+                    if (config.second.first->IsMatch(path.first, path.second)) {
+                        ++matched;
+                    }
+                }
+            }
+        }
+        Report("full scan", GetCurrentTimeInMicroSeconds() - starttime, rounds);
+        return matched;
+    }
+
+    size_t RunIndex(size_t rounds) {
+        size_t matched = 0;
+        uint64_t starttime = GetCurrentTimeInMicroSeconds();
+        FileDiscoveryMatcherIndex index(mConfigs);
+        uint64_t buildTime = GetCurrentTimeInMicroSeconds() - starttime;
+        size_t candidateCnt = 0;
+        vector<FileDiscoveryConfig> candidates;
+        starttime = GetCurrentTimeInMicroSeconds();
+        for (size_t r = 0; r < rounds; ++r) {
+            for (const auto& path : mPaths) {
+                candidates.clear();
+                index.FindCandidates(path.first, candidates);
+                candidateCnt += candidates.size();
+                for (const auto& config : candidates) {
+                    if (config.first->IsMatch(path.first, path.second)) {
+                        ++matched;
+                    }
+                }
+            }
+        }
+        Report("index", GetCurrentTimeInMicroSeconds() - starttime, rounds);
+        printf("  index with %lu nodes built in %luus, %.1f candidates per path\n",
+               index.GetNodeCount(),
+               buildTime,
+               candidateCnt * 1.0 / rounds / mPaths.size());
+        return matched;
+    }
+
+    void RunFileNameMatch(size_t rounds) {
+        vector<string> patterns = {"*.log", "0.log", "access.log*", "*error*", "app-*.log"};
+        size_t matched = 0;
+        uint64_t starttime = GetCurrentTimeInMicroSeconds();
+        for (size_t r = 0; r < rounds; ++r) {
+            for (const auto& pattern : patterns) {
+                for (const auto& path : mPaths) {
+                    matched += fnmatch(pattern.c_str(), path.second.c_str(), 0) == 0;
+                }
+            }
+        }
+        uint64_t fnmatchTime = GetCurrentTimeInMicroSeconds() - starttime;
+        vector<GlobPattern> globs;
+        for (const auto& pattern : patterns) {
+            globs.emplace_back(pattern, 0);
+        }
+        starttime = GetCurrentTimeInMicroSeconds();
+        for (size_t r = 0; r < rounds; ++r) {
+            for (const auto& glob : globs) {
+                for (const auto& path : mPaths) {
+                    matched -= glob.Match(path.second);
+                }
+            }
+        }
+        uint64_t globTime = GetCurrentTimeInMicroSeconds() - starttime;
+        size_t cnt = rounds * patterns.size() * mPaths.size();
+        printf("file name match: fnmatch %.1fns, compiled %.1fns per match%s\n",
+               fnmatchTime * 1000.0 / cnt,
+               globTime * 1000.0 / cnt,
+               matched == 0 ? "" : ", error: results differ");
+    }
+
+    void Report(const char* name, uint64_t timeelapsed, size_t rounds) {
+        size_t cnt = rounds * mPaths.size();
+        printf("%s: %lu lookups cost %lums, %.2fus per lookup\n",
+               name,
+               cnt,
+               timeelapsed / 1000,
+               timeelapsed * 1.0 / max<size_t>(cnt, 1));
+    }
+
+    vector<unique_ptr<PipelineContext>> mContexts;
+    vector<unique_ptr<FileDiscoveryOptions>> mOptions;
+    unordered_map<string, FileDiscoveryConfig> mConfigs;
+    vector<pair<string, string>> mPaths;
+};
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    size_t configCnt = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000;
+    size_t podsPerConfig = argc > 2 ? strtoul(argv[2], nullptr, 10) : 5;
+    size_t rounds = argc > 3 ? strtoul(argv[3], nullptr, 10) : 3;
+    logtail::FileDiscoveryMatcherBenchmark benchmark(configCnt, podsPerConfig);
+    benchmark.Run(rounds);
+    return 0;
+}
@@ -0,0 +1,132 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <json/json.h>
+
+#include "file_server/FileDiscoveryMatcherIndex.h"
+#include "file_server/FileDiscoveryOptions.h"
+#include "pipeline/PipelineContext.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class FileDiscoveryMatcherIndexUnittest : public testing::Test {
+public:
+    void TestFindCandidates();
+    void TestCandidatesContainAllMatches();
+
+protected:
+    void SetUp() override {
+        AddConfig("nginx", "/var/log/nginx/**/*.log");
+        AddConfig("nginx_access", "/var/log/nginx/access.log");
+        AddConfig("wildcard", "/var/log/*/app/*.log");
+        AddConfig("root", "/**/*.log");
+        AddConfig("container", "/home/admin/logs/**/*.log");
+        auto infos = make_shared<vector<ContainerInfo>>(2);
+        (*infos)[0].mRealBaseDir = "/host/containers/c1/home/admin/logs";
+        (*infos)[1].mRealBaseDir = "/host/containers/c2/home/admin/logs";
+        mOptions["container"]->SetEnableContainerDiscoveryFlag(true);
+        mOptions["container"]->SetContainerInfo(infos);
+    }
+
+private:
+    void AddConfig(const string& name, const string& filePath) {
+        Json::Value configJson;
+        configJson["FilePaths"].append(Json::Value(filePath));
+        configJson["MaxDirSearchDepth"] = Json::Value(10);
+        auto& ctx = mContexts[name];
+        ctx.reset(new PipelineContext());
+        ctx->SetConfigName(name);
+        auto& opts = mOptions[name];
+        opts.reset(new FileDiscoveryOptions());
+        APSARA_TEST_TRUE(opts->Init(configJson, *ctx, "test"));
+        mConfigs[name] = make_pair(opts.get(), ctx.get());
+    }
+
+    set<string> FindCandidates(const FileDiscoveryMatcherIndex& index, const string& path) {
+        vector<FileDiscoveryConfig> candidates;
+        index.FindCandidates(path, candidates);
+        set<string> res;
+        for (const auto& config : candidates) {
+            APSARA_TEST_TRUE(res.insert(config.second->GetConfigName()).second);
+        }
+        return res;
+    }
+
+    unordered_map<string, unique_ptr<FileDiscoveryOptions>> mOptions;
+    unordered_map<string, unique_ptr<PipelineContext>> mContexts;
+    unordered_map<string, FileDiscoveryConfig> mConfigs;
+};
+
+void FileDiscoveryMatcherIndexUnittest::TestFindCandidates() {
+    FileDiscoveryMatcherIndex index(mConfigs);
+    APSARA_TEST_EQUAL(5U, index.GetConfigCount());
+    APSARA_TEST_TRUE((set<string>{"root"}) == FindCandidates(index, "/"));
+    APSARA_TEST_TRUE((set<string>{"root"}) == FindCandidates(index, "/var/logs"));
+    APSARA_TEST_TRUE((set<string>{"root", "wildcard"}) == FindCandidates(index, "/var/log"));
+    APSARA_TEST_TRUE((set<string>{"root", "wildcard"}) == FindCandidates(index, "/var/log/nginx2"));
+    APSARA_TEST_TRUE((set<string>{"root", "wildcard", "nginx", "nginx_access"})
+                     == FindCandidates(index, "/var/log/nginx"));
+    APSARA_TEST_TRUE((set<string>{"root", "wildcard", "nginx", "nginx_access"})
+                     == FindCandidates(index, "/var/log/nginx/sub/dir"));
+    APSARA_TEST_TRUE((set<string>{"root", "wildcard", "nginx", "nginx_access"})
+                     == FindCandidates(index, "/var//log/nginx/"));
+    APSARA_TEST_TRUE((set<string>{"root"}) == FindCandidates(index, "/home/admin/logs"));
+    APSARA_TEST_TRUE((set<string>{"root", "container"})
+                     == FindCandidates(index, "/host/containers/c1/home/admin/logs/sub"));
+    APSARA_TEST_TRUE((set<string>{"root", "container"}) == FindCandidates(index, "/host/containers/c2/home/admin/logs"));
+    APSARA_TEST_TRUE((set<string>{"root"}) == FindCandidates(index, "/host/containers/c3/home/admin/logs"));
+}
+
+void FileDiscoveryMatcherIndexUnittest::TestCandidatesContainAllMatches() {
+    FileDiscoveryMatcherIndex index(mConfigs);
+    vector<string> paths = {"/",
+                            "/var",
+                            "/var/log",
+                            "/var/log/nginx",
+                            "/var/log/nginx/a/b",
+                            "/var/log/svc/app",
+                            "/var/log/svc/app/sub",
+                            "/var/log/nginx/app",
+                            "/home/admin/logs",
+                            "/host/containers/c1/home/admin/logs",
+                            "/host/containers/c1/home/admin/logs/a",
+                            "/host/containers/c2/home/admin/logs2"};
+    for (const auto& path : paths) {
+        auto candidates = FindCandidates(index, path);
+        for (const auto& name : {"", "a.log", "access.log", "a.txt"}) {
+            for (const auto& config : mConfigs) {
+                if (config.second.first->IsMatch(path, name)) {
+                    APSARA_TEST_TRUE_DESC(candidates.find(config.first) != candidates.end(),
+                                          path + " " + name + " " + config.first);
+                }
+            }
+        }
+    }
+}
+
+UNIT_TEST_CASE(FileDiscoveryMatcherIndexUnittest, TestFindCandidates)
+UNIT_TEST_CASE(FileDiscoveryMatcherIndexUnittest, TestCandidatesContainAllMatches)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
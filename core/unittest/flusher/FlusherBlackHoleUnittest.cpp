@@ -0,0 +1,146 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <json/json.h>
+
+#include <memory>
+#include <string>
+
+#include "common/JsonUtil.h"
+#include "pipeline/Pipeline.h"
+#include "pipeline/PipelineContext.h"
+#include "pipeline/queue/QueueKeyManager.h"
+#include "pipeline/queue/SenderQueueManager.h"
+#include "plugin/flusher/blackhole/FlusherBlackHole.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class FlusherBlackHoleUnittest : public testing::Test {
+public:
+    void OnSuccessfulInit();
+    void TestSend();
+    void TestSendWithSerialization();
+
+protected:
+    void SetUp() override {
+        ctx.SetConfigName("test_config");
+        ctx.SetPipeline(pipeline);
+    }
+
+    void TearDown() override {
+        QueueKeyManager::GetInstance()->Clear();
+        SenderQueueManager::GetInstance()->Clear();
+    }
+
+private:
+    PipelineEventGroup CreateEventGroup() {
+        PipelineEventGroup group(make_shared<SourceBuffer>());
+        for (size_t i = 0; i < 10; ++i) {
+            auto e = group.AddLogEvent();
+            e->SetTimestamp(1234567890);
+            e->SetContent(string("content_key"), string("content_value"));
+        }
+        return group;
+    }
+
+    Pipeline pipeline;
+    PipelineContext ctx;
+};
+
+void FlusherBlackHoleUnittest::OnSuccessfulInit() {
+    unique_ptr<FlusherBlackHole> flusher;
+    Json::Value configJson, optionalGoPipeline;
+    string configStr, errorMsg;
+
+    // only mandatory param
+    configStr = R"(
+        {
+            "Type": "flusher_blackhole"
+        }
+    )";
+    APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+    flusher.reset(new FlusherBlackHole());
+    flusher->SetContext(ctx);
+    flusher->SetMetricsRecordRef(FlusherBlackHole::sName, "1");
+    APSARA_TEST_TRUE(flusher->Init(configJson, optionalGoPipeline));
+    APSARA_TEST_FALSE(flusher->mSerialize);
+    APSARA_TEST_EQUAL(nullptr, flusher->mGroupSerializer);
+    APSARA_TEST_EQUAL(nullptr, flusher->mCompressor);
+
+    // serialization enabled
+    configStr = R"(
+        {
+            "Type": "flusher_blackhole",
+            "Serialize": true,
+            "CompressType": "zstd"
+        }
+    )";
+    APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+    flusher.reset(new FlusherBlackHole());
+    flusher->SetContext(ctx);
+    flusher->SetMetricsRecordRef(FlusherBlackHole::sName, "1");
+    APSARA_TEST_TRUE(flusher->Init(configJson, optionalGoPipeline));
+    APSARA_TEST_TRUE(flusher->mSerialize);
+    APSARA_TEST_NOT_EQUAL(nullptr, flusher->mGroupSerializer);
+    APSARA_TEST_EQUAL(CompressType::ZSTD, flusher->mCompressor->GetCompressType());
+}
+
+void FlusherBlackHoleUnittest::TestSend() {
+    Json::Value configJson, optionalGoPipeline;
+    configJson["Type"] = "flusher_blackhole";
+    FlusherBlackHole flusher;
+    flusher.SetContext(ctx);
+    flusher.SetMetricsRecordRef(FlusherBlackHole::sName, "1");
+    APSARA_TEST_TRUE(flusher.Init(configJson, optionalGoPipeline));
+
+    APSARA_TEST_TRUE(flusher.Send(CreateEventGroup()));
+    vector<SenderQueueItem*> res;
+    SenderQueueManager::GetInstance()->GetAvailableItems(res, 80);
+    APSARA_TEST_EQUAL(1U, res.size());
+    APSARA_TEST_TRUE(res[0]->mData.empty());
+}
+
+void FlusherBlackHoleUnittest::TestSendWithSerialization() {
+    Json::Value configJson, optionalGoPipeline;
+    configJson["Type"] = "flusher_blackhole";
+    configJson["Serialize"] = true;
+    FlusherBlackHole flusher;
+    flusher.SetContext(ctx);
+    flusher.SetMetricsRecordRef(FlusherBlackHole::sName, "1");
+    APSARA_TEST_TRUE(flusher.Init(configJson, optionalGoPipeline));
+
+    // events are batched
+    APSARA_TEST_TRUE(flusher.Send(CreateEventGroup()));
+    APSARA_TEST_TRUE(flusher.Send(CreateEventGroup()));
+    vector<SenderQueueItem*> res;
+    SenderQueueManager::GetInstance()->GetAvailableItems(res, 80);
+    APSARA_TEST_TRUE(res.empty());
+
+    APSARA_TEST_TRUE(flusher.FlushAll());
+    SenderQueueManager::GetInstance()->GetAvailableItems(res, 80);
+    APSARA_TEST_EQUAL(1U, res.size());
+    APSARA_TEST_FALSE(res[0]->mData.empty());
+    APSARA_TEST_TRUE(res[0]->mRawSize > res[0]->mData.size());
+}
+
+UNIT_TEST_CASE(FlusherBlackHoleUnittest, OnSuccessfulInit)
+UNIT_TEST_CASE(FlusherBlackHoleUnittest, TestSend)
+UNIT_TEST_CASE(FlusherBlackHoleUnittest, TestSendWithSerialization)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -33,6 +33,7 @@
 #include "plugin/flusher/sls/FlusherSLS.h"
 #include "plugin/flusher/sls/PackIdManager.h"
 #include "plugin/flusher/sls/SLSClientManager.h"
+#include "sdk/Common.h"
 #include "unittest/Unittest.h"
 
 DECLARE_FLAG_INT32(batch_send_interval);
@@ -622,6 +623,7 @@ void FlusherSLSUnittest::TestSend() {
             APSARA_TEST_EQUAL("hash_key_1", item->mShardHashKey);
             APSARA_TEST_EQUAL(flusher.mLogstore, item->mLogstore);
             APSARA_TEST_EQUAL(cpt, item->mExactlyOnceCheckpoint);
+            APSARA_TEST_EQUAL(sdk::CalcMD5(item->mData), item->mDataMd5);
 
             auto compressor
                 = CompressorFactory::GetInstance()->Create(Json::Value(), ctx, "flusher_sls", "1", CompressType::LZ4);
@@ -754,7 +756,9 @@ void FlusherSLSUnittest::TestSend() {
             APSARA_TEST_TRUE(item->mBufferOrNot);
             APSARA_TEST_EQUAL(&flusher, item->mFlusher);
             APSARA_TEST_EQUAL(flusher.mQueueKey, item->mQueueKey);
-            APSARA_TEST_EQUAL(sdk::CalcMD5("tag_value"), item->mShardHashKey);
+            APSARA_TEST_EQUAL(XXH64("tag_value", 9, 0), *item->mShardHashKeyDigest);
+            APSARA_TEST_EQUAL(32U, item->GetShardHashKey().size());
+            APSARA_TEST_EQUAL(string(16, '0'), item->GetShardHashKey().substr(16));
             APSARA_TEST_EQUAL(flusher.mLogstore, item->mLogstore);
 
             auto compressor
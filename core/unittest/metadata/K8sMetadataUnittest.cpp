@@ -18,6 +18,7 @@
 #include <vector>
 #include "metadata/LabelingK8sMetadata.h"
 #include "metadata/K8sMetadata.h"
+#include "metadata/K8sMetadataCache.h"
 #include "models/PipelineEventGroup.h"
 
 using namespace std;
@@ -415,12 +416,127 @@ public:
         APSARA_TEST_EQUAL("kube-proxy-worker", metricEvent.GetTag("peerWorkloadName").to_string());
         APSARA_TEST_TRUE_FATAL(k8sMetadata.GetInfoByIpFromCache("10.41.0.2") != nullptr);
     }
+
+    void TestCache() {
+        K8sMetadataCache cache(4, 2);
+        std::shared_ptr<k8sContainerInfo> info;
+        bool needRefresh = false;
+        APSARA_TEST_FALSE(cache.Get("key_0", info, needRefresh));
+
+        auto value = std::make_shared<k8sContainerInfo>();
+        value->workloadName = "workload";
+        cache.Insert("key_0", value, 600);
+        APSARA_TEST_TRUE(cache.Get("key_0", info, needRefresh));
+        APSARA_TEST_EQUAL("workload", info->workloadName);
+        APSARA_TEST_FALSE(needRefresh);
+
+        // negative entry
+        cache.Insert("key_1", nullptr, 600);
+        APSARA_TEST_TRUE(cache.Get("key_1", info, needRefresh));
+        APSARA_TEST_EQUAL(nullptr, info);
+
+        // expired entry
+        cache.Insert("key_2", value, 0);
+        APSARA_TEST_FALSE(cache.Get("key_2", info, needRefresh));
+        APSARA_TEST_EQUAL(2U, cache.Size());
+
+        // entry about to expire is refreshed once within the retry interval
+        cache.Insert("key_3", value, 1);
+        APSARA_TEST_TRUE(cache.Get("key_3", info, needRefresh));
+        APSARA_TEST_TRUE(needRefresh);
+        APSARA_TEST_TRUE(cache.Get("key_3", info, needRefresh));
+        APSARA_TEST_FALSE(needRefresh);
+
+        // each shard holds at most 2 entries
+        for (size_t i = 10; i < 20; ++i) {
+            cache.Insert("key_" + std::to_string(i), value, 600);
+        }
+        APSARA_TEST_TRUE(cache.Size() <= 4U);
+        cache.Clear();
+        APSARA_TEST_EQUAL(0U, cache.Size());
+    }
+
+    void TestAsyncRequestDone() {
+        auto& k8sMetadata = K8sMetadata::GetInstance();
+        k8sMetadata.containerCache.Clear();
+        std::vector<std::string> keys{"containerd://aaa", "containerd://bbb"};
+        {
+            std::lock_guard<std::mutex> lock(k8sMetadata.mPendingMux);
+            k8sMetadata.mPendingKeys[0].insert(keys.begin(), keys.end());
+        }
+        // keys being fetched are not requested again
+        uint64_t requestCnt = k8sMetadata.mRefreshRequestsTotal->GetValue();
+        APSARA_TEST_TRUE(k8sMetadata.AsyncGetByContainerIdsFromServer(keys));
+        APSARA_TEST_EQUAL(requestCnt, k8sMetadata.mRefreshRequestsTotal->GetValue());
+
+        // stand-in for the operator response, which only knows the first key
+        HttpResponse response;
+        response.SetStatusCode(200);
+        *response.GetBody<std::string>()
+            = R"({"containerd://aaa":{"namespace":"default","workloadName":"demo","workloadKind":"replicaset",)"
+              R"("serviceName":"","labels":{"app":"demo"},"envs":{},"images":{"demo":"demo:1.0.0"}}})";
+        k8sMetadata.OnAsyncRequestDone(keys, containerInfoType::ContainerIdInfo, response, std::chrono::system_clock::now());
+        APSARA_TEST_TRUE(k8sMetadata.mPendingKeys[0].empty());
+
+        std::shared_ptr<k8sContainerInfo> info;
+        bool needRefresh = false;
+        uint64_t hitCnt = k8sMetadata.mCacheHitTotal->GetValue();
+        APSARA_TEST_TRUE(k8sMetadata.TryGetInfoByContainerIdFromCache("containerd://aaa", info, needRefresh));
+        APSARA_TEST_EQUAL("demo", info->workloadName);
+        // negative entry
+        APSARA_TEST_TRUE(k8sMetadata.TryGetInfoByContainerIdFromCache("containerd://bbb", info, needRefresh));
+        APSARA_TEST_EQUAL(nullptr, info);
+        APSARA_TEST_EQUAL(hitCnt + 2, k8sMetadata.mCacheHitTotal->GetValue());
+
+        // failed request
+        uint64_t failedCnt = k8sMetadata.mRefreshFailedTotal->GetValue();
+        HttpResponse failedResponse;
+        failedResponse.SetStatusCode(500);
+        k8sMetadata.OnAsyncRequestDone(
+            {"containerd://ccc"}, containerInfoType::ContainerIdInfo, failedResponse, std::chrono::system_clock::now());
+        APSARA_TEST_EQUAL(failedCnt + 1, k8sMetadata.mRefreshFailedTotal->GetValue());
+        APSARA_TEST_TRUE(k8sMetadata.TryGetInfoByContainerIdFromCache("containerd://ccc", info, needRefresh));
+        APSARA_TEST_EQUAL(nullptr, info);
+    }
+
+    void TestLabelingNegativeEntry() {
+        auto& k8sMetadata = K8sMetadata::GetInstance();
+        k8sMetadata.containerCache.Clear();
+        k8sMetadata.ipCache.Clear();
+        k8sMetadata.containerCache.Insert("containerd://unknown", nullptr, 600);
+        k8sMetadata.ipCache.Insert("10.0.0.1", nullptr, 600);
+
+        auto eventGroup = PipelineEventGroup(std::make_shared<SourceBuffer>());
+        auto* metricEvent = eventGroup.AddMetricEvent();
+        metricEvent->SetTag(containerIdKey, std::string("containerd://unknown"));
+        metricEvent->SetTag(remoteIpKey, std::string("10.0.0.1"));
+        LabelingK8sMetadata processor;
+        std::vector<std::string> containerVec;
+        std::vector<std::string> remoteIpVec;
+        // negative entries are hits, and are not requested again
+        APSARA_TEST_TRUE(processor.AddLabels(*metricEvent, containerVec, remoteIpVec));
+        APSARA_TEST_TRUE(containerVec.empty());
+        APSARA_TEST_TRUE(remoteIpVec.empty());
+        APSARA_TEST_FALSE(metricEvent->HasTag(workloadNameKey));
+
+        // misses are requested
+        metricEvent->SetTag(containerIdKey, std::string("containerd://missing"));
+        metricEvent->SetTag(remoteIpKey, std::string("10.0.0.2"));
+        APSARA_TEST_FALSE(processor.AddLabels(*metricEvent, containerVec, remoteIpVec));
+        APSARA_TEST_EQUAL(std::vector<std::string>{"containerd://missing"}, containerVec);
+        APSARA_TEST_EQUAL(std::vector<std::string>{"10.0.0.2"}, remoteIpVec);
+        k8sMetadata.containerCache.Clear();
+        k8sMetadata.ipCache.Clear();
+    }
 };
 
 APSARA_UNIT_TEST_CASE(k8sMetadataUnittest, TestGetByContainerIds, 0);
 APSARA_UNIT_TEST_CASE(k8sMetadataUnittest, TestGetByLocalHost, 1);
 APSARA_UNIT_TEST_CASE(k8sMetadataUnittest, TestAddLabelToMetric, 2);
 APSARA_UNIT_TEST_CASE(k8sMetadataUnittest, TestAddLabelToSpan, 3);
+APSARA_UNIT_TEST_CASE(k8sMetadataUnittest, TestCache, 4);
+APSARA_UNIT_TEST_CASE(k8sMetadataUnittest, TestAsyncRequestDone, 5);
+APSARA_UNIT_TEST_CASE(k8sMetadataUnittest, TestLabelingNegativeEntry, 6);
 
 
 
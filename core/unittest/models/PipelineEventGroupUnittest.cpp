@@ -31,6 +31,7 @@ public:
     void TestSwapEvents();
     void TestReserveEvents();
     void TestCopy();
+    void TestShare();
     void TestDestructor();
     void TestSetMetadata();
     void TestDelMetadata();
@@ -215,6 +216,39 @@ void PipelineEventGroupUnittest::TestCopy() {
     APSARA_TEST_EQUAL(3U, res.GetSourceBuffer().use_count());
 }
 
+void PipelineEventGroupUnittest::TestShare() {
+    mEventGroup->SetTag(string("key"), string("value"));
+    mEventGroup->AddLogEvent();
+    const auto* addr = mEventGroup->GetEvents()[0].Get<LogEvent>();
+    {
+        auto res = mEventGroup->Share();
+        APSARA_TEST_EQUAL(1U, res.GetEvents().size());
+        APSARA_TEST_EQUAL(addr, res.GetEvents()[0].Get<LogEvent>());
+        APSARA_TEST_EQUAL(3U, res.GetSourceBuffer().use_count());
+
+        // tags can be modified independently
+        res.DelTag("key");
+        APSARA_TEST_FALSE(res.HasTag("key"));
+        APSARA_TEST_TRUE(mEventGroup->HasTag("key"));
+
+        // events are copied on write
+        res.MutableEvents()[0]->SetTimestamp(1);
+        APSARA_TEST_NOT_EQUAL(addr, res.GetEvents()[0].Get<LogEvent>());
+        APSARA_TEST_EQUAL(&res, res.GetEvents()[0]->mPipelineEventGroupPtr);
+        APSARA_TEST_EQUAL(addr, mEventGroup->GetEvents()[0].Get<LogEvent>());
+    }
+    {
+        auto res = mEventGroup->Share();
+        auto moved = std::move(res);
+        moved.MutableEvents()[0]->SetTimestamp(1);
+        APSARA_TEST_EQUAL(&moved, moved.GetEvents()[0]->mPipelineEventGroupPtr);
+    }
+    // the original group becomes the last owner
+    mEventGroup->MutableEvents()[0]->SetTimestamp(2);
+    APSARA_TEST_EQUAL(addr, mEventGroup->GetEvents()[0].Get<LogEvent>());
+    APSARA_TEST_EQUAL(mEventGroup.get(), mEventGroup->GetEvents()[0]->mPipelineEventGroupPtr);
+}
+
 void PipelineEventGroupUnittest::TestSetMetadata() {
     { // string copy, let kv out of scope
         mEventGroup->SetMetadata(EventGroupMetaKey::LOG_FILE_PATH, std::string("value1"));
@@ -298,6 +332,7 @@ UNIT_TEST_CASE(PipelineEventGroupUnittest, TestAddEvent)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestSwapEvents)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestReserveEvents)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestCopy)
+UNIT_TEST_CASE(PipelineEventGroupUnittest, TestShare)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestDestructor)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestSetMetadata)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestDelMetadata)
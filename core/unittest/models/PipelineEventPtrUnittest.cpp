@@ -12,7 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
 #include <cstdlib>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "models/PipelineEventPtr.h"
 #include "unittest/Unittest.h"
@@ -26,6 +30,8 @@ public:
     void TestCast();
     void TestRelease();
     void TestCopy();
+    void TestShare();
+    void TestShareAcrossThreads();
 
 protected:
     void SetUp() override {
@@ -125,11 +131,75 @@ void PipelineEventPtrUnittest::TestCopy() {
     }
 }
 
+void PipelineEventPtrUnittest::TestShare() {
+    mEventGroup->AddLogEvent();
+    auto& event = mEventGroup->MutableEvents()[0];
+    event->SetTimestamp(12345678901);
+    auto* addr = event.Get<LogEvent>();
+    auto res = event.Share();
+    auto res2 = event.Share();
+    APSARA_TEST_TRUE(event.IsShared());
+    APSARA_TEST_TRUE(res.IsShared());
+    APSARA_TEST_TRUE(res2.IsShared());
+    // const access does not copy
+    APSARA_TEST_EQUAL(addr, std::as_const(event).Get<LogEvent>());
+    APSARA_TEST_EQUAL(addr, std::as_const(res).Get<LogEvent>());
+    APSARA_TEST_EQUAL(12345678901, std::as_const(res)->GetTimestamp());
+    // only the last owner can release the event
+    APSARA_TEST_EQUAL(nullptr, res2.Release());
+    APSARA_TEST_FALSE(res2);
+
+    // mutable access copies the event
+    res->SetTimestamp(1);
+    APSARA_TEST_FALSE(res.IsShared());
+    APSARA_TEST_NOT_EQUAL(addr, res.Get<LogEvent>());
+    APSARA_TEST_EQUAL(mEventGroup.get(), res->GetPipelineEventGroupPtr());
+    APSARA_TEST_EQUAL(12345678901, std::as_const(event)->GetTimestamp());
+
+    // the last owner takes the event back without copy
+    event->SetTimestamp(2);
+    APSARA_TEST_FALSE(event.IsShared());
+    APSARA_TEST_EQUAL(addr, event.Get<LogEvent>());
+    APSARA_TEST_EQUAL(2, event->GetTimestamp());
+    APSARA_TEST_EQUAL(1, res->GetTimestamp());
+}
+
+void PipelineEventPtrUnittest::TestShareAcrossThreads() {
+    mEventGroup->AddLogEvent();
+    auto& event = mEventGroup->MutableEvents()[0];
+    auto* addr = event.Get<LogEvent>();
+    std::vector<PipelineEventPtr> shares;
+    for (size_t i = 0; i < 4; ++i) {
+        shares.emplace_back(event.Share());
+    }
+    // other owners read the event and drop their shares on their own threads
+    std::vector<std::thread> threads;
+    std::atomic_size_t readCnt = 0;
+    for (auto& share : shares) {
+        threads.emplace_back([&readCnt, share = std::move(share)]() mutable {
+            if (std::as_const(share)->GetType() == PipelineEvent::Type::LOG) {
+                ++readCnt;
+            }
+            share.Release();
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    APSARA_TEST_EQUAL(4U, readCnt.load());
+    // the last owner takes the event back without copy
+    event->SetTimestamp(1);
+    APSARA_TEST_FALSE(event.IsShared());
+    APSARA_TEST_EQUAL(addr, event.Get<LogEvent>());
+}
+
 UNIT_TEST_CASE(PipelineEventPtrUnittest, TestIs)
 UNIT_TEST_CASE(PipelineEventPtrUnittest, TestGet)
 UNIT_TEST_CASE(PipelineEventPtrUnittest, TestCast)
 UNIT_TEST_CASE(PipelineEventPtrUnittest, TestRelease)
 UNIT_TEST_CASE(PipelineEventPtrUnittest, TestCopy)
+UNIT_TEST_CASE(PipelineEventPtrUnittest, TestShare)
+UNIT_TEST_CASE(PipelineEventPtrUnittest, TestShareAcrossThreads)
 
 } // namespace logtail
 
@@ -0,0 +1,183 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <string>
+
+#include "common/Flags.h"
+#include "monitor/MetricManager.h"
+#include "monitor/metric_constants/MetricConstants.h"
+#include "monitor/OpenMetricsServer.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(self_monitor_openmetrics_min_render_interval_ms);
+
+using namespace std;
+
+namespace logtail {
+
+class OpenMetricsServerUnittest : public ::testing::Test {
+public:
+    void TestRender();
+    void TestCumulativeValues();
+    void TestCachedResponse();
+    void TestProfile();
+
+protected:
+    void SetUp() override { INT32_FLAG(self_monitor_openmetrics_min_render_interval_ms) = 0; }
+
+    void TearDown() override {
+        INT32_FLAG(self_monitor_openmetrics_min_render_interval_ms) = 1000;
+        // records of released refs are unlinked when taking snapshot
+        DoSnapshot();
+    }
+
+    static void DoSnapshot() {
+        MetricsRecord* snapshot = WriteMetrics::GetInstance()->DoSnapshot();
+        while (snapshot) {
+            MetricsRecord* next = snapshot->GetNext();
+            delete snapshot;
+            snapshot = next;
+        }
+    }
+};
+
+void OpenMetricsServerUnittest::TestRender() {
+    MetricsRecordRef ref;
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
+        ref,
+        MetricCategory::METRIC_CATEGORY_PIPELINE,
+        {{"project", "p\"1"}, {"pipeline.name", "test"}, {"k8s:namespace", "default"}});
+    CounterPtr counter = ref.CreateCounter("in_events_total");
+    IntGaugePtr gauge = ref.CreateIntGauge("queue_size");
+    HistogramPtr histogram = ref.CreateHistogram("delay_ms");
+    counter->Add(3);
+    gauge->Set(2);
+    histogram->Observe(chrono::milliseconds(2));
+    histogram->Observe(chrono::milliseconds(200));
+
+    string body = OpenMetricsServer::GetInstance()->GetResponseBody();
+    string labels = "project=\"p\\\"1\",pipeline_name=\"test\",k8s_namespace=\"default\"";
+    APSARA_TEST_TRUE(body.find("# TYPE loongcollector_pipeline_in_events counter\n") != string::npos);
+    APSARA_TEST_TRUE(body.find("loongcollector_pipeline_in_events_total{" + labels + "} 3\n") != string::npos);
+    APSARA_TEST_TRUE(body.find("# TYPE loongcollector_pipeline_queue_size gauge\n") != string::npos);
+    APSARA_TEST_TRUE(body.find("loongcollector_pipeline_queue_size{" + labels + "} 2\n") != string::npos);
+    APSARA_TEST_TRUE(body.find("# TYPE loongcollector_pipeline_delay_ms histogram\n") != string::npos);
+    APSARA_TEST_TRUE(body.find("loongcollector_pipeline_delay_ms_bucket{" + labels + ",le=\"1.0\"} 0\n")
+                     != string::npos);
+    APSARA_TEST_TRUE(body.find("loongcollector_pipeline_delay_ms_bucket{" + labels + ",le=\"5.0\"} 1\n")
+                     != string::npos);
+    APSARA_TEST_TRUE(body.find("loongcollector_pipeline_delay_ms_bucket{" + labels + ",le=\"500.0\"} 2\n")
+                     != string::npos);
+    APSARA_TEST_TRUE(body.find("loongcollector_pipeline_delay_ms_bucket{" + labels + ",le=\"+Inf\"} 2\n")
+                     != string::npos);
+    APSARA_TEST_TRUE(body.find("loongcollector_pipeline_delay_ms_sum{" + labels + "} 202\n") != string::npos);
+    APSARA_TEST_TRUE(body.find("loongcollector_pipeline_delay_ms_count{" + labels + "} 2\n") != string::npos);
+    // quantiles are the upper bounds of the buckets holding them
+    APSARA_TEST_TRUE(body.find("# TYPE loongcollector_pipeline_delay_ms_summary summary\n") != string::npos);
+    APSARA_TEST_TRUE(body.find("loongcollector_pipeline_delay_ms_summary{" + labels + ",quantile=\"0.5\"} 2.047\n")
+                     != string::npos);
+    APSARA_TEST_TRUE(body.find("loongcollector_pipeline_delay_ms_summary{" + labels + ",quantile=\"0.99\"} 212.991\n")
+                     != string::npos);
+    APSARA_TEST_TRUE(body.find("loongcollector_pipeline_delay_ms_summary_sum{" + labels + "} 202\n") != string::npos);
+    APSARA_TEST_TRUE(body.find("loongcollector_pipeline_delay_ms_summary_count{" + labels + "} 2\n")
+                     != string::npos);
+    APSARA_TEST_EQUAL(body.size() - 6, body.rfind("# EOF\n"));
+}
+
+void OpenMetricsServerUnittest::TestCumulativeValues() {
+    MetricsRecordRef ref;
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
+        ref, MetricCategory::METRIC_CATEGORY_RUNNER, {{"runner_name", "cumulative"}});
+    CounterPtr counter = ref.CreateCounter("out_items_total");
+    ShardedCounterPtr shardedCounter = ref.CreateShardedCounter("in_items_total");
+    counter->Add(3);
+    shardedCounter->Add(4);
+
+    // snapshot taken by self monitor server resets the values
+    DoSnapshot();
+    APSARA_TEST_EQUAL(0U, counter->GetValue());
+    counter->Add(2);
+    shardedCounter->Add(1);
+
+    string body = OpenMetricsServer::GetInstance()->GetResponseBody();
+    APSARA_TEST_TRUE(body.find("loongcollector_runner_out_items_total{runner_name=\"cumulative\"} 5\n")
+                     != string::npos);
+    APSARA_TEST_TRUE(body.find("loongcollector_runner_in_items_total{runner_name=\"cumulative\"} 5\n")
+                     != string::npos);
+    // scraping does not reset the values
+    APSARA_TEST_EQUAL(2U, counter->GetValue());
+    APSARA_TEST_EQUAL(1U, shardedCounter->GetValue());
+}
+
+void OpenMetricsServerUnittest::TestCachedResponse() {
+    MetricsRecordRef ref;
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
+        ref, MetricCategory::METRIC_CATEGORY_RUNNER, {{"runner_name", "cached"}});
+    CounterPtr counter = ref.CreateCounter("out_items_total");
+    counter->Add(1);
+    OpenMetricsServer::GetInstance()->GetResponseBody();
+
+    INT32_FLAG(self_monitor_openmetrics_min_render_interval_ms) = 60000;
+    counter->Add(1);
+    string body = OpenMetricsServer::GetInstance()->GetResponseBody();
+    APSARA_TEST_TRUE(body.find("loongcollector_runner_out_items_total{runner_name=\"cached\"} 1\n") != string::npos);
+}
+
+void OpenMetricsServerUnittest::TestProfile() {
+    MetricsRecordRef processorRef;
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(processorRef,
+                                                         MetricCategory::METRIC_CATEGORY_PLUGIN,
+                                                         {{METRIC_LABEL_KEY_PIPELINE_NAME, "test_config"},
+                                                          {METRIC_LABEL_KEY_PLUGIN_TYPE, "processor_parse_regex_native"},
+                                                          {METRIC_LABEL_KEY_PLUGIN_ID, "2"}});
+    ShardedTimeCounterPtr processorCpu = processorRef.CreateShardedTimeCounter(METRIC_PLUGIN_TOTAL_CPU_TIME_MS);
+    processorCpu->Add(chrono::milliseconds(5));
+
+    MetricsRecordRef serializerRef;
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
+        serializerRef,
+        MetricCategory::METRIC_CATEGORY_COMPONENT,
+        {{METRIC_LABEL_KEY_PIPELINE_NAME, "test_config"},
+         {METRIC_LABEL_KEY_COMPONENT_NAME, METRIC_LABEL_VALUE_COMPONENT_NAME_SERIALIZER},
+         {METRIC_LABEL_KEY_FLUSHER_PLUGIN_ID, "3"}});
+    ShardedTimeCounterPtr serializerCpu = serializerRef.CreateShardedTimeCounter(METRIC_COMPONENT_TOTAL_CPU_TIME_MS);
+    serializerCpu->Add(chrono::milliseconds(8));
+
+    // records of input files are merged
+    MetricsRecordRef fileRef1, fileRef2;
+    for (auto ref : {&fileRef1, &fileRef2}) {
+        WriteMetrics::GetInstance()->PrepareMetricsRecordRef(*ref,
+                                                             MetricCategory::METRIC_CATEGORY_PLUGIN_SOURCE,
+                                                             {{METRIC_LABEL_KEY_PIPELINE_NAME, "other_config"},
+                                                              {METRIC_LABEL_KEY_PLUGIN_TYPE, "input_file"},
+                                                              {METRIC_LABEL_KEY_PLUGIN_ID, "1"}});
+        ref->CreateTimeCounter(METRIC_PLUGIN_TOTAL_CPU_TIME_MS)->Add(chrono::milliseconds(2));
+    }
+
+    string body = OpenMetricsServer::GetInstance()->GetProfileBody();
+    APSARA_TEST_EQUAL("test_config;flusher/3;serializer 8\n"
+                      "test_config;processor_parse_regex_native/2 5\n"
+                      "other_config;input_file/1 4\n",
+                      body);
+}
+
+UNIT_TEST_CASE(OpenMetricsServerUnittest, TestRender)
+UNIT_TEST_CASE(OpenMetricsServerUnittest, TestCumulativeValues)
+UNIT_TEST_CASE(OpenMetricsServerUnittest, TestCachedResponse)
+UNIT_TEST_CASE(OpenMetricsServerUnittest, TestProfile)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
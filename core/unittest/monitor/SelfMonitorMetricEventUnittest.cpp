@@ -12,10 +12,17 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <thread>
+
+#include "common/Flags.h"
+
 #include "monitor/MetricManager.h"
+#include "monitor/metric_models/ScopedCpuTimer.h"
 #include "monitor/metric_models/SelfMonitorMetricEvent.h"
 #include "unittest/Unittest.h"
 
+DECLARE_FLAG_INT32(cpu_time_sample_interval);
+
 namespace logtail {
 
 class SelfMonitorMetricEventUnittest : public ::testing::Test {
@@ -27,6 +34,9 @@ public:
     void TestCreateFromGoMetricMap();
     void TestMerge();
     void TestSendInterval();
+    void TestShardedCounter();
+    void TestHistogram();
+    void TestScopedCpuTimer();
 
 private:
     std::shared_ptr<SourceBuffer> mSourceBuffer;
@@ -38,6 +48,9 @@ APSARA_UNIT_TEST_CASE(SelfMonitorMetricEventUnittest, TestCreateFromMetricEvent,
 APSARA_UNIT_TEST_CASE(SelfMonitorMetricEventUnittest, TestCreateFromGoMetricMap, 1);
 APSARA_UNIT_TEST_CASE(SelfMonitorMetricEventUnittest, TestMerge, 2);
 APSARA_UNIT_TEST_CASE(SelfMonitorMetricEventUnittest, TestSendInterval, 3);
+APSARA_UNIT_TEST_CASE(SelfMonitorMetricEventUnittest, TestShardedCounter, 4);
+APSARA_UNIT_TEST_CASE(SelfMonitorMetricEventUnittest, TestHistogram, 5);
+APSARA_UNIT_TEST_CASE(SelfMonitorMetricEventUnittest, TestScopedCpuTimer, 6);
 
 void SelfMonitorMetricEventUnittest::TestCreateFromMetricEvent() {
     std::vector<std::pair<std::string, std::string>> labels;
@@ -198,6 +211,139 @@ void SelfMonitorMetricEventUnittest::TestSendInterval() {
     APSARA_TEST_TRUE(event.ShouldDelete()); // 第三次调用，间隔计数达到3，应返回true
 }
 
+void SelfMonitorMetricEventUnittest::TestShardedCounter() {
+    MetricsRecord record(MetricCategory::METRIC_CATEGORY_PIPELINE,
+                         std::make_shared<MetricLabels>(),
+                         std::make_shared<DynamicMetricLabels>());
+    ShardedCounterPtr counter = record.CreateShardedCounter("counter");
+    ShardedTimeCounterPtr timeCounter = record.CreateShardedTimeCounter("time_counter");
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; ++i) {
+        threads.emplace_back([&]() {
+            for (size_t j = 0; j < 1000; ++j) {
+                counter->Add(1);
+                timeCounter->Add(std::chrono::milliseconds(1));
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    APSARA_TEST_EQUAL(4000U, counter->GetValue());
+    APSARA_TEST_EQUAL(4000U, timeCounter->GetValue());
+
+    // sharded counters are collected as plain counters, and reset
+    std::unique_ptr<MetricsRecord> snapshot(record.Collect());
+    APSARA_TEST_EQUAL(1U, snapshot->GetCounters().size());
+    APSARA_TEST_EQUAL(4000U, snapshot->GetCounters()[0]->GetValue());
+    APSARA_TEST_EQUAL(1U, snapshot->GetTimeCounters().size());
+    APSARA_TEST_EQUAL(4000U, snapshot->GetTimeCounters()[0]->GetValue());
+    APSARA_TEST_EQUAL(0U, counter->GetValue());
+    APSARA_TEST_EQUAL(0U, timeCounter->GetValue());
+}
+
+void SelfMonitorMetricEventUnittest::TestHistogram() {
+    // buckets
+    for (uint64_t val : {0UL, 7UL, 8UL, 15UL, 16UL, 1000UL, 123456789UL, UINT64_MAX}) {
+        size_t index = Histogram::GetBucketIndex(val);
+        APSARA_TEST_TRUE(index < Histogram::kBucketCnt);
+        APSARA_TEST_TRUE(val <= Histogram::GetBucketUpperBound(index));
+        // relative error is within 1/8
+        APSARA_TEST_TRUE(Histogram::GetBucketUpperBound(index) - val <= val / Histogram::kSubBucketCnt);
+    }
+    APSARA_TEST_EQUAL(Histogram::kBucketCnt - 1, Histogram::GetBucketIndex(UINT64_MAX));
+
+    MetricsRecord record(MetricCategory::METRIC_CATEGORY_PIPELINE,
+                         std::make_shared<MetricLabels>(),
+                         std::make_shared<DynamicMetricLabels>());
+    HistogramPtr histogram = record.CreateHistogram("latency_ms");
+    // 1ms ~ 100ms
+    for (size_t i = 1; i <= 100; ++i) {
+        histogram->Observe(std::chrono::milliseconds(i));
+    }
+    APSARA_TEST_EQUAL(100U, histogram->GetCount());
+    std::unique_ptr<MetricsRecord> snapshot(record.Collect());
+    APSARA_TEST_EQUAL(0U, histogram->GetCount());
+    APSARA_TEST_EQUAL(1U, snapshot->GetHistograms().size());
+    APSARA_TEST_EQUAL(100U, snapshot->GetHistograms()[0]->GetCount());
+
+    SelfMonitorMetricEvent event1(snapshot.get());
+    SelfMonitorMetricEvent event2(snapshot.get());
+    event1.Merge(event2);
+
+    auto group = std::make_unique<PipelineEventGroup>(std::make_shared<SourceBuffer>());
+    MetricEvent* metricEvent = group->AddMetricEvent();
+    event1.ReadAsMetricEvent(metricEvent);
+    double val = 0;
+    APSARA_TEST_TRUE(metricEvent->GetValue<UntypedMultiDoubleValues>()->GetValue("latency_ms_count", val));
+    APSARA_TEST_EQUAL(200.0, val);
+    APSARA_TEST_TRUE(metricEvent->GetValue<UntypedMultiDoubleValues>()->GetValue("latency_ms_p50", val));
+    APSARA_TEST_TRUE(val >= 50.0 && val <= 50.0 * 1.125);
+    APSARA_TEST_TRUE(metricEvent->GetValue<UntypedMultiDoubleValues>()->GetValue("latency_ms_p99", val));
+    APSARA_TEST_TRUE(val >= 99.0 && val <= 99.0 * 1.125);
+
+    // buckets are reset once read
+    MetricEvent* metricEvent2 = group->AddMetricEvent();
+    event1.ReadAsMetricEvent(metricEvent2);
+    APSARA_TEST_TRUE(metricEvent2->GetValue<UntypedMultiDoubleValues>()->GetValue("latency_ms_count", val));
+    APSARA_TEST_EQUAL(0.0, val);
+    APSARA_TEST_FALSE(metricEvent2->GetValue<UntypedMultiDoubleValues>()->GetValue("latency_ms_p50", val));
+}
+
+void SelfMonitorMetricEventUnittest::TestScopedCpuTimer() {
+    MetricsRecord record(MetricCategory::METRIC_CATEGORY_PIPELINE,
+                         std::make_shared<MetricLabels>(),
+                         std::make_shared<DynamicMetricLabels>());
+    ShardedTimeCounterPtr counter = record.CreateShardedTimeCounter("cpu");
+    auto burn = []() {
+        uint64_t start = CpuTimeSampler::GetThreadCpuTimeNs();
+        volatile uint64_t sum = 0;
+        while (CpuTimeSampler::GetThreadCpuTimeNs() - start < 2000000) {
+            ++sum;
+        }
+    };
+
+    INT32_FLAG(cpu_time_sample_interval) = 0;
+    {
+        ScopedCpuTimer<ShardedTimeCounterPtr> timer(counter);
+        burn();
+    }
+    APSARA_TEST_EQUAL(0U, counter->GetValue());
+
+    ShardedTimeCounterPtr nullCounter;
+    {
+        ScopedCpuTimer<ShardedTimeCounterPtr> timer(nullCounter);
+    }
+
+#if defined(__linux__)
+    // 1 in every 4 scopes is measured and scaled up
+    INT32_FLAG(cpu_time_sample_interval) = 4;
+    for (size_t i = 0; i < 8; ++i) {
+        ScopedCpuTimer<ShardedTimeCounterPtr> timer(counter);
+        burn();
+    }
+    APSARA_TEST_GE(counter->GetValue(), 16U);
+
+    // scopes are counted per counter, so scopes interleaved on a thread are all sampled
+    INT32_FLAG(cpu_time_sample_interval) = 2;
+    ShardedTimeCounterPtr counter1 = record.CreateShardedTimeCounter("cpu1");
+    ShardedTimeCounterPtr counter2 = record.CreateShardedTimeCounter("cpu2");
+    for (size_t i = 0; i < 4; ++i) {
+        {
+            ScopedCpuTimer<ShardedTimeCounterPtr> timer(counter1);
+            burn();
+        }
+        {
+            ScopedCpuTimer<ShardedTimeCounterPtr> timer(counter2);
+            burn();
+        }
+    }
+    APSARA_TEST_GE(counter1->GetValue(), 8U);
+    APSARA_TEST_GE(counter2->GetValue(), 8U);
+#endif
+    INT32_FLAG(cpu_time_sample_interval) = 16;
+}
+
 } // namespace logtail
 
 int main(int argc, char** argv) {
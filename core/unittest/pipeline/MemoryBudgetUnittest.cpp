@@ -0,0 +1,153 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+
+#include "common/Flags.h"
+#include "models/PipelineEventGroup.h"
+#include "pipeline/limiter/MemoryBudget.h"
+#include "pipeline/queue/ProcessQueueManager.h"
+#include "pipeline/queue/QueueKeyManager.h"
+#include "pipeline/queue/SenderQueueItem.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT64(pipeline_memory_budget_mb);
+
+using namespace std;
+
+namespace logtail {
+
+class MemoryBudgetUnittest : public testing::Test {
+public:
+    void TestAddAndSub();
+    void TestIsValidToPush();
+    void TestProcessQueue();
+    void TestSenderQueueItem();
+
+protected:
+    void SetUp() override {
+        INT64_FLAG(pipeline_memory_budget_mb) = 1;
+        MemoryBudget::GetInstance()->Clear();
+    }
+
+    void TearDown() override {
+        INT64_FLAG(pipeline_memory_budget_mb) = 0;
+        MemoryBudget::GetInstance()->Clear();
+        QueueKeyManager::GetInstance()->Clear();
+        ProcessQueueManager::GetInstance()->Clear();
+    }
+
+private:
+    static const size_t sLimit = 1024 * 1024;
+};
+
+void MemoryBudgetUnittest::TestAddAndSub() {
+    auto budget = MemoryBudget::GetInstance();
+    budget->Add(MemoryBudget::Component::PROCESS_QUEUE, 100);
+    budget->Add(MemoryBudget::Component::BATCHER, 200);
+    budget->Add(MemoryBudget::Component::SENDER_QUEUE, 300);
+    APSARA_TEST_EQUAL(100U, budget->GetUsage(MemoryBudget::Component::PROCESS_QUEUE));
+    APSARA_TEST_EQUAL(200U, budget->GetUsage(MemoryBudget::Component::BATCHER));
+    APSARA_TEST_EQUAL(300U, budget->GetUsage(MemoryBudget::Component::SENDER_QUEUE));
+    APSARA_TEST_EQUAL(600U, budget->GetUsage());
+    APSARA_TEST_EQUAL(200U,
+                      budget->mUsageGauges[static_cast<size_t>(MemoryBudget::Component::BATCHER)]->GetValue());
+    APSARA_TEST_EQUAL(600U, budget->mTotalUsageGauge->GetValue());
+
+    budget->Sub(MemoryBudget::Component::BATCHER, 200);
+    APSARA_TEST_EQUAL(0U, budget->GetUsage(MemoryBudget::Component::BATCHER));
+    APSARA_TEST_EQUAL(400U, budget->GetUsage());
+    APSARA_TEST_EQUAL(0U, budget->mUsageGauges[static_cast<size_t>(MemoryBudget::Component::BATCHER)]->GetValue());
+    APSARA_TEST_EQUAL(400U, budget->mTotalUsageGauge->GetValue());
+}
+
+void MemoryBudgetUnittest::TestIsValidToPush() {
+    auto budget = MemoryBudget::GetInstance();
+    APSARA_TEST_EQUAL(sLimit, budget->GetLimit());
+    APSARA_TEST_TRUE(budget->IsValidToPush(0));
+    APSARA_TEST_TRUE(budget->IsValidToPush(1));
+    APSARA_TEST_TRUE(budget->IsValidToPush(2));
+    APSARA_TEST_EQUAL(sLimit, budget->mLimitGauge->GetValue());
+
+    // above 70%, lowest priority is blocked
+    budget->Add(MemoryBudget::Component::PROCESS_QUEUE, sLimit * 3 / 4);
+    APSARA_TEST_TRUE(budget->IsValidToPush(0));
+    APSARA_TEST_TRUE(budget->IsValidToPush(1));
+    APSARA_TEST_FALSE(budget->IsValidToPush(2));
+    // priority beyond the max one is treated as the lowest
+    APSARA_TEST_FALSE(budget->IsValidToPush(5));
+
+    // above 80%
+    budget->Add(MemoryBudget::Component::BATCHER, sLimit / 10);
+    APSARA_TEST_TRUE(budget->IsValidToPush(0));
+    APSARA_TEST_FALSE(budget->IsValidToPush(1));
+
+    // above 90%
+    budget->Add(MemoryBudget::Component::SENDER_QUEUE, sLimit / 10);
+    APSARA_TEST_FALSE(budget->IsValidToPush(0));
+    APSARA_TEST_EQUAL(4U, budget->mRejectedPushTimesTotal->GetValue());
+
+    // release
+    budget->Sub(MemoryBudget::Component::PROCESS_QUEUE, sLimit * 3 / 4);
+    APSARA_TEST_TRUE(budget->IsValidToPush(2));
+}
+
+void MemoryBudgetUnittest::TestProcessQueue() {
+    auto budget = MemoryBudget::GetInstance();
+    auto manager = ProcessQueueManager::GetInstance();
+    PipelineContext ctx;
+    ctx.SetConfigName("test_config_1");
+    manager->CreateOrUpdateBoundedQueue(0, 0, ctx);
+    manager->EnablePop("test_config_1");
+    ctx.SetConfigName("test_config_2");
+    manager->CreateOrUpdateBoundedQueue(1, 2, ctx);
+
+    PipelineEventGroup g(make_shared<SourceBuffer>());
+    g.AddLogEvent()->SetContent(string("key"), string("value"));
+    size_t dataSize = g.DataSize();
+    APSARA_TEST_EQUAL(0, manager->PushQueue(0, make_unique<ProcessQueueItem>(std::move(g), 0)));
+    APSARA_TEST_EQUAL(dataSize, budget->GetUsage(MemoryBudget::Component::PROCESS_QUEUE));
+
+    // low priority queue is blocked by the budget
+    budget->Add(MemoryBudget::Component::BATCHER, sLimit * 3 / 4);
+    APSARA_TEST_TRUE(manager->IsValidToPush(0));
+    APSARA_TEST_FALSE(manager->IsValidToPush(1));
+    PipelineEventGroup g2(make_shared<SourceBuffer>());
+    APSARA_TEST_EQUAL(3, manager->PushQueue(1, make_unique<ProcessQueueItem>(std::move(g2), 0)));
+    budget->Sub(MemoryBudget::Component::BATCHER, sLimit * 3 / 4);
+
+    unique_ptr<ProcessQueueItem> item;
+    string configName;
+    APSARA_TEST_TRUE(manager->PopItem(0, item, configName));
+    APSARA_TEST_EQUAL("test_config_1", configName);
+    APSARA_TEST_EQUAL(0U, budget->GetUsage(MemoryBudget::Component::PROCESS_QUEUE));
+}
+
+void MemoryBudgetUnittest::TestSenderQueueItem() {
+    auto budget = MemoryBudget::GetInstance();
+    {
+        SenderQueueItem item(string(100, 'a'), 100, nullptr, 0);
+        APSARA_TEST_EQUAL(100U, budget->GetUsage(MemoryBudget::Component::SENDER_QUEUE));
+    }
+    APSARA_TEST_EQUAL(0U, budget->GetUsage(MemoryBudget::Component::SENDER_QUEUE));
+}
+
+UNIT_TEST_CASE(MemoryBudgetUnittest, TestAddAndSub)
+UNIT_TEST_CASE(MemoryBudgetUnittest, TestIsValidToPush)
+UNIT_TEST_CASE(MemoryBudgetUnittest, TestProcessQueue)
+UNIT_TEST_CASE(MemoryBudgetUnittest, TestSenderQueueItem)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,369 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/JsonUtil.h"
+#include "common/TimeUtil.h"
+#include "config/PipelineConfig.h"
+#include "constants/Constants.h"
+#include "logger/Logger.h"
+#include "monitor/metric_models/ScopedCpuTimer.h"
+#include "pipeline/Pipeline.h"
+#include "pipeline/plugin/PluginRegistry.h"
+#include "pipeline/queue/SenderQueueManager.h"
+
+#ifdef ENABLE_COMPATIBLE_MODE
+extern "C" {
+#include <string.h>
+asm(".symver memcpy, memcpy@GLIBC_2.2.5");
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+    return memcpy(dest, src, n);
+}
+}
+#endif
+
+using namespace std;
+
+namespace logtail {
+
+// Drives a real pipeline, built from a json config, with synthetic log lines: the lines are packed into groups the
+// same way as input_file does, and then go through the inner split processor, the native processors, the batcher, the
+// serializer and the compressor of flusher_blackhole. Events/s, bytes/s, cpu per GB of raw logs and peak rss are
+// reported for each stage.
+//
+// usage: pipeline_benchmark [--shape=json|regex|delimiter] [--line-size=512] [--fields=10] [--lines=1000]
+//                           [--groups=200] [--config=<pipeline config file>]
+// When no config file is given, a pipeline with input_file, the parse processor of the shape and flusher_blackhole is
+// used. A custom config should contain input_file as its only input, so that the synthetic groups can be split.
+class PipelineBenchmark {
+public:
+    struct Options {
+        string mShape;
+        size_t mLineSize = 512;
+        size_t mFieldCnt = 10;
+        size_t mLineCntPerGroup = 1000;
+        size_t mGroupCnt = 200;
+        string mConfigPath;
+    };
+
+    explicit PipelineBenchmark(const Options& opts) : mOpts(opts) {}
+
+    bool Run(const string& shape) {
+        unique_ptr<Pipeline> pipeline = CreatePipeline(shape);
+        if (!pipeline) {
+            return false;
+        }
+        string block = GenerateBlock(shape);
+        mOutSize = 0;
+
+        Stage process("process"), send("send"), flush("flush");
+        for (size_t i = 0; i < mOpts.mGroupCnt; ++i) {
+            vector<PipelineEventGroup> groups;
+            groups.emplace_back(CreateEventGroup(block));
+
+            process.Begin();
+            pipeline->Process(groups, 0);
+            process.End(mOpts.mLineCntPerGroup, block.size());
+
+            send.Begin();
+            pipeline->Send(std::move(groups));
+            send.End(mOpts.mLineCntPerGroup, block.size());
+
+            mOutSize += DrainSenderQueue();
+        }
+        flush.Begin();
+        pipeline->FlushBatch();
+        flush.End(0, 0);
+        mOutSize += DrainSenderQueue();
+
+        uint64_t totalEvents = mOpts.mGroupCnt * mOpts.mLineCntPerGroup;
+        uint64_t totalBytes = mOpts.mGroupCnt * block.size();
+        printf("shape %s, %lu events of %lu bytes with %lu fields, %lu bytes in total, %lu bytes sent\n",
+               shape.c_str(),
+               totalEvents,
+               mOpts.mLineSize,
+               mOpts.mFieldCnt,
+               totalBytes,
+               mOutSize);
+        for (const auto* stage : {&process, &send, &flush}) {
+            stage->Print();
+        }
+        Stage total("total");
+        for (const auto* stage : {&process, &send, &flush}) {
+            total.Merge(*stage);
+        }
+        total.Print();
+        return true;
+    }
+
+private:
+    class Stage {
+    public:
+        explicit Stage(const char* name) : mName(name) {}
+
+        void Begin() {
+            ResetPeakRss();
+            mBeginTime = GetCurrentTimeInMicroSeconds();
+            mBeginCpu = CpuTimeSampler::GetThreadCpuTimeNs();
+        }
+
+        void End(uint64_t events, uint64_t bytes) {
+            mCpuNs += CpuTimeSampler::GetThreadCpuTimeNs() - mBeginCpu;
+            mWallUs += GetCurrentTimeInMicroSeconds() - mBeginTime;
+            mEvents += events;
+            mBytes += bytes;
+            mPeakRssKB = max(mPeakRssKB, GetPeakRssKB());
+        }
+
+        void Merge(const Stage& rhs) {
+            mWallUs += rhs.mWallUs;
+            mCpuNs += rhs.mCpuNs;
+            mEvents = max(mEvents, rhs.mEvents);
+            mBytes = max(mBytes, rhs.mBytes);
+            mPeakRssKB = max(mPeakRssKB, rhs.mPeakRssKB);
+        }
+
+        void Print() const {
+            uint64_t wallUs = max<uint64_t>(mWallUs, 1);
+            printf("  %-8s cost %8lums, %12.0f events/s, %9.1f MB/s, %7.2f cpu s/GB, peak rss %lu MB\n",
+                   mName,
+                   mWallUs / 1000,
+                   mEvents * 1000000.0 / wallUs,
+                   mBytes * 1000000.0 / wallUs / 1024 / 1024,
+                   mBytes == 0 ? 0.0 : mCpuNs / 1e9 / (mBytes / 1024.0 / 1024 / 1024),
+                   mPeakRssKB / 1024);
+        }
+
+    private:
+        // peak rss is reset before each stage so that it reflects the memory used by the stage, which requires linux
+        // 4.0+. Otherwise, the peak rss of the whole process so far is reported.
+        static void ResetPeakRss() {
+            ofstream fout("/proc/self/clear_refs");
+            fout << "5";
+        }
+
+        static uint64_t GetPeakRssKB() {
+            ifstream fin("/proc/self/status");
+            string line;
+            while (getline(fin, line)) {
+                if (line.compare(0, 6, "VmHWM:") == 0) {
+                    return strtoull(line.c_str() + 6, nullptr, 10);
+                }
+            }
+            return 0;
+        }
+
+        const char* mName;
+        uint64_t mBeginTime = 0;
+        uint64_t mBeginCpu = 0;
+        uint64_t mWallUs = 0;
+        uint64_t mCpuNs = 0;
+        uint64_t mEvents = 0;
+        uint64_t mBytes = 0;
+        uint64_t mPeakRssKB = 0;
+    };
+
+    unique_ptr<Pipeline> CreatePipeline(const string& shape) {
+        string configStr, errorMsg;
+        if (!mOpts.mConfigPath.empty()) {
+            ifstream fin(mOpts.mConfigPath);
+            if (!fin) {
+                printf("failed to open config file %s\n", mOpts.mConfigPath.c_str());
+                return nullptr;
+            }
+            stringstream ss;
+            ss << fin.rdbuf();
+            configStr = ss.str();
+        } else {
+            configStr = GenerateConfig(shape);
+        }
+        unique_ptr<Json::Value> configJson = make_unique<Json::Value>();
+        if (!ParseJsonTable(configStr, *configJson, errorMsg)) {
+            printf("invalid config: %s\n", errorMsg.c_str());
+            return nullptr;
+        }
+        PipelineConfig config("pipeline_benchmark_" + shape, std::move(configJson));
+        if (!config.Parse()) {
+            printf("failed to parse config\n");
+            return nullptr;
+        }
+        auto pipeline = make_unique<Pipeline>();
+        if (!pipeline->Init(std::move(config)) || pipeline->GetInputs().empty()) {
+            printf("failed to init pipeline\n");
+            return nullptr;
+        }
+        return pipeline;
+    }
+
+    string GenerateConfig(const string& shape) const {
+        Json::Value root, input, processor, flusher;
+        input["Type"] = "input_file";
+        input["FilePaths"].append("/tmp/pipeline_benchmark/*.log");
+        root["inputs"].append(input);
+
+        Json::Value keys;
+        for (size_t i = 0; i < mOpts.mFieldCnt; ++i) {
+            keys.append("f" + to_string(i));
+        }
+        if (shape == "json") {
+            processor["Type"] = "processor_parse_json_native";
+            processor["SourceKey"] = "content";
+        } else if (shape == "regex") {
+            string regex;
+            for (size_t i = 0; i < mOpts.mFieldCnt; ++i) {
+                regex += i == 0 ? "(\\S+)" : "\\s(\\S+)";
+            }
+            processor["Type"] = "processor_parse_regex_native";
+            processor["SourceKey"] = "content";
+            processor["Regex"] = regex;
+            processor["Keys"] = keys;
+        } else {
+            processor["Type"] = "processor_parse_delimiter_native";
+            processor["SourceKey"] = "content";
+            processor["Separator"] = "|";
+            processor["Keys"] = keys;
+        }
+        root["processors"].append(processor);
+
+        flusher["Type"] = "flusher_blackhole";
+        flusher["Serialize"] = true;
+        flusher["CompressType"] = "lz4";
+        root["flushers"].append(flusher);
+        return root.toStyledString();
+    }
+
+    // lines differ from each other to keep the compression ratio realistic
+    string GenerateBlock(const string& shape) const {
+        static const char* charset = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+        size_t fieldCnt = max<size_t>(mOpts.mFieldCnt, 1);
+        size_t overhead = shape == "json" ? 8 + fieldCnt * 8 : fieldCnt;
+        size_t valueSize = mOpts.mLineSize > overhead ? (mOpts.mLineSize - overhead) / fieldCnt : 1;
+        valueSize = max<size_t>(valueSize, 1);
+
+        string block;
+        block.reserve((mOpts.mLineSize + 1) * mOpts.mLineCntPerGroup);
+        uint64_t seed = 88172645463325252ULL;
+        for (size_t i = 0; i < mOpts.mLineCntPerGroup; ++i) {
+            if (shape == "json") {
+                block += '{';
+            }
+            for (size_t j = 0; j < fieldCnt; ++j) {
+                if (shape == "json") {
+                    block += (j == 0 ? "\"f" : ",\"f") + to_string(j) + "\":\"";
+                } else if (j != 0) {
+                    block += shape == "regex" ? ' ' : '|';
+                }
+                for (size_t k = 0; k < valueSize; ++k) {
+                    // xorshift, only a few distinct chars per field to resemble real logs
+                    seed ^= seed << 13;
+                    seed ^= seed >> 7;
+                    seed ^= seed << 17;
+                    block += charset[(j * 7 + seed % 8) % 62];
+                }
+                if (shape == "json") {
+                    block += '"';
+                }
+            }
+            if (shape == "json") {
+                block += '}';
+            }
+            block += '\n';
+        }
+        return block;
+    }
+
+    // mimics the event group generated by LogFileReader
+    PipelineEventGroup CreateEventGroup(const string& block) const {
+        PipelineEventGroup group(make_shared<SourceBuffer>());
+        StringBuffer content = group.GetSourceBuffer()->CopyString(block.data(), block.size() - 1);
+        auto e = group.AddLogEvent();
+        e->SetContentNoCopy(StringView(DEFAULT_CONTENT_KEY), StringView(content.data, content.size));
+        e->SetTimestamp(time(nullptr));
+        e->SetPosition(0, block.size());
+        return group;
+    }
+
+    // there is no flusher runner in the benchmark, so items are removed here to prevent the queue from being full
+    static uint64_t DrainSenderQueue() {
+        uint64_t size = 0;
+        vector<SenderQueueItem*> items;
+        SenderQueueManager::GetInstance()->GetAvailableItems(items, -1);
+        for (auto item : items) {
+            size += item->mData.size();
+            SenderQueueManager::GetInstance()->RemoveItem(item->mQueueKey, item);
+        }
+        return size;
+    }
+
+    Options mOpts;
+    uint64_t mOutSize = 0;
+};
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+    logtail::PluginRegistry::GetInstance()->LoadPlugins();
+
+    logtail::PipelineBenchmark::Options opts;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (strncmp(arg, "--shape=", 8) == 0) {
+            opts.mShape = arg + 8;
+        } else if (strncmp(arg, "--line-size=", 12) == 0) {
+            opts.mLineSize = strtoul(arg + 12, nullptr, 10);
+        } else if (strncmp(arg, "--fields=", 9) == 0) {
+            opts.mFieldCnt = strtoul(arg + 9, nullptr, 10);
+        } else if (strncmp(arg, "--lines=", 8) == 0) {
+            opts.mLineCntPerGroup = strtoul(arg + 8, nullptr, 10);
+        } else if (strncmp(arg, "--groups=", 9) == 0) {
+            opts.mGroupCnt = strtoul(arg + 9, nullptr, 10);
+        } else if (strncmp(arg, "--config=", 9) == 0) {
+            opts.mConfigPath = arg + 9;
+        } else {
+            printf("unknown argument %s\n", arg);
+            return 1;
+        }
+    }
+    if (opts.mLineCntPerGroup == 0) {
+        printf("--lines should be positive\n");
+        return 1;
+    }
+
+    if (!opts.mShape.empty() && opts.mShape != "json" && opts.mShape != "regex" && opts.mShape != "delimiter") {
+        printf("--shape should be one of json, regex and delimiter\n");
+        return 1;
+    }
+
+    int res = 0;
+    logtail::PipelineBenchmark benchmark(opts);
+    if (!opts.mShape.empty()) {
+        res = benchmark.Run(opts.mShape) ? 0 : 1;
+    } else {
+        for (const char* shape : {"json", "regex", "delimiter"}) {
+            if (!benchmark.Run(shape)) {
+                res = 1;
+            }
+        }
+    }
+    logtail::PluginRegistry::GetInstance()->UnloadPlugins();
+    return res;
+}
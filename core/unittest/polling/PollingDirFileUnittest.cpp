@@ -0,0 +1,130 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "common/Flags.h"
+#include "file_server/FileDiscoveryOptions.h"
+#include "file_server/polling/PollingDirFile.h"
+#include "pipeline/PipelineContext.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_BOOL(polling_dir_shared_scan);
+
+using namespace std;
+
+namespace logtail {
+
+class PollingDirFileUnittest : public ::testing::Test {
+public:
+    void TestSharedListDir();
+    void TestSharedStatPath();
+    void TestSharedScanDisabled();
+
+protected:
+    void SetUp() override {
+        mRootDir = filesystem::temp_directory_path() / "polling_dir_file_unittest";
+        filesystem::remove_all(mRootDir);
+        filesystem::create_directories(mRootDir / "sub");
+        ofstream(mRootDir / "a.log") << "a";
+        ofstream(mRootDir / "b.log") << "b";
+
+        auto polling = PollingDirFile::GetInstance();
+        polling->mRuningFlag = true;
+        polling->mHoldOnFlag = false;
+        polling->ClearCache();
+        mConfig = make_pair(&mOpts, &mCtx);
+    }
+
+    void TearDown() override {
+        BOOL_FLAG(polling_dir_shared_scan) = true;
+        PollingDirFile::GetInstance()->ClearCache();
+        PollingDirFile::GetInstance()->mRuningFlag = false;
+        filesystem::remove_all(mRootDir);
+    }
+
+private:
+    filesystem::path mRootDir;
+    FileDiscoveryOptions mOpts;
+    PipelineContext mCtx;
+    FileDiscoveryConfig mConfig;
+};
+
+void PollingDirFileUnittest::TestSharedListDir() {
+    auto polling = PollingDirFile::GetInstance();
+    auto listing = polling->ListDir(mRootDir.string(), mConfig);
+    APSARA_TEST_TRUE(listing->mOpened);
+    APSARA_TEST_EQUAL(3U, listing->mEntries.size());
+    APSARA_TEST_EQUAL(1, polling->mRoundReaddirCount);
+    APSARA_TEST_EQUAL(3, polling->mStatCount);
+
+    // listing of the same directory is reused in the round
+    APSARA_TEST_EQUAL(listing, polling->ListDir(mRootDir.string(), mConfig));
+    APSARA_TEST_EQUAL(1, polling->mRoundReaddirCount);
+    APSARA_TEST_EQUAL(1, polling->mRoundSharedScanHitCount);
+    APSARA_TEST_EQUAL(3, polling->mStatCount);
+
+    // failure is also reused
+    auto notExisted = polling->ListDir((mRootDir / "not_existed").string(), mConfig);
+    APSARA_TEST_FALSE(notExisted->mOpened);
+    APSARA_TEST_TRUE(fsutil::Dir::IsENOENT(notExisted->mErrno));
+    APSARA_TEST_EQUAL(notExisted, polling->ListDir((mRootDir / "not_existed").string(), mConfig));
+    APSARA_TEST_EQUAL(2, polling->mRoundSharedScanHitCount);
+
+    // next round
+    polling->ClearRoundCache();
+    APSARA_TEST_NOT_EQUAL(listing, polling->ListDir(mRootDir.string(), mConfig));
+    APSARA_TEST_EQUAL(1, polling->mRoundReaddirCount);
+    APSARA_TEST_EQUAL(0, polling->mRoundSharedScanHitCount);
+}
+
+void PollingDirFileUnittest::TestSharedStatPath() {
+    auto polling = PollingDirFile::GetInstance();
+    fsutil::PathStat buf1, buf2;
+    APSARA_TEST_TRUE(polling->StatPath((mRootDir / "a.log").string(), buf1));
+    APSARA_TEST_TRUE(polling->StatPath((mRootDir / "a.log").string(), buf2));
+    APSARA_TEST_TRUE(buf2.IsRegFile());
+    APSARA_TEST_EQUAL(buf1.GetFileSize(), buf2.GetFileSize());
+    APSARA_TEST_TRUE(polling->StatPath((mRootDir / "sub").string(), buf1));
+    APSARA_TEST_TRUE(buf1.IsDir());
+    APSARA_TEST_FALSE(polling->StatPath((mRootDir / "c.log").string(), buf1));
+    APSARA_TEST_FALSE(polling->StatPath((mRootDir / "c.log").string(), buf1));
+    APSARA_TEST_EQUAL(3, polling->mRoundStatCallCount);
+    APSARA_TEST_EQUAL(2, polling->mRoundSharedScanHitCount);
+}
+
+void PollingDirFileUnittest::TestSharedScanDisabled() {
+    BOOL_FLAG(polling_dir_shared_scan) = false;
+    auto polling = PollingDirFile::GetInstance();
+    auto listing = polling->ListDir(mRootDir.string(), mConfig);
+    APSARA_TEST_NOT_EQUAL(listing, polling->ListDir(mRootDir.string(), mConfig));
+    APSARA_TEST_EQUAL(2, polling->mRoundReaddirCount);
+    APSARA_TEST_EQUAL(6, polling->mStatCount);
+
+    fsutil::PathStat buf;
+    APSARA_TEST_TRUE(polling->StatPath((mRootDir / "a.log").string(), buf));
+    APSARA_TEST_TRUE(polling->StatPath((mRootDir / "a.log").string(), buf));
+    APSARA_TEST_EQUAL(2, polling->mRoundStatCallCount);
+    APSARA_TEST_EQUAL(0, polling->mRoundSharedScanHitCount);
+}
+
+UNIT_TEST_CASE(PollingDirFileUnittest, TestSharedListDir)
+UNIT_TEST_CASE(PollingDirFileUnittest, TestSharedStatPath)
+UNIT_TEST_CASE(PollingDirFileUnittest, TestSharedScanDisabled)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
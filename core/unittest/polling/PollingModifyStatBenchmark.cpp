@@ -0,0 +1,164 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <time.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "common/Flags.h"
+#include "common/TimeUtil.h"
+#include "file_server/FileServer.h"
+#include "file_server/event/Event.h"
+#include "file_server/polling/PollingEventQueue.h"
+#include "file_server/polling/PollingModify.h"
+#include "logger/Logger.h"
+#include "monitor/metric_constants/MetricConstants.h"
+#include "monitor/metric_models/ScopedCpuTimer.h"
+
+#ifdef ENABLE_COMPATIBLE_MODE
+extern "C" {
+#include <string.h>
+asm(".symver memcpy, memcpy@GLIBC_2.2.5");
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+    return memcpy(dest, src, n);
+}
+}
+#endif
+
+DECLARE_FLAG_INT32(modify_stat_sleepMs);
+DECLARE_FLAG_INT32(modify_stat_count);
+DECLARE_FLAG_INT32(modify_stat_max_count_per_round);
+DECLARE_FLAG_BOOL(polling_modify_io_uring_enable);
+
+using namespace std;
+
+namespace logtail {
+
+// measures stat syscalls and time taken by modify polling rounds over many files, with files stated one by one or in
+// io_uring batches. Note that the kernel runs statx of io_uring in its worker threads, so cpu time of the whole
+// process is reported besides the polling thread.
+class PollingModifyStatBenchmark {
+public:
+    explicit PollingModifyStatBenchmark(size_t fileCnt) : mFileCnt(fileCnt) {
+        mDir = (filesystem::temp_directory_path() / ("polling_modify_stat_benchmark_" + to_string(getpid()))).string();
+        filesystem::create_directories(mDir);
+        vector<SplitedFilePath> files;
+        for (size_t i = 0; i < mFileCnt; ++i) {
+            string name = to_string(i) + ".log";
+            ofstream(mDir + "/" + name) << "a\n";
+            files.emplace_back(mDir, name);
+        }
+        INT32_FLAG(modify_stat_sleepMs) = 0;
+        INT32_FLAG(modify_stat_max_count_per_round) = mFileCnt;
+        auto polling = PollingModify::GetInstance();
+        polling->mRuningFlag = true;
+        polling->mHoldOnFlag = false;
+        polling->mPollingModifySize = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(
+            METRIC_RUNNER_FILE_POLLING_MODIFY_CACHE_SIZE);
+        polling->mPollingModifyStatCount = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(
+            METRIC_RUNNER_FILE_POLLING_MODIFY_STAT_COUNT);
+        polling->ClearCache();
+        polling->AddNewFile(files);
+    }
+
+    ~PollingModifyStatBenchmark() {
+        PollingModify::GetInstance()->ClearCache();
+        error_code ec;
+        filesystem::remove_all(mDir, ec);
+    }
+
+    void Run(bool ioUring, int32_t batchSize, size_t rounds) {
+        auto polling = PollingModify::GetInstance();
+        BOOL_FLAG(polling_modify_io_uring_enable) = ioUring;
+        INT32_FLAG(modify_stat_count) = batchSize;
+        // the ring is sized by batch size
+        polling->mIoUring.Destroy();
+        polling->mIoUringUnavailable = false;
+        // warm up, which also loads files and drops events of new files
+        RunRound();
+        if (ioUring && !polling->mIoUring.IsInit()) {
+            printf("io_uring is not available\n");
+            return;
+        }
+
+        uint64_t syscallStart = polling->mIoUring.GetSyscallCount();
+        uint64_t threadCpuStart = CpuTimeSampler::GetThreadCpuTimeNs();
+        uint64_t processCpuStart = GetProcessCpuTimeNs();
+        uint64_t starttime = GetCurrentTimeInMicroSeconds();
+        size_t statCount = 0;
+        for (size_t i = 0; i < rounds; ++i) {
+            statCount += RunRound();
+        }
+        uint64_t timeelapsed = max<uint64_t>(GetCurrentTimeInMicroSeconds() - starttime, 1);
+        uint64_t threadCpu = CpuTimeSampler::GetThreadCpuTimeNs() - threadCpuStart;
+        uint64_t processCpu = GetProcessCpuTimeNs() - processCpuStart;
+        uint64_t syscalls = ioUring ? polling->mIoUring.GetSyscallCount() - syscallStart : statCount;
+        printf("%s, batch %d: %lu files stated in %lums, %lu syscalls, %.0f files/s, cpu per file %.0fns on polling "
+               "thread, %.0fns in total\n",
+               ioUring ? "io_uring" : "stat",
+               batchSize,
+               statCount,
+               timeelapsed / 1000,
+               syscalls,
+               statCount * 1000000.0 / timeelapsed,
+               threadCpu * 1.0 / max<size_t>(statCount, 1),
+               processCpu * 1.0 / max<size_t>(statCount, 1));
+    }
+
+private:
+    size_t RunRound() {
+        auto polling = PollingModify::GetInstance();
+        for (auto& item : polling->mModifyCacheMap) {
+            polling->ScheduleCheck(&item, 0);
+        }
+        polling->PollingIteration();
+        vector<Event*> events;
+        PollingEventQueue::GetInstance()->PopAllEvents(events);
+        for (auto ev : events) {
+            delete ev;
+        }
+        return polling->mRoundStatCount;
+    }
+
+    static uint64_t GetProcessCpuTimeNs() {
+        timespec ts;
+        if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0) {
+            return 0;
+        }
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+    }
+
+    size_t mFileCnt;
+    string mDir;
+};
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    size_t fileCnt = argc > 1 ? strtoul(argv[1], nullptr, 10) : 10000;
+    size_t rounds = argc > 2 ? strtoul(argv[2], nullptr, 10) : 20;
+    logtail::Logger::Instance().InitGlobalLoggers();
+    logtail::PollingModifyStatBenchmark benchmark(fileCnt);
+    benchmark.Run(false, 100, rounds);
+    for (int32_t batchSize : {100, 1000}) {
+        benchmark.Run(true, batchSize, rounds);
+    }
+    return 0;
+}
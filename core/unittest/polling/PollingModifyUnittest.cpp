@@ -0,0 +1,238 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sys/stat.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "common/Flags.h"
+#include "file_server/FileServer.h"
+#include "file_server/event/Event.h"
+#include "file_server/polling/PollingEventQueue.h"
+#include "file_server/polling/PollingModify.h"
+#include "monitor/metric_constants/MetricConstants.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(modify_check_interval);
+DECLARE_FLAG_INT32(modify_check_min_interval);
+DECLARE_FLAG_INT32(modify_check_max_interval);
+DECLARE_FLAG_INT32(modify_stat_max_count_per_round);
+DECLARE_FLAG_BOOL(polling_modify_io_uring_enable);
+
+using namespace std;
+
+namespace logtail {
+
+class PollingModifyUnittest : public ::testing::Test {
+public:
+    void TestUpdateCheckInterval();
+    void TestAdaptiveSchedule();
+    void TestStatLimit();
+    void TestDeleteFile();
+    void TestIoUringStat();
+
+protected:
+    void SetUp() override {
+        mRootDir = filesystem::temp_directory_path() / "polling_modify_unittest";
+        filesystem::remove_all(mRootDir);
+        filesystem::create_directories(mRootDir);
+        ofstream(mRootDir / "hot.log") << "a\n";
+        ofstream(mRootDir / "cold.log") << "a\n";
+        // too old to be collected
+        filesystem::last_write_time(mRootDir / "cold.log",
+                                    filesystem::file_time_type::clock::now() - chrono::hours(1));
+
+        INT32_FLAG(modify_check_interval) = 400;
+        INT32_FLAG(modify_check_min_interval) = 100;
+        INT32_FLAG(modify_check_max_interval) = 1600;
+        auto polling = PollingModify::GetInstance();
+        polling->mRuningFlag = true;
+        polling->mHoldOnFlag = false;
+        polling->mPollingModifySize = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(
+            METRIC_RUNNER_FILE_POLLING_MODIFY_CACHE_SIZE);
+        polling->mPollingModifyStatCount = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(
+            METRIC_RUNNER_FILE_POLLING_MODIFY_STAT_COUNT);
+        polling->ClearCache();
+        polling->AddNewFile({SplitedFilePath(mRootDir.string(), "hot.log"),
+                             SplitedFilePath(mRootDir.string(), "cold.log")});
+    }
+
+    void TearDown() override {
+        INT32_FLAG(modify_check_interval) = 1000;
+        INT32_FLAG(modify_check_min_interval) = 250;
+        INT32_FLAG(modify_check_max_interval) = 0;
+        INT32_FLAG(modify_stat_max_count_per_round) = 10000;
+        BOOL_FLAG(polling_modify_io_uring_enable) = false;
+        PollingModify::GetInstance()->ClearCache();
+        PollingModify::GetInstance()->mRuningFlag = false;
+        vector<Event*> events;
+        PollingEventQueue::GetInstance()->PopAllEvents(events);
+        for (auto ev : events) {
+            delete ev;
+        }
+        filesystem::remove_all(mRootDir);
+    }
+
+private:
+    ModifyCheckCache& GetCache(const string& fileName) {
+        return PollingModify::GetInstance()->mModifyCacheMap[SplitedFilePath(mRootDir.string(), fileName)];
+    }
+
+    // makes all files due now
+    void MakeAllDue() {
+        auto polling = PollingModify::GetInstance();
+        for (auto& item : polling->mModifyCacheMap) {
+            polling->ScheduleCheck(&item, 0);
+        }
+    }
+
+    filesystem::path mRootDir;
+};
+
+void PollingModifyUnittest::TestUpdateCheckInterval() {
+    ModifyCheckCache cache;
+    cache.mCheckInterval = 1000;
+    cache.UpdateCheckInterval(true, 250, 8000);
+    APSARA_TEST_EQUAL(500, cache.mCheckInterval);
+    cache.UpdateCheckInterval(true, 250, 8000);
+    cache.UpdateCheckInterval(true, 250, 8000);
+    APSARA_TEST_EQUAL(250, cache.mCheckInterval);
+    for (int i = 0; i < 10; ++i) {
+        cache.UpdateCheckInterval(false, 250, 8000);
+    }
+    APSARA_TEST_EQUAL(8000, cache.mCheckInterval);
+
+    // fixed interval
+    cache.UpdateCheckInterval(true, 1000, 1000);
+    APSARA_TEST_EQUAL(1000, cache.mCheckInterval);
+    cache.UpdateCheckInterval(false, 1000, 1000);
+    APSARA_TEST_EQUAL(1000, cache.mCheckInterval);
+}
+
+void PollingModifyUnittest::TestAdaptiveSchedule() {
+    auto polling = PollingModify::GetInstance();
+    polling->PollingIteration();
+    APSARA_TEST_EQUAL(2, polling->mRoundStatCount);
+    APSARA_TEST_EQUAL(2U, polling->mCheckSchedule.size());
+    // the hot file is collected and checked more often, while the cold one less often
+    APSARA_TEST_EQUAL(200, GetCache("hot.log").mCheckInterval);
+    APSARA_TEST_EQUAL(800, GetCache("cold.log").mCheckInterval);
+    APSARA_TEST_EQUAL("hot.log", polling->mCheckSchedule.begin()->second->first.mFileName);
+    APSARA_TEST_TRUE(polling->mWaitTime >= 100 && polling->mWaitTime <= 200);
+    vector<Event*> events;
+    PollingEventQueue::GetInstance()->PopAllEvents(events);
+    APSARA_TEST_EQUAL(1U, events.size());
+    for (auto ev : events) {
+        APSARA_TEST_EQUAL("hot.log", ev->GetObject());
+        delete ev;
+    }
+
+    // nothing is due yet
+    polling->PollingIteration();
+    APSARA_TEST_EQUAL(0, polling->mRoundStatCount);
+
+    // files not modified back off
+    MakeAllDue();
+    polling->PollingIteration();
+    APSARA_TEST_EQUAL(2, polling->mRoundStatCount);
+    APSARA_TEST_EQUAL(400, GetCache("hot.log").mCheckInterval);
+    APSARA_TEST_EQUAL(1600, GetCache("cold.log").mCheckInterval);
+
+    ofstream(mRootDir / "hot.log", ios::app) << "b\n";
+    MakeAllDue();
+    polling->PollingIteration();
+    APSARA_TEST_EQUAL(200, GetCache("hot.log").mCheckInterval);
+    APSARA_TEST_EQUAL(1600, GetCache("cold.log").mCheckInterval);
+    APSARA_TEST_TRUE(GetCache("hot.log").mNextCheckTime < GetCache("cold.log").mNextCheckTime);
+}
+
+void PollingModifyUnittest::TestStatLimit() {
+    auto polling = PollingModify::GetInstance();
+    INT32_FLAG(modify_stat_max_count_per_round) = 1;
+    polling->PollingIteration();
+    APSARA_TEST_EQUAL(1, polling->mRoundStatCount);
+    // the rest is checked as soon as possible
+    APSARA_TEST_EQUAL(100, polling->mWaitTime);
+    polling->PollingIteration();
+    APSARA_TEST_EQUAL(1, polling->mRoundStatCount);
+    polling->PollingIteration();
+    APSARA_TEST_EQUAL(0, polling->mRoundStatCount);
+}
+
+void PollingModifyUnittest::TestDeleteFile() {
+    auto polling = PollingModify::GetInstance();
+    polling->PollingIteration();
+    polling->AddDeleteFile({SplitedFilePath(mRootDir.string(), "cold.log")});
+    polling->PollingIteration();
+    APSARA_TEST_EQUAL(1U, polling->mModifyCacheMap.size());
+    APSARA_TEST_EQUAL(1U, polling->mCheckSchedule.size());
+
+    // removed after failing to stat for max_file_not_exist_times
+    filesystem::remove(mRootDir / "hot.log");
+    for (int i = 0; i < 9; ++i) {
+        MakeAllDue();
+        polling->PollingIteration();
+        // missing files are checked at the normal interval
+        APSARA_TEST_EQUAL(400, GetCache("hot.log").mCheckInterval);
+    }
+    MakeAllDue();
+    polling->PollingIteration();
+    APSARA_TEST_TRUE(polling->mModifyCacheMap.empty());
+    APSARA_TEST_TRUE(polling->mCheckSchedule.empty());
+    vector<Event*> events;
+    PollingEventQueue::GetInstance()->PopAllEvents(events);
+    bool deleted = false;
+    for (auto ev : events) {
+        deleted |= ev->IsDeleted() && ev->GetObject() == "hot.log";
+        delete ev;
+    }
+    APSARA_TEST_TRUE(deleted);
+}
+
+void PollingModifyUnittest::TestIoUringStat() {
+    auto polling = PollingModify::GetInstance();
+    BOOL_FLAG(polling_modify_io_uring_enable) = true;
+    polling->AddNewFile({SplitedFilePath(mRootDir.string(), "missing.log")});
+    polling->PollingIteration();
+    // results are the same whether io_uring is available or not
+    APSARA_TEST_EQUAL(3, polling->mRoundStatCount);
+    APSARA_TEST_EQUAL(200, GetCache("hot.log").mCheckInterval);
+    APSARA_TEST_EQUAL(800, GetCache("cold.log").mCheckInterval);
+    APSARA_TEST_EQUAL(400, GetCache("missing.log").mCheckInterval);
+    APSARA_TEST_EQUAL(1, GetCache("missing.log").mNotExistTimes);
+    struct stat buf;
+    APSARA_TEST_EQUAL(0, stat((mRootDir / "hot.log").c_str(), &buf));
+    APSARA_TEST_EQUAL((uint64_t)buf.st_ino, GetCache("hot.log").mInode);
+    APSARA_TEST_EQUAL(buf.st_mtim.tv_nsec, GetCache("hot.log").mModifyTime.tv_nsec);
+
+    BOOL_FLAG(polling_modify_io_uring_enable) = false;
+    MakeAllDue();
+    polling->PollingIteration();
+    APSARA_TEST_FALSE(polling->mIoUring.IsInit());
+    APSARA_TEST_EQUAL(3, polling->mRoundStatCount);
+}
+
+UNIT_TEST_CASE(PollingModifyUnittest, TestUpdateCheckInterval)
+UNIT_TEST_CASE(PollingModifyUnittest, TestAdaptiveSchedule)
+UNIT_TEST_CASE(PollingModifyUnittest, TestStatLimit)
+UNIT_TEST_CASE(PollingModifyUnittest, TestDeleteFile)
+UNIT_TEST_CASE(PollingModifyUnittest, TestIoUringStat)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,100 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "common/CompiledTimeFormat.h"
+#include "common/TimeUtil.h"
+
+#ifdef ENABLE_COMPATIBLE_MODE
+extern "C" {
+#include <string.h>
+asm(".symver memcpy, memcpy@GLIBC_2.2.5");
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+    return memcpy(dest, src, n);
+}
+}
+#endif
+
+using namespace std;
+using namespace logtail;
+
+// parses log time of common formats with Strptime and CompiledTimeFormat. Each log is one second after the previous
+// one, so that the second-level cache of ProcessorParseTimestampNative would miss on every log.
+static void BM_ParseTime(const string& format, int count) {
+    string printFormat = format;
+    size_t pos = printFormat.find("%f");
+    if (pos != string::npos) {
+        printFormat.replace(pos, 2, "123456");
+    }
+    vector<string> logs;
+    time_t base = 1700000000;
+    char buf[64];
+    for (int i = 0; i < count; ++i) {
+        time_t t = base + i;
+        struct tm tm;
+        localtime_r(&t, &tm);
+        logs.emplace_back(buf, strftime(buf, sizeof(buf), printFormat.c_str(), &tm));
+    }
+
+    vector<LogtailTime> expected(count);
+    int nanosecondLength = 0;
+    uint64_t start = GetCurrentTimeInNanoSeconds();
+    for (int i = 0; i < count; ++i) {
+        Strptime(logs[i].c_str(), format.c_str(), &expected[i], nanosecondLength);
+    }
+    uint64_t strptimeCost = GetCurrentTimeInNanoSeconds() - start;
+
+    CompiledTimeFormat compiled(format);
+    vector<LogtailTime> actual(count);
+    start = GetCurrentTimeInNanoSeconds();
+    for (int i = 0; i < count; ++i) {
+        compiled.Parse(logs[i].data(), logs[i].size(), &actual[i], nanosecondLength);
+    }
+    uint64_t compiledCost = GetCurrentTimeInNanoSeconds() - start;
+
+    int mismatch = 0;
+    for (int i = 0; i < count; ++i) {
+        if (expected[i].tv_sec != actual[i].tv_sec || expected[i].tv_nsec != actual[i].tv_nsec
+            || expected[i].tv_sec != base + i) {
+            ++mismatch;
+        }
+    }
+    printf("%-26s %-32s compiled: %-3s strptime: %6.1f ns, compiled: %6.1f ns, mismatch: %d\n",
+           format.c_str(),
+           logs[0].c_str(),
+           compiled.IsCompiled() ? "yes" : "no",
+           static_cast<double>(strptimeCost) / count,
+           static_cast<double>(compiledCost) / count,
+           mismatch);
+}
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? atoi(argv[1]) : 1000000;
+    for (const auto& format : {"%Y-%m-%d %H:%M:%S",
+                               "%Y-%m-%d %H:%M:%S.%f",
+                               "%Y-%m-%dT%H:%M:%S.%fZ",
+                               "[%Y-%m-%d %H:%M:%S.%f]",
+                               "%Y/%m/%d %H:%M:%S",
+                               "%d/%m/%Y:%H:%M:%S",
+                               "%Y%m%d%H%M%S",
+                               "%d %b %Y %H:%M:%S"}) {
+        BM_ParseTime(format, count);
+    }
+    return 0;
+}
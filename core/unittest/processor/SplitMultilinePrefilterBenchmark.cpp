@@ -0,0 +1,135 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include "common/RegexPrefilter.h"
+#include "common/TimeUtil.h"
+#include "constants/Constants.h"
+#include "logger/Logger.h"
+#include "models/PipelineEventGroup.h"
+#include "pipeline/PipelineContext.h"
+#include "plugin/processor/inner/ProcessorSplitMultilineLogStringNative.h"
+
+#ifdef ENABLE_COMPATIBLE_MODE
+extern "C" {
+#include <string.h>
+asm(".symver memcpy, memcpy@GLIBC_2.2.5");
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+    return memcpy(dest, src, n);
+}
+}
+#endif
+
+using namespace std;
+
+namespace logtail {
+
+// measures splitting stack trace heavy logs, where most lines are continuation lines that can not match the start
+// pattern. Each block is split with and without the pattern prefilters, and the fraction of pattern checks answered
+// by the prefilters is printed.
+class SplitMultilinePrefilterBenchmark {
+public:
+    SplitMultilinePrefilterBenchmark(const string& startPattern, const string& continuePattern)
+        : mStartPattern(startPattern) {
+        mCtx.SetConfigName("project##config_0");
+        Json::Value config;
+        config["StartPattern"] = startPattern;
+        if (!continuePattern.empty()) {
+            config["ContinuePattern"] = continuePattern;
+        }
+        config["UnmatchedContentTreatment"] = "single_line";
+        Init(mFiltered, config);
+        Init(mUnfiltered, config);
+        mUnfiltered.mMultiline.mStartPatternFilter = RegexPrefilter();
+        mUnfiltered.mMultiline.mContinuePatternFilter = RegexPrefilter();
+
+        string trace = "2024-04-07 08:02:40.873 ERROR [main] request failed\n"
+                       "java.lang.NullPointerException: null\n";
+        for (int i = 0; i < 30; ++i) {
+            trace += "    at com.example.myproject.Book.getTitle(Book.java:" + to_string(i) + ")\n";
+        }
+        trace += "    ... 23 more\n";
+        while (mBlock.size() < 512 * 1024) {
+            mBlock += "2024-04-07 08:02:40.873 INFO [main] request done\n";
+            mBlock += trace;
+        }
+        mBlock.pop_back();
+    }
+
+    void Run(int rounds) {
+        int64_t filtered = Time(mFiltered, rounds);
+        int64_t unfiltered = Time(mUnfiltered, rounds);
+        uint64_t checks = mFiltered.mPatternChecksTotal->GetValue();
+        uint64_t prefiltered = mFiltered.mPrefilteredPatternChecksTotal->GetValue();
+        printf("start pattern %s: %zu bytes\n", mStartPattern.c_str(), mBlock.size());
+        printf("  prefiltered: %lu of %lu pattern checks (%.1f%%)\n",
+               prefiltered,
+               checks,
+               checks > 0 ? 100.0 * prefiltered / checks : 0.0);
+        printf("  regex only:      %10.1f MB/s\n", Throughput(rounds, unfiltered));
+        printf("  with prefilters: %10.1f MB/s\n", Throughput(rounds, filtered));
+    }
+
+private:
+    void Init(ProcessorSplitMultilineLogStringNative& processor, const Json::Value& config) {
+        processor.SetContext(mCtx);
+        processor.SetMetricsRecordRef(ProcessorSplitMultilineLogStringNative::sName, "1");
+        if (!processor.Init(config)) {
+            printf("failed to init processor with start pattern %s\n", mStartPattern.c_str());
+            exit(1);
+        }
+    }
+
+    int64_t Time(ProcessorSplitMultilineLogStringNative& processor, int rounds) {
+        int64_t duration = 0;
+        for (int i = 0; i < rounds; ++i) {
+            PipelineEventGroup group(make_shared<SourceBuffer>());
+            StringBuffer content = group.GetSourceBuffer()->CopyString(mBlock);
+            auto e = group.AddLogEvent();
+            e->SetContentNoCopy(StringView(DEFAULT_CONTENT_KEY), StringView(content.data, content.size));
+            e->SetTimestamp(time(nullptr));
+            int64_t start = GetCurrentTimeInMicroSeconds();
+            processor.Process(group);
+            duration += GetCurrentTimeInMicroSeconds() - start;
+        }
+        return duration;
+    }
+
+    double Throughput(int rounds, int64_t durationUs) const {
+        return static_cast<double>(mBlock.size()) * rounds / (durationUs > 0 ? durationUs : 1);
+    }
+
+    string mStartPattern;
+    string mBlock;
+    PipelineContext mCtx;
+    ProcessorSplitMultilineLogStringNative mFiltered;
+    ProcessorSplitMultilineLogStringNative mUnfiltered;
+};
+
+} // namespace logtail
+
+using namespace logtail;
+
+int main(int argc, char** argv) {
+    Logger::Instance().InitGlobalLoggers();
+    int rounds = argc > 1 ? atoi(argv[1]) : 20;
+    SplitMultilinePrefilterBenchmark(R"(\d{4}-\d{2}-\d{2}.*)", "").Run(rounds);
+    SplitMultilinePrefilterBenchmark(R"(\[\d+-\d+-\d+.*)", "").Run(rounds);
+    SplitMultilinePrefilterBenchmark(R"(\d{4}-\d{2}-\d{2}.*)", R"(\s+at\s.*)").Run(rounds);
+    return 0;
+}
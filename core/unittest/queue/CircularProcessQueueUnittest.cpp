@@ -137,12 +137,14 @@ void CircularProcessQueueUnittest::TestReset() {
         auto item1 = GenerateItem(2);
         auto item2 = GenerateItem(1);
         auto p2 = item2.get();
+        auto dataSize2 = item2->mEventGroup.DataSize();
 
         mQueue->Push(std::move(item1));
         mQueue->Push(std::move(item2));
         mQueue->Reset(2);
         APSARA_TEST_EQUAL(2U, mQueue->mCapacity);
         APSARA_TEST_EQUAL(1U, mQueue->Size());
+        APSARA_TEST_EQUAL(dataSize2, mQueue->mQueueDataSizeByte->GetValue());
         APSARA_TEST_TRUE(mQueue->mDownStreamQueues.empty());
         mQueue->Pop(res);
         APSARA_TEST_EQUAL(p2, res.get());
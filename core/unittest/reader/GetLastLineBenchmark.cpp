@@ -0,0 +1,176 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/TimeUtil.h"
+#include "file_server/reader/LogFileReader.h"
+#include "logger/Logger.h"
+
+#ifdef ENABLE_COMPATIBLE_MODE
+extern "C" {
+#include <string.h>
+asm(".symver memcpy, memcpy@GLIBC_2.2.5");
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+    return memcpy(dest, src, n);
+}
+}
+#endif
+
+using namespace std;
+
+namespace logtail {
+
+// measures backward line searches over a read buffer of raw text, containerd text and docker json lines, which are
+// the formats covered by GetLastLineDataUnittest. The buffer is walked from the end to the beginning line by line,
+// and rolled back with a start pattern matching only the first line, which is the worst case of rollback.
+class GetLastLineBenchmark {
+public:
+    enum class Format { RAW, CONTAINERD_TEXT, DOCKER_JSON };
+
+    GetLastLineBenchmark(Format format, const string& name) : mName(name) {
+        Json::Value config;
+        config["StartPattern"] = R"(Exception.*)";
+        mMultilineOpts.Init(config, mCtx, "");
+        mReader.reset(new LogFileReader(
+            "dir", "file", DevInode(), make_pair(&mReaderOpts, &mCtx), make_pair(&mMultilineOpts, &mCtx)));
+        switch (format) {
+            case Format::CONTAINERD_TEXT:
+                mReader->mLineParsers.emplace_back(
+                    mReader->GetParser<ContainerdTextParser>(LogFileReader::BUFFER_SIZE));
+                break;
+            case Format::DOCKER_JSON:
+                mReader->mLineParsers.emplace_back(mReader->GetParser<DockerJsonFileParser>(0));
+                break;
+            default:
+                break;
+        }
+        mBuffer = Line(format, "Exception in thread \"main\" java.lang.NullPointerException", false);
+        while (mBuffer.size() < LogFileReader::BUFFER_SIZE) {
+            mBuffer += Line(format, "    at com.example.myproject.Book.getTitle(Book.java:16)", false);
+            mBuffer += Line(format, "    at com.example.myproject.Author.getBook", true);
+            mBuffer += Line(format, "Author.java:25)", false);
+        }
+    }
+
+    void Run(int rounds) {
+        RawTextParser* rawParser = static_cast<RawTextParser*>(mReader->mLineParsers[0]);
+        StringView buffer(mBuffer.data(), mBuffer.size());
+        size_t lines = 0;
+        int64_t start = GetCurrentTimeInMicroSeconds();
+        for (int i = 0; i < rounds; ++i) {
+            lines = WalkLines(buffer);
+        }
+        int64_t uncached = GetCurrentTimeInMicroSeconds() - start;
+
+        start = GetCurrentTimeInMicroSeconds();
+        for (int i = 0; i < rounds; ++i) {
+            rawParser->EnableBoundaryCache(buffer);
+            WalkLines(buffer);
+            rawParser->DisableBoundaryCache();
+        }
+        int64_t cached = GetCurrentTimeInMicroSeconds() - start;
+
+        int32_t rollbackLineFeedCount = 0;
+        int32_t left = 0;
+        start = GetCurrentTimeInMicroSeconds();
+        for (int i = 0; i < rounds; ++i) {
+            left = mReader->RemoveLastIncompleteLog(
+                const_cast<char*>(mBuffer.data()), mBuffer.size(), rollbackLineFeedCount);
+        }
+        int64_t rollback = GetCurrentTimeInMicroSeconds() - start;
+
+        printf("%s: %zu bytes, %zu lines, rollback kept %d bytes\n", mName.c_str(), mBuffer.size(), lines, left);
+        printf("  walk lines:            %10.1f MB/s\n", Throughput(rounds, uncached));
+        printf("  walk lines with cache: %10.1f MB/s\n", Throughput(rounds, cached));
+        printf("  rollback:              %10.1f MB/s\n", Throughput(rounds, rollback));
+    }
+
+    // the byte by byte backward search used before, for reference
+    static void RunLegacy(const string& buffer, int rounds) {
+        size_t lines = 0;
+        int64_t start = GetCurrentTimeInMicroSeconds();
+        for (int i = 0; i < rounds; ++i) {
+            lines = 0;
+            for (int32_t end = buffer.size() - 1; end > 0; ++lines) {
+                int32_t begin = end;
+                while (begin > 0 && buffer[begin - 1] != '\n') {
+                    --begin;
+                }
+                end = begin - 1;
+            }
+        }
+        int64_t duration = GetCurrentTimeInMicroSeconds() - start;
+        printf("byte by byte search: %zu lines, %10.1f MB/s\n",
+               lines,
+               static_cast<double>(buffer.size()) * rounds / (duration > 0 ? duration : 1));
+    }
+
+    const string& GetBuffer() const { return mBuffer; }
+
+private:
+    static string Line(Format format, const string& content, bool partial) {
+        switch (format) {
+            case Format::CONTAINERD_TEXT:
+                return "2021-08-25T07:00:00.000000000Z stdout " + string(partial ? "P " : "F ") + content + "\n";
+            case Format::DOCKER_JSON:
+                return R"({"log":")" + content + (partial ? "" : R"(\n)")
+                    + R"(","stream":"stdout","time":"2024-02-19T03:49:37.793533014Z"})" + "\n";
+            default:
+                return content + (partial ? "" : "\n");
+        }
+    }
+
+    size_t WalkLines(StringView buffer) {
+        size_t lines = 0;
+        int32_t end = buffer.size() - 1;
+        while (end > 0) {
+            LineInfo line = mReader->GetLastLine(buffer, end, false);
+            end = line.lineBegin - 1;
+            ++lines;
+        }
+        return lines;
+    }
+
+    double Throughput(int rounds, int64_t durationUs) const {
+        return static_cast<double>(mBuffer.size()) * rounds / (durationUs > 0 ? durationUs : 1);
+    }
+
+    string mName;
+    string mBuffer;
+    FileReaderOptions mReaderOpts;
+    MultilineOptions mMultilineOpts;
+    PipelineContext mCtx;
+    unique_ptr<LogFileReader> mReader;
+};
+
+} // namespace logtail
+
+using namespace logtail;
+
+int main(int argc, char** argv) {
+    Logger::Instance().InitGlobalLoggers();
+    int rounds = argc > 1 ? atoi(argv[1]) : 20;
+    GetLastLineBenchmark raw(GetLastLineBenchmark::Format::RAW, "raw text");
+    GetLastLineBenchmark::RunLegacy(raw.GetBuffer(), rounds);
+    raw.Run(rounds);
+    GetLastLineBenchmark containerd(GetLastLineBenchmark::Format::CONTAINERD_TEXT, "containerd text");
+    containerd.Run(rounds);
+    GetLastLineBenchmark docker(GetLastLineBenchmark::Format::DOCKER_JSON, "docker json");
+    docker.Run(rounds);
+    return 0;
+}
@@ -58,6 +58,20 @@ void ConditionUnittest::TestInit() {
         APSARA_TEST_TRUE(cond.Init(configJson, ctx));
         APSARA_TEST_EQUAL(Condition::Type::TAG, cond.mType);
     }
+    {
+        configStr = R"(
+            {
+                "Type": "content",
+                "Key": "level",
+                "Value": "ERROR"
+            }
+        )";
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+        Condition cond;
+        APSARA_TEST_TRUE(cond.Init(configJson, ctx));
+        APSARA_TEST_EQUAL(Condition::Type::CONTENT, cond.mType);
+        APSARA_TEST_TRUE(cond.IsEventLevel());
+    }
     {
         configStr = R"(
             {
@@ -440,6 +454,159 @@ UNIT_TEST_CASE(TagConditionUnittest, TestInit)
 UNIT_TEST_CASE(TagConditionUnittest, TestCheck)
 UNIT_TEST_CASE(TagConditionUnittest, TestDiscardTag)
 
+class ContentConditionUnittest : public testing::Test {
+public:
+    void TestInit();
+    void TestCheck();
+
+private:
+    PipelineContext ctx;
+};
+
+void ContentConditionUnittest::TestInit() {
+    Json::Value configJson;
+    string configStr, errorMsg;
+    {
+        configStr = R"(
+            {
+                "Key": "level",
+                "Value": "ERROR"
+            }
+        )";
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+        ContentCondition cond;
+        APSARA_TEST_TRUE(cond.Init(configJson, ctx));
+        APSARA_TEST_EQUAL("level", cond.mKey);
+        APSARA_TEST_EQUAL("ERROR", cond.mValue);
+        APSARA_TEST_EQUAL(ContentCondition::Operator::EQUALS, cond.mOperator);
+    }
+    {
+        configStr = R"(
+            {
+                "Key": "tenant",
+                "Value": "team_a",
+                "Operator": "prefix"
+            }
+        )";
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+        ContentCondition cond;
+        APSARA_TEST_TRUE(cond.Init(configJson, ctx));
+        APSARA_TEST_EQUAL(ContentCondition::Operator::PREFIX, cond.mOperator);
+    }
+    {
+        configStr = R"(
+            {
+                "Key": "level",
+                "Value": "ERROR|FATAL",
+                "Operator": "regex"
+            }
+        )";
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+        ContentCondition cond;
+        APSARA_TEST_TRUE(cond.Init(configJson, ctx));
+        APSARA_TEST_EQUAL(ContentCondition::Operator::REGEX, cond.mOperator);
+    }
+    {
+        configStr = R"(
+            {
+                "Key": "level",
+                "Value": "(ERROR",
+                "Operator": "regex"
+            }
+        )";
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+        ContentCondition cond;
+        APSARA_TEST_FALSE(cond.Init(configJson, ctx));
+    }
+    {
+        configStr = R"(
+            {
+                "Key": "level",
+                "Value": "ERROR",
+                "Operator": "unknown"
+            }
+        )";
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+        ContentCondition cond;
+        APSARA_TEST_FALSE(cond.Init(configJson, ctx));
+    }
+    {
+        configStr = R"(
+            {
+                "Value": "ERROR"
+            }
+        )";
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+        ContentCondition cond;
+        APSARA_TEST_FALSE(cond.Init(configJson, ctx));
+    }
+}
+
+void ContentConditionUnittest::TestCheck() {
+    PipelineEventGroup g(make_shared<SourceBuffer>());
+    auto e1 = g.AddLogEvent();
+    e1->SetContent(string("level"), string("ERROR"));
+    auto e2 = g.AddLogEvent();
+    e2->SetContent(string("level"), string("ERROR_FATAL"));
+    auto e3 = g.AddLogEvent();
+    e3->SetContent(string("unknown"), string("ERROR"));
+    g.AddMetricEvent();
+    const auto& events = g.GetEvents();
+
+    Json::Value configJson;
+    string configStr, errorMsg;
+    {
+        configStr = R"(
+            {
+                "Key": "level",
+                "Value": "ERROR"
+            }
+        )";
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+        ContentCondition cond;
+        APSARA_TEST_TRUE(cond.Init(configJson, ctx));
+        APSARA_TEST_TRUE(cond.Check(events[0]));
+        APSARA_TEST_FALSE(cond.Check(events[1]));
+        APSARA_TEST_FALSE(cond.Check(events[2]));
+        APSARA_TEST_FALSE(cond.Check(events[3]));
+    }
+    {
+        configStr = R"(
+            {
+                "Key": "level",
+                "Value": "ERROR",
+                "Operator": "prefix"
+            }
+        )";
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+        ContentCondition cond;
+        APSARA_TEST_TRUE(cond.Init(configJson, ctx));
+        APSARA_TEST_TRUE(cond.Check(events[0]));
+        APSARA_TEST_TRUE(cond.Check(events[1]));
+        APSARA_TEST_FALSE(cond.Check(events[2]));
+        APSARA_TEST_FALSE(cond.Check(events[3]));
+    }
+    {
+        configStr = R"(
+            {
+                "Key": "level",
+                "Value": ".*FATAL",
+                "Operator": "regex"
+            }
+        )";
+        APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+        ContentCondition cond;
+        APSARA_TEST_TRUE(cond.Init(configJson, ctx));
+        APSARA_TEST_FALSE(cond.Check(events[0]));
+        APSARA_TEST_TRUE(cond.Check(events[1]));
+        APSARA_TEST_FALSE(cond.Check(events[2]));
+        APSARA_TEST_FALSE(cond.Check(events[3]));
+    }
+}
+
+UNIT_TEST_CASE(ContentConditionUnittest, TestInit)
+UNIT_TEST_CASE(ContentConditionUnittest, TestCheck)
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
@@ -0,0 +1,160 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/JsonUtil.h"
+#include "common/TimeUtil.h"
+#include "models/PipelineEventGroup.h"
+#include "pipeline/route/Router.h"
+
+#ifdef ENABLE_COMPATIBLE_MODE
+extern "C" {
+#include <string.h>
+asm(".symver memcpy, memcpy@GLIBC_2.2.5");
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+    return memcpy(dest, src, n);
+}
+}
+#endif
+
+using namespace std;
+
+namespace logtail {
+
+static const size_t kGroupCnt = 200;
+static const size_t kEventCnt = 1000;
+static const size_t kContentCnt = 10;
+
+class RouterBenchmark {
+public:
+    // routes each group to n flushers, as Router did before events could be shared
+    void TestRouteByCopy(size_t n);
+    void TestRouteByShare(size_t n);
+    // partitions events by content conditions of the given operator
+    void TestPartitionByContent(const std::string& op, const std::string& value);
+
+private:
+    vector<PipelineEventGroup> GenerateGroups() {
+        vector<PipelineEventGroup> groups;
+        groups.reserve(kGroupCnt);
+        for (size_t i = 0; i < kGroupCnt; ++i) {
+            groups.emplace_back(make_shared<SourceBuffer>());
+            auto& g = groups.back();
+            g.SetTag(string("__hostname__"), string("benchmark"));
+            for (size_t j = 0; j < kEventCnt; ++j) {
+                auto e = g.AddLogEvent();
+                e->SetTimestamp(1234567890);
+                for (size_t k = 0; k < kContentCnt; ++k) {
+                    e->SetContent("key_" + to_string(k), string(50, 'a' + k));
+                }
+                e->SetContent(string("level"), string(j % 10 == 0 ? "ERROR" : "INFO"));
+                e->SetContent(string("tenant"), "team_" + to_string(j % 4));
+            }
+        }
+        return groups;
+    }
+};
+
+void RouterBenchmark::TestRouteByCopy(size_t n) {
+    auto groups = GenerateGroups();
+    size_t eventCnt = 0;
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (auto& g : groups) {
+        vector<PipelineEventGroup> res;
+        res.reserve(n);
+        for (size_t i = 0; i + 1 < n; ++i) {
+            res.emplace_back(g.Copy());
+        }
+        res.emplace_back(std::move(g));
+        for (const auto& item : res) {
+            eventCnt += item.GetEvents().size();
+        }
+    }
+    uint64_t timeelapsed = GetCurrentTimeInMilliSeconds() - starttime;
+    printf("%s 1->%zu: %zu events routed, costs %lums\n", __func__, n, eventCnt, timeelapsed);
+}
+
+void RouterBenchmark::TestRouteByShare(size_t n) {
+    PipelineContext ctx;
+    ctx.SetConfigName("router_benchmark");
+    vector<pair<size_t, const Json::Value*>> configs;
+    for (size_t i = 0; i < n; ++i) {
+        configs.emplace_back(i, nullptr);
+    }
+    Router router;
+    router.Init(configs, ctx);
+
+    auto groups = GenerateGroups();
+    size_t eventCnt = 0;
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (auto& g : groups) {
+        auto res = router.Route(g);
+        for (const auto& item : res) {
+            eventCnt += item.second.GetEvents().size();
+        }
+    }
+    uint64_t timeelapsed = GetCurrentTimeInMilliSeconds() - starttime;
+    printf("%s 1->%zu: %zu events routed, costs %lums\n", __func__, n, eventCnt, timeelapsed);
+}
+
+void RouterBenchmark::TestPartitionByContent(const string& op, const string& value) {
+    PipelineContext ctx;
+    ctx.SetConfigName("router_benchmark");
+    Json::Value configJson;
+    string errorMsg;
+    ParseJsonTable(R"([{"Type": "content", "Key": "level", "Operator": ")" + op + R"(", "Value": ")" + value
+                       + R"("}, {"Type": "content", "Key": "tenant", "Operator": "prefix", "Value": "team_1"}])",
+                   configJson,
+                   errorMsg);
+    vector<pair<size_t, const Json::Value*>> configs;
+    for (Json::Value::ArrayIndex i = 0; i < configJson.size(); ++i) {
+        configs.emplace_back(i, &configJson[i]);
+    }
+    configs.emplace_back(configJson.size(), nullptr);
+    Router router;
+    if (!router.Init(configs, ctx)) {
+        printf("%s: invalid config\n", __func__);
+        return;
+    }
+
+    auto groups = GenerateGroups();
+    size_t eventCnt = 0;
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (auto& g : groups) {
+        auto res = router.Route(g);
+        for (const auto& item : res) {
+            eventCnt += item.second.GetEvents().size();
+        }
+    }
+    uint64_t timeelapsed = GetCurrentTimeInMilliSeconds() - starttime;
+    printf("%s %s: %zu events routed, costs %lums\n", __func__, op.c_str(), eventCnt, timeelapsed);
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    logtail::RouterBenchmark benchmark;
+    for (size_t n : {2, 4, 8}) {
+        benchmark.TestRouteByCopy(n);
+        benchmark.TestRouteByShare(n);
+    }
+    benchmark.TestPartitionByContent("equals", "ERROR");
+    benchmark.TestPartitionByContent("prefix", "ERR");
+    benchmark.TestPartitionByContent("regex", "ERR.*");
+    return 0;
+}
@@ -26,6 +26,7 @@ class RouterUnittest : public testing::Test {
 public:
     void TestInit();
     void TestRoute();
+    void TestRouteByContent();
     void TestMetric();
 
 protected:
@@ -148,6 +149,94 @@ void RouterUnittest::TestRoute() {
     }
 }
 
+void RouterUnittest::TestRouteByContent() {
+    Json::Value configJson;
+    string errorMsg;
+    string configStr = R"(
+        [
+            {
+                "Type": "content",
+                "Key": "level",
+                "Value": "ERROR"
+            },
+            {
+                "Type": "content",
+                "Key": "tenant",
+                "Value": "team_a",
+                "Operator": "prefix"
+            }
+        ]
+    )";
+    APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
+    vector<pair<size_t, const Json::Value*>> configs;
+    for (Json::Value::ArrayIndex i = 0; i < configJson.size(); ++i) {
+        configs.emplace_back(i, &configJson[i]);
+    }
+    auto generateGroup = []() {
+        PipelineEventGroup g(make_shared<SourceBuffer>());
+        g.SetTag(string("key"), string("value"));
+        auto e = g.AddLogEvent();
+        e->SetContent(string("level"), string("ERROR"));
+        e->SetContent(string("tenant"), string("team_a_1"));
+        e = g.AddLogEvent();
+        e->SetContent(string("level"), string("ERROR"));
+        e->SetContent(string("tenant"), string("team_b"));
+        e = g.AddLogEvent();
+        e->SetContent(string("level"), string("INFO"));
+        e->SetContent(string("tenant"), string("team_b"));
+        return g;
+    };
+    {
+        // events are only sent to flushers with matched content conditions
+        Router router;
+        APSARA_TEST_TRUE(router.Init(configs, ctx));
+        APSARA_TEST_EQUAL(0U, router.mConditions.size());
+        APSARA_TEST_EQUAL(2U, router.mEventConditions.size());
+
+        auto g = generateGroup();
+        const auto* addr = g.GetEvents()[0].Get<LogEvent>();
+        auto res = router.Route(g);
+        APSARA_TEST_EQUAL(2U, res.size());
+        APSARA_TEST_EQUAL(0U, res[0].first);
+        APSARA_TEST_EQUAL(2U, res[0].second.GetEvents().size());
+        APSARA_TEST_TRUE(res[0].second.HasTag("key"));
+        APSARA_TEST_EQUAL(1U, res[1].first);
+        APSARA_TEST_EQUAL(1U, res[1].second.GetEvents().size());
+        APSARA_TEST_TRUE(res[1].second.HasTag("key"));
+        // the event matched by both conditions is shared
+        APSARA_TEST_EQUAL(addr, res[0].second.GetEvents()[0].Get<LogEvent>());
+        APSARA_TEST_EQUAL(addr, res[1].second.GetEvents()[0].Get<LogEvent>());
+        APSARA_TEST_EQUAL(3U, router.mPartitionedEventsTotal->GetValue());
+    }
+    {
+        // the whole group is still sent to the always matched flusher
+        configs.emplace_back(configJson.size(), nullptr);
+        Router router;
+        APSARA_TEST_TRUE(router.Init(configs, ctx));
+
+        auto g = generateGroup();
+        auto res = router.Route(g);
+        APSARA_TEST_EQUAL(3U, res.size());
+        APSARA_TEST_EQUAL(0U, res[0].first);
+        APSARA_TEST_EQUAL(2U, res[0].second.GetEvents().size());
+        APSARA_TEST_EQUAL(1U, res[1].first);
+        APSARA_TEST_EQUAL(1U, res[1].second.GetEvents().size());
+        APSARA_TEST_EQUAL(2U, res[2].first);
+        APSARA_TEST_EQUAL(3U, res[2].second.GetEvents().size());
+    }
+    {
+        // no group is generated if no event is matched
+        Router router;
+        APSARA_TEST_TRUE(router.Init(configs, ctx));
+
+        PipelineEventGroup g(make_shared<SourceBuffer>());
+        g.AddLogEvent()->SetContent(string("level"), string("INFO"));
+        auto res = router.Route(g);
+        APSARA_TEST_EQUAL(1U, res.size());
+        APSARA_TEST_EQUAL(2U, res[0].first);
+    }
+}
+
 void RouterUnittest::TestMetric() {
     Json::Value configJson;
     string errorMsg;
@@ -186,6 +275,7 @@ void RouterUnittest::TestMetric() {
 
 UNIT_TEST_CASE(RouterUnittest, TestInit)
 UNIT_TEST_CASE(RouterUnittest, TestRoute)
+UNIT_TEST_CASE(RouterUnittest, TestRouteByContent)
 UNIT_TEST_CASE(RouterUnittest, TestMetric)
 
 } // namespace logtail
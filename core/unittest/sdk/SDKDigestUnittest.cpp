@@ -0,0 +1,97 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <map>
+#include <string>
+
+#include "common/Flags.h"
+#include "sdk/Common.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_BOOL(sls_client_openssl_digest);
+
+using namespace std;
+
+namespace logtail {
+
+class SDKDigestUnittest : public ::testing::Test {
+public:
+    void TestMD5();
+    void TestHmacSha1();
+    void TestSignatureWithContentMd5();
+
+protected:
+    void TearDown() override { BOOL_FLAG(sls_client_openssl_digest) = true; }
+
+private:
+    static string ToHex(const string& s) {
+        static const char* table = "0123456789abcdef";
+        string res;
+        for (unsigned char c : s) {
+            res += table[c >> 4];
+            res += table[c & 0x0F];
+        }
+        return res;
+    }
+};
+
+void SDKDigestUnittest::TestMD5() {
+    string large(1024 * 1024 + 7, '\0');
+    for (size_t i = 0; i < large.size(); ++i) {
+        large[i] = static_cast<char>(i * 131 + 7);
+    }
+    for (bool useOpenssl : {true, false}) {
+        BOOL_FLAG(sls_client_openssl_digest) = useOpenssl;
+        APSARA_TEST_EQUAL("D41D8CD98F00B204E9800998ECF8427E", sdk::CalcMD5(""));
+        APSARA_TEST_EQUAL("9E107D9D372BB6826BD81D3542A419D6",
+                          sdk::CalcMD5("The quick brown fox jumps over the lazy dog"));
+    }
+    BOOL_FLAG(sls_client_openssl_digest) = true;
+    string res = sdk::CalcMD5(large);
+    BOOL_FLAG(sls_client_openssl_digest) = false;
+    APSARA_TEST_EQUAL(sdk::CalcMD5(large), res);
+}
+
+void SDKDigestUnittest::TestHmacSha1() {
+    // test cases from RFC 2202
+    for (bool useOpenssl : {true, false}) {
+        BOOL_FLAG(sls_client_openssl_digest) = useOpenssl;
+        APSARA_TEST_EQUAL("b617318655057264e28bc0b6fb378c8ef146be00",
+                          ToHex(sdk::CalcSHA1("Hi There", string(20, '\x0b'))));
+        APSARA_TEST_EQUAL("effcdf6ae5eb2fa2d27416d5f184df9c259a7c79",
+                          ToHex(sdk::CalcSHA1("what do ya want for nothing?", "Jefe")));
+        APSARA_TEST_EQUAL("aa4ae5e15272d00e95705637ce8a3b55ed402112",
+                          ToHex(sdk::CalcSHA1("Test Using Larger Than Block-Size Key - Hash Key First",
+                                              string(80, '\xaa'))));
+    }
+}
+
+void SDKDigestUnittest::TestSignatureWithContentMd5() {
+    string content = "content";
+    map<string, string> parameterList;
+    map<string, string> header;
+    header[sdk::DATE] = "Thu, 18 Feb 2021 10:11:10 GMT";
+    string expected = sdk::GetUrlSignature(sdk::HTTP_POST, "/logstores", header, parameterList, content, "key");
+
+    header[sdk::CONTENT_MD5] = sdk::CalcMD5(content);
+    APSARA_TEST_EQUAL(expected, sdk::GetUrlSignature(sdk::HTTP_POST, "/logstores", header, parameterList, content, "key"));
+}
+
+UNIT_TEST_CASE(SDKDigestUnittest, TestMD5)
+UNIT_TEST_CASE(SDKDigestUnittest, TestHmacSha1)
+UNIT_TEST_CASE(SDKDigestUnittest, TestSignatureWithContentMd5)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
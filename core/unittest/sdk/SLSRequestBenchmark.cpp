@@ -0,0 +1,95 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "common/Flags.h"
+#include "common/TimeUtil.h"
+#include "pipeline/queue/SenderQueueItem.h"
+#include "sdk/Client.h"
+#include "sdk/Common.h"
+
+#ifdef ENABLE_COMPATIBLE_MODE
+extern "C" {
+#include <string.h>
+asm(".symver memcpy, memcpy@GLIBC_2.2.5");
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+    return memcpy(dest, src, n);
+}
+}
+#endif
+
+DECLARE_FLAG_BOOL(sls_client_openssl_digest);
+
+using namespace std;
+
+namespace logtail {
+
+// measures the throughput of building PostLogStoreLogs requests on the sending thread, which includes calculating
+// Content-MD5 of the body and signing the request
+class SLSRequestBenchmark {
+public:
+    SLSRequestBenchmark() : mClient("", "cn-hangzhou.log.aliyuncs.com") {}
+
+    void TestBuildRequest(size_t bodySize) {
+        BOOL_FLAG(sls_client_openssl_digest) = false;
+        Run(bodySize, false, "bundled digest");
+        BOOL_FLAG(sls_client_openssl_digest) = true;
+        Run(bodySize, false, "openssl digest");
+        Run(bodySize, true, "precomputed md5");
+    }
+
+private:
+    static constexpr size_t sTotalBytes = 1024UL * 1024 * 1024;
+
+    void Run(size_t bodySize, bool precomputeMd5, const char* name) {
+        // SetUp
+        string data(bodySize, '\0');
+        for (size_t i = 0; i < bodySize; ++i) {
+            data[i] = static_cast<char>(i * 2654435761U >> 13);
+        }
+        SenderQueueItem item(std::move(data), bodySize * 4, nullptr, 0);
+        if (precomputeMd5) {
+            item.mDataMd5 = sdk::CalcMD5(item.mData);
+        }
+        size_t cnt = sTotalBytes / bodySize;
+        // Test
+        uint64_t starttime = GetCurrentTimeInMicroSeconds();
+        for (size_t i = 0; i < cnt; ++i) {
+            auto req = mClient.CreatePostLogStoreLogsRequest(
+                "test_project", "test_logstore", sls_logs::SLS_CMP_LZ4, item.mData, item.mRawSize, &item);
+        }
+        uint64_t timeelapsed = max<uint64_t>(GetCurrentTimeInMicroSeconds() - starttime, 1);
+        printf("%s with %luKB body: %lu requests cost %lums, %.1f MB/s\n",
+               name,
+               bodySize / 1024,
+               cnt,
+               timeelapsed / 1000,
+               cnt * bodySize * 1000000.0 / timeelapsed / 1024 / 1024);
+    }
+
+    sdk::Client mClient;
+};
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    logtail::SLSRequestBenchmark benchmark;
+    for (size_t bodySize : {64 * 1024, 512 * 1024, 4 * 1024 * 1024}) {
+        benchmark.TestBuildRequest(bodySize);
+    }
+    return 0;
+}